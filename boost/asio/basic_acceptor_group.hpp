@@ -0,0 +1,233 @@
+//
+// basic_acceptor_group.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_BASIC_ACCEPTOR_GROUP_HPP
+#define BOOST_ASIO_BASIC_ACCEPTOR_GROUP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+
+#if defined(BOOST_ASIO_HAS_SO_REUSEPORT) \
+  || defined(GENERATING_DOCUMENTATION)
+
+#include <cstddef>
+#include <vector>
+#include <boost/asio/basic_socket_acceptor.hpp>
+#include <boost/asio/error.hpp>
+#include <boost/asio/io_service_pool.hpp>
+#include <boost/asio/socket_acceptor_service.hpp>
+#include <boost/asio/socket_base.hpp>
+#include <boost/asio/detail/noncopyable.hpp>
+#include <boost/asio/detail/shared_ptr.hpp>
+#include <boost/asio/detail/throw_error.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+
+/// Provides a set of acceptors that share a listening port, one for each
+/// io_service in a pool.
+/**
+ * The basic_acceptor_group class template opens one acceptor on each
+ * io_service in an io_service_pool. Every acceptor has the
+ * socket_base::reuse_port option set and is bound to the same endpoint, so
+ * that the operating system distributes incoming connections among them.
+ * A connection accepted by the acceptor at a given index is handled entirely
+ * by the io_service at the same index in the pool, and never migrates between
+ * threads.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe. Each acceptor in the group has the same
+ * thread safety as a basic_socket_acceptor.
+ *
+ * @par Example
+ * Accepting connections on every io_service in a pool:
+ * @code
+ * boost::asio::io_service_pool pool(4);
+ * boost::asio::basic_acceptor_group<boost::asio::ip::tcp> acceptors(pool,
+ *     boost::asio::ip::tcp::endpoint(boost::asio::ip::tcp::v4(), 8080));
+ * for (std::size_t i = 0; i < acceptors.size(); ++i)
+ *   start_accept(acceptors[i]);
+ * pool.run();
+ * @endcode
+ */
+template <typename Protocol,
+    typename SocketAcceptorService = socket_acceptor_service<Protocol> >
+class basic_acceptor_group
+  : private noncopyable
+{
+public:
+  /// The protocol type.
+  typedef Protocol protocol_type;
+
+  /// The endpoint type.
+  typedef typename Protocol::endpoint endpoint_type;
+
+  /// The type of each acceptor in the group.
+  typedef basic_socket_acceptor<Protocol, SocketAcceptorService> acceptor_type;
+
+  /// Construct a group of acceptors listening on the specified endpoint.
+  /**
+   * This constructor creates one acceptor for each io_service in the pool.
+   * Each acceptor is opened, has the socket_base::reuse_address and
+   * socket_base::reuse_port options set, is bound to the endpoint and is put
+   * into the listening state.
+   *
+   * If the endpoint's port is zero, the first acceptor is bound to an
+   * ephemeral port and the remaining acceptors are bound to the same port.
+   *
+   * @param pool The io_service_pool that provides the io_service objects
+   * used by the acceptors.
+   *
+   * @param endpoint An endpoint on the local machine on which the acceptors
+   * will listen for new connections.
+   *
+   * @param backlog The maximum length of the queue of pending connections for
+   * each acceptor.
+   *
+   * @throws boost::system::system_error Thrown on failure.
+   */
+  basic_acceptor_group(io_service_pool& pool, const endpoint_type& endpoint,
+      int backlog = socket_base::max_connections)
+  {
+    boost::system::error_code ec;
+    open(pool, endpoint, backlog, ec);
+    boost::asio::detail::throw_error(ec, "open");
+  }
+
+  /// Construct a group of acceptors listening on the specified endpoint.
+  /**
+   * This constructor creates one acceptor for each io_service in the pool.
+   * Each acceptor is opened, has the socket_base::reuse_address and
+   * socket_base::reuse_port options set, is bound to the endpoint and is put
+   * into the listening state.
+   *
+   * @param pool The io_service_pool that provides the io_service objects
+   * used by the acceptors.
+   *
+   * @param endpoint An endpoint on the local machine on which the acceptors
+   * will listen for new connections.
+   *
+   * @param backlog The maximum length of the queue of pending connections for
+   * each acceptor.
+   *
+   * @param ec Set to indicate what error occurred, if any. On failure, the
+   * group contains no acceptors.
+   */
+  basic_acceptor_group(io_service_pool& pool, const endpoint_type& endpoint,
+      int backlog, boost::system::error_code& ec)
+  {
+    open(pool, endpoint, backlog, ec);
+  }
+
+  /// Get the number of acceptors in the group.
+  std::size_t size() const
+  {
+    return acceptors_.size();
+  }
+
+  /// Get the acceptor at the given index.
+  /**
+   * The acceptor at index @c i uses the io_service at index @c i in the pool
+   * that was used to construct the group.
+   */
+  acceptor_type& operator[](std::size_t index)
+  {
+    return *acceptors_[index];
+  }
+
+  /// Get the local endpoint shared by all acceptors in the group.
+  /**
+   * @throws boost::system::system_error Thrown on failure.
+   */
+  endpoint_type local_endpoint() const
+  {
+    boost::system::error_code ec;
+    endpoint_type ep = local_endpoint(ec);
+    boost::asio::detail::throw_error(ec, "local_endpoint");
+    return ep;
+  }
+
+  /// Get the local endpoint shared by all acceptors in the group.
+  /**
+   * @param ec Set to indicate what error occurred, if any.
+   *
+   * @returns An object that represents the local endpoint of the acceptors.
+   * Returns a default-constructed endpoint object if an error occurred.
+   */
+  endpoint_type local_endpoint(boost::system::error_code& ec) const
+  {
+    if (acceptors_.empty())
+    {
+      ec = boost::asio::error::bad_descriptor;
+      return endpoint_type();
+    }
+    return acceptors_[0]->local_endpoint(ec);
+  }
+
+  /// Close all acceptors in the group.
+  /**
+   * Any asynchronous accept operations are cancelled immediately. The
+   * acceptor objects remain in the group and may be reopened individually.
+   */
+  void close()
+  {
+    boost::system::error_code ec;
+    for (std::size_t i = 0; i < acceptors_.size(); ++i)
+      acceptors_[i]->close(ec);
+  }
+
+private:
+  // Open, bind and listen on one acceptor per io_service in the pool.
+  void open(io_service_pool& pool, endpoint_type endpoint,
+      int backlog, boost::system::error_code& ec)
+  {
+    ec = boost::system::error_code();
+    for (std::size_t i = 0; i < pool.size() && !ec; ++i)
+    {
+      detail::shared_ptr<acceptor_type> acceptor(
+          new acceptor_type(pool.get_io_service(i)));
+      acceptor->open(endpoint.protocol(), ec);
+      if (!ec)
+        acceptor->set_option(socket_base::reuse_address(true), ec);
+      if (!ec)
+        acceptor->set_option(socket_base::reuse_port(true), ec);
+      if (!ec)
+        acceptor->bind(endpoint, ec);
+      if (!ec)
+        acceptor->listen(backlog, ec);
+      if (!ec && i == 0)
+        endpoint = acceptor->local_endpoint(ec);
+      if (!ec)
+        acceptors_.push_back(acceptor);
+    }
+
+    if (ec)
+      acceptors_.clear();
+  }
+
+  // The acceptors, in the same order as the io_service objects in the pool.
+  std::vector<detail::shared_ptr<acceptor_type> > acceptors_;
+};
+
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // defined(BOOST_ASIO_HAS_SO_REUSEPORT)
+       //   || defined(GENERATING_DOCUMENTATION)
+
+#endif // BOOST_ASIO_BASIC_ACCEPTOR_GROUP_HPP
@@ -18,6 +18,8 @@
 #include <boost/asio/detail/config.hpp>
 #include <cstddef>
 #include <boost/asio/basic_socket.hpp>
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/datagram_slot.hpp>
 #include <boost/asio/datagram_socket_service.hpp>
 #include <boost/asio/detail/handler_type_requirements.hpp>
 #include <boost/asio/detail/throw_error.hpp>
@@ -943,6 +945,317 @@ public:
         this->get_implementation(), buffers, sender_endpoint, flags,
         BOOST_ASIO_MOVE_CAST(ReadHandler)(handler));
   }
+
+#if defined(BOOST_ASIO_HAS_MMSG) || defined(GENERATING_DOCUMENTATION)
+  /// The type of a slot used to send a batch of datagrams.
+  typedef datagram_slot<endpoint_type, const_buffer> send_slot;
+
+  /// The type of a slot used to receive a batch of datagrams.
+  typedef datagram_slot<endpoint_type, mutable_buffer> receive_slot;
+
+  /// Send a batch of datagrams.
+  /**
+   * This function is used to send several datagrams, each to the endpoint
+   * given in its slot, using as few system calls as possible. The function
+   * call will block until all of the datagrams have been sent successfully or
+   * an error occurs.
+   *
+   * @param slots An array of slots, each describing one datagram. The
+   * bytes_transferred member of each slot is set to the number of bytes sent.
+   *
+   * @param count The number of slots in the array.
+   *
+   * @returns The number of datagrams sent.
+   *
+   * @throws boost::system::system_error Thrown on failure.
+   *
+   * @par Example
+   * @code
+   * std::vector<boost::asio::ip::udp::socket::send_slot> slots;
+   * slots.push_back(boost::asio::ip::udp::socket::send_slot(
+   *       boost::asio::buffer(data1, size1), destination1));
+   * slots.push_back(boost::asio::ip::udp::socket::send_slot(
+   *       boost::asio::buffer(data2, size2), destination2));
+   * socket.send_many(&slots[0], slots.size());
+   * @endcode
+   *
+   * @note Only available on Linux, where it is implemented using sendmmsg().
+   */
+  std::size_t send_many(send_slot* slots, std::size_t count)
+  {
+    boost::system::error_code ec;
+    std::size_t s = this->get_service().send_many(
+        this->get_implementation(), slots, count, 0, ec);
+    boost::asio::detail::throw_error(ec, "send_many");
+    return s;
+  }
+
+  /// Send a batch of datagrams.
+  /**
+   * This function is used to send several datagrams, each to the endpoint
+   * given in its slot, using as few system calls as possible. The function
+   * call will block until all of the datagrams have been sent successfully or
+   * an error occurs.
+   *
+   * @param slots An array of slots, each describing one datagram. The
+   * bytes_transferred member of each slot is set to the number of bytes sent.
+   *
+   * @param count The number of slots in the array.
+   *
+   * @param flags Flags specifying how the send call is to be made.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   *
+   * @returns The number of datagrams sent. If an error occurs, this is the
+   * index of the slot whose datagram could not be sent.
+   */
+  std::size_t send_many(send_slot* slots, std::size_t count,
+      socket_base::message_flags flags, boost::system::error_code& ec)
+  {
+    return this->get_service().send_many(
+        this->get_implementation(), slots, count, flags, ec);
+  }
+
+  /// Start an asynchronous send of a batch of datagrams.
+  /**
+   * This function is used to asynchronously send several datagrams, each to
+   * the endpoint given in its slot. The function call always returns
+   * immediately. The operation completes when all of the datagrams have been
+   * sent or an error occurs.
+   *
+   * @param slots An array of slots, each describing one datagram. The
+   * bytes_transferred member of each slot is set to the number of bytes sent.
+   * Ownership of the slots, and of the memory blocks they refer to, is
+   * retained by the caller, which must guarantee that they remain valid until
+   * the handler is called.
+   *
+   * @param count The number of slots in the array.
+   *
+   * @param handler The handler to be called when the send operation
+   * completes. Copies will be made of the handler as required. The function
+   * signature of the handler must be:
+   * @code void handler(
+   *   const boost::system::error_code& error, // Result of operation.
+   *   std::size_t datagrams_transferred       // Number of datagrams sent.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. Invocation
+   * of the handler will be performed in a manner equivalent to using
+   * boost::asio::io_service::post().
+   */
+  template <typename WriteHandler>
+  BOOST_ASIO_INITFN_RESULT_TYPE(WriteHandler,
+      void (boost::system::error_code, std::size_t))
+  async_send_many(send_slot* slots, std::size_t count,
+      BOOST_ASIO_MOVE_ARG(WriteHandler) handler)
+  {
+    // If you get an error on the following line it means that your handler does
+    // not meet the documented type requirements for a WriteHandler.
+    BOOST_ASIO_WRITE_HANDLER_CHECK(WriteHandler, handler) type_check;
+
+    return this->get_service().async_send_many(
+        this->get_implementation(), slots, count, 0,
+        BOOST_ASIO_MOVE_CAST(WriteHandler)(handler));
+  }
+
+  /// Start an asynchronous send of a batch of datagrams.
+  /**
+   * This function is used to asynchronously send several datagrams, each to
+   * the endpoint given in its slot. The function call always returns
+   * immediately. The operation completes when all of the datagrams have been
+   * sent or an error occurs.
+   *
+   * @param slots An array of slots, each describing one datagram. The
+   * bytes_transferred member of each slot is set to the number of bytes sent.
+   * Ownership of the slots, and of the memory blocks they refer to, is
+   * retained by the caller, which must guarantee that they remain valid until
+   * the handler is called.
+   *
+   * @param count The number of slots in the array.
+   *
+   * @param flags Flags specifying how the send call is to be made.
+   *
+   * @param handler The handler to be called when the send operation
+   * completes. Copies will be made of the handler as required. The function
+   * signature of the handler must be:
+   * @code void handler(
+   *   const boost::system::error_code& error, // Result of operation.
+   *   std::size_t datagrams_transferred       // Number of datagrams sent.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. Invocation
+   * of the handler will be performed in a manner equivalent to using
+   * boost::asio::io_service::post().
+   */
+  template <typename WriteHandler>
+  BOOST_ASIO_INITFN_RESULT_TYPE(WriteHandler,
+      void (boost::system::error_code, std::size_t))
+  async_send_many(send_slot* slots, std::size_t count,
+      socket_base::message_flags flags,
+      BOOST_ASIO_MOVE_ARG(WriteHandler) handler)
+  {
+    // If you get an error on the following line it means that your handler does
+    // not meet the documented type requirements for a WriteHandler.
+    BOOST_ASIO_WRITE_HANDLER_CHECK(WriteHandler, handler) type_check;
+
+    return this->get_service().async_send_many(
+        this->get_implementation(), slots, count, flags,
+        BOOST_ASIO_MOVE_CAST(WriteHandler)(handler));
+  }
+
+  /// Receive a batch of datagrams.
+  /**
+   * This function is used to receive several datagrams using as few system
+   * calls as possible. The function call will block until at least one
+   * datagram has been received or an error occurs, and then fills as many
+   * slots as it can without blocking.
+   *
+   * @param slots An array of slots, each with a buffer into which one
+   * datagram will be received. The endpoint, bytes_transferred and
+   * segment_size members of each filled slot are set to describe the
+   * datagram.
+   *
+   * @param count The number of slots in the array.
+   *
+   * @returns The number of slots filled.
+   *
+   * @throws boost::system::system_error Thrown on failure.
+   *
+   * @par Example
+   * @code
+   * boost::asio::ip::udp::socket::receive_slot slots[32];
+   * for (int i = 0; i < 32; ++i)
+   *   slots[i].buffer = boost::asio::buffer(data[i], size);
+   * std::size_t n = socket.receive_many(slots, 32);
+   * @endcode
+   *
+   * @note Only available on Linux, where it is implemented using recvmmsg().
+   */
+  std::size_t receive_many(receive_slot* slots, std::size_t count)
+  {
+    boost::system::error_code ec;
+    std::size_t s = this->get_service().receive_many(
+        this->get_implementation(), slots, count, 0, ec);
+    boost::asio::detail::throw_error(ec, "receive_many");
+    return s;
+  }
+
+  /// Receive a batch of datagrams.
+  /**
+   * This function is used to receive several datagrams using as few system
+   * calls as possible. The function call will block until at least one
+   * datagram has been received or an error occurs, and then fills as many
+   * slots as it can without blocking.
+   *
+   * @param slots An array of slots, each with a buffer into which one
+   * datagram will be received. The endpoint, bytes_transferred and
+   * segment_size members of each filled slot are set to describe the
+   * datagram.
+   *
+   * @param count The number of slots in the array.
+   *
+   * @param flags Flags specifying how the receive call is to be made.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   *
+   * @returns The number of slots filled.
+   */
+  std::size_t receive_many(receive_slot* slots, std::size_t count,
+      socket_base::message_flags flags, boost::system::error_code& ec)
+  {
+    return this->get_service().receive_many(
+        this->get_implementation(), slots, count, flags, ec);
+  }
+
+  /// Start an asynchronous receive of a batch of datagrams.
+  /**
+   * This function is used to asynchronously receive several datagrams. The
+   * function call always returns immediately. The operation completes once at
+   * least one datagram has been received, after filling as many slots as it
+   * can without blocking.
+   *
+   * @param slots An array of slots, each with a buffer into which one
+   * datagram will be received. The endpoint, bytes_transferred and
+   * segment_size members of each filled slot are set to describe the
+   * datagram. Ownership of the slots, and of the memory blocks they refer to,
+   * is retained by the caller, which must guarantee that they remain valid
+   * until the handler is called.
+   *
+   * @param count The number of slots in the array.
+   *
+   * @param handler The handler to be called when the receive operation
+   * completes. Copies will be made of the handler as required. The function
+   * signature of the handler must be:
+   * @code void handler(
+   *   const boost::system::error_code& error, // Result of operation.
+   *   std::size_t datagrams_transferred       // Number of slots filled.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. Invocation
+   * of the handler will be performed in a manner equivalent to using
+   * boost::asio::io_service::post().
+   */
+  template <typename ReadHandler>
+  BOOST_ASIO_INITFN_RESULT_TYPE(ReadHandler,
+      void (boost::system::error_code, std::size_t))
+  async_receive_many(receive_slot* slots, std::size_t count,
+      BOOST_ASIO_MOVE_ARG(ReadHandler) handler)
+  {
+    // If you get an error on the following line it means that your handler does
+    // not meet the documented type requirements for a ReadHandler.
+    BOOST_ASIO_READ_HANDLER_CHECK(ReadHandler, handler) type_check;
+
+    return this->get_service().async_receive_many(
+        this->get_implementation(), slots, count, 0,
+        BOOST_ASIO_MOVE_CAST(ReadHandler)(handler));
+  }
+
+  /// Start an asynchronous receive of a batch of datagrams.
+  /**
+   * This function is used to asynchronously receive several datagrams. The
+   * function call always returns immediately. The operation completes once at
+   * least one datagram has been received, after filling as many slots as it
+   * can without blocking.
+   *
+   * @param slots An array of slots, each with a buffer into which one
+   * datagram will be received. The endpoint, bytes_transferred and
+   * segment_size members of each filled slot are set to describe the
+   * datagram. Ownership of the slots, and of the memory blocks they refer to,
+   * is retained by the caller, which must guarantee that they remain valid
+   * until the handler is called.
+   *
+   * @param count The number of slots in the array.
+   *
+   * @param flags Flags specifying how the receive call is to be made.
+   *
+   * @param handler The handler to be called when the receive operation
+   * completes. Copies will be made of the handler as required. The function
+   * signature of the handler must be:
+   * @code void handler(
+   *   const boost::system::error_code& error, // Result of operation.
+   *   std::size_t datagrams_transferred       // Number of slots filled.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. Invocation
+   * of the handler will be performed in a manner equivalent to using
+   * boost::asio::io_service::post().
+   */
+  template <typename ReadHandler>
+  BOOST_ASIO_INITFN_RESULT_TYPE(ReadHandler,
+      void (boost::system::error_code, std::size_t))
+  async_receive_many(receive_slot* slots, std::size_t count,
+      socket_base::message_flags flags,
+      BOOST_ASIO_MOVE_ARG(ReadHandler) handler)
+  {
+    // If you get an error on the following line it means that your handler does
+    // not meet the documented type requirements for a ReadHandler.
+    BOOST_ASIO_READ_HANDLER_CHECK(ReadHandler, handler) type_check;
+
+    return this->get_service().async_receive_many(
+        this->get_implementation(), slots, count, flags,
+        BOOST_ASIO_MOVE_CAST(ReadHandler)(handler));
+  }
+#endif // defined(BOOST_ASIO_HAS_MMSG) || defined(GENERATING_DOCUMENTATION)
 };
 
 } // namespace asio
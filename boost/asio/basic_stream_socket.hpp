@@ -19,6 +19,7 @@
 #include <cstddef>
 #include <boost/asio/async_result.hpp>
 #include <boost/asio/basic_socket.hpp>
+#include <boost/asio/detail/cstdint.hpp>
 #include <boost/asio/detail/handler_type_requirements.hpp>
 #include <boost/asio/detail/throw_error.hpp>
 #include <boost/asio/error.hpp>
@@ -413,6 +414,108 @@ public:
         BOOST_ASIO_MOVE_CAST(WriteHandler)(handler));
   }
 
+#if defined(BOOST_ASIO_HAS_SENDFILE) || defined(GENERATING_DOCUMENTATION)
+  /// Send part of a file on the socket.
+  /**
+   * This function is used to send data from a file on the stream socket,
+   * without copying it through user space. The function call will block until
+   * the requested range has been sent successfully, or until an error occurs.
+   *
+   * @param file A native descriptor for the file to be sent. The file's
+   * current position is neither used nor changed.
+   *
+   * @param offset The position in the file at which to start sending.
+   *
+   * @param length The number of bytes to send.
+   *
+   * @returns The number of bytes sent.
+   *
+   * @throws boost::system::system_error Thrown on failure. An error code of
+   * boost::asio::error::eof indicates that the file ended before the range.
+   *
+   * @note Only available on Linux, where it is implemented using sendfile().
+   */
+  std::size_t send_file(int file, uint64_t offset, std::size_t length)
+  {
+    boost::system::error_code ec;
+    std::size_t s = this->get_service().send_file(
+        this->get_implementation(), file, offset, length, ec);
+    boost::asio::detail::throw_error(ec, "send_file");
+    return s;
+  }
+
+  /// Send part of a file on the socket.
+  /**
+   * This function is used to send data from a file on the stream socket,
+   * without copying it through user space. The function call will block until
+   * the requested range has been sent successfully, or until an error occurs.
+   *
+   * @param file A native descriptor for the file to be sent. The file's
+   * current position is neither used nor changed.
+   *
+   * @param offset The position in the file at which to start sending.
+   *
+   * @param length The number of bytes to send.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   *
+   * @returns The number of bytes sent.
+   */
+  std::size_t send_file(int file, uint64_t offset, std::size_t length,
+      boost::system::error_code& ec)
+  {
+    return this->get_service().send_file(
+        this->get_implementation(), file, offset, length, ec);
+  }
+
+  /// Start an asynchronous send of part of a file.
+  /**
+   * This function is used to asynchronously send data from a file on the
+   * stream socket, without copying it through user space. The function call
+   * always returns immediately. Unlike async_send, the operation does not
+   * complete until the whole range has been sent or an error occurs.
+   *
+   * @param file A native descriptor for the file to be sent. The descriptor
+   * must remain open until the handler is called. The file's current
+   * position is neither used nor changed.
+   *
+   * @param offset The position in the file at which to start sending.
+   *
+   * @param length The number of bytes to send.
+   *
+   * @param handler The handler to be called when the send operation completes.
+   * Copies will be made of the handler as required. The function signature of
+   * the handler must be:
+   * @code void handler(
+   *   const boost::system::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred           // Number of bytes sent.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. Invocation
+   * of the handler will be performed in a manner equivalent to using
+   * boost::asio::io_service::post().
+   *
+   * @par Example
+   * @code
+   * socket.async_send_file(fd, 0, file_size, handler);
+   * @endcode
+   */
+  template <typename WriteHandler>
+  BOOST_ASIO_INITFN_RESULT_TYPE(WriteHandler,
+      void (boost::system::error_code, std::size_t))
+  async_send_file(int file, uint64_t offset, std::size_t length,
+      BOOST_ASIO_MOVE_ARG(WriteHandler) handler)
+  {
+    // If you get an error on the following line it means that your handler does
+    // not meet the documented type requirements for a WriteHandler.
+    BOOST_ASIO_WRITE_HANDLER_CHECK(WriteHandler, handler) type_check;
+
+    return this->get_service().async_send_file(
+        this->get_implementation(), file, offset, length,
+        BOOST_ASIO_MOVE_CAST(WriteHandler)(handler));
+  }
+#endif // defined(BOOST_ASIO_HAS_SENDFILE) || defined(GENERATING_DOCUMENTATION)
+
   /// Receive some data on the socket.
   /**
    * This function is used to receive data on the stream socket. The function
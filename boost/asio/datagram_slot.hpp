@@ -0,0 +1,98 @@
+//
+// datagram_slot.hpp
+// ~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DATAGRAM_SLOT_HPP
+#define BOOST_ASIO_DATAGRAM_SLOT_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <cstddef>
+#include <boost/asio/buffer.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+
+/// Describes one datagram in a batched send or receive operation.
+/**
+ * The basic_datagram_socket::send_many and basic_datagram_socket::receive_many
+ * functions, and their asynchronous counterparts, operate on an array of
+ * slots. Each slot holds the buffer and peer endpoint for a single datagram,
+ * and records the outcome of the operation on that datagram.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe.
+ */
+template <typename Endpoint, typename Buffer>
+class datagram_slot
+{
+public:
+  /// The type of the endpoint.
+  typedef Endpoint endpoint_type;
+
+  /// The type of the buffer.
+  typedef Buffer buffer_type;
+
+  /// Construct an empty slot.
+  datagram_slot()
+    : bytes_transferred(0),
+      segment_size(0)
+  {
+  }
+
+  /// Construct a slot for the given buffer.
+  explicit datagram_slot(const Buffer& b)
+    : buffer(b),
+      bytes_transferred(0),
+      segment_size(0)
+  {
+  }
+
+  /// Construct a slot for the given buffer and endpoint.
+  datagram_slot(const Buffer& b, const Endpoint& e)
+    : buffer(b),
+      endpoint(e),
+      bytes_transferred(0),
+      segment_size(0)
+  {
+  }
+
+  /// The datagram's data, or the space into which it is to be received.
+  Buffer buffer;
+
+  /// The destination of a datagram being sent, or the sender of a datagram
+  /// that has been received.
+  Endpoint endpoint;
+
+  /// The number of bytes sent or received. Set by the operation.
+  std::size_t bytes_transferred;
+
+  /// The segment size for UDP generic segmentation and receive offload.
+  /**
+   * When sending, a non-zero value asks the kernel to split the buffer into
+   * datagrams of this size (UDP_SEGMENT). When receiving with
+   * ip::udp::generic_receive_offload enabled, the kernel may coalesce several
+   * datagrams from the same sender into one buffer, and this is set to the
+   * size of each of them. It is otherwise set to 0.
+   */
+  std::size_t segment_size;
+};
+
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_DATAGRAM_SLOT_HPP
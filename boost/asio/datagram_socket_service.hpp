@@ -18,6 +18,8 @@
 #include <boost/asio/detail/config.hpp>
 #include <cstddef>
 #include <boost/asio/async_result.hpp>
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/datagram_slot.hpp>
 #include <boost/asio/detail/type_traits.hpp>
 #include <boost/asio/error.hpp>
 #include <boost/asio/io_service.hpp>
@@ -411,6 +413,60 @@ public:
     return init.result.get();
   }
 
+#if defined(BOOST_ASIO_HAS_MMSG) || defined(GENERATING_DOCUMENTATION)
+  /// Send a batch of datagrams.
+  std::size_t send_many(implementation_type& impl,
+      datagram_slot<endpoint_type, const_buffer>* slots, std::size_t count,
+      socket_base::message_flags flags, boost::system::error_code& ec)
+  {
+    return service_impl_.send_many(impl, slots, count, flags, ec);
+  }
+
+  /// Start an asynchronous send of a batch of datagrams.
+  template <typename WriteHandler>
+  BOOST_ASIO_INITFN_RESULT_TYPE(WriteHandler,
+      void (boost::system::error_code, std::size_t))
+  async_send_many(implementation_type& impl,
+      datagram_slot<endpoint_type, const_buffer>* slots, std::size_t count,
+      socket_base::message_flags flags,
+      BOOST_ASIO_MOVE_ARG(WriteHandler) handler)
+  {
+    detail::async_result_init<
+      WriteHandler, void (boost::system::error_code, std::size_t)> init(
+        BOOST_ASIO_MOVE_CAST(WriteHandler)(handler));
+
+    service_impl_.async_send_many(impl, slots, count, flags, init.handler);
+
+    return init.result.get();
+  }
+
+  /// Receive a batch of datagrams.
+  std::size_t receive_many(implementation_type& impl,
+      datagram_slot<endpoint_type, mutable_buffer>* slots, std::size_t count,
+      socket_base::message_flags flags, boost::system::error_code& ec)
+  {
+    return service_impl_.receive_many(impl, slots, count, flags, ec);
+  }
+
+  /// Start an asynchronous receive of a batch of datagrams.
+  template <typename ReadHandler>
+  BOOST_ASIO_INITFN_RESULT_TYPE(ReadHandler,
+      void (boost::system::error_code, std::size_t))
+  async_receive_many(implementation_type& impl,
+      datagram_slot<endpoint_type, mutable_buffer>* slots, std::size_t count,
+      socket_base::message_flags flags,
+      BOOST_ASIO_MOVE_ARG(ReadHandler) handler)
+  {
+    detail::async_result_init<
+      ReadHandler, void (boost::system::error_code, std::size_t)> init(
+        BOOST_ASIO_MOVE_CAST(ReadHandler)(handler));
+
+    service_impl_.async_receive_many(impl, slots, count, flags, init.handler);
+
+    return init.result.get();
+  }
+#endif // defined(BOOST_ASIO_HAS_MMSG) || defined(GENERATING_DOCUMENTATION)
+
 private:
   // Destroy all user-defined handler objects owned by the service.
   void shutdown_service()
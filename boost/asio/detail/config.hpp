@@ -450,6 +450,38 @@
 #   endif // (__GLIBC__ > 2) || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 8)
 #  endif // defined(BOOST_ASIO_HAS_EPOLL)
 # endif // !defined(BOOST_ASIO_HAS_TIMERFD)
+# if !defined(BOOST_ASIO_EPOLL_MAX_EVENTS)
+#  define BOOST_ASIO_EPOLL_MAX_EVENTS 128
+# endif // !defined(BOOST_ASIO_EPOLL_MAX_EVENTS)
+# if !defined(BOOST_ASIO_HAS_SENDFILE)
+#  if !defined(BOOST_ASIO_DISABLE_SENDFILE)
+#   define BOOST_ASIO_HAS_SENDFILE 1
+#  endif // !defined(BOOST_ASIO_DISABLE_SENDFILE)
+# endif // !defined(BOOST_ASIO_HAS_SENDFILE)
+# if !defined(BOOST_ASIO_HAS_MMSG)
+#  if !defined(BOOST_ASIO_DISABLE_MMSG)
+#   if LINUX_VERSION_CODE >= KERNEL_VERSION(3,0,0)
+#    define BOOST_ASIO_HAS_MMSG 1
+#   endif // LINUX_VERSION_CODE >= KERNEL_VERSION(3,0,0)
+#  endif // !defined(BOOST_ASIO_DISABLE_MMSG)
+# endif // !defined(BOOST_ASIO_HAS_MMSG)
+# if !defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+#  if !defined(BOOST_ASIO_DISABLE_MSG_ZEROCOPY)
+#   if LINUX_VERSION_CODE >= KERNEL_VERSION(4,14,0)
+#    define BOOST_ASIO_HAS_MSG_ZEROCOPY 1
+#   endif // LINUX_VERSION_CODE >= KERNEL_VERSION(4,14,0)
+#  endif // !defined(BOOST_ASIO_DISABLE_MSG_ZEROCOPY)
+# endif // !defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+# if !defined(BOOST_ASIO_HAS_IO_URING)
+#  if defined(BOOST_ASIO_ENABLE_IO_URING) && defined(BOOST_ASIO_HAS_EPOLL)
+#   if LINUX_VERSION_CODE >= KERNEL_VERSION(5,19,0)
+#    define BOOST_ASIO_HAS_IO_URING 1
+#   endif // LINUX_VERSION_CODE >= KERNEL_VERSION(5,19,0)
+#  endif // defined(BOOST_ASIO_ENABLE_IO_URING) && defined(BOOST_ASIO_HAS_EPOLL)
+# endif // !defined(BOOST_ASIO_HAS_IO_URING)
+# if !defined(BOOST_ASIO_IO_URING_ENTRIES)
+#  define BOOST_ASIO_IO_URING_ENTRIES 256
+# endif // !defined(BOOST_ASIO_IO_URING_ENTRIES)
 #endif // defined(__linux__)
 
 // Mac OS X, FreeBSD, NetBSD, OpenBSD: kqueue.
@@ -545,6 +577,19 @@
 # endif // !defined(BOOST_ASIO_DISABLE_LOCAL_SOCKETS)
 #endif // !defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
 
+// Support for the SO_REUSEPORT socket option.
+#if !defined(BOOST_ASIO_HAS_SO_REUSEPORT)
+# if !defined(BOOST_ASIO_DISABLE_SO_REUSEPORT)
+#  if defined(__linux__) \
+   || defined(__FreeBSD__) \
+   || defined(__NetBSD__) \
+   || defined(__OpenBSD__) \
+   || (defined(__MACH__) && defined(__APPLE__))
+#   define BOOST_ASIO_HAS_SO_REUSEPORT 1
+#  endif // defined(__linux__) || ...
+# endif // !defined(BOOST_ASIO_DISABLE_SO_REUSEPORT)
+#endif // !defined(BOOST_ASIO_HAS_SO_REUSEPORT)
+
 // Can use sigaction() instead of signal().
 #if !defined(BOOST_ASIO_HAS_SIGACTION)
 # if !defined(BOOST_ASIO_DISABLE_SIGACTION)
@@ -632,6 +677,42 @@
 # endif // defined(BOOST_ASIO_HAS_THREADS)
 #endif // !defined(BOOST_ASIO_HAS_PTHREADS)
 
+// Per-thread handler queues with work stealing in the io_service.
+#if defined(BOOST_ASIO_ENABLE_WORK_STEALING)
+# if !defined(BOOST_ASIO_WORK_STEALING_DEFAULT_SHARDS)
+#  define BOOST_ASIO_WORK_STEALING_DEFAULT_SHARDS 16
+# endif // !defined(BOOST_ASIO_WORK_STEALING_DEFAULT_SHARDS)
+# if !defined(BOOST_ASIO_WORK_STEALING_MAX_SHARDS)
+#  define BOOST_ASIO_WORK_STEALING_MAX_SHARDS 256
+# endif // !defined(BOOST_ASIO_WORK_STEALING_MAX_SHARDS)
+#endif // defined(BOOST_ASIO_ENABLE_WORK_STEALING)
+#if !defined(BOOST_ASIO_WORK_STEALING_TASK_INTERVAL)
+# define BOOST_ASIO_WORK_STEALING_TASK_INTERVAL 61
+#endif // !defined(BOOST_ASIO_WORK_STEALING_TASK_INTERVAL)
+
+// Lock-free strand implementation.
+#if !defined(BOOST_ASIO_HAS_LOCK_FREE_STRAND)
+# if !defined(BOOST_ASIO_DISABLE_LOCK_FREE_STRAND)
+#  if defined(BOOST_ASIO_HAS_STD_ATOMIC)
+#   define BOOST_ASIO_HAS_LOCK_FREE_STRAND 1
+#  endif // defined(BOOST_ASIO_HAS_STD_ATOMIC)
+# endif // !defined(BOOST_ASIO_DISABLE_LOCK_FREE_STRAND)
+#endif // !defined(BOOST_ASIO_HAS_LOCK_FREE_STRAND)
+
+// Resolution, in microseconds, of the timing wheel used for timer queues.
+#if !defined(BOOST_ASIO_TIMER_WHEEL_RESOLUTION)
+# define BOOST_ASIO_TIMER_WHEEL_RESOLUTION 1000
+#endif // !defined(BOOST_ASIO_TIMER_WHEEL_RESOLUTION)
+
+// Size classes and per-thread cache capacity of the recycling allocator used
+// for handler memory.
+#if !defined(BOOST_ASIO_RECYCLING_ALLOCATOR_SIZE_CLASSES)
+# define BOOST_ASIO_RECYCLING_ALLOCATOR_SIZE_CLASSES 5
+#endif // !defined(BOOST_ASIO_RECYCLING_ALLOCATOR_SIZE_CLASSES)
+#if !defined(BOOST_ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE)
+# define BOOST_ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE 4
+#endif // !defined(BOOST_ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE)
+
 // Helper to prevent macro expansion.
 #define BOOST_ASIO_PREVENT_MACRO_SUBSTITUTION
 
@@ -0,0 +1,156 @@
+//
+// detail/datagram_slot_adapter.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_DATAGRAM_SLOT_ADAPTER_HPP
+#define BOOST_ASIO_DETAIL_DATAGRAM_SLOT_ADAPTER_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+
+#if defined(BOOST_ASIO_HAS_MMSG)
+
+#include <cstring>
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/datagram_slot.hpp>
+#include <boost/asio/detail/buffer_sequence_adapter.hpp>
+#include <boost/asio/detail/cstdint.hpp>
+#include <boost/asio/detail/socket_types.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+// Helper class to translate an array of datagram slots into the message
+// headers used by recvmmsg() and sendmmsg(). At most max_mmsg_len slots are
+// translated, so that the headers can live on the stack.
+template <typename Endpoint, typename Buffer>
+class datagram_slot_adapter
+  : buffer_sequence_adapter_base
+{
+public:
+  typedef boost::asio::datagram_slot<Endpoint, Buffer> slot_type;
+
+  datagram_slot_adapter(slot_type* slots, std::size_t count)
+    : slots_(slots),
+      count_(count < static_cast<std::size_t>(max_mmsg_len)
+          ? count : static_cast<std::size_t>(max_mmsg_len))
+  {
+    for (std::size_t i = 0; i < count_; ++i)
+    {
+      init_native_buffer(buffers_[i], slots_[i].buffer);
+      msgs_[i] = mmsg_type();
+      msgs_[i].msg_hdr.msg_iov = &buffers_[i];
+      msgs_[i].msg_hdr.msg_iovlen = 1;
+      init_message(msgs_[i].msg_hdr, slots_[i], control_[i], slots_[i].buffer);
+    }
+  }
+
+  mmsg_type* messages()
+  {
+    return msgs_;
+  }
+
+  std::size_t count() const
+  {
+    return count_;
+  }
+
+  // Record the results for the first n slots.
+  void complete(std::size_t n)
+  {
+    for (std::size_t i = 0; i < n && i < count_; ++i)
+    {
+      slots_[i].bytes_transferred = msgs_[i].msg_len;
+      complete_message(msgs_[i].msg_hdr, slots_[i], slots_[i].buffer);
+    }
+  }
+
+private:
+  // Space for a single integer-valued control message.
+  union control_type
+  {
+    cmsghdr align;
+    char data[CMSG_SPACE(sizeof(int))];
+  };
+
+  // Prepare a message for receiving, with room for the sender's address and
+  // the coalesced segment size.
+  static void init_message(msghdr& msg, slot_type& slot,
+      control_type& control, const boost::asio::mutable_buffer&)
+  {
+    msg.msg_name = slot.endpoint.data();
+    msg.msg_namelen = static_cast<socklen_t>(slot.endpoint.capacity());
+    msg.msg_control = control.data;
+    msg.msg_controllen = sizeof(control.data);
+  }
+
+  // Prepare a message for sending, requesting segmentation if asked.
+  static void init_message(msghdr& msg, slot_type& slot,
+      control_type& control, const boost::asio::const_buffer&)
+  {
+    msg.msg_name = slot.endpoint.data();
+    msg.msg_namelen = static_cast<socklen_t>(slot.endpoint.size());
+    if (slot.segment_size != 0)
+    {
+      msg.msg_control = control.data;
+      msg.msg_controllen = CMSG_SPACE(sizeof(uint16_t));
+      cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+      cmsg->cmsg_level = udp_option_level;
+      cmsg->cmsg_type = udp_segment_option;
+      cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+      uint16_t segment_size = static_cast<uint16_t>(slot.segment_size);
+      std::memcpy(CMSG_DATA(cmsg), &segment_size, sizeof(segment_size));
+    }
+  }
+
+  static void complete_message(msghdr& msg, slot_type& slot,
+      const boost::asio::mutable_buffer&)
+  {
+    slot.endpoint.resize(msg.msg_namelen);
+    slot.segment_size = 0;
+    for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg;
+        cmsg = CMSG_NXTHDR(&msg, cmsg))
+    {
+      if (cmsg->cmsg_level == udp_option_level
+          && cmsg->cmsg_type == udp_gro_option)
+      {
+        int segment_size = 0;
+        std::memcpy(&segment_size, CMSG_DATA(cmsg), sizeof(segment_size));
+        slot.segment_size = segment_size;
+      }
+    }
+  }
+
+  static void complete_message(msghdr&, slot_type&,
+      const boost::asio::const_buffer&)
+  {
+  }
+
+  slot_type* slots_;
+  std::size_t count_;
+  mmsg_type msgs_[max_mmsg_len];
+  native_buffer_type buffers_[max_mmsg_len];
+  control_type control_[max_mmsg_len];
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // defined(BOOST_ASIO_HAS_MMSG)
+
+#endif // BOOST_ASIO_DETAIL_DATAGRAM_SLOT_ADAPTER_HPP
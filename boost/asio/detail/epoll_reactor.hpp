@@ -62,10 +62,13 @@ public:
     uint32_t registered_events_;
     op_queue<reactor_op> op_queue_[max_ops];
     bool shutdown_;
+    bool batch_io_;
 
     BOOST_ASIO_DECL descriptor_state();
     void set_ready_events(uint32_t events) { task_result_ = events; }
     BOOST_ASIO_DECL operation* perform_io(uint32_t events);
+    BOOST_ASIO_DECL bool perform_batched_io(
+        uint32_t events, op_queue<operation>& ops);
     BOOST_ASIO_DECL static void do_complete(
         io_service_impl* owner, operation* base,
         const boost::system::error_code& ec, std::size_t bytes_transferred);
@@ -74,6 +77,20 @@ public:
   // Per-descriptor data.
   typedef descriptor_state* per_descriptor_data;
 
+  // Counters describing the events returned by epoll_wait.
+  struct statistics
+  {
+    // The number of calls made to epoll_wait.
+    std::size_t wakeups;
+
+    // The total number of events returned by epoll_wait.
+    std::size_t events;
+
+    // The number of calls that returned a full event array, indicating that
+    // more events may have been ready than could be collected.
+    std::size_t full_wakeups;
+  };
+
   // Constructor.
   BOOST_ASIO_DECL epoll_reactor(boost::asio::io_service& io_service);
 
@@ -155,16 +172,31 @@ public:
       typename timer_queue<Time_Traits>::per_timer_data& timer,
       std::size_t max_cancelled = (std::numeric_limits<std::size_t>::max)());
 
+  // Set whether the I/O for a descriptor is performed by the thread that runs
+  // the reactor, so that its completions are delivered in a single batch.
+  BOOST_ASIO_DECL void set_batching(
+      per_descriptor_data& descriptor_data, bool enable);
+
+  // Determine whether the I/O for a descriptor is performed by the thread
+  // that runs the reactor.
+  BOOST_ASIO_DECL bool get_batching(per_descriptor_data& descriptor_data);
+
   // Run epoll once until interrupted or events are ready to be dispatched.
   BOOST_ASIO_DECL void run(bool block, op_queue<operation>& ops);
 
   // Interrupt the select loop.
   BOOST_ASIO_DECL void interrupt();
 
+  // Obtain a snapshot of the counters. May be called from any thread.
+  BOOST_ASIO_DECL statistics get_statistics() const;
+
 private:
   // The hint to pass to epoll_create to size its data structures.
   enum { epoll_size = 20000 };
 
+  // The maximum number of events to collect with each call to epoll_wait.
+  enum { max_events = BOOST_ASIO_EPOLL_MAX_EVENTS };
+
   // Create the epoll file descriptor. Throws an exception if the descriptor
   // cannot be created.
   BOOST_ASIO_DECL static int do_epoll_create();
@@ -225,6 +257,19 @@ private:
   // Keep track of all registered descriptors.
   object_pool<descriptor_state> registered_descriptors_;
 
+  // The number of calls made to epoll_wait.
+  atomic_count wakeups_;
+
+  // The total number of events returned by epoll_wait.
+  atomic_count events_;
+
+  // The number of calls to epoll_wait that filled the event array.
+  atomic_count full_wakeups_;
+
+  // The number of registered descriptors that have batching enabled. The
+  // per-descriptor setting is only checked when this is non-zero.
+  atomic_count batching_descriptors_;
+
   // Helper class to do post-perform_io cleanup.
   struct perform_io_cleanup_on_block_exit;
   friend struct perform_io_cleanup_on_block_exit;
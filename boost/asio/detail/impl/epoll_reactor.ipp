@@ -42,7 +42,11 @@ epoll_reactor::epoll_reactor(boost::asio::io_service& io_service)
     interrupter_(),
     epoll_fd_(do_epoll_create()),
     timer_fd_(do_timerfd_create()),
-    shutdown_(false)
+    shutdown_(false),
+    wakeups_(0),
+    events_(0),
+    full_wakeups_(0),
+    batching_descriptors_(0)
 {
   // Add the interrupter's descriptor to epoll.
   epoll_event ev = { 0, { 0 } };
@@ -156,6 +160,12 @@ int epoll_reactor::register_descriptor(socket_type descriptor,
     descriptor_data->reactor_ = this;
     descriptor_data->descriptor_ = descriptor;
     descriptor_data->shutdown_ = false;
+#if defined(BOOST_ASIO_ENABLE_EPOLL_BATCHING)
+    descriptor_data->batch_io_ = true;
+    ++batching_descriptors_;
+#else // defined(BOOST_ASIO_ENABLE_EPOLL_BATCHING)
+    descriptor_data->batch_io_ = false;
+#endif // defined(BOOST_ASIO_ENABLE_EPOLL_BATCHING)
   }
 
   epoll_event ev = { 0, { 0 } };
@@ -164,7 +174,18 @@ int epoll_reactor::register_descriptor(socket_type descriptor,
   ev.data.ptr = descriptor_data;
   int result = epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, descriptor, &ev);
   if (result != 0)
+  {
+    if (errno == EPERM)
+    {
+      // This descriptor type is not supported by epoll. However, if it is a
+      // regular file then operations on it will not block. We allow the
+      // descriptor to be used, and fail later if an operation on it would
+      // otherwise require a trip through the reactor.
+      descriptor_data->registered_events_ = 0;
+      return 0;
+    }
     return errno;
+  }
 
   return 0;
 }
@@ -181,6 +202,7 @@ int epoll_reactor::register_internal_descriptor(
     descriptor_data->reactor_ = this;
     descriptor_data->descriptor_ = descriptor;
     descriptor_data->shutdown_ = false;
+    descriptor_data->batch_io_ = false;
     descriptor_data->op_queue_[op_type].push(op);
   }
 
@@ -235,6 +257,13 @@ void epoll_reactor::start_op(int op_type, socket_type descriptor,
         return;
       }
 
+      if (descriptor_data->registered_events_ == 0)
+      {
+        op->ec_ = boost::asio::error::operation_not_supported;
+        io_service_.post_immediate_completion(op, is_continuation);
+        return;
+      }
+
       if (op_type == write_op)
       {
         if ((descriptor_data->registered_events_ & EPOLLOUT) == 0)
@@ -256,6 +285,12 @@ void epoll_reactor::start_op(int op_type, socket_type descriptor,
         }
       }
     }
+    else if (descriptor_data->registered_events_ == 0)
+    {
+      op->ec_ = boost::asio::error::operation_not_supported;
+      io_service_.post_immediate_completion(op, is_continuation);
+      return;
+    }
     else
     {
       if (op_type == write_op)
@@ -332,6 +367,11 @@ void epoll_reactor::deregister_descriptor(socket_type descriptor,
 
     descriptor_data->descriptor_ = -1;
     descriptor_data->shutdown_ = true;
+    if (descriptor_data->batch_io_)
+    {
+      descriptor_data->batch_io_ = false;
+      --batching_descriptors_;
+    }
 
     descriptor_lock.unlock();
 
@@ -387,9 +427,28 @@ void epoll_reactor::run(bool block, op_queue<operation>& ops)
     timeout = block ? get_timeout() : 0;
   }
 
-  // Block on the epoll descriptor.
-  epoll_event events[128];
-  int num_events = epoll_wait(epoll_fd_, events, 128, timeout);
+  // Block on the epoll descriptor, recording the time spent waiting if the
+  // io_service is collecting metrics.
+  epoll_event events[max_events];
+  int num_events;
+  metrics_collector& metrics = io_service_.metrics();
+  if (timeout != 0 && metrics.enabled())
+  {
+    uint64_t start = metrics_collector::now();
+    num_events = epoll_wait(epoll_fd_, events, max_events, timeout);
+    uint64_t finish = metrics_collector::now();
+    metrics.thread_idle(finish > start ? finish - start : 0);
+  }
+  else
+    num_events = epoll_wait(epoll_fd_, events, max_events, timeout);
+
+  ++wakeups_;
+  if (num_events > 0)
+  {
+    boost::asio::detail::increment(events_, num_events);
+    if (num_events == max_events)
+      ++full_wakeups_;
+  }
 
 #if defined(BOOST_ASIO_HAS_TIMERFD)
   bool check_timers = (timer_fd_ == -1);
@@ -427,8 +486,12 @@ void epoll_reactor::run(bool block, op_queue<operation>& ops)
       // don't call work_started() here. This still allows the io_service to
       // stop if the only remaining operations are descriptor operations.
       descriptor_state* descriptor_data = static_cast<descriptor_state*>(ptr);
-      descriptor_data->set_ready_events(events[i].events);
-      ops.push(descriptor_data);
+      if (batching_descriptors_ == 0
+          || !descriptor_data->perform_batched_io(events[i].events, ops))
+      {
+        descriptor_data->set_ready_events(events[i].events);
+        ops.push(descriptor_data);
+      }
     }
   }
 
@@ -457,6 +520,37 @@ void epoll_reactor::interrupt()
   epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, interrupter_.read_descriptor(), &ev);
 }
 
+void epoll_reactor::set_batching(
+    epoll_reactor::per_descriptor_data& descriptor_data, bool enable)
+{
+  mutex::scoped_lock descriptor_lock(descriptor_data->mutex_);
+
+  if (!descriptor_data->shutdown_ && descriptor_data->batch_io_ != enable)
+  {
+    descriptor_data->batch_io_ = enable;
+    if (enable)
+      ++batching_descriptors_;
+    else
+      --batching_descriptors_;
+  }
+}
+
+bool epoll_reactor::get_batching(
+    epoll_reactor::per_descriptor_data& descriptor_data)
+{
+  mutex::scoped_lock descriptor_lock(descriptor_data->mutex_);
+  return descriptor_data->batch_io_;
+}
+
+epoll_reactor::statistics epoll_reactor::get_statistics() const
+{
+  statistics s;
+  s.wakeups = static_cast<std::size_t>(static_cast<long>(wakeups_));
+  s.events = static_cast<std::size_t>(static_cast<long>(events_));
+  s.full_wakeups = static_cast<std::size_t>(static_cast<long>(full_wakeups_));
+  return s;
+}
+
 int epoll_reactor::do_epoll_create()
 {
 #if defined(EPOLL_CLOEXEC)
@@ -638,6 +732,38 @@ operation* epoll_reactor::descriptor_state::perform_io(uint32_t events)
   return io_cleanup.first_op_;
 }
 
+bool epoll_reactor::descriptor_state::perform_batched_io(
+    uint32_t events, op_queue<operation>& ops)
+{
+  mutex::scoped_lock descriptor_lock(mutex_);
+  if (!batch_io_)
+    return false;
+
+  // Exception operations must be processed first to ensure that any
+  // out-of-band data is read before normal data.
+  static const int flag[max_ops] = { EPOLLIN, EPOLLOUT, EPOLLPRI };
+  for (int j = max_ops - 1; j >= 0; --j)
+  {
+    if (events & (flag[j] | EPOLLERR | EPOLLHUP))
+    {
+      while (reactor_op* op = op_queue_[j].front())
+      {
+        if (op->perform())
+        {
+          // The operation was counted as work when it was started, so it can
+          // be returned directly to the io_service like an expired timer.
+          op_queue_[j].pop();
+          ops.push(op);
+        }
+        else
+          break;
+      }
+    }
+  }
+
+  return true;
+}
+
 void epoll_reactor::descriptor_state::do_complete(
     io_service_impl* owner, operation* base,
     const boost::system::error_code& ec, std::size_t bytes_transferred)
@@ -0,0 +1,673 @@
+//
+// detail/impl/io_uring_service.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_IMPL_IO_URING_SERVICE_IPP
+#define BOOST_ASIO_DETAIL_IMPL_IO_URING_SERVICE_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+
+#if defined(BOOST_ASIO_HAS_IO_URING)
+
+#include <cerrno>
+#include <cstring>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <boost/asio/detail/io_uring_service.hpp>
+#include <boost/asio/detail/reactor_op.hpp>
+#include <boost/asio/error.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+// The user_data value used for the cancellation entries submitted at shutdown
+// and when probing the kernel. Other entries that are not associated with an
+// operation use zero.
+enum { io_uring_shutdown_cancel = 1 };
+
+class io_uring_service::flush_op : public operation
+{
+public:
+  flush_op(io_uring_service* service)
+    : operation(&flush_op::do_complete),
+      service_(service)
+  {
+  }
+
+  static void do_complete(io_service_impl* owner, operation* base,
+      const boost::system::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    // The operation is owned by the service, so is never deleted here.
+    if (owner)
+      static_cast<flush_op*>(base)->service_->flush();
+  }
+
+private:
+  io_uring_service* service_;
+};
+
+class io_uring_service::reap_op : public reactor_op
+{
+public:
+  reap_op(io_uring_service* service)
+    : reactor_op(&reap_op::do_perform, reap_op::do_complete),
+      service_(service)
+  {
+  }
+
+  static bool do_perform(reactor_op* base)
+  {
+    io_uring_service* service = static_cast<reap_op*>(base)->service_;
+
+    op_queue<operation> ops;
+    mutex::scoped_lock lock(service->mutex_);
+    service->reap(ops);
+    lock.unlock();
+
+    service->io_service_.post_deferred_completions(ops);
+    return false;
+  }
+
+  static void do_complete(io_service_impl* /*owner*/, operation* base,
+      const boost::system::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    reap_op* o(static_cast<reap_op*>(base));
+    delete o;
+  }
+
+private:
+  io_uring_service* service_;
+};
+
+io_uring_service::io_uring_service(boost::asio::io_service& io_service)
+  : boost::asio::detail::service_base<io_uring_service>(io_service),
+    io_service_(use_service<io_service_impl>(io_service)),
+    reactor_(use_service<reactor>(io_service)),
+    mutex_(),
+    ring_fd_(-1),
+    sq_ring_(0),
+    sq_ring_size_(0),
+    cq_ring_(0),
+    cq_ring_size_(0),
+    sqes_(0),
+    sqes_size_(0),
+    sq_head_(0),
+    sq_tail_(0),
+    sq_flags_(0),
+    sq_array_(0),
+    sq_mask_(0),
+    sq_entries_(0),
+    cq_head_(0),
+    cq_tail_(0),
+    cqes_(0),
+    cq_mask_(0),
+    pending_(0),
+    outstanding_(0),
+    flush_scheduled_(false),
+    flush_op_(new flush_op(this)),
+    shutdown_(false)
+{
+  reactor_.init_task();
+
+  open_ring();
+  if (ring_fd_ != -1)
+  {
+    if (reactor_.register_internal_descriptor(reactor::read_op,
+          ring_fd_, reactor_data_, new reap_op(this)) != 0)
+      close_ring();
+  }
+}
+
+io_uring_service::~io_uring_service()
+{
+  close_ring();
+  delete flush_op_;
+}
+
+void io_uring_service::shutdown_service()
+{
+  op_queue<operation> ops;
+
+  mutex::scoped_lock lock(mutex_);
+  shutdown_ = true;
+
+  if (ring_fd_ == -1)
+    return;
+
+  // Cancel everything in flight and wait for the kernel to release the
+  // operations, since they may refer to memory owned by the handlers.
+  if (pending_ > 0 || outstanding_ > 0)
+  {
+    if (::io_uring_sqe* sqe = get_sqe())
+    {
+      sqe->opcode = IORING_OP_ASYNC_CANCEL;
+      sqe->fd = -1;
+      sqe->cancel_flags = IORING_ASYNC_CANCEL_ANY | IORING_ASYNC_CANCEL_ALL;
+      sqe->user_data = io_uring_shutdown_cancel;
+      __atomic_store_n(sq_tail_, *sq_tail_ + 1, __ATOMIC_RELEASE);
+      ++pending_;
+    }
+
+    bool cancel_failed = false;
+    while ((pending_ > 0 || outstanding_ > 0) && !cancel_failed)
+    {
+      if (submit(1) != 0)
+        break;
+      int result = 0;
+      reap(ops, &result);
+      cancel_failed = (result < 0 && result != -ENOENT);
+    }
+  }
+
+  lock.unlock();
+
+  reactor_.deregister_internal_descriptor(ring_fd_, reactor_data_);
+}
+
+void io_uring_service::start_op(io_uring_operation* op, bool is_continuation)
+{
+  mutex::scoped_lock lock(mutex_);
+
+  if (shutdown_)
+  {
+    lock.unlock();
+    io_service_.post_immediate_completion(op, is_continuation);
+    return;
+  }
+
+  ::io_uring_sqe* sqe = get_sqe();
+  if (!sqe)
+  {
+    lock.unlock();
+    op->ec_ = boost::asio::error::no_buffer_space;
+    io_service_.post_immediate_completion(op, is_continuation);
+    return;
+  }
+
+  op->prepare(sqe);
+  apply_registrations(sqe);
+  sqe->user_data = reinterpret_cast<__u64>(op);
+  __atomic_store_n(sq_tail_, *sq_tail_ + 1, __ATOMIC_RELEASE);
+  ++pending_;
+
+  io_service_.work_started();
+
+  // Operations started from outside the io_service are submitted at once.
+  // Those started from within a handler are left for the flush operation,
+  // so that all of the operations started by a batch of handlers are passed
+  // to the kernel in a single system call.
+  if (!io_service_.can_dispatch())
+  {
+    if (submit(0) == 0)
+      return;
+  }
+
+  bool schedule_flush = !flush_scheduled_;
+  flush_scheduled_ = true;
+  lock.unlock();
+
+  if (schedule_flush)
+    io_service_.post_immediate_completion(flush_op_, is_continuation);
+}
+
+void io_uring_service::cancel_ops(int descriptor)
+{
+  mutex::scoped_lock lock(mutex_);
+
+  if (shutdown_ || ring_fd_ == -1)
+    return;
+
+  if (::io_uring_sqe* sqe = get_sqe())
+  {
+    sqe->opcode = IORING_OP_ASYNC_CANCEL;
+    sqe->fd = descriptor;
+    // Operations that use a registered descriptor refer to the same file,
+    // so are matched without IORING_ASYNC_CANCEL_FD_FIXED (Linux 6.0).
+    sqe->cancel_flags = IORING_ASYNC_CANCEL_FD | IORING_ASYNC_CANCEL_ALL;
+    sqe->user_data = 0;
+    __atomic_store_n(sq_tail_, *sq_tail_ + 1, __ATOMIC_RELEASE);
+    ++pending_;
+  }
+
+  // Submit immediately, so that the operations have been cancelled before
+  // the caller goes on to close the descriptor.
+  submit(0);
+}
+
+boost::system::error_code io_uring_service::register_buffers(
+    const boost::asio::mutable_buffer* buffers, std::size_t count,
+    boost::system::error_code& ec)
+{
+  mutex::scoped_lock lock(mutex_);
+
+  if (ring_fd_ == -1)
+  {
+    ec = boost::asio::error::operation_not_supported;
+    return ec;
+  }
+
+  std::vector< ::iovec> iovecs(count);
+  std::vector<registered_buffer> registered(count);
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    registered[i].data = boost::asio::buffer_cast<char*>(buffers[i]);
+    registered[i].size = boost::asio::buffer_size(buffers[i]);
+    iovecs[i].iov_base = registered[i].data;
+    iovecs[i].iov_len = registered[i].size;
+  }
+
+  if (::syscall(__NR_io_uring_register, ring_fd_, IORING_REGISTER_BUFFERS,
+        count ? &iovecs[0] : 0, static_cast<unsigned>(count)) != 0)
+  {
+    ec = boost::system::error_code(errno,
+        boost::asio::error::get_system_category());
+    return ec;
+  }
+
+  buffers_.swap(registered);
+  ec = boost::system::error_code();
+  return ec;
+}
+
+boost::system::error_code io_uring_service::unregister_buffers(
+    boost::system::error_code& ec)
+{
+  mutex::scoped_lock lock(mutex_);
+
+  if (ring_fd_ == -1)
+  {
+    ec = boost::asio::error::operation_not_supported;
+    return ec;
+  }
+
+  if (::syscall(__NR_io_uring_register, ring_fd_,
+        IORING_UNREGISTER_BUFFERS, 0, 0) != 0)
+  {
+    ec = boost::system::error_code(errno,
+        boost::asio::error::get_system_category());
+    return ec;
+  }
+
+  buffers_.clear();
+  ec = boost::system::error_code();
+  return ec;
+}
+
+boost::system::error_code io_uring_service::register_files(
+    const int* descriptors, std::size_t count, boost::system::error_code& ec)
+{
+  mutex::scoped_lock lock(mutex_);
+
+  if (ring_fd_ == -1)
+  {
+    ec = boost::asio::error::operation_not_supported;
+    return ec;
+  }
+
+  if (::syscall(__NR_io_uring_register, ring_fd_, IORING_REGISTER_FILES,
+        descriptors, static_cast<unsigned>(count)) != 0)
+  {
+    ec = boost::system::error_code(errno,
+        boost::asio::error::get_system_category());
+    return ec;
+  }
+
+  file_indexes_.clear();
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    if (descriptors[i] < 0)
+      continue;
+    std::size_t descriptor = static_cast<std::size_t>(descriptors[i]);
+    if (descriptor >= file_indexes_.size())
+      file_indexes_.resize(descriptor + 1, -1);
+    file_indexes_[descriptor] = static_cast<int>(i);
+  }
+
+  ec = boost::system::error_code();
+  return ec;
+}
+
+boost::system::error_code io_uring_service::unregister_files(
+    boost::system::error_code& ec)
+{
+  mutex::scoped_lock lock(mutex_);
+
+  if (ring_fd_ == -1)
+  {
+    ec = boost::asio::error::operation_not_supported;
+    return ec;
+  }
+
+  // Entries that refer to registered descriptors by index must reach the
+  // kernel before the registrations are removed.
+  submit(0);
+
+  if (::syscall(__NR_io_uring_register, ring_fd_,
+        IORING_UNREGISTER_FILES, 0, 0) != 0)
+  {
+    ec = boost::system::error_code(errno,
+        boost::asio::error::get_system_category());
+    return ec;
+  }
+
+  file_indexes_.clear();
+  ec = boost::system::error_code();
+  return ec;
+}
+
+void io_uring_service::open_ring()
+{
+  ::io_uring_params params;
+  std::memset(&params, 0, sizeof(params));
+  params.flags = IORING_SETUP_CQSIZE;
+  params.cq_entries = BOOST_ASIO_IO_URING_ENTRIES * 4;
+
+  int fd = static_cast<int>(::syscall(__NR_io_uring_setup,
+        BOOST_ASIO_IO_URING_ENTRIES, &params));
+  if (fd < 0)
+    return;
+
+  // Completions must never be dropped, and sockets must be polled internally
+  // by the kernel rather than by a worker thread per operation.
+  const unsigned required_features = IORING_FEAT_NODROP | IORING_FEAT_FAST_POLL;
+  if ((params.features & required_features) != required_features)
+  {
+    ::close(fd);
+    return;
+  }
+
+  ring_fd_ = fd;
+  sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+  cq_ring_size_ = params.cq_off.cqes
+    + params.cq_entries * sizeof(::io_uring_cqe);
+  if (params.features & IORING_FEAT_SINGLE_MMAP)
+  {
+    if (cq_ring_size_ > sq_ring_size_)
+      sq_ring_size_ = cq_ring_size_;
+    cq_ring_size_ = 0;
+  }
+
+  sq_ring_ = ::mmap(0, sq_ring_size_, PROT_READ | PROT_WRITE,
+      MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+  if (sq_ring_ == MAP_FAILED)
+  {
+    sq_ring_ = 0;
+    close_ring();
+    return;
+  }
+
+  if (cq_ring_size_ == 0)
+    cq_ring_ = sq_ring_;
+  else
+  {
+    cq_ring_ = ::mmap(0, cq_ring_size_, PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+    if (cq_ring_ == MAP_FAILED)
+    {
+      cq_ring_ = 0;
+      close_ring();
+      return;
+    }
+  }
+
+  sqes_size_ = params.sq_entries * sizeof(::io_uring_sqe);
+  void* sqes = ::mmap(0, sqes_size_, PROT_READ | PROT_WRITE,
+      MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+  if (sqes == MAP_FAILED)
+  {
+    close_ring();
+    return;
+  }
+  sqes_ = static_cast< ::io_uring_sqe*>(sqes);
+
+  char* sq = static_cast<char*>(sq_ring_);
+  sq_head_ = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+  sq_tail_ = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+  sq_flags_ = reinterpret_cast<unsigned*>(sq + params.sq_off.flags);
+  sq_array_ = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+  sq_mask_ = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+  sq_entries_ = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_entries);
+
+  char* cq = static_cast<char*>(cq_ring_);
+  cq_head_ = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+  cq_tail_ = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+  cqes_ = reinterpret_cast< ::io_uring_cqe*>(cq + params.cq_off.cqes);
+  cq_mask_ = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+
+  // The features above are present from Linux 5.7, but cancelling the
+  // operations for a descriptor, and all operations at shutdown, requires
+  // the cancellation flags added in Linux 5.19. Older kernels reject the
+  // flags, in which case the reactor is used instead.
+  if (!probe_cancel(ring_fd_,
+        IORING_ASYNC_CANCEL_FD | IORING_ASYNC_CANCEL_ALL)
+      || !probe_cancel(-1, IORING_ASYNC_CANCEL_ANY | IORING_ASYNC_CANCEL_ALL))
+    close_ring();
+}
+
+bool io_uring_service::probe_cancel(int descriptor, unsigned cancel_flags)
+{
+  ::io_uring_sqe* sqe = get_sqe();
+  if (!sqe)
+    return false;
+
+  sqe->opcode = IORING_OP_ASYNC_CANCEL;
+  sqe->fd = descriptor;
+  sqe->cancel_flags = cancel_flags;
+  sqe->user_data = io_uring_shutdown_cancel;
+  __atomic_store_n(sq_tail_, *sq_tail_ + 1, __ATOMIC_RELEASE);
+  ++pending_;
+
+  int result = -EINVAL;
+  op_queue<operation> ops;
+  while (pending_ > 0 || outstanding_ > 0)
+  {
+    if (submit(1) != 0)
+      return false;
+    reap(ops, &result);
+  }
+
+  // A cancellation of all matching operations reports the number cancelled.
+  return result >= 0 || result == -ENOENT;
+}
+
+void io_uring_service::close_ring()
+{
+  if (sqes_)
+    ::munmap(sqes_, sqes_size_);
+  if (cq_ring_ && cq_ring_ != sq_ring_)
+    ::munmap(cq_ring_, cq_ring_size_);
+  if (sq_ring_)
+    ::munmap(sq_ring_, sq_ring_size_);
+  if (ring_fd_ != -1)
+    ::close(ring_fd_);
+
+  sqes_ = 0;
+  cq_ring_ = 0;
+  sq_ring_ = 0;
+  ring_fd_ = -1;
+}
+
+::io_uring_sqe* io_uring_service::get_sqe()
+{
+  unsigned tail = *sq_tail_;
+  if (tail - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE) >= sq_entries_)
+  {
+    // The submission queue is full, so hand the pending entries to the
+    // kernel now rather than waiting for the flush operation.
+    submit(0);
+    if (tail - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE) >= sq_entries_)
+      return 0;
+  }
+
+  unsigned index = tail & sq_mask_;
+  sq_array_[index] = index;
+  ::io_uring_sqe* sqe = &sqes_[index];
+  std::memset(sqe, 0, sizeof(*sqe));
+  return sqe;
+}
+
+void io_uring_service::apply_registrations(::io_uring_sqe* sqe)
+{
+  if (sqe->fd >= 0
+      && static_cast<std::size_t>(sqe->fd) < file_indexes_.size()
+      && file_indexes_[sqe->fd] >= 0)
+  {
+    sqe->fd = file_indexes_[sqe->fd];
+    sqe->flags |= IOSQE_FIXED_FILE;
+  }
+
+  if (!buffers_.empty()
+      && (sqe->opcode == IORING_OP_READ || sqe->opcode == IORING_OP_WRITE))
+  {
+    char* data = reinterpret_cast<char*>(sqe->addr);
+    for (std::size_t i = 0; i < buffers_.size(); ++i)
+    {
+      if (data >= buffers_[i].data
+          && data + sqe->len <= buffers_[i].data + buffers_[i].size)
+      {
+        sqe->opcode = (sqe->opcode == IORING_OP_READ)
+          ? IORING_OP_READ_FIXED : IORING_OP_WRITE_FIXED;
+        sqe->buf_index = static_cast<__u16>(i);
+        break;
+      }
+    }
+  }
+}
+
+int io_uring_service::submit(unsigned min_complete)
+{
+  unsigned flags = min_complete > 0 ? IORING_ENTER_GETEVENTS : 0;
+  if (__atomic_load_n(sq_flags_, __ATOMIC_RELAXED) & IORING_SQ_CQ_OVERFLOW)
+    flags |= IORING_ENTER_GETEVENTS;
+
+  if (pending_ == 0 && flags == 0)
+    return 0;
+
+  for (;;)
+  {
+    int result = static_cast<int>(::syscall(__NR_io_uring_enter,
+          ring_fd_, pending_, min_complete, flags, 0, 0));
+    if (result >= 0)
+    {
+      pending_ -= static_cast<unsigned>(result);
+      outstanding_ += static_cast<std::size_t>(result);
+      return 0;
+    }
+    if (errno != EINTR)
+      return errno;
+  }
+}
+
+void io_uring_service::flush()
+{
+  op_queue<operation> ops;
+
+  mutex::scoped_lock lock(mutex_);
+  flush_scheduled_ = false;
+
+  int error = submit(0);
+  if (error == EAGAIN || error == EBUSY)
+  {
+    // The kernel is short of resources or the completion queue is full. Try
+    // again once the io_service has had a chance to reap some completions.
+    if (pending_ > 0)
+    {
+      flush_scheduled_ = true;
+      lock.unlock();
+      io_service_.post_immediate_completion(flush_op_, true);
+    }
+    return;
+  }
+  else if (error != 0)
+  {
+    // Withdraw the pending entries and fail their operations.
+    unsigned tail = *sq_tail_;
+    for (unsigned i = tail - pending_; i != tail; ++i)
+    {
+      ::io_uring_sqe* sqe = &sqes_[sq_array_[i & sq_mask_]];
+      if (sqe->user_data > io_uring_shutdown_cancel)
+      {
+        io_uring_operation* op =
+          reinterpret_cast<io_uring_operation*>(sqe->user_data);
+        op->ec_ = boost::system::error_code(error,
+            boost::asio::error::get_system_category());
+        ops.push(op);
+      }
+    }
+    __atomic_store_n(sq_tail_, tail - pending_, __ATOMIC_RELEASE);
+    pending_ = 0;
+  }
+
+  lock.unlock();
+
+  io_service_.post_deferred_completions(ops);
+}
+
+void io_uring_service::reap(op_queue<operation>& ops, int* cancel_result)
+{
+  for (;;)
+  {
+    unsigned head = *cq_head_;
+    unsigned tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+    for (; head != tail; ++head)
+    {
+      ::io_uring_cqe* cqe = &cqes_[head & cq_mask_];
+      --outstanding_;
+
+      if (cqe->user_data == io_uring_shutdown_cancel)
+      {
+        if (cancel_result)
+          *cancel_result = cqe->res;
+      }
+      else if (cqe->user_data != 0)
+      {
+        io_uring_operation* op =
+          reinterpret_cast<io_uring_operation*>(cqe->user_data);
+        if (cqe->res == -ECANCELED)
+          op->ec_ = boost::asio::error::operation_aborted;
+        else if (cqe->res < 0)
+          op->ec_ = boost::system::error_code(-cqe->res,
+              boost::asio::error::get_system_category());
+        else
+          op->bytes_transferred_ = static_cast<std::size_t>(cqe->res);
+        ops.push(op);
+      }
+    }
+    __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+
+    // Completions that did not fit in the queue are held by the kernel until
+    // it is asked for more events.
+    if ((__atomic_load_n(sq_flags_, __ATOMIC_RELAXED)
+          & IORING_SQ_CQ_OVERFLOW) == 0)
+      break;
+    if (submit(0) != 0)
+      break;
+  }
+}
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // defined(BOOST_ASIO_HAS_IO_URING)
+
+#endif // BOOST_ASIO_DETAIL_IMPL_IO_URING_SERVICE_IPP
@@ -0,0 +1,167 @@
+//
+// detail/impl/lock_free_strand_service.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_IMPL_LOCK_FREE_STRAND_SERVICE_HPP
+#define BOOST_ASIO_DETAIL_IMPL_LOCK_FREE_STRAND_SERVICE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/addressof.hpp>
+#include <boost/asio/detail/call_stack.hpp>
+#include <boost/asio/detail/fenced_block.hpp>
+#include <boost/asio/detail/handler_alloc_helpers.hpp>
+#include <boost/asio/detail/handler_cont_helpers.hpp>
+#include <boost/asio/detail/handler_invoke_helpers.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+inline lock_free_strand_service::strand_impl::strand_impl(
+    lock_free_strand_service* service)
+  : operation(&lock_free_strand_service::do_complete),
+    service_(service),
+    tail_(reinterpret_cast<std::size_t>(&stub_) | 1),
+    head_(&stub_),
+    ref_count_(1),
+    next_(0),
+    prev_(0)
+{
+}
+
+template <typename Handler>
+class lock_free_strand_service::handler_op
+  : public lock_free_strand_service::strand_op
+{
+public:
+  BOOST_ASIO_DEFINE_HANDLER_PTR(handler_op);
+
+  handler_op(Handler& h)
+    : strand_op(&handler_op::do_complete),
+      handler_(BOOST_ASIO_MOVE_CAST(Handler)(h))
+  {
+  }
+
+  static void do_complete(io_service_impl* owner, operation* base,
+      const boost::system::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    // Take ownership of the handler object.
+    handler_op* h(static_cast<handler_op*>(base));
+    ptr p = { boost::asio::detail::addressof(h->handler_), h, h };
+
+    BOOST_ASIO_HANDLER_COMPLETION((h));
+
+    // Make a copy of the handler so that the memory can be deallocated before
+    // the upcall is made. Even if we're not about to make an upcall, a
+    // sub-object of the handler may be the true owner of the memory associated
+    // with the handler. Consequently, a local copy of the handler is required
+    // to ensure that any owning sub-object remains valid until after we have
+    // deallocated the memory here.
+    Handler handler(BOOST_ASIO_MOVE_CAST(Handler)(h->handler_));
+    p.h = boost::asio::detail::addressof(handler);
+    p.reset();
+
+    // Make the upcall if required.
+    if (owner)
+    {
+      fenced_block b(fenced_block::half);
+      BOOST_ASIO_HANDLER_INVOCATION_BEGIN(());
+      boost_asio_handler_invoke_helpers::invoke(handler, handler);
+      BOOST_ASIO_HANDLER_INVOCATION_END;
+    }
+  }
+
+private:
+  Handler handler_;
+};
+
+struct lock_free_strand_service::on_strand_exit
+{
+  io_service_impl* owner_;
+  strand_impl* impl_;
+  bool is_continuation_;
+
+  ~on_strand_exit()
+  {
+    lock_free_strand_service::release(*owner_, impl_, is_continuation_);
+  }
+};
+
+template <typename Handler>
+void lock_free_strand_service::dispatch(
+    lock_free_strand_service::implementation_type& impl, Handler& handler)
+{
+  // If we are already in the strand then the handler can run immediately.
+  if (call_stack<strand_impl>::contains(impl))
+  {
+    fenced_block b(fenced_block::full);
+    boost_asio_handler_invoke_helpers::invoke(handler, handler);
+    return;
+  }
+
+  // Allocate and construct an operation to wrap the handler.
+  typedef handler_op<Handler> op;
+  typename op::ptr p = { boost::asio::detail::addressof(handler),
+    boost_asio_handler_alloc_helpers::allocate(
+      sizeof(op), handler), 0 };
+  p.p = new (p.v) op(handler);
+
+  BOOST_ASIO_HANDLER_CREATION((p.p, "strand", impl, "dispatch"));
+
+  bool dispatch_immediately = do_dispatch(impl, p.p);
+  operation* o = p.p;
+  p.v = p.p = 0;
+
+  if (dispatch_immediately)
+  {
+    // Indicate that this strand is executing on the current thread.
+    call_stack<strand_impl>::context ctx(impl);
+
+    // Ensure the next handler, if any, is scheduled on block exit.
+    on_strand_exit on_exit = { &io_service_, impl, false };
+    (void)on_exit;
+
+    op::do_complete(&io_service_, o, boost::system::error_code(), 0);
+  }
+}
+
+// Request the io_service to invoke the given handler and return immediately.
+template <typename Handler>
+void lock_free_strand_service::post(
+    lock_free_strand_service::implementation_type& impl, Handler& handler)
+{
+  bool is_continuation =
+    boost_asio_handler_cont_helpers::is_continuation(handler);
+
+  // Allocate and construct an operation to wrap the handler.
+  typedef handler_op<Handler> op;
+  typename op::ptr p = { boost::asio::detail::addressof(handler),
+    boost_asio_handler_alloc_helpers::allocate(
+      sizeof(op), handler), 0 };
+  p.p = new (p.v) op(handler);
+
+  BOOST_ASIO_HANDLER_CREATION((p.p, "strand", impl, "post"));
+
+  do_post(impl, p.p, is_continuation);
+  p.v = p.p = 0;
+}
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_DETAIL_IMPL_LOCK_FREE_STRAND_SERVICE_HPP
@@ -0,0 +1,276 @@
+//
+// detail/impl/lock_free_strand_service.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_IMPL_LOCK_FREE_STRAND_SERVICE_IPP
+#define BOOST_ASIO_DETAIL_IMPL_LOCK_FREE_STRAND_SERVICE_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+
+#if defined(BOOST_ASIO_HAS_LOCK_FREE_STRAND)
+
+#include <boost/asio/detail/call_stack.hpp>
+#include <boost/asio/detail/lock_free_strand_service.hpp>
+#include <boost/asio/detail/op_queue.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+lock_free_strand_service::lock_free_strand_service(
+    boost::asio::io_service& io_service)
+  : boost::asio::detail::service_base<lock_free_strand_service>(io_service),
+    io_service_(boost::asio::use_service<io_service_impl>(io_service)),
+    mutex_(),
+    impl_list_(0)
+{
+}
+
+lock_free_strand_service::~lock_free_strand_service()
+{
+  while (impl_list_)
+  {
+    strand_impl* impl = impl_list_;
+    impl_list_ = impl->next_;
+
+    // Strand objects may outlive the service, so detach the implementation
+    // and leave it to be freed by the last strand that refers to it.
+    impl->service_ = 0;
+    impl->next_ = 0;
+    impl->prev_ = 0;
+
+    // Implementations that were still scheduled when the io_service was shut
+    // down never become idle, and so never release the scheduled reference.
+    if ((impl->tail_.load(std::memory_order_acquire) & 1) == 0)
+      release_ref(impl);
+  }
+}
+
+void lock_free_strand_service::shutdown_service()
+{
+  op_queue<operation> ops;
+
+  boost::asio::detail::mutex::scoped_lock lock(mutex_);
+
+  // No other thread may access the strands once the io_service has been
+  // shut down, so each non-idle strand's queue can be drained in place.
+  for (strand_impl* impl = impl_list_; impl; impl = impl->next_)
+  {
+    if ((impl->tail_.load(std::memory_order_acquire) & 1) == 0)
+      while (strand_op* op = dequeue(impl))
+        ops.push(op);
+  }
+}
+
+void lock_free_strand_service::construct(
+    lock_free_strand_service::implementation_type& impl)
+{
+  impl = new strand_impl(this);
+
+  boost::asio::detail::mutex::scoped_lock lock(mutex_);
+  impl->next_ = impl_list_;
+  impl->prev_ = 0;
+  if (impl_list_)
+    impl_list_->prev_ = impl;
+  impl_list_ = impl;
+}
+
+void lock_free_strand_service::copy_construct(
+    lock_free_strand_service::implementation_type& impl,
+    const lock_free_strand_service::implementation_type& other_impl)
+{
+  impl = other_impl;
+  ++impl->ref_count_;
+}
+
+void lock_free_strand_service::destroy(
+    lock_free_strand_service::implementation_type& impl)
+{
+  release_ref(impl);
+  impl = 0;
+}
+
+bool lock_free_strand_service::running_in_this_thread(
+    const implementation_type& impl) const
+{
+  return call_stack<strand_impl>::contains(impl) != 0;
+}
+
+bool lock_free_strand_service::do_dispatch(
+    implementation_type& impl, strand_op* op)
+{
+  // If we are running inside the io_service, and the strand is idle, then the
+  // handler can acquire the strand and run immediately.
+  if (io_service_.can_dispatch())
+  {
+    std::size_t idle = reinterpret_cast<std::size_t>(&impl->stub_) | 1;
+    std::size_t locked = reinterpret_cast<std::size_t>(&impl->stub_);
+    if (impl->tail_.compare_exchange_strong(idle, locked,
+          std::memory_order_acquire, std::memory_order_relaxed))
+    {
+      ++impl->ref_count_;
+      return true;
+    }
+  }
+
+  do_post(impl, op, false);
+  return false;
+}
+
+void lock_free_strand_service::do_post(implementation_type& impl,
+    strand_op* op, bool is_continuation)
+{
+  op->strand_next_.store(0, std::memory_order_relaxed);
+  std::size_t prev = impl->tail_.exchange(
+      reinterpret_cast<std::size_t>(op), std::memory_order_acq_rel);
+  reinterpret_cast<strand_op*>(prev & ~static_cast<std::size_t>(1))
+    ->strand_next_.store(op, std::memory_order_release);
+
+  if (prev & 1)
+  {
+    // The handler found the strand idle and so is responsible for scheduling
+    // it. The scheduled strand holds a reference to the implementation.
+    ++impl->ref_count_;
+    io_service_.post_immediate_completion(impl, is_continuation);
+  }
+}
+
+void lock_free_strand_service::do_complete(io_service_impl* owner,
+    operation* base, const boost::system::error_code& ec,
+    std::size_t /*bytes_transferred*/)
+{
+  if (owner)
+  {
+    strand_impl* impl = static_cast<strand_impl*>(base);
+
+    // Indicate that this strand is executing on the current thread.
+    call_stack<strand_impl>::context ctx(impl);
+
+    // Ensure the strand is released or rescheduled on block exit.
+    on_strand_exit on_exit = { owner, impl, true };
+    (void)on_exit;
+
+    // Run the handlers that were waiting when the strand was scheduled.
+    // Handlers added after this point are left for the next time the strand
+    // is scheduled, so that a busy strand cannot starve other work.
+    strand_op* last = reinterpret_cast<strand_op*>(
+        impl->tail_.load(std::memory_order_acquire));
+    while (last != impl->head_ || last != &impl->stub_)
+    {
+      strand_op* o = dequeue(impl);
+      if (!o)
+        break;
+      bool more = (o != last);
+      o->complete(*owner, ec, 0);
+      if (!more)
+        break;
+    }
+  }
+}
+
+lock_free_strand_service::strand_op* lock_free_strand_service::dequeue(
+    strand_impl* impl)
+{
+  strand_op* head = impl->head_;
+  strand_op* next = head->strand_next_.load(std::memory_order_acquire);
+
+  // Skip over the placeholder.
+  if (head == &impl->stub_)
+  {
+    if (!next)
+      return 0;
+    impl->head_ = next;
+    head = next;
+    next = next->strand_next_.load(std::memory_order_acquire);
+  }
+
+  if (next)
+  {
+    impl->head_ = next;
+    return head;
+  }
+
+  // A producer has swapped in a new tail but not yet linked it.
+  if (impl->tail_.load(std::memory_order_acquire)
+      != reinterpret_cast<std::size_t>(head))
+    return 0;
+
+  // The head is the only operation in the queue. Enqueue the placeholder
+  // behind it so that it can be removed without racing with producers.
+  impl->stub_.strand_next_.store(0, std::memory_order_relaxed);
+  std::size_t prev = impl->tail_.exchange(
+      reinterpret_cast<std::size_t>(&impl->stub_), std::memory_order_acq_rel);
+  reinterpret_cast<strand_op*>(prev)->strand_next_.store(
+      &impl->stub_, std::memory_order_release);
+
+  next = head->strand_next_.load(std::memory_order_acquire);
+  if (next)
+  {
+    impl->head_ = next;
+    return head;
+  }
+
+  return 0;
+}
+
+void lock_free_strand_service::release(io_service_impl& owner,
+    strand_impl* impl, bool is_continuation)
+{
+  if (impl->head_ == &impl->stub_
+      && impl->stub_.strand_next_.load(std::memory_order_acquire) == 0)
+  {
+    // The queue appears to be empty, so try to make the strand idle. This
+    // fails if a producer has enqueued a new handler in the meantime.
+    std::size_t locked = reinterpret_cast<std::size_t>(&impl->stub_);
+    if (impl->tail_.compare_exchange_strong(locked, locked | 1,
+          std::memory_order_release, std::memory_order_relaxed))
+    {
+      release_ref(impl);
+      return;
+    }
+  }
+
+  owner.post_immediate_completion(impl, is_continuation);
+}
+
+void lock_free_strand_service::release_ref(strand_impl* impl)
+{
+  if (--impl->ref_count_ == 0)
+  {
+    // The service is gone if the implementation was detached by the service's
+    // destructor.
+    if (lock_free_strand_service* service = impl->service_)
+    {
+      boost::asio::detail::mutex::scoped_lock lock(service->mutex_);
+      if (service->impl_list_ == impl)
+        service->impl_list_ = impl->next_;
+      if (impl->prev_)
+        impl->prev_->next_ = impl->next_;
+      if (impl->next_)
+        impl->next_->prev_ = impl->prev_;
+    }
+    delete impl;
+  }
+}
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // defined(BOOST_ASIO_HAS_LOCK_FREE_STRAND)
+
+#endif // BOOST_ASIO_DETAIL_IMPL_LOCK_FREE_STRAND_SERVICE_IPP
@@ -135,6 +135,89 @@ boost::system::error_code reactive_socket_service_base::cancel(
   return ec;
 }
 
+#if defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+bool reactive_socket_service_base::enable_zero_copy(
+    reactive_socket_service_base::base_implementation_type& impl)
+{
+  if (impl.state_ & socket_ops::zero_copy_enabled)
+    return true;
+
+  int optval = 1;
+  boost::system::error_code ec;
+  if (socket_ops::setsockopt(impl.socket_, impl.state_, SOL_SOCKET,
+        zero_copy_option, &optval, sizeof(optval), ec) != 0)
+    return false;
+
+  impl.state_ |= socket_ops::zero_copy_enabled;
+  return true;
+}
+#endif // defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+
+bool reactive_socket_service_base::set_reactor_option(
+    reactive_socket_service_base::base_implementation_type& impl,
+    int level, int optname, const void* optval, std::size_t optlen,
+    boost::system::error_code& ec)
+{
+#if defined(BOOST_ASIO_HAS_EPOLL)
+  if (level == custom_socket_option_level
+      && optname == reactor_batching_option)
+  {
+    if (!is_open(impl))
+      ec = boost::asio::error::bad_descriptor;
+    else if (optlen != sizeof(int))
+      ec = boost::asio::error::invalid_argument;
+    else
+    {
+      reactor_.set_batching(impl.reactor_data_,
+          *static_cast<const int*>(optval) != 0);
+      ec = boost::system::error_code();
+    }
+    return true;
+  }
+#else // defined(BOOST_ASIO_HAS_EPOLL)
+  (void)impl;
+  (void)level;
+  (void)optname;
+  (void)optval;
+  (void)optlen;
+  (void)ec;
+#endif // defined(BOOST_ASIO_HAS_EPOLL)
+  return false;
+}
+
+bool reactive_socket_service_base::get_reactor_option(
+    const reactive_socket_service_base::base_implementation_type& impl,
+    int level, int optname, void* optval, std::size_t* optlen,
+    boost::system::error_code& ec) const
+{
+#if defined(BOOST_ASIO_HAS_EPOLL)
+  if (level == custom_socket_option_level
+      && optname == reactor_batching_option)
+  {
+    if (!is_open(impl))
+      ec = boost::asio::error::bad_descriptor;
+    else if (*optlen != sizeof(int))
+      ec = boost::asio::error::invalid_argument;
+    else
+    {
+      reactor::per_descriptor_data descriptor_data = impl.reactor_data_;
+      *static_cast<int*>(optval) =
+        reactor_.get_batching(descriptor_data) ? 1 : 0;
+      ec = boost::system::error_code();
+    }
+    return true;
+  }
+#else // defined(BOOST_ASIO_HAS_EPOLL)
+  (void)impl;
+  (void)level;
+  (void)optname;
+  (void)optval;
+  (void)optlen;
+  (void)ec;
+#endif // defined(BOOST_ASIO_HAS_EPOLL)
+  return false;
+}
+
 boost::system::error_code reactive_socket_service_base::do_open(
     reactive_socket_service_base::base_implementation_type& impl,
     int af, int type, int protocol, boost::system::error_code& ec)
@@ -26,6 +26,10 @@
 #include <boost/asio/detail/socket_ops.hpp>
 #include <boost/asio/error.hpp>
 
+#if defined(BOOST_ASIO_HAS_SENDFILE)
+# include <sys/sendfile.h>
+#endif // defined(BOOST_ASIO_HAS_SENDFILE)
+
 #if defined(BOOST_ASIO_WINDOWS) || defined(__CYGWIN__) \
   || defined(__MACH__) && defined(__APPLE__)
 # if defined(BOOST_ASIO_HAS_PTHREADS)
@@ -1197,6 +1201,333 @@ bool non_blocking_send(socket_type s,
 
 #endif // defined(BOOST_ASIO_HAS_IOCP)
 
+#if defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+
+bool non_blocking_recv_zero_copy_notification(
+    socket_type s, boost::system::error_code& ec)
+{
+  for (;;)
+  {
+    // Read the next message from the socket's error queue.
+    union
+    {
+      cmsghdr align;
+      char data[CMSG_SPACE(sizeof(sock_extended_err))
+        + CMSG_SPACE(sizeof(sockaddr_in6))];
+    } control;
+    msghdr msg = msghdr();
+    msg.msg_control = control.data;
+    msg.msg_controllen = sizeof(control.data);
+    clear_last_error();
+    signed_size_type result = error_wrapper(
+        ::recvmsg(s, &msg, MSG_ERRQUEUE), ec);
+
+    // Retry operation if interrupted by signal.
+    if (ec == boost::asio::error::interrupted)
+      continue;
+
+    // Check if we need to run the operation again.
+    if (ec == boost::asio::error::would_block
+        || ec == boost::asio::error::try_again)
+      return false;
+
+    // Operation failed.
+    if (result < 0)
+      return true;
+
+    // Ignore anything that is not a completion notification, such as ICMP
+    // errors queued when IP_RECVERR is enabled.
+    for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg;
+        cmsg = CMSG_NXTHDR(&msg, cmsg))
+    {
+      if ((cmsg->cmsg_level == SOL_IP && cmsg->cmsg_type == IP_RECVERR)
+          || (cmsg->cmsg_level == SOL_IPV6
+            && cmsg->cmsg_type == IPV6_RECVERR))
+      {
+        const sock_extended_err* err =
+          reinterpret_cast<const sock_extended_err*>(CMSG_DATA(cmsg));
+        if (err->ee_origin == SO_EE_ORIGIN_ZEROCOPY)
+        {
+          ec = boost::system::error_code();
+          return true;
+        }
+      }
+    }
+  }
+}
+
+#endif // defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+
+#if defined(BOOST_ASIO_HAS_SENDFILE)
+
+signed_size_type sendfile(socket_type s, int file,
+    uint64_t& offset, size_t length, boost::system::error_code& ec)
+{
+  clear_last_error();
+  off_t file_offset = static_cast<off_t>(offset);
+  signed_size_type result = error_wrapper(
+      ::sendfile(s, file, &file_offset, length), ec);
+  if (result >= 0)
+  {
+    ec = boost::system::error_code();
+    offset = static_cast<uint64_t>(file_offset);
+  }
+  return result;
+}
+
+size_t sync_sendfile(socket_type s, state_type state,
+    int file, uint64_t offset, size_t length, boost::system::error_code& ec)
+{
+  if (s == invalid_socket)
+  {
+    ec = boost::asio::error::bad_descriptor;
+    return 0;
+  }
+
+  // Write until the whole range has been sent.
+  size_t bytes_transferred = 0;
+  while (bytes_transferred < length)
+  {
+    // Try to complete the operation without blocking.
+    signed_size_type bytes = socket_ops::sendfile(
+        s, file, offset, length - bytes_transferred, ec);
+
+    // Check if operation succeeded.
+    if (bytes > 0)
+    {
+      bytes_transferred += bytes;
+      continue;
+    }
+
+    // The file ended before the range did.
+    if (bytes == 0)
+    {
+      ec = boost::asio::error::eof;
+      return bytes_transferred;
+    }
+
+    // Operation failed.
+    if ((state & user_set_non_blocking)
+        || (ec != boost::asio::error::would_block
+          && ec != boost::asio::error::try_again))
+      return bytes_transferred;
+
+    // Wait for socket to become ready.
+    if (socket_ops::poll_write(s, 0, ec) < 0)
+      return bytes_transferred;
+  }
+
+  ec = boost::system::error_code();
+  return bytes_transferred;
+}
+
+bool non_blocking_sendfile(socket_type s,
+    int file, uint64_t& offset, size_t& remaining,
+    boost::system::error_code& ec, size_t& bytes_transferred)
+{
+  while (remaining > 0)
+  {
+    // Write some data.
+    signed_size_type bytes = socket_ops::sendfile(
+        s, file, offset, remaining, ec);
+
+    // Retry operation if interrupted by signal.
+    if (ec == boost::asio::error::interrupted)
+      continue;
+
+    // Check if we need to run the operation again.
+    if (ec == boost::asio::error::would_block
+        || ec == boost::asio::error::try_again)
+      return false;
+
+    // Operation failed.
+    if (bytes < 0)
+      return true;
+
+    // The file ended before the range did.
+    if (bytes == 0)
+    {
+      ec = boost::asio::error::eof;
+      return true;
+    }
+
+    bytes_transferred += bytes;
+    remaining -= bytes;
+  }
+
+  ec = boost::system::error_code();
+  return true;
+}
+
+#endif // defined(BOOST_ASIO_HAS_SENDFILE)
+
+#if defined(BOOST_ASIO_HAS_MMSG)
+
+int recvmmsg(socket_type s, mmsg_type* msgs,
+    size_t count, int flags, boost::system::error_code& ec)
+{
+  clear_last_error();
+  int result = error_wrapper(::recvmmsg(s, msgs,
+        static_cast<unsigned int>(count), flags, 0), ec);
+  if (result >= 0)
+    ec = boost::system::error_code();
+  return result;
+}
+
+size_t sync_recvmmsg(socket_type s, state_type state,
+    mmsg_type* msgs, size_t count, int flags, boost::system::error_code& ec)
+{
+  if (s == invalid_socket)
+  {
+    ec = boost::asio::error::bad_descriptor;
+    return 0;
+  }
+
+  // A request to receive no messages is a no-op.
+  if (count == 0)
+  {
+    ec = boost::system::error_code();
+    return 0;
+  }
+
+  // Read some messages.
+  for (;;)
+  {
+    // Try to complete the operation without blocking.
+    int messages = socket_ops::recvmmsg(s, msgs, count, flags, ec);
+
+    // Check if operation succeeded.
+    if (messages >= 0)
+      return messages;
+
+    // Operation failed.
+    if ((state & user_set_non_blocking)
+        || (ec != boost::asio::error::would_block
+          && ec != boost::asio::error::try_again))
+      return 0;
+
+    // Wait for socket to become ready.
+    if (socket_ops::poll_read(s, 0, ec) < 0)
+      return 0;
+  }
+}
+
+bool non_blocking_recvmmsg(socket_type s,
+    mmsg_type* msgs, size_t count, int flags,
+    boost::system::error_code& ec, size_t& messages_transferred)
+{
+  for (;;)
+  {
+    // Read some messages.
+    int messages = socket_ops::recvmmsg(s, msgs, count, flags, ec);
+
+    // Retry operation if interrupted by signal.
+    if (ec == boost::asio::error::interrupted)
+      continue;
+
+    // Check if we need to run the operation again.
+    if (ec == boost::asio::error::would_block
+        || ec == boost::asio::error::try_again)
+      return false;
+
+    // Operation is complete.
+    if (messages >= 0)
+    {
+      ec = boost::system::error_code();
+      messages_transferred = messages;
+    }
+    else
+      messages_transferred = 0;
+
+    return true;
+  }
+}
+
+int sendmmsg(socket_type s, mmsg_type* msgs,
+    size_t count, int flags, boost::system::error_code& ec)
+{
+  clear_last_error();
+#if defined(__linux__)
+  flags |= MSG_NOSIGNAL;
+#endif // defined(__linux__)
+  int result = error_wrapper(::sendmmsg(s, msgs,
+        static_cast<unsigned int>(count), flags), ec);
+  if (result >= 0)
+    ec = boost::system::error_code();
+  return result;
+}
+
+size_t sync_sendmmsg(socket_type s, state_type state,
+    mmsg_type* msgs, size_t count, int flags, boost::system::error_code& ec)
+{
+  if (s == invalid_socket)
+  {
+    ec = boost::asio::error::bad_descriptor;
+    return 0;
+  }
+
+  // A request to send no messages is a no-op.
+  if (count == 0)
+  {
+    ec = boost::system::error_code();
+    return 0;
+  }
+
+  // Write some messages.
+  for (;;)
+  {
+    // Try to complete the operation without blocking.
+    int messages = socket_ops::sendmmsg(s, msgs, count, flags, ec);
+
+    // Check if operation succeeded.
+    if (messages >= 0)
+      return messages;
+
+    // Operation failed.
+    if ((state & user_set_non_blocking)
+        || (ec != boost::asio::error::would_block
+          && ec != boost::asio::error::try_again))
+      return 0;
+
+    // Wait for socket to become ready.
+    if (socket_ops::poll_write(s, 0, ec) < 0)
+      return 0;
+  }
+}
+
+bool non_blocking_sendmmsg(socket_type s,
+    mmsg_type* msgs, size_t count, int flags,
+    boost::system::error_code& ec, size_t& messages_transferred)
+{
+  for (;;)
+  {
+    // Write some messages.
+    int messages = socket_ops::sendmmsg(s, msgs, count, flags, ec);
+
+    // Retry operation if interrupted by signal.
+    if (ec == boost::asio::error::interrupted)
+      continue;
+
+    // Check if we need to run the operation again.
+    if (ec == boost::asio::error::would_block
+        || ec == boost::asio::error::try_again)
+      return false;
+
+    // Operation is complete.
+    if (messages >= 0)
+    {
+      ec = boost::system::error_code();
+      messages_transferred = messages;
+    }
+    else
+      messages_transferred = 0;
+
+    return true;
+  }
+}
+
+#endif // defined(BOOST_ASIO_HAS_MMSG)
+
 signed_size_type sendto(socket_type s, const buf* bufs, size_t count,
     int flags, const socket_addr_type* addr, std::size_t addrlen,
     boost::system::error_code& ec)
@@ -1390,6 +1721,21 @@ int setsockopt(socket_type s, state_type& state, int level, int optname,
     return 0;
   }
 
+  if (level == custom_socket_option_level
+      && optname == reactor_batching_option)
+  {
+    if (optlen != sizeof(int))
+    {
+      ec = boost::asio::error::invalid_argument;
+      return socket_error_retval;
+    }
+
+    // Only the epoll reactor supports batching, and it handles the option
+    // itself. Elsewhere the option is accepted and has no effect.
+    ec = boost::system::error_code();
+    return 0;
+  }
+
   if (level == SOL_SOCKET && optname == SO_LINGER)
     state |= user_set_linger;
 
@@ -1475,6 +1821,20 @@ int getsockopt(socket_type s, state_type state, int level, int optname,
     return 0;
   }
 
+  if (level == custom_socket_option_level
+      && optname == reactor_batching_option)
+  {
+    if (*optlen != sizeof(int))
+    {
+      ec = boost::asio::error::invalid_argument;
+      return socket_error_retval;
+    }
+
+    *static_cast<int*>(optval) = 0;
+    ec = boost::system::error_code();
+    return 0;
+  }
+
 #if defined(__BORLANDC__)
   // Mysteriously, using the getsockopt and setsockopt functions directly with
   // Borland C++ results in incorrect values being set and read. The bug can be
@@ -34,6 +34,17 @@ inline strand_service::strand_impl::strand_impl()
 {
 }
 
+inline void strand_service::copy_construct(
+    strand_service::implementation_type& impl,
+    const strand_service::implementation_type& other_impl)
+{
+  impl = other_impl;
+}
+
+inline void strand_service::destroy(strand_service::implementation_type&)
+{
+}
+
 struct strand_service::on_dispatch_exit
 {
   io_service_impl* io_service_;
@@ -43,6 +43,22 @@ struct task_io_service::task_cleanup
     }
     this_thread_->private_outstanding_work = 0;
 
+    task_io_service_->record_queued(this_thread_->private_op_queue);
+
+    if (task_io_service_->shards_)
+    {
+      // Completed operations go to this thread's own queue, where idle peers
+      // are able to steal them. Only the task goes back on the main queue.
+      task_io_service_->release_task_wakeup();
+      if (!this_thread_->private_op_queue.empty())
+        task_io_service_->push_to_shard(this_thread_->shard_index,
+            this_thread_->private_op_queue);
+      lock_->lock();
+      task_io_service_->task_interrupted_ = true;
+      task_io_service_->op_queue_.push(&task_io_service_->task_operation_);
+      return;
+    }
+
     // Enqueue the completed operations and reinsert the task at the end of
     // the operation queue.
     lock_->lock();
@@ -75,6 +91,13 @@ struct task_io_service::work_cleanup
 #if defined(BOOST_ASIO_HAS_THREADS)
     if (!this_thread_->private_op_queue.empty())
     {
+      if (task_io_service_->shards_)
+      {
+        task_io_service_->push_to_shard(this_thread_->shard_index,
+            this_thread_->private_op_queue);
+        return;
+      }
+
       lock_->lock();
       task_io_service_->op_queue_.push(this_thread_->private_op_queue);
     }
@@ -96,9 +119,24 @@ task_io_service::task_io_service(
     outstanding_work_(0),
     stopped_(false),
     shutdown_(false),
-    first_idle_thread_(0)
+    first_idle_thread_(0),
+    shards_(0),
+    num_shards_(one_thread_ ? 0 : calculate_num_shards(concurrency_hint)),
+    next_shard_(0),
+    next_post_shard_(0),
+    num_waiters_(0),
+    task_wakeup_(0),
+    stopped_hint_(0)
 {
   BOOST_ASIO_HANDLER_TRACKING_INIT;
+
+  if (num_shards_ > 0)
+    shards_ = new shard[num_shards_];
+}
+
+task_io_service::~task_io_service()
+{
+  delete[] shards_;
 }
 
 void task_io_service::shutdown_service()
@@ -116,6 +154,21 @@ void task_io_service::shutdown_service()
       o->destroy();
   }
 
+  for (std::size_t i = 0; i < num_shards_; ++i)
+  {
+    mutex::scoped_lock shard_lock(shards_[i].mutex_);
+    op_queue<operation> ops;
+    ops.push(shards_[i].op_queue_);
+
+    while (!ops.empty())
+    {
+      operation* o = ops.front();
+      ops.pop();
+      --shards_[i].size_;
+      o->destroy();
+    }
+  }
+
   // Reset to initial state.
   task_ = 0;
 }
@@ -144,12 +197,25 @@ std::size_t task_io_service::run(boost::system::error_code& ec)
   event wakeup_event;
   this_thread.wakeup_event = &wakeup_event;
   this_thread.private_outstanding_work = 0;
+  this_thread.shard_index = 0;
+  this_thread.shard_run_count = 0;
   this_thread.next = 0;
   thread_call_stack::context ctx(this, this_thread);
 
   mutex::scoped_lock lock(mutex_);
 
   std::size_t n = 0;
+  if (shards_)
+  {
+    this_thread.shard_index = next_shard_++ % num_shards_;
+    lock.unlock();
+
+    for (; do_run_one_sharded(lock, this_thread, ec); )
+      if (n != (std::numeric_limits<std::size_t>::max)())
+        ++n;
+    return n;
+  }
+
   for (; do_run_one(lock, this_thread, ec); lock.lock())
     if (n != (std::numeric_limits<std::size_t>::max)())
       ++n;
@@ -169,11 +235,20 @@ std::size_t task_io_service::run_one(boost::system::error_code& ec)
   event wakeup_event;
   this_thread.wakeup_event = &wakeup_event;
   this_thread.private_outstanding_work = 0;
+  this_thread.shard_index = 0;
+  this_thread.shard_run_count = 0;
   this_thread.next = 0;
   thread_call_stack::context ctx(this, this_thread);
 
   mutex::scoped_lock lock(mutex_);
 
+  if (shards_)
+  {
+    this_thread.shard_index = next_shard_++ % num_shards_;
+    lock.unlock();
+    return do_run_one_sharded(lock, this_thread, ec);
+  }
+
   return do_run_one(lock, this_thread, ec);
 }
 
@@ -189,11 +264,34 @@ std::size_t task_io_service::poll(boost::system::error_code& ec)
   thread_info this_thread;
   this_thread.wakeup_event = 0;
   this_thread.private_outstanding_work = 0;
+  this_thread.shard_index = 0;
+  this_thread.shard_run_count = 0;
   this_thread.next = 0;
   thread_call_stack::context ctx(this, this_thread);
 
   mutex::scoped_lock lock(mutex_);
 
+  if (shards_)
+  {
+    this_thread.shard_index = next_shard_++ % num_shards_;
+    lock.unlock();
+
+#if defined(BOOST_ASIO_HAS_THREADS)
+    // Handlers on an outer thread-private queue must be made visible to the
+    // nested call to poll().
+    if (thread_info* outer_thread_info = ctx.next_by_key())
+      if (!outer_thread_info->private_op_queue.empty())
+        push_to_shard(outer_thread_info->shard_index,
+            outer_thread_info->private_op_queue);
+#endif // defined(BOOST_ASIO_HAS_THREADS)
+
+    std::size_t n = 0;
+    for (; do_poll_one_sharded(lock, this_thread, ec); )
+      if (n != (std::numeric_limits<std::size_t>::max)())
+        ++n;
+    return n;
+  }
+
 #if defined(BOOST_ASIO_HAS_THREADS)
   // We want to support nested calls to poll() and poll_one(), so any handlers
   // that are already on a thread-private queue need to be put on to the main
@@ -222,11 +320,30 @@ std::size_t task_io_service::poll_one(boost::system::error_code& ec)
   thread_info this_thread;
   this_thread.wakeup_event = 0;
   this_thread.private_outstanding_work = 0;
+  this_thread.shard_index = 0;
+  this_thread.shard_run_count = 0;
   this_thread.next = 0;
   thread_call_stack::context ctx(this, this_thread);
 
   mutex::scoped_lock lock(mutex_);
 
+  if (shards_)
+  {
+    this_thread.shard_index = next_shard_++ % num_shards_;
+    lock.unlock();
+
+#if defined(BOOST_ASIO_HAS_THREADS)
+    // Handlers on an outer thread-private queue must be made visible to the
+    // nested call to poll_one().
+    if (thread_info* outer_thread_info = ctx.next_by_key())
+      if (!outer_thread_info->private_op_queue.empty())
+        push_to_shard(outer_thread_info->shard_index,
+            outer_thread_info->private_op_queue);
+#endif // defined(BOOST_ASIO_HAS_THREADS)
+
+    return do_poll_one_sharded(lock, this_thread, ec);
+  }
+
 #if defined(BOOST_ASIO_HAS_THREADS)
   // We want to support nested calls to poll() and poll_one(), so any handlers
   // that are already on a thread-private queue need to be put on to the main
@@ -254,12 +371,16 @@ bool task_io_service::stopped() const
 void task_io_service::reset()
 {
   mutex::scoped_lock lock(mutex_);
+  if (stopped_)
+    --stopped_hint_;
   stopped_ = false;
 }
 
 void task_io_service::post_immediate_completion(
     task_io_service::operation* op, bool is_continuation)
 {
+  record_queued(op);
+
 #if defined(BOOST_ASIO_HAS_THREADS)
   if (one_thread_ || is_continuation)
   {
@@ -273,6 +394,13 @@ void task_io_service::post_immediate_completion(
 #endif // defined(BOOST_ASIO_HAS_THREADS)
 
   work_started();
+
+  if (shards_)
+  {
+    push_to_shard(select_shard(), op);
+    return;
+  }
+
   mutex::scoped_lock lock(mutex_);
   op_queue_.push(op);
   wake_one_thread_and_unlock(lock);
@@ -280,6 +408,8 @@ void task_io_service::post_immediate_completion(
 
 void task_io_service::post_deferred_completion(task_io_service::operation* op)
 {
+  record_queued(op);
+
 #if defined(BOOST_ASIO_HAS_THREADS)
   if (one_thread_)
   {
@@ -291,6 +421,12 @@ void task_io_service::post_deferred_completion(task_io_service::operation* op)
   }
 #endif // defined(BOOST_ASIO_HAS_THREADS)
 
+  if (shards_)
+  {
+    push_to_shard(select_shard(), op);
+    return;
+  }
+
   mutex::scoped_lock lock(mutex_);
   op_queue_.push(op);
   wake_one_thread_and_unlock(lock);
@@ -301,6 +437,8 @@ void task_io_service::post_deferred_completions(
 {
   if (!ops.empty())
   {
+    record_queued(ops);
+
 #if defined(BOOST_ASIO_HAS_THREADS)
     if (one_thread_)
     {
@@ -312,6 +450,12 @@ void task_io_service::post_deferred_completions(
     }
 #endif // defined(BOOST_ASIO_HAS_THREADS)
 
+    if (shards_)
+    {
+      push_to_shard(select_shard(), ops);
+      return;
+    }
+
     mutex::scoped_lock lock(mutex_);
     op_queue_.push(ops);
     wake_one_thread_and_unlock(lock);
@@ -321,7 +465,15 @@ void task_io_service::post_deferred_completions(
 void task_io_service::do_dispatch(
     task_io_service::operation* op)
 {
+  record_queued(op);
   work_started();
+
+  if (shards_)
+  {
+    push_to_shard(select_shard(), op);
+    return;
+  }
+
   mutex::scoped_lock lock(mutex_);
   op_queue_.push(op);
   wake_one_thread_and_unlock(lock);
@@ -381,7 +533,7 @@ std::size_t task_io_service::do_run_one(mutex::scoped_lock& lock,
         (void)on_exit;
 
         // Complete the operation. May throw an exception. Deletes the object.
-        o->complete(*this, ec, task_result);
+        complete_operation(o, ec, task_result);
 
         return 1;
       }
@@ -391,8 +543,7 @@ std::size_t task_io_service::do_run_one(mutex::scoped_lock& lock,
       // Nothing to run right now, so just wait for work to do.
       this_thread.next = first_idle_thread_;
       first_idle_thread_ = &this_thread;
-      this_thread.wakeup_event->clear(lock);
-      this_thread.wakeup_event->wait(lock);
+      wait_for_work(lock, this_thread);
     }
   }
 
@@ -448,7 +599,7 @@ std::size_t task_io_service::do_poll_one(mutex::scoped_lock& lock,
   (void)on_exit;
 
   // Complete the operation. May throw an exception. Deletes the object.
-  o->complete(*this, ec, task_result);
+  complete_operation(o, ec, task_result);
 
   return 1;
 }
@@ -456,6 +607,8 @@ std::size_t task_io_service::do_poll_one(mutex::scoped_lock& lock,
 void task_io_service::stop_all_threads(
     mutex::scoped_lock& lock)
 {
+  if (!stopped_)
+    ++stopped_hint_;
   stopped_ = true;
 
   while (first_idle_thread_)
@@ -501,6 +654,337 @@ void task_io_service::wake_one_thread_and_unlock(
   }
 }
 
+void task_io_service::record_queued(op_queue<task_io_service::operation>& ops)
+{
+  if (metrics_.enabled())
+  {
+    uint64_t now = 0;
+    for (operation* op = ops.front(); op; op = op_queue_access::next(op))
+    {
+      if (op->enqueue_time_ == 0)
+      {
+        if (now == 0)
+          now = metrics_collector::now();
+        op->enqueue_time_ = now;
+        metrics_.handler_queued();
+      }
+    }
+  }
+}
+
+void task_io_service::complete_timed_operation(task_io_service::operation* o,
+    const boost::system::error_code& ec, std::size_t task_result)
+{
+  uint64_t start = metrics_collector::now();
+  if (o->enqueue_time_ != 0)
+  {
+    metrics_.handler_dequeued(
+        start > o->enqueue_time_ ? start - o->enqueue_time_ : 0);
+    o->enqueue_time_ = 0;
+  }
+
+  // Complete the operation. May throw an exception. Deletes the object.
+  o->complete(*this, ec, task_result);
+
+  if (metrics_.enabled())
+  {
+    uint64_t finish = metrics_collector::now();
+    metrics_.handler_executed(finish > start ? finish - start : 0);
+  }
+}
+
+void task_io_service::wait_for_work(mutex::scoped_lock& lock,
+    task_io_service::thread_info& this_thread)
+{
+  this_thread.wakeup_event->clear(lock);
+  if (metrics_.enabled())
+  {
+    uint64_t start = metrics_collector::now();
+    this_thread.wakeup_event->wait(lock);
+    uint64_t finish = metrics_collector::now();
+    metrics_.thread_idle(finish > start ? finish - start : 0);
+  }
+  else
+    this_thread.wakeup_event->wait(lock);
+}
+
+std::size_t task_io_service::calculate_num_shards(std::size_t concurrency_hint)
+{
+#if defined(BOOST_ASIO_HAS_THREADS) \
+  && defined(BOOST_ASIO_ENABLE_WORK_STEALING)
+  if (concurrency_hint > 1
+      && concurrency_hint <= BOOST_ASIO_WORK_STEALING_MAX_SHARDS)
+    return concurrency_hint;
+  return BOOST_ASIO_WORK_STEALING_DEFAULT_SHARDS;
+#else // defined(BOOST_ASIO_HAS_THREADS)
+      //   && defined(BOOST_ASIO_ENABLE_WORK_STEALING)
+  (void)concurrency_hint;
+  return 0;
+#endif // defined(BOOST_ASIO_HAS_THREADS)
+       //   && defined(BOOST_ASIO_ENABLE_WORK_STEALING)
+}
+
+std::size_t task_io_service::select_shard()
+{
+  // Handlers posted from within the io_service stay with the posting thread.
+  if (thread_info* this_thread = thread_call_stack::contains(this))
+    return this_thread->shard_index;
+
+  // Handlers posted from outside are spread across all threads.
+  return static_cast<std::size_t>(++next_post_shard_) % num_shards_;
+}
+
+void task_io_service::push_to_shard(std::size_t index,
+    task_io_service::operation* op)
+{
+  mutex::scoped_lock shard_lock(shards_[index].mutex_);
+  shards_[index].op_queue_.push(op);
+  ++shards_[index].size_;
+  shard_lock.unlock();
+
+  wake_waiting_thread();
+}
+
+void task_io_service::push_to_shard(std::size_t index,
+    op_queue<task_io_service::operation>& ops)
+{
+  long count = 0;
+  for (operation* op = ops.front(); op; op = op_queue_access::next(op))
+    ++count;
+
+  mutex::scoped_lock shard_lock(shards_[index].mutex_);
+  shards_[index].op_queue_.push(ops);
+  boost::asio::detail::increment(shards_[index].size_, count);
+  shard_lock.unlock();
+
+  wake_waiting_thread();
+}
+
+task_io_service::operation* task_io_service::pop_from_shards(
+    std::size_t index, bool& more)
+{
+  for (std::size_t i = 0; i < num_shards_; ++i)
+  {
+    shard& s = shards_[(index + i) % num_shards_];
+    if (s.size_ == 0)
+      continue;
+
+    mutex::scoped_lock shard_lock(s.mutex_);
+    if (operation* o = s.op_queue_.front())
+    {
+      s.op_queue_.pop();
+      more = (--s.size_ != 0);
+      return o;
+    }
+  }
+
+  more = false;
+  return 0;
+}
+
+bool task_io_service::shards_empty()
+{
+  for (std::size_t i = 0; i < num_shards_; ++i)
+    if (shards_[i].size_ != 0)
+      return false;
+
+  return true;
+}
+
+void task_io_service::wake_waiting_thread()
+{
+  // A thread only waits after incrementing num_waiters_, or task_wakeup_ for
+  // the task, and then finding all of the queue sizes zero. Since the queue
+  // sizes are updated before they are checked here, a pusher that sees no
+  // waiters is guaranteed that any thread about to wait will see the newly
+  // pushed operations.
+  if (num_waiters_ > 0)
+  {
+    mutex::scoped_lock lock(mutex_);
+    if (wake_one_idle_thread_and_unlock(lock))
+      return;
+    lock.unlock();
+  }
+
+  // Only the first pusher to claim the wakeup needs to interrupt the task.
+  if (task_wakeup_ > 0)
+  {
+    if (--task_wakeup_ == 0)
+      task_->interrupt();
+    else
+      ++task_wakeup_;
+  }
+}
+
+void task_io_service::release_task_wakeup()
+{
+  // The claim may race with a pusher, in which case whichever decrement
+  // reaches zero owns it and the others are undone.
+  if (--task_wakeup_ != 0)
+    ++task_wakeup_;
+}
+
+std::size_t task_io_service::do_run_one_sharded(mutex::scoped_lock& lock,
+    task_io_service::thread_info& this_thread,
+    const boost::system::error_code& ec)
+{
+  while (stopped_hint_ == 0)
+  {
+    // Prefer handlers from this thread's own queue, then those of its peers,
+    // but periodically fall through to the main queue so that the task is not
+    // starved by a steady stream of posted handlers.
+    bool more_handlers = false;
+    operation* o = 0;
+    if (++this_thread.shard_run_count % BOOST_ASIO_WORK_STEALING_TASK_INTERVAL)
+      o = pop_from_shards(this_thread.shard_index, more_handlers);
+    if (o)
+    {
+      if (more_handlers)
+        wake_waiting_thread();
+
+      std::size_t task_result = o->task_result_;
+
+      // Ensure the count of outstanding work is decremented on block exit.
+      work_cleanup on_exit = { this, &lock, &this_thread };
+      (void)on_exit;
+
+      // Complete the operation. May throw an exception. Deletes the object.
+      complete_operation(o, ec, task_result);
+
+      return 1;
+    }
+
+    lock.lock();
+
+    if (stopped_)
+      break;
+
+    if (!op_queue_.empty())
+    {
+      o = op_queue_.front();
+      op_queue_.pop();
+      more_handlers = (!op_queue_.empty());
+
+      if (o == &task_operation_)
+      {
+        // Allow the task to be interrupted before checking the queues, so
+        // that any handler pushed after the check will interrupt it.
+        task_interrupted_ = more_handlers;
+        lock.unlock();
+        if (!more_handlers)
+        {
+          ++task_wakeup_;
+          more_handlers = !shards_empty();
+        }
+
+        {
+          task_cleanup on_exit = { this, &lock, &this_thread };
+          (void)on_exit;
+
+          // Run the task. May throw an exception. Only block if there are no
+          // handlers ready to run.
+          task_->run(!more_handlers, this_thread.private_op_queue);
+        }
+
+        lock.unlock();
+      }
+      else
+      {
+        std::size_t task_result = o->task_result_;
+        lock.unlock();
+
+        // Ensure the count of outstanding work is decremented on block exit.
+        work_cleanup on_exit = { this, &lock, &this_thread };
+        (void)on_exit;
+
+        // Complete the operation. May throw an exception. Deletes the object.
+        complete_operation(o, ec, task_result);
+
+        return 1;
+      }
+    }
+    else
+    {
+      // Nothing to run right now, so wait for work unless some arrived after
+      // the queues were last checked.
+      ++num_waiters_;
+      if (shards_empty())
+      {
+        this_thread.next = first_idle_thread_;
+        first_idle_thread_ = &this_thread;
+        wait_for_work(lock, this_thread);
+      }
+      --num_waiters_;
+      lock.unlock();
+    }
+  }
+
+  lock.unlock();
+  return 0;
+}
+
+std::size_t task_io_service::do_poll_one_sharded(mutex::scoped_lock& lock,
+    task_io_service::thread_info& this_thread,
+    const boost::system::error_code& ec)
+{
+  if (stopped_hint_ != 0)
+    return 0;
+
+  bool more_handlers = false;
+  operation* o = pop_from_shards(this_thread.shard_index, more_handlers);
+  if (o == 0)
+  {
+    lock.lock();
+
+    if (stopped_)
+    {
+      lock.unlock();
+      return 0;
+    }
+
+    o = op_queue_.front();
+    if (o == &task_operation_)
+    {
+      op_queue_.pop();
+      lock.unlock();
+
+      {
+        task_cleanup c = { this, &lock, &this_thread };
+        (void)c;
+
+        // Run the task. May throw an exception. We're polling, so never block.
+        task_->run(false, this_thread.private_op_queue);
+      }
+
+      lock.unlock();
+      o = pop_from_shards(this_thread.shard_index, more_handlers);
+    }
+    else
+    {
+      if (o)
+        op_queue_.pop();
+      lock.unlock();
+    }
+
+    if (o == 0)
+      return 0;
+  }
+
+  if (more_handlers)
+    wake_waiting_thread();
+
+  std::size_t task_result = o->task_result_;
+
+  // Ensure the count of outstanding work is decremented on block exit.
+  work_cleanup on_exit = { this, &lock, &this_thread };
+  (void)on_exit;
+
+  // Complete the operation. May throw an exception. Deletes the object.
+  complete_operation(o, ec, task_result);
+
+  return 1;
+}
+
 } // namespace detail
 } // namespace asio
 } // namespace boost
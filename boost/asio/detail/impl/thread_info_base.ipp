@@ -0,0 +1,105 @@
+//
+// detail/impl/thread_info_base.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_IMPL_THREAD_INFO_BASE_IPP
+#define BOOST_ASIO_DETAIL_IMPL_THREAD_INFO_BASE_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <boost/asio/detail/atomic_count.hpp>
+#include <boost/asio/detail/thread_info_base.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+namespace thread_info_stats {
+
+// The counts are spread over a number of stripes, each used by a subset of the
+// threads, so that threads do not contend for a single set of counters.
+enum { num_stripes = 16 };
+
+struct stripe
+{
+  stripe() : hits(0), misses(0), releases(0) {}
+
+  atomic_count hits;
+  atomic_count misses;
+  atomic_count releases;
+
+  // Keep the counters of adjacent stripes on separate cache lines.
+  char padding[64];
+};
+
+struct totals
+{
+  totals() : next_stripe(0) {}
+
+  stripe stripes[num_stripes];
+
+  // Used to assign stripes to threads in turn.
+  atomic_count next_stripe;
+};
+
+// The totals are never destroyed, so that they remain usable by threads that
+// exit, or by handlers that are freed, during static destruction.
+inline totals& get_totals()
+{
+  static totals* t = new totals;
+  return *t;
+}
+
+} // namespace thread_info_stats
+
+std::size_t thread_info_base::assign_stripe()
+{
+  long n = ++thread_info_stats::get_totals().next_stripe;
+  return static_cast<std::size_t>(n) % thread_info_stats::num_stripes;
+}
+
+void thread_info_base::get_stats(std::size_t& hits,
+    std::size_t& misses, std::size_t& releases)
+{
+  thread_info_stats::totals& t = thread_info_stats::get_totals();
+  hits = misses = releases = 0;
+  for (std::size_t i = 0; i < thread_info_stats::num_stripes; ++i)
+  {
+    thread_info_stats::stripe& s = t.stripes[i];
+    hits += static_cast<std::size_t>(static_cast<long>(s.hits));
+    misses += static_cast<std::size_t>(static_cast<long>(s.misses));
+    releases += static_cast<std::size_t>(static_cast<long>(s.releases));
+  }
+}
+
+void thread_info_base::publish_stats()
+{
+  thread_info_stats::stripe& s =
+    thread_info_stats::get_totals().stripes[stripe_];
+  if (hits_)
+    increment(s.hits, static_cast<long>(hits_));
+  if (misses_)
+    increment(s.misses, static_cast<long>(misses_));
+  if (releases_)
+    increment(s.releases, static_cast<long>(releases_));
+  hits_ = misses_ = releases_ = unpublished_ = 0;
+}
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_DETAIL_IMPL_THREAD_INFO_BASE_IPP
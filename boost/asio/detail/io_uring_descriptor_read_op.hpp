@@ -0,0 +1,145 @@
+//
+// detail/io_uring_descriptor_read_op.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_IO_URING_DESCRIPTOR_READ_OP_HPP
+#define BOOST_ASIO_DETAIL_IO_URING_DESCRIPTOR_READ_OP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+
+#if defined(BOOST_ASIO_HAS_IO_URING)
+
+#include <boost/asio/detail/addressof.hpp>
+#include <boost/asio/detail/bind_handler.hpp>
+#include <boost/asio/detail/buffer_sequence_adapter.hpp>
+#include <boost/asio/detail/descriptor_ops.hpp>
+#include <boost/asio/detail/fenced_block.hpp>
+#include <boost/asio/detail/io_uring_operation.hpp>
+#include <boost/asio/error.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+template <typename MutableBufferSequence>
+class io_uring_descriptor_read_op_base : public io_uring_operation
+{
+public:
+  io_uring_descriptor_read_op_base(int descriptor,
+      const MutableBufferSequence& buffers, func_type complete_func)
+    : io_uring_operation(&io_uring_descriptor_read_op_base::do_prepare,
+        complete_func),
+      descriptor_(descriptor),
+      bufs_(buffers)
+  {
+  }
+
+  static void do_prepare(io_uring_operation* base, ::io_uring_sqe* sqe)
+  {
+    io_uring_descriptor_read_op_base* o(
+        static_cast<io_uring_descriptor_read_op_base*>(base));
+
+    // An offset of -1 uses, and updates, the current file position.
+    sqe->fd = o->descriptor_;
+    sqe->off = static_cast<__u64>(-1);
+    if (o->bufs_.count() == 1)
+    {
+      sqe->opcode = IORING_OP_READ;
+      sqe->addr = reinterpret_cast<__u64>(o->bufs_.buffers()[0].iov_base);
+      sqe->len = static_cast<__u32>(o->bufs_.buffers()[0].iov_len);
+    }
+    else
+    {
+      sqe->opcode = IORING_OP_READV;
+      sqe->addr = reinterpret_cast<__u64>(o->bufs_.buffers());
+      sqe->len = static_cast<__u32>(o->bufs_.count());
+    }
+  }
+
+protected:
+  // Check for end of file.
+  void check_eof()
+  {
+    if (!this->ec_ && this->bytes_transferred_ == 0)
+      this->ec_ = boost::asio::error::eof;
+  }
+
+private:
+  int descriptor_;
+  buffer_sequence_adapter<boost::asio::mutable_buffer, MutableBufferSequence> bufs_;
+};
+
+template <typename MutableBufferSequence, typename Handler>
+class io_uring_descriptor_read_op
+  : public io_uring_descriptor_read_op_base<MutableBufferSequence>
+{
+public:
+  BOOST_ASIO_DEFINE_HANDLER_PTR(io_uring_descriptor_read_op);
+
+  io_uring_descriptor_read_op(int descriptor,
+      const MutableBufferSequence& buffers, Handler& handler)
+    : io_uring_descriptor_read_op_base<MutableBufferSequence>(
+        descriptor, buffers, &io_uring_descriptor_read_op::do_complete),
+      handler_(BOOST_ASIO_MOVE_CAST(Handler)(handler))
+  {
+  }
+
+  static void do_complete(io_service_impl* owner, operation* base,
+      const boost::system::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    // Take ownership of the handler object.
+    io_uring_descriptor_read_op* o(
+        static_cast<io_uring_descriptor_read_op*>(base));
+    ptr p = { boost::asio::detail::addressof(o->handler_), o, o };
+
+    BOOST_ASIO_HANDLER_COMPLETION((o));
+
+    o->check_eof();
+
+    // Make a copy of the handler so that the memory can be deallocated before
+    // the upcall is made. Even if we're not about to make an upcall, a
+    // sub-object of the handler may be the true owner of the memory associated
+    // with the handler. Consequently, a local copy of the handler is required
+    // to ensure that any owning sub-object remains valid until after we have
+    // deallocated the memory here.
+    detail::binder2<Handler, boost::system::error_code, std::size_t>
+      handler(o->handler_, o->ec_, o->bytes_transferred_);
+    p.h = boost::asio::detail::addressof(handler.handler_);
+    p.reset();
+
+    // Make the upcall if required.
+    if (owner)
+    {
+      fenced_block b(fenced_block::half);
+      BOOST_ASIO_HANDLER_INVOCATION_BEGIN((handler.arg1_, handler.arg2_));
+      boost_asio_handler_invoke_helpers::invoke(handler, handler.handler_);
+      BOOST_ASIO_HANDLER_INVOCATION_END;
+    }
+  }
+
+private:
+  Handler handler_;
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // defined(BOOST_ASIO_HAS_IO_URING)
+
+#endif // BOOST_ASIO_DETAIL_IO_URING_SOCKET_DESCRIPTOR_READ_OP_HPP
@@ -0,0 +1,184 @@
+//
+// detail/io_uring_descriptor_service.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_IO_URING_DESCRIPTOR_SERVICE_HPP
+#define BOOST_ASIO_DETAIL_IO_URING_DESCRIPTOR_SERVICE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+
+#if defined(BOOST_ASIO_HAS_IO_URING)
+
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/detail/addressof.hpp>
+#include <boost/asio/detail/buffer_sequence_adapter.hpp>
+#include <boost/asio/detail/io_uring_descriptor_read_op.hpp>
+#include <boost/asio/detail/io_uring_descriptor_write_op.hpp>
+#include <boost/asio/detail/io_uring_service.hpp>
+#include <boost/asio/detail/reactive_descriptor_service.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+// A descriptor service that performs reads and writes using io_uring. Unlike
+// the reactive implementation, this also supports asynchronous operations on
+// regular files, which the reactor cannot wait on.
+class io_uring_descriptor_service
+  : public reactive_descriptor_service
+{
+public:
+  // Constructor.
+  io_uring_descriptor_service(boost::asio::io_service& io_service)
+    : reactive_descriptor_service(io_service),
+      io_uring_service_(use_service<io_uring_service>(io_service))
+  {
+  }
+
+  // Move-assign from another descriptor implementation.
+  void move_assign(implementation_type& impl,
+      reactive_descriptor_service& other_service,
+      implementation_type& other_impl)
+  {
+    if (is_open(impl))
+      io_uring_service_.cancel_ops(native_handle(impl));
+    reactive_descriptor_service::move_assign(impl, other_service, other_impl);
+  }
+
+  // Destroy a descriptor implementation.
+  void destroy(implementation_type& impl)
+  {
+    if (is_open(impl))
+      io_uring_service_.cancel_ops(native_handle(impl));
+    reactive_descriptor_service::destroy(impl);
+  }
+
+  // Destroy a descriptor implementation.
+  boost::system::error_code close(implementation_type& impl,
+      boost::system::error_code& ec)
+  {
+    if (is_open(impl))
+      io_uring_service_.cancel_ops(native_handle(impl));
+    return reactive_descriptor_service::close(impl, ec);
+  }
+
+  // Release ownership of the native descriptor representation.
+  native_handle_type release(implementation_type& impl)
+  {
+    if (is_open(impl))
+      io_uring_service_.cancel_ops(native_handle(impl));
+    return reactive_descriptor_service::release(impl);
+  }
+
+  // Cancel all operations associated with the descriptor.
+  boost::system::error_code cancel(implementation_type& impl,
+      boost::system::error_code& ec)
+  {
+    if (is_open(impl))
+      io_uring_service_.cancel_ops(native_handle(impl));
+    return reactive_descriptor_service::cancel(impl, ec);
+  }
+
+  // Start an asynchronous write. The data being sent must be valid for the
+  // lifetime of the asynchronous operation.
+  template <typename ConstBufferSequence, typename Handler>
+  void async_write_some(implementation_type& impl,
+      const ConstBufferSequence& buffers, Handler& handler)
+  {
+    if (!io_uring_service_.is_available()
+        || buffer_sequence_adapter<boost::asio::const_buffer,
+          ConstBufferSequence>::all_empty(buffers))
+    {
+      reactive_descriptor_service::async_write_some(impl, buffers, handler);
+      return;
+    }
+
+    bool is_continuation =
+      boost_asio_handler_cont_helpers::is_continuation(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef io_uring_descriptor_write_op<ConstBufferSequence, Handler> op;
+    typename op::ptr p = { boost::asio::detail::addressof(handler),
+      boost_asio_handler_alloc_helpers::allocate(
+        sizeof(op), handler), 0 };
+    p.p = new (p.v) op(native_handle(impl), buffers, handler);
+
+    BOOST_ASIO_HANDLER_CREATION((p.p, "descriptor", &impl, "async_write_some"));
+
+    io_uring_service_.start_op(p.p, is_continuation);
+    p.v = p.p = 0;
+  }
+
+  // Start an asynchronous wait until data can be written without blocking.
+  template <typename Handler>
+  void async_write_some(implementation_type& impl,
+      const null_buffers& buffers, Handler& handler)
+  {
+    reactive_descriptor_service::async_write_some(impl, buffers, handler);
+  }
+
+  // Start an asynchronous read. The buffer for the data being read must be
+  // valid for the lifetime of the asynchronous operation.
+  template <typename MutableBufferSequence, typename Handler>
+  void async_read_some(implementation_type& impl,
+      const MutableBufferSequence& buffers, Handler& handler)
+  {
+    if (!io_uring_service_.is_available()
+        || buffer_sequence_adapter<boost::asio::mutable_buffer,
+          MutableBufferSequence>::all_empty(buffers))
+    {
+      reactive_descriptor_service::async_read_some(impl, buffers, handler);
+      return;
+    }
+
+    bool is_continuation =
+      boost_asio_handler_cont_helpers::is_continuation(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef io_uring_descriptor_read_op<MutableBufferSequence, Handler> op;
+    typename op::ptr p = { boost::asio::detail::addressof(handler),
+      boost_asio_handler_alloc_helpers::allocate(
+        sizeof(op), handler), 0 };
+    p.p = new (p.v) op(native_handle(impl), buffers, handler);
+
+    BOOST_ASIO_HANDLER_CREATION((p.p, "descriptor", &impl, "async_read_some"));
+
+    io_uring_service_.start_op(p.p, is_continuation);
+    p.v = p.p = 0;
+  }
+
+  // Wait until data can be read without blocking.
+  template <typename Handler>
+  void async_read_some(implementation_type& impl,
+      const null_buffers& buffers, Handler& handler)
+  {
+    reactive_descriptor_service::async_read_some(impl, buffers, handler);
+  }
+
+private:
+  // The service that submits operations to the kernel.
+  io_uring_service& io_uring_service_;
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // defined(BOOST_ASIO_HAS_IO_URING)
+
+#endif // BOOST_ASIO_DETAIL_IO_URING_DESCRIPTOR_SERVICE_HPP
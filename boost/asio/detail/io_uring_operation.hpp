@@ -0,0 +1,71 @@
+//
+// detail/io_uring_operation.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_IO_URING_OPERATION_HPP
+#define BOOST_ASIO_DETAIL_IO_URING_OPERATION_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+
+#if defined(BOOST_ASIO_HAS_IO_URING)
+
+#include <linux/io_uring.h>
+#include <boost/asio/detail/operation.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+class io_uring_operation
+  : public operation
+{
+public:
+  // The error code to be passed to the completion handler.
+  boost::system::error_code ec_;
+
+  // The number of bytes transferred, to be passed to the completion handler.
+  // For operations that produce a descriptor, holds the new descriptor.
+  std::size_t bytes_transferred_;
+
+  // Fill in the submission queue entry for the operation. The entry has been
+  // zeroed, and its user_data field is set by the caller.
+  void prepare(::io_uring_sqe* sqe)
+  {
+    prepare_func_(this, sqe);
+  }
+
+protected:
+  typedef void (*prepare_func_type)(io_uring_operation*, ::io_uring_sqe*);
+
+  io_uring_operation(prepare_func_type prepare_func, func_type complete_func)
+    : operation(complete_func),
+      bytes_transferred_(0),
+      prepare_func_(prepare_func)
+  {
+  }
+
+private:
+  prepare_func_type prepare_func_;
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // defined(BOOST_ASIO_HAS_IO_URING)
+
+#endif // BOOST_ASIO_DETAIL_IO_URING_OPERATION_HPP
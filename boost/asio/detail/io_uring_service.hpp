@@ -0,0 +1,223 @@
+//
+// detail/io_uring_service.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_IO_URING_SERVICE_HPP
+#define BOOST_ASIO_DETAIL_IO_URING_SERVICE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+
+#if defined(BOOST_ASIO_HAS_IO_URING)
+
+#include <cstddef>
+#include <vector>
+#include <linux/io_uring.h>
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/detail/io_uring_operation.hpp>
+#include <boost/asio/detail/mutex.hpp>
+#include <boost/asio/detail/op_queue.hpp>
+#include <boost/asio/detail/reactor.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+// Submits operations to a Linux io_uring instance and delivers their
+// completions to the io_service.
+//
+// Submission queue entries are written under a lock but are not passed to the
+// kernel immediately. Instead, the first operation started after a submission
+// posts a flush operation to the io_service, and that flush submits all of
+// the entries that have accumulated in a single io_uring_enter call. The ring
+// descriptor itself is registered with the reactor, so that completion queue
+// entries are reaped in batches whenever the reactor runs, without any system
+// call beyond the reactor's existing epoll_wait.
+//
+// If the kernel does not support io_uring, or lacks the features required,
+// is_available() returns false and callers use the reactor instead.
+class io_uring_service
+  : public boost::asio::detail::service_base<io_uring_service>
+{
+public:
+  // Constructor.
+  BOOST_ASIO_DECL io_uring_service(boost::asio::io_service& io_service);
+
+  // Destructor.
+  BOOST_ASIO_DECL ~io_uring_service();
+
+  // Destroy all user-defined handler objects owned by the service.
+  BOOST_ASIO_DECL void shutdown_service();
+
+  // Whether io_uring may be used.
+  bool is_available() const
+  {
+    return ring_fd_ != -1;
+  }
+
+  // Start an operation. The operation's prepare function is called to fill
+  // in a submission queue entry.
+  BOOST_ASIO_DECL void start_op(io_uring_operation* op, bool is_continuation);
+
+  // Post an operation for immediate completion.
+  void post_immediate_completion(io_uring_operation* op, bool is_continuation)
+  {
+    io_service_.post_immediate_completion(op, is_continuation);
+  }
+
+  // Cancel all operations associated with the given descriptor. The handlers
+  // for those operations are invoked with the operation_aborted error.
+  BOOST_ASIO_DECL void cancel_ops(int descriptor);
+
+  // Register buffers with the kernel. Single-buffer reads and writes that lie
+  // entirely within a registered buffer then use the fixed-buffer opcodes,
+  // avoiding the per-operation cost of mapping user memory.
+  BOOST_ASIO_DECL boost::system::error_code register_buffers(
+      const boost::asio::mutable_buffer* buffers, std::size_t count,
+      boost::system::error_code& ec);
+
+  // Unregister all buffers.
+  BOOST_ASIO_DECL boost::system::error_code unregister_buffers(
+      boost::system::error_code& ec);
+
+  // Register descriptors with the kernel. Operations on a registered
+  // descriptor refer to it by index, avoiding a file table lookup for each
+  // operation. A registered descriptor must be unregistered before it is
+  // closed.
+  BOOST_ASIO_DECL boost::system::error_code register_files(
+      const int* descriptors, std::size_t count,
+      boost::system::error_code& ec);
+
+  // Unregister all descriptors.
+  BOOST_ASIO_DECL boost::system::error_code unregister_files(
+      boost::system::error_code& ec);
+
+private:
+  // Operation used to submit pending entries from within the io_service.
+  class flush_op;
+  friend class flush_op;
+
+  // Reactor operation used to reap completions when the ring is readable.
+  class reap_op;
+  friend class reap_op;
+
+  // A buffer registered with the kernel.
+  struct registered_buffer
+  {
+    char* data;
+    std::size_t size;
+  };
+
+  // Create the ring and map its queues. Leaves ring_fd_ as -1 on failure.
+  BOOST_ASIO_DECL void open_ring();
+
+  // Unmap the queues and close the ring.
+  BOOST_ASIO_DECL void close_ring();
+
+  // Determine whether the kernel supports cancellation by descriptor and of
+  // all matching operations, by submitting a cancellation that matches
+  // nothing. Must only be called before any operations are started.
+  BOOST_ASIO_DECL bool probe_cancel(int descriptor, unsigned cancel_flags);
+
+  // Get a free submission queue entry, submitting pending entries to make
+  // room if necessary. The mutex must be held.
+  BOOST_ASIO_DECL ::io_uring_sqe* get_sqe();
+
+  // Switch an entry to a registered buffer or descriptor where possible.
+  BOOST_ASIO_DECL void apply_registrations(::io_uring_sqe* sqe);
+
+  // Pass pending entries to the kernel. The mutex must be held.
+  BOOST_ASIO_DECL int submit(unsigned min_complete);
+
+  // Submit pending entries and clear the flush flag.
+  BOOST_ASIO_DECL void flush();
+
+  // Move completed operations from the completion queue to the given queue.
+  // The result of the shutdown cancellation, if reaped, is stored in
+  // cancel_result. The mutex must be held.
+  BOOST_ASIO_DECL void reap(op_queue<operation>& ops, int* cancel_result = 0);
+
+  // The io_service implementation used to post completions.
+  io_service_impl& io_service_;
+
+  // The reactor that notifies us when completions are available.
+  reactor& reactor_;
+
+  // Per-descriptor data used by the reactor for the ring descriptor.
+  reactor::per_descriptor_data reactor_data_;
+
+  // Mutex to protect access to internal data.
+  mutex mutex_;
+
+  // The io_uring descriptor.
+  int ring_fd_;
+
+  // The mapped submission queue ring, completion queue ring and entries.
+  void* sq_ring_;
+  std::size_t sq_ring_size_;
+  void* cq_ring_;
+  std::size_t cq_ring_size_;
+  ::io_uring_sqe* sqes_;
+  std::size_t sqes_size_;
+
+  // Pointers into the submission queue ring.
+  unsigned* sq_head_;
+  unsigned* sq_tail_;
+  unsigned* sq_flags_;
+  unsigned* sq_array_;
+  unsigned sq_mask_;
+  unsigned sq_entries_;
+
+  // Pointers into the completion queue ring.
+  unsigned* cq_head_;
+  unsigned* cq_tail_;
+  ::io_uring_cqe* cqes_;
+  unsigned cq_mask_;
+
+  // The number of entries written but not yet passed to the kernel.
+  unsigned pending_;
+
+  // The number of operations passed to the kernel and not yet reaped.
+  std::size_t outstanding_;
+
+  // Whether a flush operation has been posted.
+  bool flush_scheduled_;
+
+  // The operation used to flush pending entries.
+  flush_op* flush_op_;
+
+  // Buffers registered with the kernel.
+  std::vector<registered_buffer> buffers_;
+
+  // Registered descriptor indexes, indexed by descriptor. -1 if unregistered.
+  std::vector<int> file_indexes_;
+
+  // Whether the service has been shut down.
+  bool shutdown_;
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#if defined(BOOST_ASIO_HEADER_ONLY)
+# include <boost/asio/detail/impl/io_uring_service.ipp>
+#endif // defined(BOOST_ASIO_HEADER_ONLY)
+
+#endif // defined(BOOST_ASIO_HAS_IO_URING)
+
+#endif // BOOST_ASIO_DETAIL_IO_URING_SERVICE_HPP
@@ -0,0 +1,179 @@
+//
+// detail/io_uring_socket_accept_op.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_IO_URING_SOCKET_ACCEPT_OP_HPP
+#define BOOST_ASIO_DETAIL_IO_URING_SOCKET_ACCEPT_OP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+
+#if defined(BOOST_ASIO_HAS_IO_URING)
+
+#include <boost/asio/detail/addressof.hpp>
+#include <boost/asio/detail/bind_handler.hpp>
+#include <boost/asio/detail/fenced_block.hpp>
+#include <boost/asio/detail/io_uring_operation.hpp>
+#include <boost/asio/detail/io_uring_service.hpp>
+#include <boost/asio/detail/socket_holder.hpp>
+#include <boost/asio/detail/socket_ops.hpp>
+#include <boost/asio/error.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+template <typename Socket, typename Protocol>
+class io_uring_socket_accept_op_base : public io_uring_operation
+{
+public:
+  io_uring_socket_accept_op_base(io_uring_service& service,
+      socket_type socket, socket_ops::state_type state, Socket& peer,
+      const Protocol& protocol, typename Protocol::endpoint* peer_endpoint,
+      func_type complete_func)
+    : io_uring_operation(&io_uring_socket_accept_op_base::do_prepare,
+        complete_func),
+      service_(service),
+      socket_(socket),
+      state_(state),
+      peer_(peer),
+      protocol_(protocol),
+      peer_endpoint_(peer_endpoint),
+      addrlen_(0)
+  {
+  }
+
+  static void do_prepare(io_uring_operation* base, ::io_uring_sqe* sqe)
+  {
+    io_uring_socket_accept_op_base* o(
+        static_cast<io_uring_socket_accept_op_base*>(base));
+
+    o->addrlen_ = o->peer_endpoint_
+      ? static_cast<socklen_t>(o->peer_endpoint_->capacity()) : 0;
+
+    sqe->opcode = IORING_OP_ACCEPT;
+    sqe->fd = o->socket_;
+    sqe->addr = o->peer_endpoint_
+      ? reinterpret_cast<__u64>(o->peer_endpoint_->data()) : 0;
+    sqe->addr2 = o->peer_endpoint_ ? reinterpret_cast<__u64>(&o->addrlen_) : 0;
+  }
+
+protected:
+  // Restart the operation if the connection was aborted and the user has not
+  // asked to be told about it. Returns true if the operation was restarted.
+  bool restart_if_aborted()
+  {
+    if (this->ec_ == boost::asio::error::connection_aborted
+        && (state_ & socket_ops::enable_connection_aborted) == 0)
+    {
+      this->ec_ = boost::system::error_code();
+      service_.start_op(this, true);
+      return true;
+    }
+    return false;
+  }
+
+  // Assign the new connection to the peer socket object, or close it if the
+  // handler is not going to be called.
+  void assign_peer(bool assign)
+  {
+    if (this->ec_)
+      return;
+
+    socket_holder new_socket_holder(
+        static_cast<socket_type>(this->bytes_transferred_));
+    if (assign)
+    {
+      if (peer_endpoint_)
+        peer_endpoint_->resize(addrlen_);
+      if (!peer_.assign(protocol_, new_socket_holder.get(), this->ec_))
+        new_socket_holder.release();
+    }
+  }
+
+private:
+  io_uring_service& service_;
+  socket_type socket_;
+  socket_ops::state_type state_;
+  Socket& peer_;
+  Protocol protocol_;
+  typename Protocol::endpoint* peer_endpoint_;
+  socklen_t addrlen_;
+};
+
+template <typename Socket, typename Protocol, typename Handler>
+class io_uring_socket_accept_op :
+  public io_uring_socket_accept_op_base<Socket, Protocol>
+{
+public:
+  BOOST_ASIO_DEFINE_HANDLER_PTR(io_uring_socket_accept_op);
+
+  io_uring_socket_accept_op(io_uring_service& service, socket_type socket,
+      socket_ops::state_type state, Socket& peer, const Protocol& protocol,
+      typename Protocol::endpoint* peer_endpoint, Handler& handler)
+    : io_uring_socket_accept_op_base<Socket, Protocol>(service, socket, state,
+        peer, protocol, peer_endpoint, &io_uring_socket_accept_op::do_complete),
+      handler_(BOOST_ASIO_MOVE_CAST(Handler)(handler))
+  {
+  }
+
+  static void do_complete(io_service_impl* owner, operation* base,
+      const boost::system::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    io_uring_socket_accept_op* o(static_cast<io_uring_socket_accept_op*>(base));
+    if (owner && o->restart_if_aborted())
+      return;
+
+    // Take ownership of the handler object.
+    ptr p = { boost::asio::detail::addressof(o->handler_), o, o };
+
+    BOOST_ASIO_HANDLER_COMPLETION((o));
+
+    o->assign_peer(owner != 0);
+
+    // Make a copy of the handler so that the memory can be deallocated before
+    // the upcall is made. Even if we're not about to make an upcall, a
+    // sub-object of the handler may be the true owner of the memory associated
+    // with the handler. Consequently, a local copy of the handler is required
+    // to ensure that any owning sub-object remains valid until after we have
+    // deallocated the memory here.
+    detail::binder1<Handler, boost::system::error_code>
+      handler(o->handler_, o->ec_);
+    p.h = boost::asio::detail::addressof(handler.handler_);
+    p.reset();
+
+    // Make the upcall if required.
+    if (owner)
+    {
+      fenced_block b(fenced_block::half);
+      BOOST_ASIO_HANDLER_INVOCATION_BEGIN((handler.arg1_));
+      boost_asio_handler_invoke_helpers::invoke(handler, handler.handler_);
+      BOOST_ASIO_HANDLER_INVOCATION_END;
+    }
+  }
+
+private:
+  Handler handler_;
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // defined(BOOST_ASIO_HAS_IO_URING)
+
+#endif // BOOST_ASIO_DETAIL_IO_URING_SOCKET_ACCEPT_OP_HPP
@@ -0,0 +1,146 @@
+//
+// detail/io_uring_socket_send_op.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_IO_URING_SOCKET_SEND_OP_HPP
+#define BOOST_ASIO_DETAIL_IO_URING_SOCKET_SEND_OP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+
+#if defined(BOOST_ASIO_HAS_IO_URING)
+
+#include <boost/asio/detail/addressof.hpp>
+#include <boost/asio/detail/bind_handler.hpp>
+#include <boost/asio/detail/buffer_sequence_adapter.hpp>
+#include <boost/asio/detail/fenced_block.hpp>
+#include <boost/asio/detail/io_uring_operation.hpp>
+#include <boost/asio/detail/socket_ops.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+template <typename ConstBufferSequence>
+class io_uring_socket_send_op_base : public io_uring_operation
+{
+public:
+  io_uring_socket_send_op_base(socket_type socket,
+      const ConstBufferSequence& buffers,
+      socket_base::message_flags flags, func_type complete_func)
+    : io_uring_operation(&io_uring_socket_send_op_base::do_prepare,
+        complete_func),
+      socket_(socket),
+      bufs_(buffers),
+      flags_(flags)
+  {
+  }
+
+  static void do_prepare(io_uring_operation* base, ::io_uring_sqe* sqe)
+  {
+    io_uring_socket_send_op_base* o(
+        static_cast<io_uring_socket_send_op_base*>(base));
+
+    int flags = o->flags_;
+#if defined(__linux__)
+    flags |= MSG_NOSIGNAL;
+#endif // defined(__linux__)
+
+    sqe->fd = o->socket_;
+    sqe->msg_flags = flags;
+    if (o->bufs_.count() == 1)
+    {
+      sqe->opcode = IORING_OP_SEND;
+      sqe->addr = reinterpret_cast<__u64>(o->bufs_.buffers()[0].iov_base);
+      sqe->len = static_cast<__u32>(o->bufs_.buffers()[0].iov_len);
+    }
+    else
+    {
+      // The message header must remain valid until the operation completes.
+      o->msg_ = msghdr();
+      o->msg_.msg_iov = o->bufs_.buffers();
+      o->msg_.msg_iovlen = o->bufs_.count();
+      sqe->opcode = IORING_OP_SENDMSG;
+      sqe->addr = reinterpret_cast<__u64>(&o->msg_);
+      sqe->len = 1;
+    }
+  }
+
+private:
+  socket_type socket_;
+  buffer_sequence_adapter<boost::asio::const_buffer, ConstBufferSequence> bufs_;
+  socket_base::message_flags flags_;
+  msghdr msg_;
+};
+
+template <typename ConstBufferSequence, typename Handler>
+class io_uring_socket_send_op :
+  public io_uring_socket_send_op_base<ConstBufferSequence>
+{
+public:
+  BOOST_ASIO_DEFINE_HANDLER_PTR(io_uring_socket_send_op);
+
+  io_uring_socket_send_op(socket_type socket,
+      const ConstBufferSequence& buffers,
+      socket_base::message_flags flags, Handler& handler)
+    : io_uring_socket_send_op_base<ConstBufferSequence>(socket,
+        buffers, flags, &io_uring_socket_send_op::do_complete),
+      handler_(BOOST_ASIO_MOVE_CAST(Handler)(handler))
+  {
+  }
+
+  static void do_complete(io_service_impl* owner, operation* base,
+      const boost::system::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    // Take ownership of the handler object.
+    io_uring_socket_send_op* o(static_cast<io_uring_socket_send_op*>(base));
+    ptr p = { boost::asio::detail::addressof(o->handler_), o, o };
+
+    BOOST_ASIO_HANDLER_COMPLETION((o));
+
+    // Make a copy of the handler so that the memory can be deallocated before
+    // the upcall is made. Even if we're not about to make an upcall, a
+    // sub-object of the handler may be the true owner of the memory associated
+    // with the handler. Consequently, a local copy of the handler is required
+    // to ensure that any owning sub-object remains valid until after we have
+    // deallocated the memory here.
+    detail::binder2<Handler, boost::system::error_code, std::size_t>
+      handler(o->handler_, o->ec_, o->bytes_transferred_);
+    p.h = boost::asio::detail::addressof(handler.handler_);
+    p.reset();
+
+    // Make the upcall if required.
+    if (owner)
+    {
+      fenced_block b(fenced_block::half);
+      BOOST_ASIO_HANDLER_INVOCATION_BEGIN((handler.arg1_, handler.arg2_));
+      boost_asio_handler_invoke_helpers::invoke(handler, handler.handler_);
+      BOOST_ASIO_HANDLER_INVOCATION_END;
+    }
+  }
+
+private:
+  Handler handler_;
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // defined(BOOST_ASIO_HAS_IO_URING)
+
+#endif // BOOST_ASIO_DETAIL_IO_URING_SOCKET_SEND_OP_HPP
@@ -0,0 +1,267 @@
+//
+// detail/io_uring_socket_service.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_IO_URING_SOCKET_SERVICE_HPP
+#define BOOST_ASIO_DETAIL_IO_URING_SOCKET_SERVICE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+
+#if defined(BOOST_ASIO_HAS_IO_URING)
+
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/error.hpp>
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/socket_base.hpp>
+#include <boost/asio/detail/addressof.hpp>
+#include <boost/asio/detail/buffer_sequence_adapter.hpp>
+#include <boost/asio/detail/io_uring_service.hpp>
+#include <boost/asio/detail/io_uring_socket_accept_op.hpp>
+#include <boost/asio/detail/io_uring_socket_connect_op.hpp>
+#include <boost/asio/detail/io_uring_socket_recv_op.hpp>
+#include <boost/asio/detail/io_uring_socket_send_op.hpp>
+#include <boost/asio/detail/reactive_socket_service.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+// A socket service that performs stream operations using io_uring, and uses
+// the reactor for everything else. Operations that io_uring cannot express,
+// such as waiting for readiness, receiving out-of-band data or zero-copy
+// sends, and all operations when io_uring is unavailable at run time, are
+// delegated to the reactive implementation.
+template <typename Protocol>
+class io_uring_socket_service :
+  public reactive_socket_service<Protocol>
+{
+public:
+  // The protocol type.
+  typedef Protocol protocol_type;
+
+  // The endpoint type.
+  typedef typename Protocol::endpoint endpoint_type;
+
+  // The native type of a socket.
+  typedef socket_type native_handle_type;
+
+  // The implementation type of the socket.
+  typedef typename reactive_socket_service<Protocol>::implementation_type
+    implementation_type;
+
+  // The base implementation type of the socket.
+  typedef reactive_socket_service_base::base_implementation_type
+    base_implementation_type;
+
+  // Constructor.
+  io_uring_socket_service(boost::asio::io_service& io_service)
+    : reactive_socket_service<Protocol>(io_service),
+      io_uring_service_(use_service<io_uring_service>(io_service))
+  {
+  }
+
+  // Move-assign from another socket implementation.
+  void move_assign(implementation_type& impl,
+      reactive_socket_service_base& other_service,
+      implementation_type& other_impl)
+  {
+    if (impl.socket_ != invalid_socket)
+      io_uring_service_.cancel_ops(impl.socket_);
+    reactive_socket_service<Protocol>::move_assign(
+        impl, other_service, other_impl);
+  }
+
+  // Destroy a socket implementation.
+  void destroy(base_implementation_type& impl)
+  {
+    if (impl.socket_ != invalid_socket)
+      io_uring_service_.cancel_ops(impl.socket_);
+    reactive_socket_service_base::destroy(impl);
+  }
+
+  // Destroy a socket implementation.
+  boost::system::error_code close(base_implementation_type& impl,
+      boost::system::error_code& ec)
+  {
+    if (impl.socket_ != invalid_socket)
+      io_uring_service_.cancel_ops(impl.socket_);
+    return reactive_socket_service_base::close(impl, ec);
+  }
+
+  // Cancel all operations associated with the socket.
+  boost::system::error_code cancel(base_implementation_type& impl,
+      boost::system::error_code& ec)
+  {
+    if (impl.socket_ != invalid_socket)
+      io_uring_service_.cancel_ops(impl.socket_);
+    return reactive_socket_service_base::cancel(impl, ec);
+  }
+
+  // Start an asynchronous send. The data being sent must be valid for the
+  // lifetime of the asynchronous operation.
+  template <typename ConstBufferSequence, typename Handler>
+  void async_send(base_implementation_type& impl,
+      const ConstBufferSequence& buffers,
+      socket_base::message_flags flags, Handler handler)
+  {
+    if (!io_uring_service_.is_available()
+        || (flags & socket_base::message_zero_copy)
+        || ((impl.state_ & socket_ops::stream_oriented)
+          && buffer_sequence_adapter<boost::asio::const_buffer,
+            ConstBufferSequence>::all_empty(buffers)))
+    {
+      reactive_socket_service_base::async_send(impl, buffers, flags, handler);
+      return;
+    }
+
+    bool is_continuation =
+      boost_asio_handler_cont_helpers::is_continuation(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef io_uring_socket_send_op<ConstBufferSequence, Handler> op;
+    typename op::ptr p = { boost::asio::detail::addressof(handler),
+      boost_asio_handler_alloc_helpers::allocate(
+        sizeof(op), handler), 0 };
+    p.p = new (p.v) op(impl.socket_, buffers, flags, handler);
+
+    BOOST_ASIO_HANDLER_CREATION((p.p, "socket", &impl, "async_send"));
+
+    io_uring_service_.start_op(p.p, is_continuation);
+    p.v = p.p = 0;
+  }
+
+  // Start an asynchronous wait until data can be sent without blocking.
+  template <typename Handler>
+  void async_send(base_implementation_type& impl, const null_buffers& buffers,
+      socket_base::message_flags flags, Handler handler)
+  {
+    reactive_socket_service_base::async_send(impl, buffers, flags, handler);
+  }
+
+  // Start an asynchronous receive. The buffer for the data being received
+  // must be valid for the lifetime of the asynchronous operation.
+  template <typename MutableBufferSequence, typename Handler>
+  void async_receive(base_implementation_type& impl,
+      const MutableBufferSequence& buffers,
+      socket_base::message_flags flags, Handler handler)
+  {
+    if (!io_uring_service_.is_available()
+        || (flags & socket_base::message_out_of_band)
+        || ((impl.state_ & socket_ops::stream_oriented)
+          && buffer_sequence_adapter<boost::asio::mutable_buffer,
+            MutableBufferSequence>::all_empty(buffers)))
+    {
+      reactive_socket_service_base::async_receive(
+          impl, buffers, flags, handler);
+      return;
+    }
+
+    bool is_continuation =
+      boost_asio_handler_cont_helpers::is_continuation(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef io_uring_socket_recv_op<MutableBufferSequence, Handler> op;
+    typename op::ptr p = { boost::asio::detail::addressof(handler),
+      boost_asio_handler_alloc_helpers::allocate(
+        sizeof(op), handler), 0 };
+    p.p = new (p.v) op(impl.socket_, impl.state_, buffers, flags, handler);
+
+    BOOST_ASIO_HANDLER_CREATION((p.p, "socket", &impl, "async_receive"));
+
+    io_uring_service_.start_op(p.p, is_continuation);
+    p.v = p.p = 0;
+  }
+
+  // Wait until data can be received without blocking.
+  template <typename Handler>
+  void async_receive(base_implementation_type& impl,
+      const null_buffers& buffers, socket_base::message_flags flags,
+      Handler handler)
+  {
+    reactive_socket_service_base::async_receive(impl, buffers, flags, handler);
+  }
+
+  // Start an asynchronous accept. The peer and peer_endpoint objects
+  // must be valid until the accept's handler is invoked.
+  template <typename Socket, typename Handler>
+  void async_accept(implementation_type& impl, Socket& peer,
+      endpoint_type* peer_endpoint, Handler& handler)
+  {
+    if (!io_uring_service_.is_available() || peer.is_open())
+    {
+      reactive_socket_service<Protocol>::async_accept(
+          impl, peer, peer_endpoint, handler);
+      return;
+    }
+
+    bool is_continuation =
+      boost_asio_handler_cont_helpers::is_continuation(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef io_uring_socket_accept_op<Socket, Protocol, Handler> op;
+    typename op::ptr p = { boost::asio::detail::addressof(handler),
+      boost_asio_handler_alloc_helpers::allocate(
+        sizeof(op), handler), 0 };
+    p.p = new (p.v) op(io_uring_service_, impl.socket_, impl.state_, peer,
+        impl.protocol_, peer_endpoint, handler);
+
+    BOOST_ASIO_HANDLER_CREATION((p.p, "socket", &impl, "async_accept"));
+
+    io_uring_service_.start_op(p.p, is_continuation);
+    p.v = p.p = 0;
+  }
+
+  // Start an asynchronous connect.
+  template <typename Handler>
+  void async_connect(implementation_type& impl,
+      const endpoint_type& peer_endpoint, Handler& handler)
+  {
+    if (!io_uring_service_.is_available())
+    {
+      reactive_socket_service<Protocol>::async_connect(
+          impl, peer_endpoint, handler);
+      return;
+    }
+
+    bool is_continuation =
+      boost_asio_handler_cont_helpers::is_continuation(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef io_uring_socket_connect_op<Protocol, Handler> op;
+    typename op::ptr p = { boost::asio::detail::addressof(handler),
+      boost_asio_handler_alloc_helpers::allocate(
+        sizeof(op), handler), 0 };
+    p.p = new (p.v) op(impl.socket_, peer_endpoint, handler);
+
+    BOOST_ASIO_HANDLER_CREATION((p.p, "socket", &impl, "async_connect"));
+
+    io_uring_service_.start_op(p.p, is_continuation);
+    p.v = p.p = 0;
+  }
+
+private:
+  // The service that submits operations to the kernel.
+  io_uring_service& io_uring_service_;
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // defined(BOOST_ASIO_HAS_IO_URING)
+
+#endif // BOOST_ASIO_DETAIL_IO_URING_SOCKET_SERVICE_HPP
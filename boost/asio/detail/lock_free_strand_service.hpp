@@ -0,0 +1,205 @@
+//
+// detail/lock_free_strand_service.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_LOCK_FREE_STRAND_SERVICE_HPP
+#define BOOST_ASIO_DETAIL_LOCK_FREE_STRAND_SERVICE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+
+#if defined(BOOST_ASIO_HAS_LOCK_FREE_STRAND)
+
+#include <atomic>
+#include <cstddef>
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/detail/atomic_count.hpp>
+#include <boost/asio/detail/mutex.hpp>
+#include <boost/asio/detail/operation.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+// Strand service implementation in which each strand has its own state, and
+// handlers waiting on a strand are held in an intrusive multiple-producer,
+// single-consumer queue. Posting a handler to a strand is a single atomic
+// exchange on the tail of the queue. The strand's "locked" state is encoded
+// in the low bit of the tail pointer, so the thread whose exchange finds the
+// strand idle becomes responsible for scheduling it.
+class lock_free_strand_service
+  : public boost::asio::detail::service_base<lock_free_strand_service>
+{
+private:
+  // Helper class to release or re-post the strand on exit.
+  struct on_strand_exit;
+
+  // Base class for operations waiting on a strand.
+  class strand_op
+    : public operation
+  {
+  protected:
+    friend class lock_free_strand_service;
+
+    strand_op(func_type func)
+      : operation(func),
+        strand_next_(0)
+    {
+    }
+
+    // The next operation in the strand's waiting queue.
+    std::atomic<strand_op*> strand_next_;
+  };
+
+  // Operation used as the permanent placeholder node in a strand's queue.
+  class stub_op
+    : public strand_op
+  {
+  public:
+    stub_op()
+      : strand_op(0)
+    {
+    }
+  };
+
+  // Operation that wraps a handler posted to a strand.
+  template <typename Handler>
+  class handler_op;
+
+public:
+
+  // The underlying implementation of a strand.
+  class strand_impl
+    : public operation
+  {
+  public:
+    strand_impl(lock_free_strand_service* service);
+
+  private:
+    // Only this service will have access to the internal values.
+    friend class lock_free_strand_service;
+    friend struct on_strand_exit;
+
+    // The service that owns the implementation, or 0 if the service has been
+    // destroyed.
+    lock_free_strand_service* service_;
+
+    // The last operation in the waiting queue. The low bit is set when the
+    // strand is idle, i.e. no handler holds the strand and the strand has not
+    // been scheduled.
+    std::atomic<std::size_t> tail_;
+
+    // The next operation to be dequeued. Accessed only by the thread that
+    // holds the strand.
+    strand_op* head_;
+
+    // Placeholder that allows the last real operation to be dequeued.
+    stub_op stub_;
+
+    // One reference for each strand object, plus one while the strand is not
+    // idle.
+    atomic_count ref_count_;
+
+    // Pointers to adjacent implementations in the service's list.
+    strand_impl* next_;
+    strand_impl* prev_;
+  };
+
+  typedef strand_impl* implementation_type;
+
+  // Construct a new strand service for the specified io_service.
+  BOOST_ASIO_DECL explicit lock_free_strand_service(
+      boost::asio::io_service& io_service);
+
+  // Detach all strand implementations, destroying those that are no longer
+  // referenced by a strand object.
+  BOOST_ASIO_DECL ~lock_free_strand_service();
+
+  // Destroy all user-defined handler objects owned by the service.
+  BOOST_ASIO_DECL void shutdown_service();
+
+  // Construct a new strand implementation.
+  BOOST_ASIO_DECL void construct(implementation_type& impl);
+
+  // Construct a strand implementation that shares state with another.
+  BOOST_ASIO_DECL void copy_construct(implementation_type& impl,
+      const implementation_type& other_impl);
+
+  // Release a reference to a strand implementation. Does not access the
+  // service, so may be called after the service has been destroyed.
+  BOOST_ASIO_DECL static void destroy(implementation_type& impl);
+
+  // Request the io_service to invoke the given handler.
+  template <typename Handler>
+  void dispatch(implementation_type& impl, Handler& handler);
+
+  // Request the io_service to invoke the given handler and return immediately.
+  template <typename Handler>
+  void post(implementation_type& impl, Handler& handler);
+
+  // Determine whether the strand is running in the current thread.
+  BOOST_ASIO_DECL bool running_in_this_thread(
+      const implementation_type& impl) const;
+
+private:
+  // Helper function to dispatch a handler. Returns true if the handler should
+  // be dispatched immediately.
+  BOOST_ASIO_DECL bool do_dispatch(implementation_type& impl, strand_op* op);
+
+  // Helper function to post a handler.
+  BOOST_ASIO_DECL void do_post(implementation_type& impl,
+      strand_op* op, bool is_continuation);
+
+  BOOST_ASIO_DECL static void do_complete(io_service_impl* owner,
+      operation* base, const boost::system::error_code& ec,
+      std::size_t bytes_transferred);
+
+  // Dequeue the next waiting operation. Must only be called by the thread
+  // holding the strand. Returns 0 if the queue is empty, or if an operation
+  // is still being linked into the queue by another thread.
+  BOOST_ASIO_DECL static strand_op* dequeue(strand_impl* impl);
+
+  // Make the strand idle if there are no waiting operations, otherwise
+  // schedule it to run again. Must only be called by the thread holding the
+  // strand.
+  BOOST_ASIO_DECL static void release(io_service_impl& owner,
+      strand_impl* impl, bool is_continuation);
+
+  // Drop a reference to an implementation, destroying it if it was the last.
+  BOOST_ASIO_DECL static void release_ref(strand_impl* impl);
+
+  // The io_service implementation used to post completions.
+  io_service_impl& io_service_;
+
+  // Mutex to protect access to the linked list of implementations.
+  boost::asio::detail::mutex mutex_;
+
+  // The head of a linked list of all implementations.
+  strand_impl* impl_list_;
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#include <boost/asio/detail/impl/lock_free_strand_service.hpp>
+#if defined(BOOST_ASIO_HEADER_ONLY)
+# include <boost/asio/detail/impl/lock_free_strand_service.ipp>
+#endif // defined(BOOST_ASIO_HEADER_ONLY)
+
+#endif // defined(BOOST_ASIO_HAS_LOCK_FREE_STRAND)
+
+#endif // BOOST_ASIO_DETAIL_LOCK_FREE_STRAND_SERVICE_HPP
@@ -0,0 +1,210 @@
+//
+// detail/metrics_collector.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_METRICS_COLLECTOR_HPP
+#define BOOST_ASIO_DETAIL_METRICS_COLLECTOR_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <cstddef>
+#include <boost/asio/detail/atomic_count.hpp>
+#include <boost/asio/detail/cstdint.hpp>
+#include <boost/asio/detail/noncopyable.hpp>
+
+#if defined(BOOST_ASIO_HAS_STD_CHRONO)
+# include <chrono>
+#elif defined(BOOST_ASIO_WINDOWS) || defined(__CYGWIN__)
+# include <boost/asio/detail/socket_types.hpp>
+#else
+# include <time.h>
+#endif
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+// Counters and histograms describing the activity of an io_service. The
+// counters are updated with atomic operations and may be read from any thread
+// while the io_service is running. Nothing that needs a clock reading is
+// recorded unless collection has been enabled.
+class metrics_collector
+  : private noncopyable
+{
+public:
+  enum
+  {
+    // The number of buckets in each histogram. Bucket 0 counts durations of
+    // less than 2 nanoseconds, bucket i counts durations of at least 2^i
+    // nanoseconds and less than 2^(i+1), and the last bucket counts all
+    // longer durations.
+    histogram_buckets = 32
+  };
+
+  // A single counter that may be default constructed in an array.
+  struct counter
+  {
+    counter() : value(0) {}
+    atomic_count value;
+  };
+
+  // Constructor.
+  metrics_collector()
+    : enabled_(0),
+      queue_depth_(0),
+      handlers_executed_(0),
+      idle_time_(0)
+  {
+  }
+
+  // Start or stop the collection of timing information.
+  void enable(bool on)
+  {
+    if (on && enabled_ == 0)
+      ++enabled_;
+    else if (!on && enabled_ != 0)
+      --enabled_;
+  }
+
+  // Whether timing information is being collected.
+  bool enabled() const
+  {
+    return enabled_ != 0;
+  }
+
+  // Obtain the current time in nanoseconds from an unspecified epoch. The
+  // value is never 0, so that 0 may be used to mean "no time recorded".
+  static uint64_t now()
+  {
+#if defined(BOOST_ASIO_HAS_STD_CHRONO)
+# if defined(BOOST_ASIO_HAS_STD_CHRONO_MONOTONIC_CLOCK)
+    typedef std::chrono::monotonic_clock clock_type;
+# else // defined(BOOST_ASIO_HAS_STD_CHRONO_MONOTONIC_CLOCK)
+    typedef std::chrono::steady_clock clock_type;
+# endif // defined(BOOST_ASIO_HAS_STD_CHRONO_MONOTONIC_CLOCK)
+    return 1 + static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+          clock_type::now().time_since_epoch()).count());
+#elif defined(BOOST_ASIO_WINDOWS) || defined(__CYGWIN__)
+    LARGE_INTEGER frequency, counter;
+    ::QueryPerformanceFrequency(&frequency);
+    ::QueryPerformanceCounter(&counter);
+    return 1 + static_cast<uint64_t>(static_cast<double>(counter.QuadPart)
+        * 1000000000.0 / static_cast<double>(frequency.QuadPart));
+#else
+    timespec ts;
+    ::clock_gettime(CLOCK_MONOTONIC, &ts);
+    return 1 + static_cast<uint64_t>(ts.tv_sec) * 1000000000
+      + static_cast<uint64_t>(ts.tv_nsec);
+#endif
+  }
+
+  // Record that a handler has been queued.
+  void handler_queued()
+  {
+    ++queue_depth_;
+  }
+
+  // Record that a queued handler has been dequeued after waiting the given
+  // number of nanoseconds.
+  void handler_dequeued(uint64_t latency)
+  {
+    --queue_depth_;
+    ++queue_latency_[bucket(latency)].value;
+  }
+
+  // Record that a handler took the given number of nanoseconds to execute.
+  void handler_executed(uint64_t duration)
+  {
+    ++handlers_executed_;
+    ++execution_time_[bucket(duration)].value;
+  }
+
+  // Record that a thread was idle for the given number of nanoseconds.
+  void thread_idle(uint64_t duration)
+  {
+    increment(idle_time_, static_cast<long>(duration / 1000));
+  }
+
+  // The number of handlers queued and not yet started.
+  std::size_t queue_depth() const
+  {
+    long depth = queue_depth_;
+    return depth > 0 ? static_cast<std::size_t>(depth) : 0;
+  }
+
+  // The number of handlers whose execution has been timed.
+  std::size_t handlers_executed() const
+  {
+    return static_cast<std::size_t>(static_cast<long>(handlers_executed_));
+  }
+
+  // The total time, in microseconds, that threads have spent waiting for work.
+  std::size_t idle_time() const
+  {
+    return static_cast<std::size_t>(static_cast<long>(idle_time_));
+  }
+
+  // Copy out the histogram of handler queueing latency.
+  void get_queue_latency(std::size_t* buckets) const
+  {
+    for (std::size_t i = 0; i < histogram_buckets; ++i)
+      buckets[i] = static_cast<std::size_t>(
+          static_cast<long>(queue_latency_[i].value));
+  }
+
+  // Copy out the histogram of handler execution time.
+  void get_execution_time(std::size_t* buckets) const
+  {
+    for (std::size_t i = 0; i < histogram_buckets; ++i)
+      buckets[i] = static_cast<std::size_t>(
+          static_cast<long>(execution_time_[i].value));
+  }
+
+private:
+  // Determine the histogram bucket for a duration.
+  static std::size_t bucket(uint64_t duration)
+  {
+    std::size_t i = 0;
+    while ((duration >>= 1) != 0 && i < histogram_buckets - 1)
+      ++i;
+    return i;
+  }
+
+  // Non-zero when timing information is to be collected.
+  atomic_count enabled_;
+
+  // The number of handlers queued and not yet started.
+  atomic_count queue_depth_;
+
+  // The number of handlers whose execution has been timed.
+  atomic_count handlers_executed_;
+
+  // The total time, in microseconds, that threads have spent idle.
+  atomic_count idle_time_;
+
+  // Histogram of the time between queueing a handler and starting it.
+  counter queue_latency_[histogram_buckets];
+
+  // Histogram of the time taken to execute each handler.
+  counter execution_time_[histogram_buckets];
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_DETAIL_METRICS_COLLECTOR_HPP
@@ -0,0 +1,159 @@
+//
+// detail/reactive_socket_send_zero_copy_op.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_REACTIVE_SOCKET_SEND_ZERO_COPY_OP_HPP
+#define BOOST_ASIO_DETAIL_REACTIVE_SOCKET_SEND_ZERO_COPY_OP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+
+#if defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+
+#include <boost/asio/detail/addressof.hpp>
+#include <boost/asio/detail/bind_handler.hpp>
+#include <boost/asio/detail/buffer_sequence_adapter.hpp>
+#include <boost/asio/detail/fenced_block.hpp>
+#include <boost/asio/detail/reactor_op.hpp>
+#include <boost/asio/detail/socket_ops.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+// Sends data with MSG_ZEROCOPY. The kernel transmits directly from the caller's
+// buffers, so the operation is not complete until the kernel reports, through
+// the socket's error queue, that it no longer refers to them. The operation
+// remains at the front of the reactor's write queue until then, so there is
+// at most one outstanding zero-copy send per socket and the first
+// notification received must belong to it.
+template <typename ConstBufferSequence>
+class reactive_socket_send_zero_copy_op_base : public reactor_op
+{
+public:
+  reactive_socket_send_zero_copy_op_base(socket_type socket,
+      const ConstBufferSequence& buffers,
+      socket_base::message_flags flags, func_type complete_func)
+    : reactor_op(&reactive_socket_send_zero_copy_op_base::do_perform,
+        complete_func),
+      socket_(socket),
+      buffers_(buffers),
+      flags_(flags),
+      sent_(false)
+  {
+  }
+
+  static bool do_perform(reactor_op* base)
+  {
+    reactive_socket_send_zero_copy_op_base* o(
+        static_cast<reactive_socket_send_zero_copy_op_base*>(base));
+
+    if (!o->sent_)
+    {
+      buffer_sequence_adapter<boost::asio::const_buffer,
+          ConstBufferSequence> bufs(o->buffers_);
+
+      if (!socket_ops::non_blocking_send(o->socket_,
+            bufs.buffers(), bufs.count(), o->flags_,
+            o->ec_, o->bytes_transferred_))
+        return false;
+
+      // The kernel refuses zero-copy sends once the socket has pinned too
+      // many pages. Copy the data instead, which needs no notification.
+      if (o->ec_ == boost::asio::error::no_buffer_space)
+      {
+        return socket_ops::non_blocking_send(o->socket_,
+            bufs.buffers(), bufs.count(), o->flags_ & ~message_zero_copy,
+            o->ec_, o->bytes_transferred_);
+      }
+
+      // The kernel only sends a notification for a successful send.
+      if (o->ec_ || o->bytes_transferred_ == 0)
+        return true;
+
+      o->sent_ = true;
+    }
+
+    return socket_ops::non_blocking_recv_zero_copy_notification(
+        o->socket_, o->ec_);
+  }
+
+private:
+  socket_type socket_;
+  ConstBufferSequence buffers_;
+  socket_base::message_flags flags_;
+  bool sent_;
+};
+
+template <typename ConstBufferSequence, typename Handler>
+class reactive_socket_send_zero_copy_op :
+  public reactive_socket_send_zero_copy_op_base<ConstBufferSequence>
+{
+public:
+  BOOST_ASIO_DEFINE_HANDLER_PTR(reactive_socket_send_zero_copy_op);
+
+  reactive_socket_send_zero_copy_op(socket_type socket,
+      const ConstBufferSequence& buffers,
+      socket_base::message_flags flags, Handler& handler)
+    : reactive_socket_send_zero_copy_op_base<ConstBufferSequence>(socket,
+        buffers, flags, &reactive_socket_send_zero_copy_op::do_complete),
+      handler_(BOOST_ASIO_MOVE_CAST(Handler)(handler))
+  {
+  }
+
+  static void do_complete(io_service_impl* owner, operation* base,
+      const boost::system::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    // Take ownership of the handler object.
+    reactive_socket_send_zero_copy_op* o(
+        static_cast<reactive_socket_send_zero_copy_op*>(base));
+    ptr p = { boost::asio::detail::addressof(o->handler_), o, o };
+
+    BOOST_ASIO_HANDLER_COMPLETION((o));
+
+    // Make a copy of the handler so that the memory can be deallocated before
+    // the upcall is made. Even if we're not about to make an upcall, a
+    // sub-object of the handler may be the true owner of the memory associated
+    // with the handler. Consequently, a local copy of the handler is required
+    // to ensure that any owning sub-object remains valid until after we have
+    // deallocated the memory here.
+    detail::binder2<Handler, boost::system::error_code, std::size_t>
+      handler(o->handler_, o->ec_, o->bytes_transferred_);
+    p.h = boost::asio::detail::addressof(handler.handler_);
+    p.reset();
+
+    // Make the upcall if required.
+    if (owner)
+    {
+      fenced_block b(fenced_block::half);
+      BOOST_ASIO_HANDLER_INVOCATION_BEGIN((handler.arg1_, handler.arg2_));
+      boost_asio_handler_invoke_helpers::invoke(handler, handler.handler_);
+      BOOST_ASIO_HANDLER_INVOCATION_END;
+    }
+  }
+
+private:
+  Handler handler_;
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+
+#endif // BOOST_ASIO_DETAIL_REACTIVE_SOCKET_SEND_ZERO_COPY_OP_HPP
@@ -0,0 +1,148 @@
+//
+// detail/reactive_socket_sendmmsg_op.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_REACTIVE_SOCKET_SENDMMSG_OP_HPP
+#define BOOST_ASIO_DETAIL_REACTIVE_SOCKET_SENDMMSG_OP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+
+#if defined(BOOST_ASIO_HAS_MMSG)
+
+#include <boost/asio/detail/addressof.hpp>
+#include <boost/asio/detail/bind_handler.hpp>
+#include <boost/asio/detail/datagram_slot_adapter.hpp>
+#include <boost/asio/detail/fenced_block.hpp>
+#include <boost/asio/detail/reactor_op.hpp>
+#include <boost/asio/detail/socket_ops.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+// Sends every datagram in the array, using as many calls to sendmmsg() as
+// necessary. The operation stops at the first datagram that cannot be sent.
+template <typename Endpoint>
+class reactive_socket_sendmmsg_op_base : public reactor_op
+{
+public:
+  typedef datagram_slot<Endpoint, boost::asio::const_buffer> slot_type;
+
+  reactive_socket_sendmmsg_op_base(socket_type socket, slot_type* slots,
+      std::size_t count, socket_base::message_flags flags,
+      func_type complete_func)
+    : reactor_op(&reactive_socket_sendmmsg_op_base::do_perform, complete_func),
+      socket_(socket),
+      slots_(slots),
+      count_(count),
+      flags_(flags)
+  {
+  }
+
+  static bool do_perform(reactor_op* base)
+  {
+    reactive_socket_sendmmsg_op_base* o(
+        static_cast<reactive_socket_sendmmsg_op_base*>(base));
+
+    while (o->bytes_transferred_ < o->count_)
+    {
+      datagram_slot_adapter<Endpoint, boost::asio::const_buffer> msgs(
+          o->slots_ + o->bytes_transferred_,
+          o->count_ - o->bytes_transferred_);
+
+      std::size_t messages = 0;
+      if (!socket_ops::non_blocking_sendmmsg(o->socket_,
+            msgs.messages(), msgs.count(), o->flags_, o->ec_, messages))
+        return false;
+
+      if (o->ec_)
+        return true;
+
+      msgs.complete(messages);
+      o->bytes_transferred_ += messages;
+    }
+
+    return true;
+  }
+
+private:
+  socket_type socket_;
+  slot_type* slots_;
+  std::size_t count_;
+  socket_base::message_flags flags_;
+};
+
+template <typename Endpoint, typename Handler>
+class reactive_socket_sendmmsg_op :
+  public reactive_socket_sendmmsg_op_base<Endpoint>
+{
+public:
+  BOOST_ASIO_DEFINE_HANDLER_PTR(reactive_socket_sendmmsg_op);
+
+  typedef datagram_slot<Endpoint, boost::asio::const_buffer> slot_type;
+
+  reactive_socket_sendmmsg_op(socket_type socket, slot_type* slots,
+      std::size_t count, socket_base::message_flags flags, Handler& handler)
+    : reactive_socket_sendmmsg_op_base<Endpoint>(socket, slots, count,
+        flags, &reactive_socket_sendmmsg_op::do_complete),
+      handler_(BOOST_ASIO_MOVE_CAST(Handler)(handler))
+  {
+  }
+
+  static void do_complete(io_service_impl* owner, operation* base,
+      const boost::system::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    // Take ownership of the handler object.
+    reactive_socket_sendmmsg_op* o(
+        static_cast<reactive_socket_sendmmsg_op*>(base));
+    ptr p = { boost::asio::detail::addressof(o->handler_), o, o };
+
+    BOOST_ASIO_HANDLER_COMPLETION((o));
+
+    // Make a copy of the handler so that the memory can be deallocated before
+    // the upcall is made. Even if we're not about to make an upcall, a
+    // sub-object of the handler may be the true owner of the memory associated
+    // with the handler. Consequently, a local copy of the handler is required
+    // to ensure that any owning sub-object remains valid until after we have
+    // deallocated the memory here.
+    detail::binder2<Handler, boost::system::error_code, std::size_t>
+      handler(o->handler_, o->ec_, o->bytes_transferred_);
+    p.h = boost::asio::detail::addressof(handler.handler_);
+    p.reset();
+
+    // Make the upcall if required.
+    if (owner)
+    {
+      fenced_block b(fenced_block::half);
+      BOOST_ASIO_HANDLER_INVOCATION_BEGIN((handler.arg1_, handler.arg2_));
+      boost_asio_handler_invoke_helpers::invoke(handler, handler.handler_);
+      BOOST_ASIO_HANDLER_INVOCATION_END;
+    }
+  }
+
+private:
+  Handler handler_;
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // defined(BOOST_ASIO_HAS_MMSG)
+
+#endif // BOOST_ASIO_DETAIL_REACTIVE_SOCKET_SENDMMSG_OP_HPP
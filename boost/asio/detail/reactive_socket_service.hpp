@@ -20,16 +20,20 @@
 #if !defined(BOOST_ASIO_HAS_IOCP)
 
 #include <boost/asio/buffer.hpp>
+#include <boost/asio/datagram_slot.hpp>
 #include <boost/asio/error.hpp>
 #include <boost/asio/io_service.hpp>
 #include <boost/asio/socket_base.hpp>
 #include <boost/asio/detail/addressof.hpp>
 #include <boost/asio/detail/buffer_sequence_adapter.hpp>
+#include <boost/asio/detail/datagram_slot_adapter.hpp>
 #include <boost/asio/detail/noncopyable.hpp>
 #include <boost/asio/detail/reactive_null_buffers_op.hpp>
 #include <boost/asio/detail/reactive_socket_accept_op.hpp>
 #include <boost/asio/detail/reactive_socket_connect_op.hpp>
 #include <boost/asio/detail/reactive_socket_recvfrom_op.hpp>
+#include <boost/asio/detail/reactive_socket_recvmmsg_op.hpp>
+#include <boost/asio/detail/reactive_socket_sendmmsg_op.hpp>
 #include <boost/asio/detail/reactive_socket_sendto_op.hpp>
 #include <boost/asio/detail/reactive_socket_service_base.hpp>
 #include <boost/asio/detail/reactor.hpp>
@@ -150,9 +154,14 @@ public:
   boost::system::error_code set_option(implementation_type& impl,
       const Option& option, boost::system::error_code& ec)
   {
-    socket_ops::setsockopt(impl.socket_, impl.state_,
-        option.level(impl.protocol_), option.name(impl.protocol_),
-        option.data(impl.protocol_), option.size(impl.protocol_), ec);
+    if (!set_reactor_option(impl, option.level(impl.protocol_),
+          option.name(impl.protocol_), option.data(impl.protocol_),
+          option.size(impl.protocol_), ec))
+    {
+      socket_ops::setsockopt(impl.socket_, impl.state_,
+          option.level(impl.protocol_), option.name(impl.protocol_),
+          option.data(impl.protocol_), option.size(impl.protocol_), ec);
+    }
     return ec;
   }
 
@@ -162,9 +171,14 @@ public:
       Option& option, boost::system::error_code& ec) const
   {
     std::size_t size = option.size(impl.protocol_);
-    socket_ops::getsockopt(impl.socket_, impl.state_,
-        option.level(impl.protocol_), option.name(impl.protocol_),
-        option.data(impl.protocol_), &size, ec);
+    if (!get_reactor_option(impl, option.level(impl.protocol_),
+          option.name(impl.protocol_), option.data(impl.protocol_),
+          &size, ec))
+    {
+      socket_ops::getsockopt(impl.socket_, impl.state_,
+          option.level(impl.protocol_), option.name(impl.protocol_),
+          option.data(impl.protocol_), &size, ec);
+    }
     if (!ec)
       option.resize(impl.protocol_, size);
     return ec;
@@ -364,6 +378,99 @@ public:
     p.v = p.p = 0;
   }
 
+#if defined(BOOST_ASIO_HAS_MMSG)
+  // The type of a slot for a batched receive.
+  typedef datagram_slot<endpoint_type, boost::asio::mutable_buffer>
+    receive_slot;
+
+  // The type of a slot for a batched send.
+  typedef datagram_slot<endpoint_type, boost::asio::const_buffer> send_slot;
+
+  // Send all of the given datagrams. Returns the number of datagrams sent,
+  // which is less than count only if an error occurred.
+  size_t send_many(implementation_type& impl, send_slot* slots,
+      std::size_t count, socket_base::message_flags flags,
+      boost::system::error_code& ec)
+  {
+    ec = boost::system::error_code();
+    std::size_t messages_sent = 0;
+    while (messages_sent < count)
+    {
+      datagram_slot_adapter<endpoint_type, boost::asio::const_buffer> msgs(
+          slots + messages_sent, count - messages_sent);
+      std::size_t messages = socket_ops::sync_sendmmsg(impl.socket_,
+          impl.state_, msgs.messages(), msgs.count(), flags, ec);
+      if (ec)
+        break;
+      msgs.complete(messages);
+      messages_sent += messages;
+    }
+    return messages_sent;
+  }
+
+  // Start an asynchronous send of all of the given datagrams. The slots, and
+  // the data they refer to, must be valid for the lifetime of the
+  // asynchronous operation.
+  template <typename Handler>
+  void async_send_many(implementation_type& impl, send_slot* slots,
+      std::size_t count, socket_base::message_flags flags, Handler& handler)
+  {
+    bool is_continuation =
+      boost_asio_handler_cont_helpers::is_continuation(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef reactive_socket_sendmmsg_op<endpoint_type, Handler> op;
+    typename op::ptr p = { boost::asio::detail::addressof(handler),
+      boost_asio_handler_alloc_helpers::allocate(
+        sizeof(op), handler), 0 };
+    p.p = new (p.v) op(impl.socket_, slots, count, flags, handler);
+
+    BOOST_ASIO_HANDLER_CREATION((p.p, "socket", &impl, "async_send_many"));
+
+    start_op(impl, reactor::write_op, p.p, is_continuation, true, count == 0);
+    p.v = p.p = 0;
+  }
+
+  // Receive one or more datagrams, waiting until at least one is available.
+  // Returns the number of slots filled.
+  size_t receive_many(implementation_type& impl, receive_slot* slots,
+      std::size_t count, socket_base::message_flags flags,
+      boost::system::error_code& ec)
+  {
+    datagram_slot_adapter<endpoint_type, boost::asio::mutable_buffer> msgs(
+        slots, count);
+    std::size_t messages = socket_ops::sync_recvmmsg(impl.socket_,
+        impl.state_, msgs.messages(), msgs.count(), flags, ec);
+    if (!ec)
+      msgs.complete(messages);
+    return messages;
+  }
+
+  // Start an asynchronous receive of one or more datagrams. The slots, and
+  // the buffers they refer to, must be valid for the lifetime of the
+  // asynchronous operation.
+  template <typename Handler>
+  void async_receive_many(implementation_type& impl, receive_slot* slots,
+      std::size_t count, socket_base::message_flags flags, Handler& handler)
+  {
+    bool is_continuation =
+      boost_asio_handler_cont_helpers::is_continuation(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef reactive_socket_recvmmsg_op<endpoint_type, Handler> op;
+    typename op::ptr p = { boost::asio::detail::addressof(handler),
+      boost_asio_handler_alloc_helpers::allocate(
+        sizeof(op), handler), 0 };
+    p.p = new (p.v) op(impl.socket_, slots, count, flags, handler);
+
+    BOOST_ASIO_HANDLER_CREATION((p.p, "socket",
+          &impl, "async_receive_many"));
+
+    start_op(impl, reactor::read_op, p.p, is_continuation, true, count == 0);
+    p.v = p.p = 0;
+  }
+#endif // defined(BOOST_ASIO_HAS_MMSG)
+
   // Accept a new connection.
   template <typename Socket>
   boost::system::error_code accept(implementation_type& impl,
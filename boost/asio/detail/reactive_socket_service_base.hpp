@@ -29,6 +29,8 @@
 #include <boost/asio/detail/reactive_socket_recv_op.hpp>
 #include <boost/asio/detail/reactive_socket_recvmsg_op.hpp>
 #include <boost/asio/detail/reactive_socket_send_op.hpp>
+#include <boost/asio/detail/reactive_socket_send_zero_copy_op.hpp>
+#include <boost/asio/detail/reactive_socket_sendfile_op.hpp>
 #include <boost/asio/detail/reactor.hpp>
 #include <boost/asio/detail/reactor_op.hpp>
 #include <boost/asio/detail/socket_holder.hpp>
@@ -179,6 +181,11 @@ public:
     buffer_sequence_adapter<boost::asio::const_buffer,
         ConstBufferSequence> bufs(buffers);
 
+#if defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+    // A synchronous send cannot wait for the kernel to release the buffers.
+    flags &= ~socket_base::message_zero_copy;
+#endif // defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+
     return socket_ops::sync_send(impl.socket_, impl.state_,
         bufs.buffers(), bufs.count(), flags, bufs.all_empty(), ec);
   }
@@ -200,6 +207,25 @@ public:
       const ConstBufferSequence& buffers,
       socket_base::message_flags flags, Handler handler)
   {
+#if defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+    if (flags & socket_base::message_zero_copy)
+    {
+      if (!(impl.state_ & socket_ops::stream_oriented)
+          || !buffer_sequence_adapter<boost::asio::const_buffer,
+            ConstBufferSequence>::all_empty(buffers))
+      {
+        if (enable_zero_copy(impl))
+        {
+          async_send_zero_copy(impl, buffers, flags, handler);
+          return;
+        }
+      }
+
+      // Fall back to copying the data.
+      flags &= ~socket_base::message_zero_copy;
+    }
+#endif // defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+
     bool is_continuation =
       boost_asio_handler_cont_helpers::is_continuation(handler);
 
@@ -219,6 +245,38 @@ public:
     p.v = p.p = 0;
   }
 
+#if defined(BOOST_ASIO_HAS_SENDFILE)
+  // Send part of a file to the peer. Returns the number of bytes sent.
+  size_t send_file(base_implementation_type& impl, int file,
+      uint64_t offset, std::size_t length, boost::system::error_code& ec)
+  {
+    return socket_ops::sync_sendfile(impl.socket_,
+        impl.state_, file, offset, length, ec);
+  }
+
+  // Start an asynchronous send of part of a file. The file must remain open
+  // until the handler is called.
+  template <typename Handler>
+  void async_send_file(base_implementation_type& impl, int file,
+      uint64_t offset, std::size_t length, Handler& handler)
+  {
+    bool is_continuation =
+      boost_asio_handler_cont_helpers::is_continuation(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef reactive_socket_sendfile_op<Handler> op;
+    typename op::ptr p = { boost::asio::detail::addressof(handler),
+      boost_asio_handler_alloc_helpers::allocate(
+        sizeof(op), handler), 0 };
+    p.p = new (p.v) op(impl.socket_, file, offset, length, handler);
+
+    BOOST_ASIO_HANDLER_CREATION((p.p, "socket", &impl, "async_send_file"));
+
+    start_op(impl, reactor::write_op, p.p, is_continuation, true, length == 0);
+    p.v = p.p = 0;
+  }
+#endif // defined(BOOST_ASIO_HAS_SENDFILE)
+
   // Start an asynchronous wait until data can be sent without blocking.
   template <typename Handler>
   void async_send(base_implementation_type& impl, const null_buffers&,
@@ -408,6 +466,47 @@ public:
   }
 
 protected:
+#if defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+  // Start an asynchronous send that completes when the kernel no longer
+  // refers to the data.
+  template <typename ConstBufferSequence, typename Handler>
+  void async_send_zero_copy(base_implementation_type& impl,
+      const ConstBufferSequence& buffers,
+      socket_base::message_flags flags, Handler& handler)
+  {
+    bool is_continuation =
+      boost_asio_handler_cont_helpers::is_continuation(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef reactive_socket_send_zero_copy_op<ConstBufferSequence, Handler> op;
+    typename op::ptr p = { boost::asio::detail::addressof(handler),
+      boost_asio_handler_alloc_helpers::allocate(
+        sizeof(op), handler), 0 };
+    p.p = new (p.v) op(impl.socket_, buffers, flags, handler);
+
+    BOOST_ASIO_HANDLER_CREATION((p.p, "socket", &impl, "async_send"));
+
+    start_op(impl, reactor::write_op, p.p, is_continuation, true, false);
+    p.v = p.p = 0;
+  }
+
+  // Enable zero-copy sends on the socket, if they are not already enabled.
+  // Returns false if the socket does not support them.
+  BOOST_ASIO_DECL bool enable_zero_copy(base_implementation_type& impl);
+#endif // defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+
+  // Set an option that is implemented by the reactor rather than the socket.
+  // Returns false if the option is not one of these.
+  BOOST_ASIO_DECL bool set_reactor_option(base_implementation_type& impl,
+      int level, int optname, const void* optval, std::size_t optlen,
+      boost::system::error_code& ec);
+
+  // Get an option that is implemented by the reactor rather than the socket.
+  // Returns false if the option is not one of these.
+  BOOST_ASIO_DECL bool get_reactor_option(
+      const base_implementation_type& impl, int level, int optname,
+      void* optval, std::size_t* optlen, boost::system::error_code& ec) const;
+
   // Open a new socket implementation.
   BOOST_ASIO_DECL boost::system::error_code do_open(
       base_implementation_type& impl, int af,
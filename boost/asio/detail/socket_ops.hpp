@@ -18,6 +18,7 @@
 #include <boost/asio/detail/config.hpp>
 
 #include <boost/system/error_code.hpp>
+#include <boost/asio/detail/cstdint.hpp>
 #include <boost/asio/detail/shared_ptr.hpp>
 #include <boost/asio/detail/socket_types.hpp>
 #include <boost/asio/detail/weak_ptr.hpp>
@@ -54,7 +55,10 @@ enum
   datagram_oriented = 32,
 
   // The socket may have been dup()-ed.
-  possible_dup = 64
+  possible_dup = 64,
+
+  // Zero-copy sends have been enabled on the socket.
+  zero_copy_enabled = 128
 };
 
 typedef unsigned char state_type;
@@ -216,6 +220,51 @@ BOOST_ASIO_DECL bool non_blocking_send(socket_type s,
 
 #endif // defined(BOOST_ASIO_HAS_IOCP)
 
+#if defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+
+BOOST_ASIO_DECL bool non_blocking_recv_zero_copy_notification(
+    socket_type s, boost::system::error_code& ec);
+
+#endif // defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+
+#if defined(BOOST_ASIO_HAS_SENDFILE)
+
+BOOST_ASIO_DECL signed_size_type sendfile(socket_type s, int file,
+    uint64_t& offset, size_t length, boost::system::error_code& ec);
+
+BOOST_ASIO_DECL size_t sync_sendfile(socket_type s, state_type state,
+    int file, uint64_t offset, size_t length, boost::system::error_code& ec);
+
+BOOST_ASIO_DECL bool non_blocking_sendfile(socket_type s,
+    int file, uint64_t& offset, size_t& remaining,
+    boost::system::error_code& ec, size_t& bytes_transferred);
+
+#endif // defined(BOOST_ASIO_HAS_SENDFILE)
+
+#if defined(BOOST_ASIO_HAS_MMSG)
+
+BOOST_ASIO_DECL int recvmmsg(socket_type s, mmsg_type* msgs,
+    size_t count, int flags, boost::system::error_code& ec);
+
+BOOST_ASIO_DECL size_t sync_recvmmsg(socket_type s, state_type state,
+    mmsg_type* msgs, size_t count, int flags, boost::system::error_code& ec);
+
+BOOST_ASIO_DECL bool non_blocking_recvmmsg(socket_type s,
+    mmsg_type* msgs, size_t count, int flags,
+    boost::system::error_code& ec, size_t& messages_transferred);
+
+BOOST_ASIO_DECL int sendmmsg(socket_type s, mmsg_type* msgs,
+    size_t count, int flags, boost::system::error_code& ec);
+
+BOOST_ASIO_DECL size_t sync_sendmmsg(socket_type s, state_type state,
+    mmsg_type* msgs, size_t count, int flags, boost::system::error_code& ec);
+
+BOOST_ASIO_DECL bool non_blocking_sendmmsg(socket_type s,
+    mmsg_type* msgs, size_t count, int flags,
+    boost::system::error_code& ec, size_t& messages_transferred);
+
+#endif // defined(BOOST_ASIO_HAS_MMSG)
+
 BOOST_ASIO_DECL signed_size_type sendto(socket_type s, const buf* bufs,
     size_t count, int flags, const socket_addr_type* addr,
     std::size_t addrlen, boost::system::error_code& ec);
@@ -69,6 +69,12 @@
 # include <netdb.h>
 # include <net/if.h>
 # include <limits.h>
+# if defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+#  include <linux/errqueue.h>
+# endif
+# if defined(BOOST_ASIO_HAS_MMSG)
+#  include <netinet/udp.h>
+# endif
 # if defined(__sun)
 #  include <sys/filio.h>
 #  include <sys/sockio.h>
@@ -164,6 +170,35 @@ const int message_peek = MSG_PEEK;
 const int message_out_of_band = MSG_OOB;
 const int message_do_not_route = MSG_DONTROUTE;
 const int message_end_of_record = MSG_EOR;
+# if defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+#  if defined(MSG_ZEROCOPY)
+const int message_zero_copy = MSG_ZEROCOPY;
+#  else // defined(MSG_ZEROCOPY)
+// Older C libraries do not define the flag, although the kernel supports it.
+const int message_zero_copy = 0x4000000;
+#  endif // defined(MSG_ZEROCOPY)
+#  if defined(SO_ZEROCOPY)
+const int zero_copy_option = SO_ZEROCOPY;
+#  else // defined(SO_ZEROCOPY)
+const int zero_copy_option = 60;
+#  endif // defined(SO_ZEROCOPY)
+# endif // defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+# if defined(BOOST_ASIO_HAS_MMSG)
+typedef mmsghdr mmsg_type;
+const int max_mmsg_len = 64;
+// The UDP segmentation options are missing from older C library headers.
+const int udp_option_level = 17; // SOL_UDP
+#  if defined(UDP_SEGMENT)
+const int udp_segment_option = UDP_SEGMENT;
+#  else // defined(UDP_SEGMENT)
+const int udp_segment_option = 103;
+#  endif // defined(UDP_SEGMENT)
+#  if defined(UDP_GRO)
+const int udp_gro_option = UDP_GRO;
+#  else // defined(UDP_GRO)
+const int udp_gro_option = 104;
+#  endif // defined(UDP_GRO)
+# endif // defined(BOOST_ASIO_HAS_MMSG)
 # if defined(IOV_MAX)
 const int max_iov_len = IOV_MAX;
 # else
@@ -174,6 +209,7 @@ const int max_iov_len = 16;
 const int custom_socket_option_level = 0xA5100000;
 const int enable_connection_aborted_option = 1;
 const int always_fail_option = 2;
+const int reactor_batching_option = 3;
 
 } // namespace detail
 } // namespace asio
@@ -84,6 +84,14 @@ public:
   // Construct a new strand implementation.
   BOOST_ASIO_DECL void construct(implementation_type& impl);
 
+  // Construct a strand implementation that shares state with another.
+  void copy_construct(implementation_type& impl,
+      const implementation_type& other_impl);
+
+  // Destroy a strand implementation. Implementations are owned by the service,
+  // so this has no effect.
+  static void destroy(implementation_type& impl);
+
   // Request the io_service to invoke the given handler.
   template <typename Handler>
   void dispatch(implementation_type& impl, Handler& handler);
@@ -23,6 +23,7 @@
 #include <boost/asio/io_service.hpp>
 #include <boost/asio/detail/atomic_count.hpp>
 #include <boost/asio/detail/call_stack.hpp>
+#include <boost/asio/detail/metrics_collector.hpp>
 #include <boost/asio/detail/mutex.hpp>
 #include <boost/asio/detail/op_queue.hpp>
 #include <boost/asio/detail/reactor_fwd.hpp>
@@ -46,6 +47,9 @@ public:
   BOOST_ASIO_DECL task_io_service(boost::asio::io_service& io_service,
       std::size_t concurrency_hint = 0);
 
+  // Destructor.
+  BOOST_ASIO_DECL ~task_io_service();
+
   // Destroy all user-defined handler objects owned by the service.
   BOOST_ASIO_DECL void shutdown_service();
 
@@ -117,6 +121,12 @@ public:
   // Assumes that work_started() was previously called for the operations.
   BOOST_ASIO_DECL void abandon_operations(op_queue<operation>& ops);
 
+  // Get the metrics for the io_service. The reactor also records into these.
+  metrics_collector& metrics()
+  {
+    return metrics_;
+  }
+
 private:
   // Structure containing information about an idle thread.
   typedef task_io_service_thread_info thread_info;
@@ -146,6 +156,81 @@ private:
   BOOST_ASIO_DECL void wake_one_thread_and_unlock(
       mutex::scoped_lock& lock);
 
+  // Determine the number of per-thread queues to use for a concurrency hint.
+  BOOST_ASIO_DECL static std::size_t calculate_num_shards(
+      std::size_t concurrency_hint);
+
+  // Choose the per-thread queue that should receive newly posted operations.
+  BOOST_ASIO_DECL std::size_t select_shard();
+
+  // Enqueue an operation on a per-thread queue and wake a waiting thread if
+  // there is one.
+  BOOST_ASIO_DECL void push_to_shard(std::size_t index, operation* op);
+
+  // Enqueue operations on a per-thread queue and wake a waiting thread if
+  // there is one.
+  BOOST_ASIO_DECL void push_to_shard(std::size_t index,
+      op_queue<operation>& ops);
+
+  // Dequeue an operation from the thread's own queue or, failing that, steal
+  // one from a peer. Returns 0 if all queues are empty.
+  BOOST_ASIO_DECL operation* pop_from_shards(std::size_t index, bool& more);
+
+  // Determine whether all per-thread queues are empty. Does not lock the
+  // queues.
+  BOOST_ASIO_DECL bool shards_empty();
+
+  // Wake an idle thread, or the task, if any thread is waiting for work.
+  BOOST_ASIO_DECL void wake_waiting_thread();
+
+  // Withdraw the task's request to be interrupted when handlers are added to
+  // a per-thread queue.
+  BOOST_ASIO_DECL void release_task_wakeup();
+
+  // Run at most one operation using the per-thread queues. May block. The
+  // mutex is unlocked on entry and exit.
+  BOOST_ASIO_DECL std::size_t do_run_one_sharded(mutex::scoped_lock& lock,
+      thread_info& this_thread, const boost::system::error_code& ec);
+
+  // Poll for at most one operation using the per-thread queues. The mutex is
+  // unlocked on entry and exit.
+  BOOST_ASIO_DECL std::size_t do_poll_one_sharded(mutex::scoped_lock& lock,
+      thread_info& this_thread, const boost::system::error_code& ec);
+
+  // Record the time at which an operation is queued, if collecting metrics.
+  void record_queued(operation* op)
+  {
+    if (metrics_.enabled() && op->enqueue_time_ == 0)
+    {
+      op->enqueue_time_ = metrics_collector::now();
+      metrics_.handler_queued();
+    }
+  }
+
+  // Record the time at which operations are queued, if collecting metrics.
+  BOOST_ASIO_DECL void record_queued(op_queue<operation>& ops);
+
+  // Complete an operation, recording how long it was queued and how long it
+  // took to execute if collecting metrics. May throw an exception. Deletes the
+  // object.
+  void complete_operation(operation* o,
+      const boost::system::error_code& ec, std::size_t task_result)
+  {
+    if (o->enqueue_time_ == 0 && !metrics_.enabled())
+      o->complete(*this, ec, task_result);
+    else
+      complete_timed_operation(o, ec, task_result);
+  }
+
+  // Complete an operation while recording metrics.
+  BOOST_ASIO_DECL void complete_timed_operation(operation* o,
+      const boost::system::error_code& ec, std::size_t task_result);
+
+  // Wait on a thread's wakeup event, recording the time spent idle if
+  // collecting metrics.
+  BOOST_ASIO_DECL void wait_for_work(mutex::scoped_lock& lock,
+      thread_info& this_thread);
+
   // Helper class to perform task-related operations on block exit.
   struct task_cleanup;
   friend struct task_cleanup;
@@ -189,6 +274,53 @@ private:
 
   // The threads that are currently idle.
   thread_info* first_idle_thread_;
+
+  // A queue of ready handlers owned by a thread running the io_service. Other
+  // threads may steal from it when their own queue is empty.
+  struct shard
+  {
+    shard() : size_(0) {}
+
+    // Mutex to protect access to the queue.
+    mutex mutex_;
+
+    // The queue of handlers that are ready to be delivered.
+    op_queue<operation> op_queue_;
+
+    // The number of handlers in the queue. Only modified while the mutex is
+    // held, but read without it to skip empty queues.
+    atomic_count size_;
+
+    // Keep adjacent shards on separate cache lines.
+    char padding_[64];
+  };
+
+  // The per-thread queues, or 0 if all handlers go through op_queue_.
+  shard* shards_;
+
+  // The number of per-thread queues.
+  const std::size_t num_shards_;
+
+  // The queue to be assigned to the next thread that enters run().
+  std::size_t next_shard_;
+
+  // The queue to receive the next handler posted from outside the io_service.
+  atomic_count next_post_shard_;
+
+  // The number of idle threads. Handlers added to a per-thread queue only
+  // touch mutex_ when this is non-zero.
+  atomic_count num_waiters_;
+
+  // Non-zero while the task may block. The first thread to add handlers to a
+  // per-thread queue claims it by decrementing it to zero, and interrupts the
+  // task without locking mutex_.
+  atomic_count task_wakeup_;
+
+  // Mirrors stopped_ so that it may be checked without locking mutex_.
+  atomic_count stopped_hint_;
+
+  // Counters describing the activity of the io_service.
+  metrics_collector metrics_;
 };
 
 } // namespace detail
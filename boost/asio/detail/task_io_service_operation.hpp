@@ -16,6 +16,7 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include <boost/system/error_code.hpp>
+#include <boost/asio/detail/cstdint.hpp>
 #include <boost/asio/detail/handler_tracking.hpp>
 #include <boost/asio/detail/op_queue.hpp>
 #include <boost/asio/detail/task_io_service_fwd.hpp>
@@ -50,7 +51,8 @@ protected:
   task_io_service_operation(func_type func)
     : next_(0),
       func_(func),
-      task_result_(0)
+      task_result_(0),
+      enqueue_time_(0)
   {
   }
 
@@ -66,6 +68,7 @@ private:
 protected:
   friend class task_io_service;
   unsigned int task_result_; // Passed into bytes transferred.
+  uint64_t enqueue_time_; // When queued, if collecting metrics, otherwise 0.
 };
 
 } // namespace detail
@@ -15,6 +15,7 @@
 # pragma once
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
+#include <cstddef>
 #include <boost/asio/detail/event.hpp>
 #include <boost/asio/detail/op_queue.hpp>
 #include <boost/asio/detail/task_io_service_fwd.hpp>
@@ -31,6 +32,8 @@ struct task_io_service_thread_info : public thread_info_base
   event* wakeup_event;
   op_queue<task_io_service_operation> private_op_queue;
   long private_outstanding_work;
+  std::size_t shard_index;
+  std::size_t shard_run_count;
   task_io_service_thread_info* next;
 };
 
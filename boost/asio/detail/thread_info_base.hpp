@@ -15,7 +15,7 @@
 # pragma once
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
-#include <climits>
+#include <boost/asio/detail/config.hpp>
 #include <cstddef>
 #include <boost/asio/detail/noncopyable.hpp>
 
@@ -25,63 +25,131 @@ namespace boost {
 namespace asio {
 namespace detail {
 
+// Per-thread state that recycles handler memory. Blocks are rounded up to one
+// of a small number of power-of-two size classes, and each thread keeps a few
+// free blocks of every class, so that the allocations made by a chain of
+// composed operations are served without calling ::operator new.
 class thread_info_base
   : private noncopyable
 {
 public:
+  enum
+  {
+    // The size of the smallest class of block.
+    min_block_size = 64,
+
+    // The number of size classes. Larger blocks are not recycled.
+    size_classes = BOOST_ASIO_RECYCLING_ALLOCATOR_SIZE_CLASSES,
+
+    // The number of free blocks kept for each size class.
+    cache_size = BOOST_ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE,
+
+    // The number of events counted before the thread publishes its counts.
+    stats_interval = 1024
+  };
+
   thread_info_base()
-    : reusable_memory_(0)
+    : hits_(0),
+      misses_(0),
+      releases_(0),
+      unpublished_(0),
+      stripe_(assign_stripe())
   {
+    for (std::size_t i = 0; i < size_classes; ++i)
+      cached_[i] = 0;
   }
 
   ~thread_info_base()
   {
-    if (reusable_memory_)
-      ::operator delete(reusable_memory_);
+    for (std::size_t i = 0; i < size_classes; ++i)
+      while (cached_[i] > 0)
+        ::operator delete(cache_[i][--cached_[i]]);
+    publish_stats();
   }
 
   static void* allocate(thread_info_base* this_thread, std::size_t size)
   {
-    if (this_thread && this_thread->reusable_memory_)
+    std::size_t size_class = size_class_of(size);
+    if (this_thread)
     {
-      void* const pointer = this_thread->reusable_memory_;
-      this_thread->reusable_memory_ = 0;
-
-      unsigned char* const mem = static_cast<unsigned char*>(pointer);
-      if (static_cast<std::size_t>(mem[0]) >= size)
+      if (size_class < size_classes && this_thread->cached_[size_class] > 0)
       {
-        mem[size] = mem[0];
-        return pointer;
+        ++this_thread->hits_;
+        this_thread->count_event();
+        std::size_t& cached = this_thread->cached_[size_class];
+        return this_thread->cache_[size_class][--cached];
       }
 
-      ::operator delete(pointer);
+      ++this_thread->misses_;
+      this_thread->count_event();
     }
 
-    void* const pointer = ::operator new(size + 1);
-    unsigned char* const mem = static_cast<unsigned char*>(pointer);
-    mem[size] = (size <= UCHAR_MAX) ? static_cast<unsigned char>(size) : 0;
-    return pointer;
+    return ::operator new(size_class < size_classes
+        ? static_cast<std::size_t>(min_block_size) << size_class : size);
   }
 
   static void deallocate(thread_info_base* this_thread,
       void* pointer, std::size_t size)
   {
-    if (size <= UCHAR_MAX)
+    if (this_thread)
     {
-      if (this_thread && this_thread->reusable_memory_ == 0)
+      std::size_t size_class = size_class_of(size);
+      if (size_class < size_classes
+          && this_thread->cached_[size_class] < cache_size)
       {
-        unsigned char* const mem = static_cast<unsigned char*>(pointer);
-        mem[0] = mem[size];
-        this_thread->reusable_memory_ = pointer;
+        this_thread->cache_[size_class][this_thread->cached_[size_class]++]
+          = pointer;
         return;
       }
+
+      ++this_thread->releases_;
+      this_thread->count_event();
     }
 
     ::operator delete(pointer);
   }
 
+  // Obtain the totals published by all threads.
+  BOOST_ASIO_DECL static void get_stats(std::size_t& hits,
+      std::size_t& misses, std::size_t& releases);
+
 private:
-  void* reusable_memory_;
+  // Determine the size class for a block. Returns size_classes if the block
+  // is too large to be recycled.
+  static std::size_t size_class_of(std::size_t size)
+  {
+    std::size_t size_class = 0;
+    std::size_t class_size = min_block_size;
+    while (class_size < size && size_class < size_classes)
+    {
+      class_size <<= 1;
+      ++size_class;
+    }
+    return size_class;
+  }
+
+  // Periodically add the thread's counts to the process-wide totals, so that
+  // the totals stay current without an atomic operation per allocation.
+  void count_event()
+  {
+    if (++unpublished_ == stats_interval)
+      publish_stats();
+  }
+
+  // Choose the stripe of the process-wide totals used by a new thread.
+  BOOST_ASIO_DECL static std::size_t assign_stripe();
+
+  // Add the thread's counts to its stripe of the process-wide totals and
+  // reset them.
+  BOOST_ASIO_DECL void publish_stats();
+
+  void* cache_[size_classes][cache_size];
+  std::size_t cached_[size_classes];
+  std::size_t hits_;
+  std::size_t misses_;
+  std::size_t releases_;
+  std::size_t unpublished_;
+  std::size_t stripe_;
 };
 
 } // namespace detail
@@ -90,4 +158,8 @@ private:
 
 #include <boost/asio/detail/pop_options.hpp>
 
+#if defined(BOOST_ASIO_HEADER_ONLY)
+# include <boost/asio/detail/impl/thread_info_base.ipp>
+#endif // defined(BOOST_ASIO_HEADER_ONLY)
+
 #endif // BOOST_ASIO_DETAIL_THREAD_INFO_BASE_HPP
@@ -23,6 +23,8 @@
 #include <boost/asio/detail/limits.hpp>
 #include <boost/asio/detail/op_queue.hpp>
 #include <boost/asio/detail/timer_queue_base.hpp>
+#include <boost/asio/detail/timer_queue_fwd.hpp>
+#include <boost/asio/detail/timer_wheel.hpp>
 #include <boost/asio/detail/wait_op.hpp>
 #include <boost/asio/error.hpp>
 
@@ -32,7 +34,7 @@ namespace boost {
 namespace asio {
 namespace detail {
 
-template <typename Time_Traits>
+template <typename Time_Traits, bool UseWheel>
 class timer_queue
   : public timer_queue_base
 {
@@ -325,6 +327,13 @@ private:
   std::vector<heap_entry> heap_;
 };
 
+// Partial specialisation for traits that select the timing wheel.
+template <typename Time_Traits>
+class timer_queue<Time_Traits, true>
+  : public timer_wheel<Time_Traits>
+{
+};
+
 } // namespace detail
 } // namespace asio
 } // namespace boost
@@ -15,11 +15,26 @@
 # pragma once
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
+#include <boost/asio/detail/config.hpp>
+
 namespace boost {
 namespace asio {
 namespace detail {
 
+// Determines whether the timer queue for the given traits is implemented as a
+// timing wheel rather than a heap. May be specialised for individual traits.
 template <typename Time_Traits>
+struct use_timer_wheel
+{
+#if defined(BOOST_ASIO_ENABLE_TIMER_WHEEL)
+  enum { value = 1 };
+#else // defined(BOOST_ASIO_ENABLE_TIMER_WHEEL)
+  enum { value = 0 };
+#endif // defined(BOOST_ASIO_ENABLE_TIMER_WHEEL)
+};
+
+template <typename Time_Traits,
+    bool UseWheel = (use_timer_wheel<Time_Traits>::value != 0)>
 class timer_queue;
 
 } // namespace detail
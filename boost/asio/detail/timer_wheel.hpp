@@ -0,0 +1,442 @@
+//
+// detail/timer_wheel.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_TIMER_WHEEL_HPP
+#define BOOST_ASIO_DETAIL_TIMER_WHEEL_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <cstddef>
+#include <boost/asio/detail/cstdint.hpp>
+#include <boost/asio/detail/date_time_fwd.hpp>
+#include <boost/asio/detail/limits.hpp>
+#include <boost/asio/detail/op_queue.hpp>
+#include <boost/asio/detail/timer_queue_base.hpp>
+#include <boost/asio/detail/wait_op.hpp>
+#include <boost/asio/error.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+// A hierarchical hashed timing wheel. Time is divided into ticks of
+// BOOST_ASIO_TIMER_WHEEL_RESOLUTION microseconds, and a timer's expiry time is
+// rounded up to the next tick. Each of the four levels of the wheel has 256
+// slots, with a slot at level n covering 256^n ticks. Timers are inserted into
+// the lowest level whose range covers their expiry, and are moved down a level
+// when the wheel's position reaches their slot. Enqueuing and cancelling a
+// timer are therefore constant time, and all timers that expire within the
+// same tick are dequeued together.
+template <typename Time_Traits>
+class timer_wheel
+  : public timer_queue_base
+{
+public:
+  // The time type.
+  typedef typename Time_Traits::time_type time_type;
+
+  // The duration type.
+  typedef typename Time_Traits::duration_type duration_type;
+
+  // Per-timer data.
+  class per_timer_data
+  {
+  public:
+    per_timer_data()
+      : next_(0), prev_(0),
+        slot_((std::numeric_limits<std::size_t>::max)())
+    {
+    }
+
+  private:
+    friend class timer_wheel;
+
+    // The operations waiting on the timer.
+    op_queue<wait_op> op_queue_;
+
+    // The tick at which the timer expires.
+    uint64_t tick_;
+
+    // Pointers to adjacent timers in the same slot.
+    per_timer_data* next_;
+    per_timer_data* prev_;
+
+    // The slot holding the timer, or the maximum value if not enqueued.
+    std::size_t slot_;
+  };
+
+  // Constructor.
+  timer_wheel()
+    : origin_(Time_Traits::now()),
+      current_tick_(0),
+      next_tick_((std::numeric_limits<uint64_t>::max)()),
+      num_timers_(0)
+  {
+    for (std::size_t i = 0; i <= num_slots; ++i)
+      slots_[i] = 0;
+    for (std::size_t i = 0; i < num_levels * words_per_level; ++i)
+      occupied_[i] = 0;
+  }
+
+  // Add a new timer to the queue. Returns true if this is the timer that is
+  // earliest in the queue, in which case the reactor's event demultiplexing
+  // function call may need to be interrupted and restarted.
+  bool enqueue_timer(const time_type& time, per_timer_data& timer, wait_op* op)
+  {
+    // Enqueue the timer object.
+    if (timer.slot_ == (std::numeric_limits<std::size_t>::max)())
+    {
+      if (this->is_positive_infinity(time))
+      {
+        // Timers that never expire are kept out of the wheel.
+        timer.tick_ = (std::numeric_limits<uint64_t>::max)();
+        link_timer(timer, infinite_slot);
+      }
+      else
+      {
+        timer.tick_ = to_tick(time);
+        insert_timer(timer);
+        ++num_timers_;
+      }
+    }
+
+    // Enqueue the individual timer operation.
+    timer.op_queue_.push(op);
+
+    // Interrupt reactor only if newly added timer expires before the time the
+    // reactor was last told to wait for.
+    if (timer.op_queue_.front() == op && timer.tick_ < next_tick_)
+    {
+      next_tick_ = timer.tick_;
+      return true;
+    }
+    return false;
+  }
+
+  // Whether there are no timers in the queue.
+  virtual bool empty() const
+  {
+    return num_timers_ == 0 && slots_[infinite_slot] == 0;
+  }
+
+  // Get the time for the timer that is earliest in the queue.
+  virtual long wait_duration_msec(long max_duration) const
+  {
+    long usec = wait_duration_usec(max_duration > 0
+        && max_duration < (std::numeric_limits<long>::max)() / 1000
+        ? max_duration * 1000 : (std::numeric_limits<long>::max)());
+    if (usec == 0)
+      return 0;
+    long msec = usec / 1000;
+    if (msec == 0)
+      return 1;
+    return msec < max_duration ? msec : max_duration;
+  }
+
+  // Get the time for the timer that is earliest in the queue.
+  virtual long wait_duration_usec(long max_duration) const
+  {
+    if (num_timers_ == 0)
+    {
+      next_tick_ = (std::numeric_limits<uint64_t>::max)();
+      return max_duration;
+    }
+
+    // Any timer not found in the remainder of the current rotation of the
+    // lowest level expires no earlier than the start of the next rotation.
+    // At the start of a rotation the higher levels have yet to be cascaded,
+    // so the current tick is the best available bound.
+    std::size_t index = static_cast<std::size_t>(current_tick_ & slot_mask);
+    std::size_t next = index == 0 ? 0 : find_occupied(0, index);
+    next_tick_ = current_tick_ - index + next;
+
+    int64_t usec = static_cast<int64_t>(next_tick_)
+      * BOOST_ASIO_TIMER_WHEEL_RESOLUTION - elapsed_usec(Time_Traits::now());
+    if (usec <= 0)
+      return 0;
+    if (usec > max_duration)
+      return max_duration;
+    return static_cast<long>(usec);
+  }
+
+  // Dequeue all timers not later than the current time.
+  virtual void get_ready_timers(op_queue<operation>& ops)
+  {
+    int64_t usec = elapsed_usec(Time_Traits::now());
+    uint64_t now_tick = usec > 0
+      ? static_cast<uint64_t>(usec) / BOOST_ASIO_TIMER_WHEEL_RESOLUTION : 0;
+
+    while (current_tick_ <= now_tick)
+    {
+      if (num_timers_ == 0)
+      {
+        // Nothing to cascade or expire, so the wheel can simply jump ahead.
+        current_tick_ = now_tick + 1;
+        break;
+      }
+
+      std::size_t index = static_cast<std::size_t>(current_tick_ & slot_mask);
+      if (index == 0)
+        cascade();
+
+      // Skip directly to the next occupied slot in this rotation.
+      std::size_t next = find_occupied(0, index);
+      uint64_t next_tick = current_tick_ - index + next;
+      if (next == slots_per_level || next_tick > now_tick)
+      {
+        current_tick_ = next_tick < now_tick + 1 ? next_tick : now_tick + 1;
+        continue;
+      }
+
+      while (per_timer_data* timer = slots_[next])
+      {
+        ops.push(timer->op_queue_);
+        remove_timer(*timer);
+      }
+
+      current_tick_ = next_tick + 1;
+    }
+  }
+
+  // Dequeue all timers.
+  virtual void get_all_timers(op_queue<operation>& ops)
+  {
+    for (std::size_t i = 0; i <= num_slots; ++i)
+    {
+      while (per_timer_data* timer = slots_[i])
+      {
+        ops.push(timer->op_queue_);
+        unlink_timer(*timer);
+      }
+    }
+
+    num_timers_ = 0;
+  }
+
+  // Cancel and dequeue operations for the given timer.
+  std::size_t cancel_timer(per_timer_data& timer, op_queue<operation>& ops,
+      std::size_t max_cancelled = (std::numeric_limits<std::size_t>::max)())
+  {
+    std::size_t num_cancelled = 0;
+    if (timer.slot_ != (std::numeric_limits<std::size_t>::max)())
+    {
+      while (wait_op* op = (num_cancelled != max_cancelled)
+          ? timer.op_queue_.front() : 0)
+      {
+        op->ec_ = boost::asio::error::operation_aborted;
+        timer.op_queue_.pop();
+        ops.push(op);
+        ++num_cancelled;
+      }
+      if (timer.op_queue_.empty())
+        remove_timer(timer);
+    }
+    return num_cancelled;
+  }
+
+private:
+  enum
+  {
+    slot_bits = 8,
+    slots_per_level = 1 << slot_bits,
+    slot_mask = slots_per_level - 1,
+    num_levels = 4,
+    num_slots = num_levels * slots_per_level,
+    infinite_slot = num_slots,
+    bits_per_word = 64,
+    words_per_level = slots_per_level / bits_per_word
+  };
+
+  // Get the number of microseconds from the wheel's origin to a given time.
+  int64_t elapsed_usec(const time_type& time) const
+  {
+    return Time_Traits::to_posix_duration(
+        Time_Traits::subtract(time, origin_)).total_microseconds();
+  }
+
+  // Convert an absolute time to a tick, rounding up so that timers never fire
+  // early. Times in the past map to the current tick.
+  uint64_t to_tick(const time_type& time) const
+  {
+    int64_t usec = elapsed_usec(time);
+    if (usec <= 0)
+      return current_tick_;
+    uint64_t tick = (static_cast<uint64_t>(usec)
+        + BOOST_ASIO_TIMER_WHEEL_RESOLUTION - 1)
+      / BOOST_ASIO_TIMER_WHEEL_RESOLUTION;
+    return tick < current_tick_ ? current_tick_ : tick;
+  }
+
+  // Insert a timer into the slot appropriate to its distance from the
+  // current tick.
+  void insert_timer(per_timer_data& timer)
+  {
+    uint64_t tick = timer.tick_ < current_tick_ ? current_tick_ : timer.tick_;
+    uint64_t delta = tick - current_tick_;
+
+    std::size_t level = 0;
+    while (level + 1 < num_levels
+        && delta >= (static_cast<uint64_t>(1) << (slot_bits * (level + 1))))
+      ++level;
+
+    // Timers beyond the range of the wheel are parked in the furthest slot,
+    // and reinserted when that slot is cascaded.
+    const uint64_t range =
+      static_cast<uint64_t>(1) << (slot_bits * num_levels);
+    if (delta >= range)
+      tick = current_tick_ + range - 1;
+
+    std::size_t index = static_cast<std::size_t>(
+        (tick >> (slot_bits * level)) & slot_mask);
+    link_timer(timer, level * slots_per_level + index);
+  }
+
+  // Move the timers from the current slot of each higher level down the
+  // wheel. Called when the lowest level starts a new rotation.
+  void cascade()
+  {
+    for (std::size_t level = 1; level < num_levels; ++level)
+    {
+      std::size_t index = static_cast<std::size_t>(
+          (current_tick_ >> (slot_bits * level)) & slot_mask);
+      std::size_t slot = level * slots_per_level + index;
+
+      per_timer_data* timer = slots_[slot];
+      slots_[slot] = 0;
+      set_occupied(slot, false);
+      while (timer)
+      {
+        per_timer_data* next = timer->next_;
+        timer->next_ = 0;
+        timer->prev_ = 0;
+        insert_timer(*timer);
+        timer = next;
+      }
+
+      if (index != 0)
+        break;
+    }
+  }
+
+  // Add a timer to the front of a slot's list.
+  void link_timer(per_timer_data& timer, std::size_t slot)
+  {
+    timer.slot_ = slot;
+    timer.prev_ = 0;
+    timer.next_ = slots_[slot];
+    if (timer.next_)
+      timer.next_->prev_ = &timer;
+    slots_[slot] = &timer;
+    if (slot != infinite_slot)
+      set_occupied(slot, true);
+  }
+
+  // Remove a timer from its slot's list.
+  void unlink_timer(per_timer_data& timer)
+  {
+    std::size_t slot = timer.slot_;
+    if (slots_[slot] == &timer)
+      slots_[slot] = timer.next_;
+    if (timer.prev_)
+      timer.prev_->next_ = timer.next_;
+    if (timer.next_)
+      timer.next_->prev_ = timer.prev_;
+    timer.next_ = 0;
+    timer.prev_ = 0;
+    timer.slot_ = (std::numeric_limits<std::size_t>::max)();
+    if (slot != infinite_slot && slots_[slot] == 0)
+      set_occupied(slot, false);
+  }
+
+  // Remove a timer from the wheel.
+  void remove_timer(per_timer_data& timer)
+  {
+    if (timer.slot_ != infinite_slot)
+      --num_timers_;
+    unlink_timer(timer);
+  }
+
+  // Record whether a slot contains any timers.
+  void set_occupied(std::size_t slot, bool occupied)
+  {
+    uint64_t bit = static_cast<uint64_t>(1) << (slot % bits_per_word);
+    if (occupied)
+      occupied_[slot / bits_per_word] |= bit;
+    else
+      occupied_[slot / bits_per_word] &= ~bit;
+  }
+
+  // Find the first occupied slot at the given level with an index not less
+  // than start. Returns slots_per_level if there is none.
+  std::size_t find_occupied(std::size_t level, std::size_t start) const
+  {
+    for (std::size_t word = start / bits_per_word;
+        word < words_per_level; ++word)
+    {
+      uint64_t bits = occupied_[level * words_per_level + word];
+      if (word == start / bits_per_word)
+        bits &= ~static_cast<uint64_t>(0) << (start % bits_per_word);
+      if (bits)
+      {
+        std::size_t bit = 0;
+        while ((bits & 1) == 0)
+          bits >>= 1, ++bit;
+        return word * bits_per_word + bit;
+      }
+    }
+    return slots_per_level;
+  }
+
+  // Determine if the specified absolute time is positive infinity.
+  template <typename Time_Type>
+  static bool is_positive_infinity(const Time_Type&)
+  {
+    return false;
+  }
+
+  // Determine if the specified absolute time is positive infinity.
+  template <typename T, typename TimeSystem>
+  static bool is_positive_infinity(
+      const boost::date_time::base_time<T, TimeSystem>& time)
+  {
+    return time.is_pos_infinity();
+  }
+
+  // The time corresponding to tick zero.
+  const time_type origin_;
+
+  // The next tick to be processed.
+  uint64_t current_tick_;
+
+  // The tick that the reactor was last told to wait until.
+  mutable uint64_t next_tick_;
+
+  // The number of timers in the wheel, excluding those that never expire.
+  std::size_t num_timers_;
+
+  // The slots of all levels, followed by a list of timers that never expire.
+  per_timer_data* slots_[num_slots + 1];
+
+  // A bitmap of the slots that contain timers.
+  uint64_t occupied_[num_levels * words_per_level];
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_DETAIL_TIMER_WHEEL_HPP
@@ -32,8 +32,12 @@ namespace asio {
  * Implement asio_handler_allocate and asio_handler_deallocate for your own
  * handlers to provide custom allocation for these temporary objects.
  *
- * The default implementation of these allocation hooks uses <tt>::operator
- * new</tt> and <tt>::operator delete</tt>.
+ * The default implementation of these allocation hooks recycles memory when
+ * called from a thread that is running an io_service. Blocks are rounded up
+ * to one of a small number of size classes, and each such thread caches a few
+ * freed blocks of every class for reuse by later operations. Otherwise, and
+ * for blocks too large to be recycled, <tt>::operator new</tt> and
+ * <tt>::operator delete</tt> are used.
  *
  * @note All temporary objects associated with a handler will be deallocated
  * before the upcall to the handler is performed. This allows the same memory to
@@ -63,14 +67,44 @@ BOOST_ASIO_DECL void* asio_handler_allocate(
  * Implement asio_handler_allocate and asio_handler_deallocate for your own
  * handlers to provide custom allocation for the associated temporary objects.
  *
- * The default implementation of these allocation hooks uses <tt>::operator
- * new</tt> and <tt>::operator delete</tt>.
+ * The default implementation of these allocation hooks recycles memory
+ * through per-thread caches.
  *
  * @sa asio_handler_allocate.
  */
 BOOST_ASIO_DECL void asio_handler_deallocate(
     void* pointer, std::size_t size, ...);
 
+/// Counters describing the behaviour of the default allocation hooks.
+/**
+ * The counters are maintained per thread and periodically added to the
+ * process-wide totals, so they may lag slightly behind the true values while
+ * threads are running. A thread's remaining counts are added when it returns
+ * from io_service::run() or a similar function. Allocations made by threads
+ * that are not running an io_service are not cached and not counted. The
+ * totals are kept in several sets of counters, each shared by a subset of the
+ * threads, and the sets are summed when the counters are obtained.
+ */
+struct handler_allocation_stats
+{
+  /// The number of allocations served from a thread's cache.
+  std::size_t hits;
+
+  /// The number of allocations that called <tt>::operator new</tt>.
+  std::size_t misses;
+
+  /// The number of deallocations that called <tt>::operator delete</tt>
+  /// because the block could not be cached.
+  std::size_t releases;
+};
+
+/// Obtain the counters for the default allocation hooks.
+/**
+ * The counters are not maintained if
+ * @c BOOST_ASIO_DISABLE_SMALL_BLOCK_RECYCLING is defined.
+ */
+BOOST_ASIO_DECL handler_allocation_stats get_handler_allocation_stats();
+
 } // namespace asio
 } // namespace boost
 
@@ -68,6 +68,16 @@ void asio_handler_deallocate(void* pointer, std::size_t size, ...)
 #endif // !defined(BOOST_ASIO_DISABLE_SMALL_BLOCK_RECYCLING)
 }
 
+handler_allocation_stats get_handler_allocation_stats()
+{
+  handler_allocation_stats stats = { 0, 0, 0 };
+#if !defined(BOOST_ASIO_DISABLE_SMALL_BLOCK_RECYCLING)
+  detail::thread_info_base::get_stats(
+      stats.hits, stats.misses, stats.releases);
+#endif // !defined(BOOST_ASIO_DISABLE_SMALL_BLOCK_RECYCLING)
+  return stats;
+}
+
 } // namespace asio
 } // namespace boost
 
@@ -0,0 +1,77 @@
+//
+// impl/io_service_metrics.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_IMPL_IO_SERVICE_METRICS_IPP
+#define BOOST_ASIO_IMPL_IO_SERVICE_METRICS_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <boost/asio/io_service_metrics.hpp>
+
+#if !defined(BOOST_ASIO_HAS_IOCP)
+# include <boost/asio/detail/task_io_service.hpp>
+# if defined(BOOST_ASIO_HAS_EPOLL)
+#  include <boost/asio/detail/epoll_reactor.hpp>
+# endif // defined(BOOST_ASIO_HAS_EPOLL)
+#endif // !defined(BOOST_ASIO_HAS_IOCP)
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+
+void enable_io_service_metrics(io_service& io_service, bool enable)
+{
+#if !defined(BOOST_ASIO_HAS_IOCP)
+  use_service<detail::task_io_service>(io_service).metrics().enable(enable);
+#else // !defined(BOOST_ASIO_HAS_IOCP)
+  (void)io_service;
+  (void)enable;
+#endif // !defined(BOOST_ASIO_HAS_IOCP)
+}
+
+io_service_metrics get_io_service_metrics(io_service& io_service)
+{
+  io_service_metrics m = io_service_metrics();
+
+#if !defined(BOOST_ASIO_HAS_IOCP)
+  detail::metrics_collector& c =
+    use_service<detail::task_io_service>(io_service).metrics();
+  m.queue_depth = c.queue_depth();
+  m.handlers_executed = c.handlers_executed();
+  c.get_queue_latency(m.queue_latency);
+  c.get_execution_time(m.execution_time);
+  m.idle_time = c.idle_time();
+
+# if defined(BOOST_ASIO_HAS_EPOLL)
+  if (has_service<detail::epoll_reactor>(io_service))
+  {
+    detail::epoll_reactor::statistics s =
+      use_service<detail::epoll_reactor>(io_service).get_statistics();
+    m.reactor_wakeups = s.wakeups;
+    m.reactor_events = s.events;
+  }
+# endif // defined(BOOST_ASIO_HAS_EPOLL)
+#else // !defined(BOOST_ASIO_HAS_IOCP)
+  (void)io_service;
+#endif // !defined(BOOST_ASIO_HAS_IOCP)
+
+  return m;
+}
+
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_IMPL_IO_SERVICE_METRICS_IPP
@@ -0,0 +1,185 @@
+//
+// impl/io_service_pool.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_IMPL_IO_SERVICE_POOL_IPP
+#define BOOST_ASIO_IMPL_IO_SERVICE_POOL_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <stdexcept>
+#include <boost/asio/io_service_pool.hpp>
+#include <boost/asio/detail/throw_exception.hpp>
+
+#if defined(BOOST_ASIO_WINDOWS) || defined(__CYGWIN__)
+# include <boost/asio/detail/socket_types.hpp>
+#elif defined(__linux__) && defined(BOOST_ASIO_HAS_PTHREADS)
+# include <pthread.h>
+# include <sched.h>
+# include <unistd.h>
+#endif
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+// Bind the calling thread to the CPU with the given index, modulo the number
+// of CPUs available. Failure is ignored, since pinning is only an optimisation.
+inline void pin_current_thread(std::size_t index)
+{
+#if defined(BOOST_ASIO_WINDOWS) || defined(__CYGWIN__)
+  SYSTEM_INFO info;
+  ::GetSystemInfo(&info);
+  if (info.dwNumberOfProcessors > 0)
+  {
+    DWORD_PTR mask = static_cast<DWORD_PTR>(1)
+      << (index % info.dwNumberOfProcessors % (sizeof(DWORD_PTR) * 8));
+    ::SetThreadAffinityMask(::GetCurrentThread(), mask);
+  }
+#elif defined(__linux__) && defined(BOOST_ASIO_HAS_PTHREADS) && defined(CPU_SET)
+  long num_cpus = ::sysconf(_SC_NPROCESSORS_ONLN);
+  if (num_cpus > 0)
+  {
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(index % static_cast<std::size_t>(num_cpus), &cpus);
+    ::pthread_setaffinity_np(::pthread_self(), sizeof(cpus), &cpus);
+  }
+#else
+  (void)index;
+#endif
+}
+
+} // namespace detail
+
+class io_service_pool::thread_function
+{
+public:
+  thread_function(io_service_pool* pool, std::size_t index)
+    : pool_(pool),
+      index_(index)
+  {
+  }
+
+  void operator()()
+  {
+    pool_->run_thread(index_);
+  }
+
+private:
+  io_service_pool* pool_;
+  std::size_t index_;
+};
+
+io_service_pool::io_service_pool(std::size_t pool_size, bool pin_threads)
+  : pin_threads_(pin_threads),
+    next_io_service_(0)
+{
+  if (pool_size == 0)
+  {
+    std::invalid_argument ex("io_service_pool size must be greater than 0");
+    boost::asio::detail::throw_exception(ex);
+  }
+
+  for (std::size_t i = 0; i < pool_size; ++i)
+  {
+    detail::shared_ptr<boost::asio::io_service> io_service(
+        new boost::asio::io_service(1));
+    io_services_.push_back(io_service);
+  }
+}
+
+io_service_pool::~io_service_pool()
+{
+  stop();
+  join();
+}
+
+boost::asio::io_service& io_service_pool::get_io_service(std::size_t index)
+{
+  return *io_services_.at(index);
+}
+
+boost::asio::io_service& io_service_pool::get_io_service()
+{
+  std::size_t index = static_cast<std::size_t>(++next_io_service_);
+  return *io_services_[index % io_services_.size()];
+}
+
+void io_service_pool::start()
+{
+  detail::mutex::scoped_lock lock(mutex_);
+  if (!threads_.empty())
+    return;
+
+  for (std::size_t i = 0; i < io_services_.size(); ++i)
+  {
+    io_services_[i]->reset();
+    detail::shared_ptr<boost::asio::io_service::work> work(
+        new boost::asio::io_service::work(*io_services_[i]));
+    work_.push_back(work);
+  }
+
+  for (std::size_t i = 0; i < io_services_.size(); ++i)
+  {
+    detail::shared_ptr<detail::thread> thread(
+        new detail::thread(thread_function(this, i)));
+    threads_.push_back(thread);
+  }
+}
+
+void io_service_pool::join()
+{
+  // The threads are only removed once they have exited, so that start() does
+  // not create a second thread for any io_service in the meantime. The lock
+  // is not held while waiting, since stop() is needed to make them exit.
+  detail::mutex::scoped_lock lock(mutex_);
+  std::vector<detail::shared_ptr<detail::thread> > threads(threads_);
+  lock.unlock();
+
+  for (std::size_t i = 0; i < threads.size(); ++i)
+    threads[i]->join();
+
+  lock.lock();
+  threads_.clear();
+}
+
+void io_service_pool::run()
+{
+  start();
+  join();
+}
+
+void io_service_pool::stop()
+{
+  detail::mutex::scoped_lock lock(mutex_);
+  work_.clear();
+  for (std::size_t i = 0; i < io_services_.size(); ++i)
+    io_services_[i]->stop();
+}
+
+void io_service_pool::run_thread(std::size_t index)
+{
+  if (pin_threads_)
+    detail::pin_current_thread(index);
+
+  io_services_[index]->run();
+}
+
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_IMPL_IO_SERVICE_POOL_IPP
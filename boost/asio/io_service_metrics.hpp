@@ -0,0 +1,97 @@
+//
+// io_service_metrics.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_IO_SERVICE_METRICS_HPP
+#define BOOST_ASIO_IO_SERVICE_METRICS_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <cstddef>
+#include <boost/asio/io_service.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+
+/// Counters describing the activity of an io_service.
+/**
+ * Timing information is only gathered while collection is enabled by calling
+ * enable_io_service_metrics(). The remaining counters are always maintained.
+ *
+ * Durations are recorded in histograms of io_service_metrics::histogram_buckets
+ * buckets. Bucket 0 counts durations of less than 2 nanoseconds, bucket @c i
+ * counts durations of at least 2^i and less than 2^(i+1) nanoseconds, and the
+ * last bucket counts all longer durations.
+ *
+ * The values are only maintained by the io_service implementation used on
+ * non-Windows platforms, and the reactor counters only when using epoll. Other
+ * implementations report zeroes.
+ */
+struct io_service_metrics
+{
+  /// The number of buckets in each histogram.
+  BOOST_ASIO_STATIC_CONSTANT(std::size_t, histogram_buckets = 32);
+
+  /// The number of handlers queued and not yet started. Only handlers queued
+  /// while collection is enabled are counted.
+  std::size_t queue_depth;
+
+  /// The number of handlers whose execution has been timed.
+  std::size_t handlers_executed;
+
+  /// Histogram of the time from a handler being queued to it being started.
+  std::size_t queue_latency[histogram_buckets];
+
+  /// Histogram of the time taken to execute each handler.
+  std::size_t execution_time[histogram_buckets];
+
+  /// The total time, in microseconds, that threads have spent waiting for
+  /// handlers to be queued, or waiting for events in the reactor when using
+  /// epoll.
+  std::size_t idle_time;
+
+  /// The number of times the reactor has returned from waiting for events.
+  std::size_t reactor_wakeups;
+
+  /// The total number of events returned by the reactor.
+  std::size_t reactor_events;
+};
+
+/// Start or stop collecting timing information for an io_service.
+/**
+ * Collection is disabled by default, since it reads a clock before and after
+ * every handler. It may be enabled or disabled at any time, but should not be
+ * changed by more than one thread at once.
+ */
+BOOST_ASIO_DECL void enable_io_service_metrics(
+    io_service& io_service, bool enable = true);
+
+/// Obtain the current counters for an io_service.
+/**
+ * This function may be called from any thread. The counters are read
+ * individually, so they need not be consistent with each other.
+ */
+BOOST_ASIO_DECL io_service_metrics get_io_service_metrics(
+    io_service& io_service);
+
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#if defined(BOOST_ASIO_HEADER_ONLY)
+# include <boost/asio/impl/io_service_metrics.ipp>
+#endif // defined(BOOST_ASIO_HEADER_ONLY)
+
+#endif // BOOST_ASIO_IO_SERVICE_METRICS_HPP
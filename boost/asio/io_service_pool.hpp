@@ -0,0 +1,157 @@
+//
+// io_service_pool.hpp
+// ~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_IO_SERVICE_POOL_HPP
+#define BOOST_ASIO_IO_SERVICE_POOL_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <cstddef>
+#include <vector>
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/detail/atomic_count.hpp>
+#include <boost/asio/detail/mutex.hpp>
+#include <boost/asio/detail/noncopyable.hpp>
+#include <boost/asio/detail/shared_ptr.hpp>
+#include <boost/asio/detail/thread.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+
+/// A pool of io_service objects, each run by a single dedicated thread.
+/**
+ * The io_service_pool class owns a fixed number of io_service objects. Each
+ * io_service has its own reactor and is run by exactly one thread, and each
+ * thread is pinned to a CPU where the platform supports it. I/O objects
+ * created on one of the pool's io_service objects therefore have all of their
+ * handlers, and all reactor state, confined to a single core.
+ *
+ * The io_service objects are constructed with a concurrency hint of 1, since
+ * only one thread runs each of them.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Safe, with the exception that calls to run() and
+ * join() must not be made concurrently with each other.
+ *
+ * @par Example
+ * Running a server on a pool with one io_service per core:
+ * @code
+ * boost::asio::io_service_pool pool(4);
+ * boost::asio::basic_acceptor_group<boost::asio::ip::tcp> acceptors(pool,
+ *     boost::asio::ip::tcp::endpoint(boost::asio::ip::tcp::v4(), 8080));
+ * ...
+ * pool.run();
+ * @endcode
+ */
+class io_service_pool
+  : private noncopyable
+{
+public:
+  /// Construct a pool containing the given number of io_service objects.
+  /**
+   * @param pool_size The number of io_service objects, and threads, in the
+   * pool. Must be greater than zero.
+   *
+   * @param pin_threads Whether each thread should be bound to a single CPU.
+   * The thread running the io_service at index @c i is bound to CPU
+   * <tt>i % N</tt>, where @c N is the number of online CPUs. Ignored on
+   * platforms that do not support thread affinity.
+   */
+  BOOST_ASIO_DECL explicit io_service_pool(
+      std::size_t pool_size, bool pin_threads = true);
+
+  /// Destructor.
+  /**
+   * Stops all io_service objects in the pool and waits for their threads to
+   * exit.
+   */
+  BOOST_ASIO_DECL ~io_service_pool();
+
+  /// Get the number of io_service objects in the pool.
+  std::size_t size() const
+  {
+    return io_services_.size();
+  }
+
+  /// Get the io_service object at the given index.
+  BOOST_ASIO_DECL boost::asio::io_service& get_io_service(std::size_t index);
+
+  /// Get an io_service object to use, selected in a round-robin fashion.
+  BOOST_ASIO_DECL boost::asio::io_service& get_io_service();
+
+  /// Start one thread for each io_service in the pool.
+  /**
+   * The threads continue to run until stop() is called, even if there is no
+   * outstanding work. Has no effect if the threads are already running.
+   */
+  BOOST_ASIO_DECL void start();
+
+  /// Wait for all threads in the pool to exit.
+  /**
+   * Calls to start() made while join() is waiting have no effect.
+   */
+  BOOST_ASIO_DECL void join();
+
+  /// Run all io_service objects in the pool, blocking until stop() is called.
+  /**
+   * Equivalent to calling start() followed by join().
+   */
+  BOOST_ASIO_DECL void run();
+
+  /// Stop all io_service objects in the pool.
+  /**
+   * This function does not block. Use join() to wait for the threads to exit.
+   * After the threads have exited, the pool may be started again.
+   */
+  BOOST_ASIO_DECL void stop();
+
+private:
+  // Function object used as the entry point for each thread in the pool.
+  class thread_function;
+  friend class thread_function;
+
+  // Run the io_service at the given index on the calling thread.
+  BOOST_ASIO_DECL void run_thread(std::size_t index);
+
+  // Whether threads are to be pinned to CPUs.
+  const bool pin_threads_;
+
+  // Mutex to protect access to the work objects and threads.
+  detail::mutex mutex_;
+
+  // The io_service objects in the pool.
+  std::vector<detail::shared_ptr<boost::asio::io_service> > io_services_;
+
+  // Work objects that keep the io_service objects running until stopped.
+  std::vector<detail::shared_ptr<boost::asio::io_service::work> > work_;
+
+  // The threads running the io_service objects.
+  std::vector<detail::shared_ptr<detail::thread> > threads_;
+
+  // The index of the io_service to be returned by the next round-robin call.
+  detail::atomic_count next_io_service_;
+};
+
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#if defined(BOOST_ASIO_HEADER_ONLY)
+# include <boost/asio/impl/io_service_pool.ipp>
+#endif // defined(BOOST_ASIO_HEADER_ONLY)
+
+#endif // BOOST_ASIO_IO_SERVICE_POOL_HPP
@@ -17,6 +17,7 @@
 
 #include <boost/asio/detail/config.hpp>
 #include <boost/asio/basic_datagram_socket.hpp>
+#include <boost/asio/detail/socket_option.hpp>
 #include <boost/asio/detail/socket_types.hpp>
 #include <boost/asio/ip/basic_endpoint.hpp>
 #include <boost/asio/ip/basic_resolver.hpp>
@@ -82,6 +83,47 @@ public:
   /// The UDP resolver type.
   typedef basic_resolver<udp> resolver;
 
+#if defined(BOOST_ASIO_HAS_MMSG) || defined(GENERATING_DOCUMENTATION)
+  /// Socket option to let the kernel coalesce received datagrams.
+  /**
+   * Implements the SOL_UDP/UDP_GRO socket option. When enabled, several
+   * datagrams of the same size from the same sender may be delivered in a
+   * single buffer. basic_datagram_socket::receive_many reports the size of
+   * each of them in the segment_size member of the slot. Receive buffers should
+   * be large enough for a coalesced datagram, up to 64 KiB, as any excess is
+   * discarded.
+   *
+   * @par Examples
+   * Setting the option:
+   * @code
+   * boost::asio::ip::udp::socket socket(io_service); 
+   * ...
+   * boost::asio::ip::udp::generic_receive_offload option(true);
+   * socket.set_option(option);
+   * @endcode
+   *
+   * @par
+   * Getting the current option value:
+   * @code
+   * boost::asio::ip::udp::socket socket(io_service); 
+   * ...
+   * boost::asio::ip::udp::generic_receive_offload option;
+   * socket.get_option(option);
+   * bool is_set = option.value();
+   * @endcode
+   *
+   * @par Concepts:
+   * Socket_Option, Boolean_Socket_Option.
+   */
+# if defined(GENERATING_DOCUMENTATION)
+  typedef implementation_defined generic_receive_offload;
+# else
+  typedef boost::asio::detail::socket_option::boolean<
+    boost::asio::detail::udp_option_level,
+    boost::asio::detail::udp_gro_option> generic_receive_offload;
+# endif
+#endif // defined(BOOST_ASIO_HAS_MMSG) || defined(GENERATING_DOCUMENTATION)
+
   /// Compare two protocols for equality.
   friend bool operator==(const udp& p1, const udp& p2)
   {
@@ -24,7 +24,11 @@
 #include <boost/asio/async_result.hpp>
 #include <boost/asio/error.hpp>
 #include <boost/asio/io_service.hpp>
-#include <boost/asio/detail/reactive_descriptor_service.hpp>
+#if defined(BOOST_ASIO_HAS_IO_URING)
+# include <boost/asio/detail/io_uring_descriptor_service.hpp>
+#else
+# include <boost/asio/detail/reactive_descriptor_service.hpp>
+#endif
 
 #include <boost/asio/detail/push_options.hpp>
 
@@ -48,7 +52,11 @@ public:
 
 private:
   // The type of the platform-specific implementation.
+#if defined(BOOST_ASIO_HAS_IO_URING)
+  typedef detail::io_uring_descriptor_service service_impl_type;
+#else
   typedef detail::reactive_descriptor_service service_impl_type;
+#endif
 
 public:
   /// The type of a stream descriptor implementation.
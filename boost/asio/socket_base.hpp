@@ -65,6 +65,16 @@ public:
 
   /// Specifies that the data marks the end of a record.
   static const int message_end_of_record = implementation_defined;
+
+  /// Send the data without copying it into the kernel. Supported only for
+  /// asynchronous sends on Linux; ignored elsewhere.
+  /**
+   * The handler is not called until the kernel no longer refers to the data,
+   * which is usually when the peer has acknowledged it. Synchronous sends,
+   * and sockets that do not support zero-copy transmission, copy the data
+   * as usual.
+   */
+  static const int message_zero_copy = implementation_defined;
 #else
   BOOST_ASIO_STATIC_CONSTANT(int,
       message_peek = boost::asio::detail::message_peek);
@@ -74,6 +84,12 @@ public:
       message_do_not_route = boost::asio::detail::message_do_not_route);
   BOOST_ASIO_STATIC_CONSTANT(int,
       message_end_of_record = boost::asio::detail::message_end_of_record);
+# if defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+  BOOST_ASIO_STATIC_CONSTANT(int,
+      message_zero_copy = boost::asio::detail::message_zero_copy);
+# else // defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+  BOOST_ASIO_STATIC_CONSTANT(int, message_zero_copy = 0);
+# endif // defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
 #endif
 
   /// Socket option to permit sending of broadcast messages.
@@ -374,6 +390,45 @@ public:
     SOL_SOCKET, SO_REUSEADDR> reuse_address;
 #endif
 
+#if defined(BOOST_ASIO_HAS_SO_REUSEPORT) || defined(GENERATING_DOCUMENTATION)
+  /// Socket option to allow multiple sockets to be bound to the same address
+  /// and port.
+  /**
+   * Implements the SOL_SOCKET/SO_REUSEPORT socket option. On Linux, incoming
+   * connections (or datagrams) are distributed across all listening sockets
+   * that have the option set and are bound to the same address.
+   *
+   * @par Examples
+   * Setting the option:
+   * @code
+   * boost::asio::ip::tcp::acceptor acceptor(io_service); 
+   * ...
+   * boost::asio::socket_base::reuse_port option(true);
+   * acceptor.set_option(option);
+   * @endcode
+   *
+   * @par
+   * Getting the current option value:
+   * @code
+   * boost::asio::ip::tcp::acceptor acceptor(io_service); 
+   * ...
+   * boost::asio::socket_base::reuse_port option;
+   * acceptor.get_option(option);
+   * bool is_set = option.value();
+   * @endcode
+   *
+   * @par Concepts:
+   * Socket_Option, Boolean_Socket_Option.
+   */
+# if defined(GENERATING_DOCUMENTATION)
+  typedef implementation_defined reuse_port;
+# else
+  typedef boost::asio::detail::socket_option::boolean<
+    SOL_SOCKET, SO_REUSEPORT> reuse_port;
+# endif
+#endif // defined(BOOST_ASIO_HAS_SO_REUSEPORT)
+       //   || defined(GENERATING_DOCUMENTATION)
+
   /// Socket option to specify whether the socket lingers on close if unsent
   /// data is present.
   /**
@@ -446,6 +501,53 @@ public:
     enable_connection_aborted;
 #endif
 
+  /// Socket option to perform the socket's I/O on the reactor thread.
+  /**
+   * Implements a custom socket option that determines whether the epoll
+   * reactor performs the I/O for the socket on the thread that waits for
+   * readiness events. The operations completed by a single wait are then
+   * handed to the io_service in one batch, which reduces locking when many
+   * sockets are ready at once. However, the I/O for all such sockets is
+   * serialised on the reactor thread, rather than being spread across the
+   * threads that run the io_service, so the option is best suited to sockets
+   * that transfer small amounts of data.
+   *
+   * By default the option is false, unless the program is compiled with
+   * @c BOOST_ASIO_ENABLE_EPOLL_BATCHING defined. The option is accepted, but
+   * has no effect and always reads as false, on platforms that do not use
+   * the epoll reactor.
+   *
+   * @par Examples
+   * Setting the option:
+   * @code
+   * boost::asio::ip::udp::socket socket(io_service); 
+   * ...
+   * boost::asio::socket_base::reactor_batching option(true);
+   * socket.set_option(option);
+   * @endcode
+   *
+   * @par
+   * Getting the current option value:
+   * @code
+   * boost::asio::ip::udp::socket socket(io_service); 
+   * ...
+   * boost::asio::socket_base::reactor_batching option;
+   * socket.get_option(option);
+   * bool is_set = option.value();
+   * @endcode
+   *
+   * @par Concepts:
+   * Socket_Option, Boolean_Socket_Option.
+   */
+#if defined(GENERATING_DOCUMENTATION)
+  typedef implementation_defined reactor_batching;
+#else
+  typedef boost::asio::detail::socket_option::boolean<
+    boost::asio::detail::custom_socket_option_level,
+    boost::asio::detail::reactor_batching_option>
+    reactor_batching;
+#endif
+
   /// (Deprecated: Use non_blocking().) IO control command to
   /// set the blocking mode of the socket.
   /**
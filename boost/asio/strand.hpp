@@ -18,6 +18,7 @@
 #include <boost/asio/detail/config.hpp>
 #include <boost/asio/async_result.hpp>
 #include <boost/asio/detail/handler_type_requirements.hpp>
+#include <boost/asio/detail/lock_free_strand_service.hpp>
 #include <boost/asio/detail/strand_service.hpp>
 #include <boost/asio/detail/wrapped_handler.hpp>
 #include <boost/asio/io_service.hpp>
@@ -91,21 +92,35 @@ public:
    * dispatch handlers that are ready to be run.
    */
   explicit strand(boost::asio::io_service& io_service)
-    : service_(boost::asio::use_service<
-        boost::asio::detail::strand_service>(io_service))
+    : service_(boost::asio::use_service<service_impl_type>(io_service))
   {
     service_.construct(impl_);
   }
 
+  /// Copy constructor.
+  /**
+   * Constructs a strand that refers to the same underlying strand as
+   * @c other. Handlers posted through either object will not execute
+   * concurrently with each other.
+   */
+  strand(const strand& other)
+    : service_(other.service_)
+  {
+    service_.copy_construct(impl_, other.impl_);
+  }
+
   /// Destructor.
   /**
    * Destroys a strand.
    *
    * Handlers posted through the strand that have not yet been invoked will
    * still be dispatched in a way that meets the guarantee of non-concurrency.
+   *
+   * A strand may be destroyed after its io_service.
    */
   ~strand()
   {
+    service_impl_type::destroy(impl_);
   }
 
   /// Get the io_service associated with the strand.
@@ -235,8 +250,17 @@ public:
   }
 
 private:
-  boost::asio::detail::strand_service& service_;
-  boost::asio::detail::strand_service::implementation_type impl_;
+  // Prevent assignment.
+  strand& operator=(const strand&);
+
+#if defined(BOOST_ASIO_HAS_LOCK_FREE_STRAND)
+  typedef boost::asio::detail::lock_free_strand_service service_impl_type;
+#else // defined(BOOST_ASIO_HAS_LOCK_FREE_STRAND)
+  typedef boost::asio::detail::strand_service service_impl_type;
+#endif // defined(BOOST_ASIO_HAS_LOCK_FREE_STRAND)
+
+  service_impl_type& service_;
+  service_impl_type::implementation_type impl_;
 };
 
 /// Typedef for backwards compatibility.
@@ -18,12 +18,15 @@
 #include <boost/asio/detail/config.hpp>
 #include <cstddef>
 #include <boost/asio/async_result.hpp>
+#include <boost/asio/detail/cstdint.hpp>
 #include <boost/asio/detail/type_traits.hpp>
 #include <boost/asio/error.hpp>
 #include <boost/asio/io_service.hpp>
 
 #if defined(BOOST_ASIO_HAS_IOCP)
 # include <boost/asio/detail/win_iocp_socket_service.hpp>
+#elif defined(BOOST_ASIO_HAS_IO_URING)
+# include <boost/asio/detail/io_uring_socket_service.hpp>
 #else
 # include <boost/asio/detail/reactive_socket_service.hpp>
 #endif
@@ -58,6 +61,8 @@ private:
   // The type of the platform-specific implementation.
 #if defined(BOOST_ASIO_HAS_IOCP)
   typedef detail::win_iocp_socket_service<Protocol> service_impl_type;
+#elif defined(BOOST_ASIO_HAS_IO_URING)
+  typedef detail::io_uring_socket_service<Protocol> service_impl_type;
 #else
   typedef detail::reactive_socket_service<Protocol> service_impl_type;
 #endif
@@ -328,6 +333,32 @@ public:
     return init.result.get();
   }
 
+#if defined(BOOST_ASIO_HAS_SENDFILE) || defined(GENERATING_DOCUMENTATION)
+  /// Send part of a file to the peer.
+  std::size_t send_file(implementation_type& impl, int file,
+      uint64_t offset, std::size_t length, boost::system::error_code& ec)
+  {
+    return service_impl_.send_file(impl, file, offset, length, ec);
+  }
+
+  /// Start an asynchronous send of part of a file.
+  template <typename WriteHandler>
+  BOOST_ASIO_INITFN_RESULT_TYPE(WriteHandler,
+      void (boost::system::error_code, std::size_t))
+  async_send_file(implementation_type& impl, int file,
+      uint64_t offset, std::size_t length,
+      BOOST_ASIO_MOVE_ARG(WriteHandler) handler)
+  {
+    detail::async_result_init<
+      WriteHandler, void (boost::system::error_code, std::size_t)> init(
+        BOOST_ASIO_MOVE_CAST(WriteHandler)(handler));
+
+    service_impl_.async_send_file(impl, file, offset, length, init.handler);
+
+    return init.result.get();
+  }
+#endif // defined(BOOST_ASIO_HAS_SENDFILE) || defined(GENERATING_DOCUMENTATION)
+
   /// Receive some data from the peer.
   template <typename MutableBufferSequence>
   std::size_t receive(implementation_type& impl,
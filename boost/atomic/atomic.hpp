@@ -16,6 +16,7 @@
 #include <boost/atomic/detail/config.hpp>
 #include <boost/atomic/detail/platform.hpp>
 #include <boost/atomic/detail/type-classification.hpp>
+#include <boost/atomic/detail/wait_pool.hpp>
 #include <boost/type_traits/is_signed.hpp>
 #if defined(BOOST_MSVC) && BOOST_MSVC < 1400
 #include <boost/type_traits/is_integral.hpp>
@@ -74,6 +75,31 @@ namespace boost {
 #define BOOST_ATOMIC_BOOL_LOCK_FREE 0
 #endif
 
+namespace atomics {
+namespace detail {
+
+// Whether the implementation selected for a type with the given classification and storage size is lock-free
+// for all objects
+template<typename C, unsigned int Size>
+struct is_always_lock_free
+{
+    BOOST_STATIC_CONSTANT(bool, value = (
+        Size == 1 ? BOOST_ATOMIC_CHAR_LOCK_FREE == 2 :
+        Size == 2 ? BOOST_ATOMIC_SHORT_LOCK_FREE == 2 :
+        Size == 4 ? BOOST_ATOMIC_INT_LOCK_FREE == 2 :
+        Size == 8 ? BOOST_ATOMIC_LLONG_LOCK_FREE == 2 :
+        Size == 16 ? BOOST_ATOMIC_INT128_LOCK_FREE == 2 : false));
+};
+
+template<unsigned int Size>
+struct is_always_lock_free<void*, Size>
+{
+    BOOST_STATIC_CONSTANT(bool, value = (BOOST_ATOMIC_POINTER_LOCK_FREE == 2));
+};
+
+}
+}
+
 #ifndef BOOST_ATOMIC_THREAD_FENCE
 #define BOOST_ATOMIC_THREAD_FENCE 0
 inline void atomic_thread_fence(memory_order)
@@ -119,6 +145,11 @@ private:
     typedef typename super::value_arg_type value_arg_type;
 
 public:
+    static BOOST_CONSTEXPR_OR_CONST bool is_always_lock_free = atomics::detail::is_always_lock_free<
+        typename atomics::detail::classify<T>::type,
+        atomics::detail::storage_size_of<T>::value
+    >::value;
+
     BOOST_DEFAULTED_FUNCTION(atomic(void), BOOST_NOEXCEPT {})
 
     // NOTE: The constructor is made explicit because gcc 4.7 complains that
@@ -138,10 +169,31 @@ public:
         return this->load();
     }
 
+    // Blocks until the value is notified and differs from old_value. May return spuriously, but only when the value
+    // differs from old_value.
+    void wait(value_arg_type old_value, memory_order order = memory_order_seq_cst) const volatile BOOST_NOEXCEPT
+    {
+        atomics::detail::wait_ops<atomic, value_type>::wait(*this, old_value, order);
+    }
+
+    // Wakes up at least one thread waiting on this object. May wake other waiters, too.
+    void notify_one(void) volatile BOOST_NOEXCEPT
+    {
+        atomics::detail::wait_pool::notify(this);
+    }
+
+    void notify_all(void) volatile BOOST_NOEXCEPT
+    {
+        atomics::detail::wait_pool::notify(this);
+    }
+
     BOOST_DELETED_FUNCTION(atomic(atomic const&))
     BOOST_DELETED_FUNCTION(atomic& operator=(atomic const&) volatile)
 };
 
+template<typename T>
+BOOST_CONSTEXPR_OR_CONST bool atomic<T>::is_always_lock_free;
+
 typedef atomic<char> atomic_char;
 typedef atomic<unsigned char> atomic_uchar;
 typedef atomic<signed char> atomic_schar;
@@ -831,207 +831,93 @@ private:
 
 #if defined(BOOST_ATOMIC_INT128_LOCK_FREE) && BOOST_ATOMIC_INT128_LOCK_FREE > 0
 
-template<typename T, bool Sign>
-class base_atomic<T, int, 16, Sign>
-{
-private:
-    typedef base_atomic this_type;
-    typedef T value_type;
-    typedef T difference_type;
-
-protected:
-    typedef value_type value_arg_type;
-
-public:
-    BOOST_DEFAULTED_FUNCTION(base_atomic(void), {})
-    BOOST_CONSTEXPR explicit base_atomic(value_type v) BOOST_NOEXCEPT : v_(v) {}
-
-    void store(value_type v, memory_order order = memory_order_seq_cst) volatile BOOST_NOEXCEPT
-    {
-        __atomic_store_n(&v_, v, atomics::detail::convert_memory_order_to_gcc(order));
-    }
-
-    value_type load(memory_order order = memory_order_seq_cst) const volatile BOOST_NOEXCEPT
-    {
-        return __atomic_load_n(&v_, atomics::detail::convert_memory_order_to_gcc(order));
-    }
-
-    value_type fetch_add(difference_type v, memory_order order = memory_order_seq_cst) volatile BOOST_NOEXCEPT
-    {
-        return __atomic_fetch_add(&v_, v, atomics::detail::convert_memory_order_to_gcc(order));
-    }
-
-    value_type fetch_sub(difference_type v, memory_order order = memory_order_seq_cst) volatile BOOST_NOEXCEPT
-    {
-        return __atomic_fetch_sub(&v_, v, atomics::detail::convert_memory_order_to_gcc(order));
-    }
-
-    value_type exchange(value_type v, memory_order order = memory_order_seq_cst) volatile BOOST_NOEXCEPT
-    {
-        return __atomic_exchange_n(&v_, v, atomics::detail::convert_memory_order_to_gcc(order));
-    }
+// The compilers don't expand the __atomic intrinsics inline for 16-byte objects, even with -mcx16: they call
+// libatomic, which may fall back to a lock and reports the objects as not lock-free. The 128-bit atomic types
+// are therefore built on cmpxchg16b in cas128strong.hpp, the same as with the gcc-x86 backend. All of the
+// operations below are locked instructions, which are full barriers, so the fences only have to restrain the compiler.
 
-    bool compare_exchange_strong(
-        value_type& expected,
-        value_type desired,
-        memory_order success_order,
-        memory_order failure_order) volatile BOOST_NOEXCEPT
-    {
-        return __atomic_compare_exchange_n(&v_, &expected, desired, false,
-            atomics::detail::convert_memory_order_to_gcc(success_order),
-            atomics::detail::convert_memory_order_to_gcc(failure_order));
-    }
-
-    bool compare_exchange_weak(
-        value_type& expected,
-        value_type desired,
-        memory_order success_order,
-        memory_order failure_order) volatile BOOST_NOEXCEPT
-    {
-        return __atomic_compare_exchange_n(&v_, &expected, desired, true,
-            atomics::detail::convert_memory_order_to_gcc(success_order),
-            atomics::detail::convert_memory_order_to_gcc(failure_order));
-    }
-
-    value_type fetch_and(value_type v, memory_order order = memory_order_seq_cst) volatile BOOST_NOEXCEPT
-    {
-        return __atomic_fetch_and(&v_, v, atomics::detail::convert_memory_order_to_gcc(order));
-    }
-
-    value_type fetch_or(value_type v, memory_order order = memory_order_seq_cst) volatile BOOST_NOEXCEPT
-    {
-        return __atomic_fetch_or(&v_, v, atomics::detail::convert_memory_order_to_gcc(order));
-    }
-
-    value_type fetch_xor(value_type v, memory_order order = memory_order_seq_cst) volatile BOOST_NOEXCEPT
-    {
-        return __atomic_fetch_xor(&v_, v, atomics::detail::convert_memory_order_to_gcc(order));
-    }
-
-    bool is_lock_free(void) const volatile BOOST_NOEXCEPT
-    {
-        return __atomic_is_lock_free(sizeof(v_), &v_);
-    }
-
-    BOOST_ATOMIC_DECLARE_INTEGRAL_OPERATORS
-
-    BOOST_DELETED_FUNCTION(base_atomic(base_atomic const&))
-    BOOST_DELETED_FUNCTION(base_atomic& operator=(base_atomic const&))
-
-private:
-    value_type v_;
-};
-
-#if defined(BOOST_HAS_INT128)
-
-typedef boost::uint128_type storage128_type;
-
-#else // defined(BOOST_HAS_INT128)
-
-struct BOOST_ALIGNMENT(16) storage128_type
+BOOST_FORCEINLINE void platform_fence_before(memory_order order) BOOST_NOEXCEPT
 {
-    uint64_t data[2];
-};
+    if (order != memory_order_relaxed)
+        __atomic_signal_fence(__ATOMIC_SEQ_CST);
+}
 
-inline bool operator== (storage128_type const& left, storage128_type const& right)
+BOOST_FORCEINLINE void platform_fence_after(memory_order order) BOOST_NOEXCEPT
 {
-    return left.data[0] == right.data[0] && left.data[1] == right.data[1];
+    if (order != memory_order_relaxed)
+        __atomic_signal_fence(__ATOMIC_SEQ_CST);
 }
-inline bool operator!= (storage128_type const& left, storage128_type const& right)
+
+BOOST_FORCEINLINE void platform_fence_before_store(memory_order order) BOOST_NOEXCEPT
 {
-    return !(left == right);
+    platform_fence_before(order);
 }
 
-#endif // defined(BOOST_HAS_INT128)
-
-template<typename T, bool Sign>
-class base_atomic<T, void, 16, Sign>
+BOOST_FORCEINLINE void platform_fence_after_store(memory_order order) BOOST_NOEXCEPT
 {
-private:
-    typedef base_atomic this_type;
-    typedef T value_type;
-    typedef storage128_type storage_type;
-
-protected:
-    typedef value_type const& value_arg_type;
-
-public:
-    BOOST_DEFAULTED_FUNCTION(base_atomic(void), {})
-    explicit base_atomic(value_type const& v) BOOST_NOEXCEPT : v_(0)
-    {
-        memcpy(&v_, &v, sizeof(value_type));
-    }
-
-    void store(value_type const& v, memory_order order = memory_order_seq_cst) volatile BOOST_NOEXCEPT
-    {
-        storage_type tmp = 0;
-        memcpy(&tmp, &v, sizeof(value_type));
-        __atomic_store_n(&v_, tmp, atomics::detail::convert_memory_order_to_gcc(order));
-    }
-
-    value_type load(memory_order order = memory_order_seq_cst) const volatile BOOST_NOEXCEPT
-    {
-        storage_type tmp = __atomic_load_n(&v_, atomics::detail::convert_memory_order_to_gcc(order));
-        value_type v;
-        memcpy(&v, &tmp, sizeof(value_type));
-        return v;
-    }
-
-    value_type exchange(value_type const& v, memory_order order = memory_order_seq_cst) volatile BOOST_NOEXCEPT
-    {
-        storage_type tmp = 0;
-        memcpy(&tmp, &v, sizeof(value_type));
-        tmp = __atomic_exchange_n(&v_, tmp, atomics::detail::convert_memory_order_to_gcc(order));
-        value_type res;
-        memcpy(&res, &tmp, sizeof(value_type));
-        return res;
-    }
-
-    bool compare_exchange_strong(
-        value_type& expected,
-        value_type const& desired,
-        memory_order success_order,
-        memory_order failure_order) volatile BOOST_NOEXCEPT
-    {
-        storage_type expected_s = 0, desired_s = 0;
-        memcpy(&expected_s, &expected, sizeof(value_type));
-        memcpy(&desired_s, &desired, sizeof(value_type));
-        const bool success = __atomic_compare_exchange_n(&v_, &expected_s, desired_s, false,
-            atomics::detail::convert_memory_order_to_gcc(success_order),
-            atomics::detail::convert_memory_order_to_gcc(failure_order));
-        memcpy(&expected, &expected_s, sizeof(value_type));
-        return success;
-    }
-
-    bool compare_exchange_weak(
-        value_type& expected,
-        value_type const& desired,
-        memory_order success_order,
-        memory_order failure_order) volatile BOOST_NOEXCEPT
-    {
-        storage_type expected_s = 0, desired_s = 0;
-        memcpy(&expected_s, &expected, sizeof(value_type));
-        memcpy(&desired_s, &desired, sizeof(value_type));
-        const bool success = __atomic_compare_exchange_n(&v_, &expected_s, desired_s, true,
-            atomics::detail::convert_memory_order_to_gcc(success_order),
-            atomics::detail::convert_memory_order_to_gcc(failure_order));
-        memcpy(&expected, &expected_s, sizeof(value_type));
-        return success;
-    }
+    platform_fence_after(order);
+}
 
-    bool is_lock_free(void) const volatile BOOST_NOEXCEPT
-    {
-        return __atomic_is_lock_free(sizeof(v_), &v_);
-    }
+BOOST_FORCEINLINE void platform_fence_after_load(memory_order order) BOOST_NOEXCEPT
+{
+    platform_fence_after(order);
+}
 
-    BOOST_ATOMIC_DECLARE_BASE_OPERATORS
+template<typename T>
+inline bool
+platform_cmpxchg128_strong(T& expected, T desired, volatile T* ptr) BOOST_NOEXCEPT
+{
+    uint64_t const* p_desired = (uint64_t const*)&desired;
+    bool success;
+    __asm__ __volatile__
+    (
+        "lock; cmpxchg16b %[dest]\n\t"
+        "sete %[success]"
+        : "+A,A" (expected), [dest] "+m,m" (*ptr), [success] "=q,m" (success)
+        : "b,b" (p_desired[0]), "c,c" (p_desired[1])
+        : "memory", "cc"
+    );
+    return success;
+}
 
-    BOOST_DELETED_FUNCTION(base_atomic(base_atomic const&))
-    BOOST_DELETED_FUNCTION(base_atomic& operator=(base_atomic const&))
+template<typename T>
+inline void
+platform_store128(T value, volatile T* ptr) BOOST_NOEXCEPT
+{
+    uint64_t const* p_value = (uint64_t const*)&value;
+    __asm__ __volatile__
+    (
+        "movq 0(%[dest]), %%rax\n\t"
+        "movq 8(%[dest]), %%rdx\n\t"
+        ".align 16\n\t"
+        "1: lock; cmpxchg16b 0(%[dest])\n\t"
+        "jne 1b"
+        :
+        : "b" (p_value[0]), "c" (p_value[1]), [dest] "r" (ptr)
+        : "memory", "cc", "rax", "rdx"
+    );
+}
 
-private:
-    storage_type v_;
-};
+template<typename T>
+inline T
+platform_load128(const volatile T* ptr) BOOST_NOEXCEPT
+{
+    T value;
+
+    // The comparison result doesn't matter, the current value is stored into value either way.
+    // rbx and rcx only have to be equal to rax and rdx before cmpxchg16b.
+    __asm__ __volatile__
+    (
+        "movq %%rbx, %%rax\n\t"
+        "movq %%rcx, %%rdx\n\t"
+        "lock; cmpxchg16b %[dest]"
+        : "=&A" (value)
+        : [dest] "m" (*ptr)
+        : "cc"
+    );
+
+    return value;
+}
 
 #endif // defined(BOOST_ATOMIC_INT128_LOCK_FREE) && BOOST_ATOMIC_INT128_LOCK_FREE > 0
 
@@ -1198,6 +1084,11 @@ private:
 } // namespace atomics
 } // namespace boost
 
+/* pull in 128-bit atomic type using cmpxchg16b above */
+#if defined(BOOST_ATOMIC_INT128_LOCK_FREE) && BOOST_ATOMIC_INT128_LOCK_FREE > 0
+#include <boost/atomic/detail/cas128strong.hpp>
+#endif
+
 #endif // !defined(BOOST_ATOMIC_FORCE_FALLBACK)
 
 #endif // BOOST_ATOMIC_DETAIL_GCC_ATOMIC_HPP
@@ -0,0 +1,63 @@
+#ifndef BOOST_ATOMIC_DETAIL_WAIT_POOL_HPP
+#define BOOST_ATOMIC_DETAIL_WAIT_POOL_HPP
+
+//  Distributed under the Boost Software License, Version 1.0.
+//  See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#include <string.h>
+
+#include <boost/memory_order.hpp>
+#include <boost/atomic/detail/config.hpp>
+
+#ifdef BOOST_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+// Whether waiting threads block in the operating system, rather than poll the atomic object
+#if defined(__linux__)
+#define BOOST_ATOMIC_HAS_NATIVE_WAIT_NOTIFY 1
+#else
+#define BOOST_ATOMIC_HAS_NATIVE_WAIT_NOTIFY 0
+#endif
+
+namespace boost {
+namespace atomics {
+namespace detail {
+
+// Threads that wait for an atomic object to change block on one of a fixed number of wait states, selected by
+// the address of the object, on a futex on Linux. A notification wakes all threads blocked on the state; each of
+// them compares its object with the value it waits for and either returns or blocks again.
+class wait_pool
+{
+public:
+    typedef bool (*changed_predicate)(const volatile void * obj, const void * old_value, memory_order order);
+
+    static BOOST_ATOMIC_DECL void wait(const volatile void * obj, changed_predicate changed, const void * old_value, memory_order order) BOOST_NOEXCEPT;
+    static BOOST_ATOMIC_DECL void notify(const volatile void * obj) BOOST_NOEXCEPT;
+};
+
+template<typename Atomic, typename T>
+struct wait_ops
+{
+    static bool
+    changed(const volatile void * obj, const void * old_value, memory_order order)
+    {
+        T const value = static_cast<Atomic const volatile *>(obj)->load(order);
+        return memcmp(&value, old_value, sizeof(T)) != 0;
+    }
+
+    static void
+    wait(Atomic const volatile & obj, T const& old_value, memory_order order) BOOST_NOEXCEPT
+    {
+        // don't call into the library if the value has changed already
+        if (!changed(&obj, &old_value, order))
+            wait_pool::wait(&obj, &changed, &old_value, order);
+    }
+};
+
+}
+}
+}
+
+#endif
@@ -0,0 +1,154 @@
+//  blocking adapter for the lock-free queues
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_LOCKFREE_BLOCKING_QUEUE_HPP_INCLUDED
+#define BOOST_LOCKFREE_BLOCKING_QUEUE_HPP_INCLUDED
+
+#include <boost/config.hpp>
+#ifdef BOOST_NO_CXX11_DELETED_FUNCTIONS
+#include <boost/noncopyable.hpp>
+#endif
+
+#include <boost/lockfree/detail/eventcount.hpp>
+#include <boost/lockfree/detail/prefix.hpp>
+
+namespace boost    {
+namespace lockfree {
+
+/** The blocking_queue class adds a blocking pop to one of the lock-free queues.
+ *
+ *  Consumers that find the queue empty can sleep in wait_pop instead of polling. The wake-up uses an eventcount, which
+ *  is implemented with a futex on linux and with a mutex and condition variable elsewhere. As long as no consumer is
+ *  waiting, push only adds a memory fence and a load to the push of the underlying queue.
+ *
+ *  \b Requirements:
+ *  - Queue must provide push(value_type const &), pop(U &) and empty(), like \ref boost::lockfree::queue,
+ *    \ref boost::lockfree::spsc_queue, \ref boost::lockfree::mpmc_ring or \ref boost::lockfree::mpsc_queue
+ *  - The progress guarantees and the number of threads that may push and pop are those of Queue
+ * */
+template <typename Queue>
+class blocking_queue
+#ifdef BOOST_NO_CXX11_DELETED_FUNCTIONS
+    : boost::noncopyable
+#endif
+{
+private:
+#ifndef BOOST_DOXYGEN_INVOKED
+#ifndef BOOST_NO_CXX11_DELETED_FUNCTIONS
+    blocking_queue(blocking_queue const &) = delete;
+    blocking_queue(blocking_queue &&)      = delete;
+    const blocking_queue& operator=( const blocking_queue& ) = delete;
+#endif
+#endif
+
+public:
+    typedef Queue queue_type;
+    typedef typename Queue::value_type value_type;
+
+    //! Construct queue, forwarding the arguments to the constructor of the underlying queue
+    // @{
+    blocking_queue(void)
+    {}
+
+    template <typename A1>
+    explicit blocking_queue(A1 const & a1):
+        queue_(a1)
+    {}
+
+    template <typename A1, typename A2>
+    blocking_queue(A1 const & a1, A2 const & a2):
+        queue_(a1, a2)
+    {}
+    // @}
+
+    /**
+     * \return true, if the underlying queue is lock-free.
+     * */
+    bool is_lock_free (void) const
+    {
+        return queue_.is_lock_free();
+    }
+
+    /** Check if the queue is empty
+     *
+     * \return true, if the queue is empty, false otherwise
+     * \note The result is only accurate, if no other thread modifies the queue. Therefore it is rarely practical to use this
+     *       value in program logic.
+     * */
+    bool empty(void)
+    {
+        return queue_.empty();
+    }
+
+    /** Pushes object t to the queue and wakes a waiting consumer.
+     *
+     * \returns true, if the push operation is successful.
+     * */
+    bool push(value_type const & t)
+    {
+        if (!queue_.push(t))
+            return false;
+
+        ec_.notify_one();
+        return true;
+    }
+
+    /** Pops object from queue without blocking.
+     *
+     * \returns true, if the pop operation is successful, false if queue was empty.
+     * */
+    template <typename U>
+    bool pop(U & ret)
+    {
+        return queue_.pop(ret);
+    }
+
+    /** Pops object from queue, blocks until an object is available.
+     *
+     * \post object will be copied to ret.
+     * */
+    template <typename U>
+    void wait_pop(U & ret)
+    {
+        for (;;) {
+            if (queue_.pop(ret))
+                return;
+
+            detail::eventcount::key_type key = ec_.prepare_wait();
+
+            if (queue_.pop(ret)) {
+                ec_.cancel_wait();
+                return;
+            }
+
+            ec_.commit_wait(key);
+        }
+    }
+
+    /** Wakes all threads that are blocked in wait_pop, so that they re-check the queue.
+     * */
+    void notify_all(void)
+    {
+        ec_.notify_all();
+    }
+
+    //! Access the underlying queue
+    Queue & queue(void)
+    {
+        return queue_;
+    }
+
+private:
+#ifndef BOOST_DOXYGEN_INVOKED
+    Queue queue_;
+    detail::eventcount ec_;
+#endif
+};
+
+} /* namespace lockfree */
+} /* namespace boost */
+
+#endif /* BOOST_LOCKFREE_BLOCKING_QUEUE_HPP_INCLUDED */
@@ -0,0 +1,130 @@
+//  eventcount: lets threads sleep until a lock-free data structure changes
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_LOCKFREE_DETAIL_EVENTCOUNT_HPP_INCLUDED
+#define BOOST_LOCKFREE_DETAIL_EVENTCOUNT_HPP_INCLUDED
+
+#include <climits>
+
+#include <boost/noncopyable.hpp>
+
+#include <boost/lockfree/detail/atomic.hpp>
+#include <boost/lockfree/detail/branch_hints.hpp>
+
+#if defined(__linux__)
+#define BOOST_LOCKFREE_EVENTCOUNT_USE_FUTEX
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#else
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+#endif
+
+namespace boost    {
+namespace lockfree {
+namespace detail   {
+
+/* A waiter announces itself with prepare_wait, re-checks its condition and then either calls cancel_wait or blocks in
+ * commit_wait. A notifier changes the condition before calling notify_one or notify_all. The notifier only touches the
+ * shared epoch (and the kernel) if somebody is waiting, so the fast path is one fence and one load.
+ * */
+class eventcount:
+    boost::noncopyable
+{
+public:
+    typedef unsigned int key_type;
+
+    eventcount(void):
+        epoch_(0), waiters_(0)
+    {}
+
+    key_type prepare_wait(void)
+    {
+        waiters_.fetch_add(1, memory_order_seq_cst);
+        atomic_thread_fence(memory_order_seq_cst);
+        return epoch_.load(memory_order_seq_cst);
+    }
+
+    void cancel_wait(void)
+    {
+        waiters_.fetch_sub(1, memory_order_relaxed);
+    }
+
+    void commit_wait(key_type key)
+    {
+#ifdef BOOST_LOCKFREE_EVENTCOUNT_USE_FUTEX
+        while (epoch_.load(memory_order_acquire) == key)
+            futex(FUTEX_WAIT_PRIVATE, key);
+#else
+        {
+            boost::unique_lock<boost::mutex> lock(mutex_);
+            while (epoch_.load(memory_order_acquire) == key)
+                cond_.wait(lock);
+        }
+#endif
+        waiters_.fetch_sub(1, memory_order_relaxed);
+    }
+
+    void notify_one(void)
+    {
+        notify(1);
+    }
+
+    void notify_all(void)
+    {
+        notify(INT_MAX);
+    }
+
+private:
+    void notify(int count)
+    {
+        using detail::likely;
+
+        atomic_thread_fence(memory_order_seq_cst);
+        if (likely(waiters_.load(memory_order_relaxed) == 0))
+            return;
+
+#ifdef BOOST_LOCKFREE_EVENTCOUNT_USE_FUTEX
+        epoch_.fetch_add(1, memory_order_seq_cst);
+        futex(FUTEX_WAKE_PRIVATE, count);
+#else
+        {
+            boost::lock_guard<boost::mutex> lock(mutex_);
+            epoch_.fetch_add(1, memory_order_seq_cst);
+        }
+        if (count == 1)
+            cond_.notify_one();
+        else
+            cond_.notify_all();
+#endif
+    }
+
+#ifdef BOOST_LOCKFREE_EVENTCOUNT_USE_FUTEX
+    void futex(int op, unsigned int value)
+    {
+        /* the kernel only looks at the 32 bit value of the epoch */
+        ::syscall(SYS_futex, reinterpret_cast<int*>(&epoch_), op, value, 0, 0, 0);
+    }
+#endif
+
+    atomic<key_type> epoch_;
+    atomic<key_type> waiters_;
+
+#ifndef BOOST_LOCKFREE_EVENTCOUNT_USE_FUTEX
+    boost::mutex mutex_;
+    boost::condition_variable cond_;
+#endif
+};
+
+} /* namespace detail */
+} /* namespace lockfree */
+} /* namespace boost */
+
+#undef BOOST_LOCKFREE_EVENTCOUNT_USE_FUTEX
+
+#endif /* BOOST_LOCKFREE_DETAIL_EVENTCOUNT_HPP_INCLUDED */
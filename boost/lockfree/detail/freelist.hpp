@@ -108,6 +108,13 @@ public:
         deallocate<ThreadSafe>(n);
     }
 
+    /* destructs n and returns it to the allocator instead of the freelist. only safe, if no other thread can access n */
+    void reclaim (T * n)
+    {
+        n->~T();
+        Alloc::deallocate(n, 1);
+    }
+
     ~freelist_stack(void)
     {
         tagged_node_ptr current (pool_);
@@ -65,6 +65,14 @@ struct extract_fixed_sized
     static const bool value = type::value;
 };
 
+template <typename bound_args>
+struct extract_reclamation
+{
+    static const bool has_reclamation = has_arg<bound_args, tag::reclamation>::value;
+
+    typedef typename has_arg<bound_args, tag::reclamation>::type type;
+};
+
 
 } /* namespace detail */
 } /* namespace lockfree */
@@ -0,0 +1,139 @@
+//  selection of the memory reclamation scheme of the node-based data structures
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_LOCKFREE_DETAIL_RECLAMATION_HPP_INCLUDED
+#define BOOST_LOCKFREE_DETAIL_RECLAMATION_HPP_INCLUDED
+
+#include <cstddef>
+
+#include <boost/mpl/void.hpp>
+#include <boost/noncopyable.hpp>
+
+#include <boost/lockfree/detail/atomic.hpp>
+#include <boost/lockfree/epoch_reclamation.hpp>
+#include <boost/lockfree/hazard_pointers.hpp>
+#include <boost/lockfree/policies.hpp>
+
+namespace boost    {
+namespace lockfree {
+namespace detail   {
+
+/* the data structures access their nodes through a guard of the reclaimer:
+ *
+ *   typename reclaimer_t::guard g(reclaimer);
+ *   handle = g.protect(slot, atomic_handle);         // load a handle and make its node safe to dereference
+ *   handle = g.protect(slot, atomic_handle, handle); // same for a handle that has been reloaded by a failed cas
+ *   g.protect_pointer(slot, node);                   // publish a node, the caller validates that it is still reachable
+ *   g.retire(node);                                  // the node has been unlinked
+ *
+ * freelist_reclaimer keeps the original behavior: loads are not published and retired nodes are pushed to the freelist,
+ * which avoids the ABA problem with tagged pointers.
+ * */
+template <typename T, typename Pool>
+class freelist_reclaimer:
+    boost::noncopyable
+{
+public:
+    explicit freelist_reclaimer(Pool & pool):
+        pool_(pool)
+    {}
+
+    class guard:
+        boost::noncopyable
+    {
+    public:
+        explicit guard(freelist_reclaimer & reclaimer):
+            pool_(reclaimer.pool_)
+        {}
+
+        template <typename Handle>
+        Handle protect(std::size_t /* index */, atomic<Handle> const & src)
+        {
+            return src.load(memory_order_acquire);
+        }
+
+        template <typename Handle>
+        Handle protect(std::size_t /* index */, atomic<Handle> const & /* src */, Handle value)
+        {
+            return value;
+        }
+
+        void protect_pointer(std::size_t /* index */, T * /* p */)
+        {}
+
+        void retire(T * p)
+        {
+            pool_.template destruct<true>(p);
+        }
+
+    private:
+        Pool & pool_;
+    };
+
+private:
+    Pool & pool_;
+};
+
+/* deleter of the hazard pointer and epoch domains: returns nodes to the allocator of the pool */
+template <typename Pool>
+struct pool_reclaim
+{
+    pool_reclaim(Pool & pool):
+        pool_(&pool)
+    {}
+
+    template <typename T>
+    void operator()(T * p) const
+    {
+        pool_->reclaim(p);
+    }
+
+    Pool * pool_;
+};
+
+/* deleter of the epoch domain of unordered_map: pushes nodes back to the freelist of the pool */
+template <typename Pool>
+struct pool_recycle
+{
+    pool_recycle(Pool & pool):
+        pool_(&pool)
+    {}
+
+    template <typename T>
+    void operator()(T * p) const
+    {
+        pool_->template destruct<true>(p);
+    }
+
+    Pool * pool_;
+};
+
+template <typename Scheme, typename T, typename Pool>
+struct select_reclaimer;
+
+template <typename T, typename Pool>
+struct select_reclaimer<mpl::void_, T, Pool>
+{
+    typedef freelist_reclaimer<T, Pool> type;
+};
+
+template <typename T, typename Pool>
+struct select_reclaimer<hazard_pointers, T, Pool>
+{
+    typedef hazard_pointer_domain<T, pool_reclaim<Pool>, 2> type;
+};
+
+template <typename T, typename Pool>
+struct select_reclaimer<epoch_based, T, Pool>
+{
+    typedef epoch_domain<T, pool_reclaim<Pool> > type;
+};
+
+} /* namespace detail */
+} /* namespace lockfree */
+} /* namespace boost */
+
+#endif /* BOOST_LOCKFREE_DETAIL_RECLAMATION_HPP_INCLUDED */
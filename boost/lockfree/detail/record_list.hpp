@@ -0,0 +1,82 @@
+//  lock-free list of per-thread records, used by the memory reclamation schemes
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_LOCKFREE_DETAIL_RECORD_LIST_HPP_INCLUDED
+#define BOOST_LOCKFREE_DETAIL_RECORD_LIST_HPP_INCLUDED
+
+#include <boost/noncopyable.hpp>
+
+#include <boost/lockfree/detail/atomic.hpp>
+
+namespace boost    {
+namespace lockfree {
+namespace detail   {
+
+/* Records are owned by one guard at a time. They are claimed with a compare-and-exchange on their in_use_ flag and are
+ * never unlinked, so that other threads can always traverse the list. New records are only allocated, if all existing
+ * records are in use, so the length of the list is bounded by the maximum number of concurrent guards.
+ *
+ * Record must be default constructible and provide the members
+ *   atomic<bool> in_use_;   // initialized to true
+ *   Record * next_;
+ * */
+template <typename Record>
+class record_list:
+    boost::noncopyable
+{
+public:
+    record_list(void):
+        head_(0)
+    {}
+
+    ~record_list(void)
+    {
+        Record * r = head_.load(memory_order_relaxed);
+        while (r) {
+            Record * next = r->next_;
+            delete r;
+            r = next;
+        }
+    }
+
+    Record * acquire(void)
+    {
+        for (Record * r = head_.load(memory_order_acquire); r; r = r->next_) {
+            if (r->in_use_.load(memory_order_relaxed))
+                continue;
+
+            bool expected = false;
+            if (r->in_use_.compare_exchange_strong(expected, true, memory_order_acquire, memory_order_relaxed))
+                return r;
+        }
+
+        Record * r = new Record();
+        Record * old_head = head_.load(memory_order_relaxed);
+        do {
+            r->next_ = old_head;
+        } while (!head_.compare_exchange_weak(old_head, r, memory_order_release, memory_order_relaxed));
+        return r;
+    }
+
+    void release(Record * r)
+    {
+        r->in_use_.store(false, memory_order_release);
+    }
+
+    Record * first(void) const
+    {
+        return head_.load(memory_order_acquire);
+    }
+
+private:
+    atomic<Record*> head_;
+};
+
+} /* namespace detail */
+} /* namespace lockfree */
+} /* namespace boost */
+
+#endif /* BOOST_LOCKFREE_DETAIL_RECORD_LIST_HPP_INCLUDED */
@@ -0,0 +1,206 @@
+//  safe memory reclamation with epochs
+//
+//  Fraser, K.,
+//  "Practical lock-freedom"
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_LOCKFREE_EPOCH_RECLAMATION_HPP_INCLUDED
+#define BOOST_LOCKFREE_EPOCH_RECLAMATION_HPP_INCLUDED
+
+#include <cstddef>
+#include <vector>
+
+#include <boost/checked_delete.hpp>
+#include <boost/noncopyable.hpp>
+
+#include <boost/lockfree/detail/atomic.hpp>
+#include <boost/lockfree/detail/record_list.hpp>
+
+namespace boost    {
+namespace lockfree {
+
+/** The epoch_domain class frees objects of type T, once no thread can access them any more.
+ *
+ *  A thread that accesses shared objects creates a \ref guard, which announces the current global epoch. An object that
+ *  has been unlinked from the shared data structure is passed to \ref guard::retire and tagged with the global epoch. The
+ *  global epoch is advanced, once all active guards have announced it, and objects are handed to the Deleter, once the
+ *  epoch has advanced twice since they have been retired. Other than with \ref boost::lockfree::hazard_pointer_domain, the
+ *  accessed objects do not need to be published one by one, but a guard that is never destroyed prevents all reclamation.
+ *
+ *  \note Creating a guard is lock-free, unless all per-thread records are in use, in which case a new record is allocated.
+ *        Retired objects are stored per record and freed when the record is used again; the remaining ones are freed when
+ *        the domain is destroyed.
+ *
+ *  \b Requirements:
+ *  - Deleter must be copyable and callable with a T *
+ * */
+template <typename T,
+          typename Deleter = boost::checked_deleter<T> >
+class epoch_domain:
+    boost::noncopyable
+{
+#ifndef BOOST_DOXYGEN_INVOKED
+    typedef std::size_t epoch_t;
+
+    /* objects retired in epoch e are stored in bucket e % 3, so each record keeps three generations of garbage */
+    static const std::size_t bucket_count = 3;
+
+    struct record
+    {
+        record(void):
+            in_use_(true), next_(0), epoch_(0), retired_since_advance_(0)
+        {
+            for (std::size_t i = 0; i != bucket_count; ++i)
+                bucket_epoch_[i] = 0;
+        }
+
+        detail::atomic<bool> in_use_;
+        record * next_;
+        detail::atomic<epoch_t> epoch_; /* (epoch << 1) | 1 while a guard is active, 0 otherwise */
+        std::vector<T*> buckets_[bucket_count];
+        epoch_t bucket_epoch_[bucket_count];
+        std::size_t retired_since_advance_;
+    };
+
+public:
+    class guard;
+    friend class guard;
+#endif
+
+public:
+    /** Constructs a domain
+     *
+     * \param deleter is called for each retired object, once it can be freed
+     * \param advance_threshold is the number of objects a guard retires, before it tries to advance the epoch
+     * */
+    explicit epoch_domain(Deleter const & deleter = Deleter(), std::size_t advance_threshold = 64):
+        epoch_(0), deleter_(deleter), advance_threshold_(advance_threshold)
+    {}
+
+    /** Destroys the domain, frees all retired objects.
+     *
+     * \pre no guard of this domain exists
+     * */
+    ~epoch_domain(void)
+    {
+        for (record * r = records_.first(); r; r = r->next_)
+            for (std::size_t i = 0; i != bucket_count; ++i)
+                free_bucket(*r, i);
+    }
+
+    /** A guard announces that a thread accesses shared objects.
+     *
+     *  No object that has been retired after the guard was created is freed, before the guard is destroyed.
+     * */
+    class guard:
+        boost::noncopyable
+    {
+    public:
+        explicit guard(epoch_domain & domain):
+            domain_(domain), record_(domain.records_.acquire())
+        {
+            epoch_t epoch = domain_.epoch_.load(memory_order_relaxed);
+            record_->epoch_.store((epoch << 1) | 1, memory_order_relaxed);
+            /* pairs with the fence in try_advance */
+            detail::atomic_thread_fence(detail::memory_order_seq_cst);
+            domain_.collect(*record_, epoch);
+        }
+
+        ~guard(void)
+        {
+            record_->epoch_.store(0, memory_order_release);
+            domain_.records_.release(record_);
+        }
+
+        /** Loads src.
+         *
+         *  The objects do not need to be published, the guard protects everything that is reachable while it exists.
+         * */
+        template <typename Handle>
+        Handle protect(std::size_t /* index */, detail::atomic<Handle> const & src)
+        {
+            return src.load(memory_order_acquire);
+        }
+
+        /// \copydoc boost::lockfree::hazard_pointer_domain::guard::protect(std::size_t, detail::atomic<Handle> const &, Handle)
+        template <typename Handle>
+        Handle protect(std::size_t /* index */, detail::atomic<Handle> const & /* src */, Handle value)
+        {
+            return value;
+        }
+
+        /// \copydoc boost::lockfree::hazard_pointer_domain::guard::protect_pointer
+        void protect_pointer(std::size_t /* index */, T * /* p */)
+        {}
+
+        /** Retires p, which has been unlinked from the shared data structure.
+         *
+         * p will be passed to the deleter, once the global epoch has advanced twice.
+         * */
+        void retire(T * p)
+        {
+            /* the epoch has to be read after p has been unlinked */
+            detail::atomic_thread_fence(detail::memory_order_seq_cst);
+            epoch_t epoch = domain_.epoch_.load(memory_order_relaxed);
+            domain_.collect(*record_, epoch);
+
+            std::size_t bucket = epoch % bucket_count;
+            record_->bucket_epoch_[bucket] = epoch;
+            record_->buckets_[bucket].push_back(p);
+
+            if (++record_->retired_since_advance_ >= domain_.advance_threshold_) {
+                record_->retired_since_advance_ = 0;
+                domain_.try_advance(epoch);
+            }
+        }
+
+    private:
+        epoch_domain & domain_;
+        record * record_;
+    };
+
+private:
+#ifndef BOOST_DOXYGEN_INVOKED
+    /* free all buckets of r, that have been retired at least two epochs before epoch */
+    void collect(record & r, epoch_t epoch)
+    {
+        for (std::size_t i = 0; i != bucket_count; ++i)
+            if (r.bucket_epoch_[i] + 2 <= epoch)
+                free_bucket(r, i);
+    }
+
+    void try_advance(epoch_t epoch)
+    {
+        detail::atomic_thread_fence(detail::memory_order_seq_cst);
+
+        for (record * r = records_.first(); r; r = r->next_) {
+            epoch_t announced = r->epoch_.load(memory_order_relaxed);
+            if ((announced & 1) && (announced >> 1) != epoch)
+                return; /* a guard has not seen the current epoch yet */
+        }
+
+        epoch_.compare_exchange_strong(epoch, epoch + 1, memory_order_release, memory_order_relaxed);
+    }
+
+    void free_bucket(record & r, std::size_t i)
+    {
+        std::vector<T*> & bucket = r.buckets_[i];
+        for (typename std::vector<T*>::iterator it = bucket.begin(); it != bucket.end(); ++it)
+            deleter_(*it);
+        bucket.clear();
+    }
+
+    detail::atomic<epoch_t> epoch_;
+    detail::record_list<record> records_;
+    Deleter deleter_;
+    const std::size_t advance_threshold_;
+#endif
+};
+
+} /* namespace lockfree */
+} /* namespace boost */
+
+#endif /* BOOST_LOCKFREE_EPOCH_RECLAMATION_HPP_INCLUDED */
@@ -0,0 +1,218 @@
+//  safe memory reclamation with hazard pointers
+//
+//  Michael, M. M.,
+//  "Hazard pointers: safe memory reclamation for lock-free objects"
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_LOCKFREE_HAZARD_POINTERS_HPP_INCLUDED
+#define BOOST_LOCKFREE_HAZARD_POINTERS_HPP_INCLUDED
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include <boost/assert.hpp>
+#include <boost/checked_delete.hpp>
+#include <boost/noncopyable.hpp>
+
+#include <boost/lockfree/detail/atomic.hpp>
+#include <boost/lockfree/detail/record_list.hpp>
+
+namespace boost    {
+namespace lockfree {
+
+/** The hazard_pointer_domain class frees objects of type T, once no thread can access them any more.
+ *
+ *  A thread that accesses shared objects creates a \ref guard and publishes every object it dereferences in one of the
+ *  Slots hazard pointers of the guard. An object that has been unlinked from the shared data structure is passed to
+ *  \ref guard::retire. It is handed to the Deleter during a later scan, which skips all objects that are published by
+ *  any hazard pointer. The scan runs whenever the number of retired objects of a guard reaches the scan threshold.
+ *
+ *  \note Creating a guard is lock-free, unless all per-thread records are in use, in which case a new record is allocated.
+ *        Retired objects are stored per record and freed during a later scan; the remaining ones are freed when the domain
+ *        is destroyed.
+ *
+ *  \b Requirements:
+ *  - Deleter must be copyable and callable with a T *
+ * */
+template <typename T,
+          typename Deleter = boost::checked_deleter<T>,
+          std::size_t Slots = 2>
+class hazard_pointer_domain:
+    boost::noncopyable
+{
+#ifndef BOOST_DOXYGEN_INVOKED
+    struct record
+    {
+        record(void):
+            in_use_(true), next_(0)
+        {
+            for (std::size_t i = 0; i != Slots; ++i)
+                hazards_[i].store(0, memory_order_relaxed);
+        }
+
+        detail::atomic<bool> in_use_;
+        record * next_;
+        detail::atomic<T*> hazards_[Slots];
+        std::vector<T*> retired_;
+        std::vector<T*> protected_; /* scratch space for scan */
+    };
+
+public:
+    class guard;
+    friend class guard;
+#endif
+
+public:
+    /** Constructs a domain
+     *
+     * \param deleter is called for each retired object, once it can be freed
+     * \param scan_threshold is the number of retired objects per guard, that triggers a scan
+     * */
+    explicit hazard_pointer_domain(Deleter const & deleter = Deleter(), std::size_t scan_threshold = 64):
+        deleter_(deleter), scan_threshold_(scan_threshold)
+    {}
+
+    /** Destroys the domain, frees all retired objects.
+     *
+     * \pre no guard of this domain exists
+     * */
+    ~hazard_pointer_domain(void)
+    {
+        for (record * r = records_.first(); r; r = r->next_)
+            free_all(r->retired_);
+    }
+
+    /** A guard owns the hazard pointers of one thread, while it accesses shared objects.
+     *
+     *  The hazard pointers are cleared, when the guard is destroyed.
+     * */
+    class guard:
+        boost::noncopyable
+    {
+    public:
+        explicit guard(hazard_pointer_domain & domain):
+            domain_(domain), record_(domain.records_.acquire())
+        {}
+
+        ~guard(void)
+        {
+            for (std::size_t i = 0; i != Slots; ++i)
+                record_->hazards_[i].store(0, memory_order_release);
+            domain_.records_.release(record_);
+        }
+
+        /** Loads src and publishes the object it refers to in hazard pointer index.
+         *
+         * \returns a value of src, that was current after it had been published.
+         * */
+        template <typename Handle>
+        Handle protect(std::size_t index, detail::atomic<Handle> const & src)
+        {
+            return protect(index, src, src.load(memory_order_relaxed));
+        }
+
+        /** Publishes value, which has been loaded from src, in hazard pointer index.
+         *
+         * \returns value, or a newer value of src, that was current after it had been published.
+         * */
+        template <typename Handle>
+        Handle protect(std::size_t index, detail::atomic<Handle> const & src, Handle value)
+        {
+            for (;;) {
+                protect_pointer(index, pointer_of(value));
+                Handle current = src.load(memory_order_acquire);
+                if (current == value)
+                    return value;
+                value = current;
+            }
+        }
+
+        /** Publishes p in hazard pointer index.
+         *
+         * \note The caller has to validate afterwards, that p is still reachable.
+         * */
+        void protect_pointer(std::size_t index, T * p)
+        {
+            BOOST_ASSERT(index < Slots);
+            record_->hazards_[index].store(p, memory_order_relaxed);
+            detail::atomic_thread_fence(detail::memory_order_seq_cst);
+        }
+
+        /** Retires p, which has been unlinked from the shared data structure.
+         *
+         * p will be passed to the deleter, once no hazard pointer refers to it.
+         * */
+        void retire(T * p)
+        {
+            record_->retired_.push_back(p);
+            if (record_->retired_.size() >= domain_.scan_threshold_)
+                domain_.scan(*record_);
+        }
+
+    private:
+        static T * pointer_of(T * p)
+        {
+            return p;
+        }
+
+        template <typename Handle>
+        static T * pointer_of(Handle const & handle)
+        {
+            return handle.get_ptr();
+        }
+
+        hazard_pointer_domain & domain_;
+        record * record_;
+    };
+
+private:
+#ifndef BOOST_DOXYGEN_INVOKED
+    void scan(record & owner)
+    {
+        /* pairs with the fence in protect_pointer: an object that was unlinked before this fence is either visible in a
+         * hazard pointer, or the protecting thread will fail to validate it */
+        detail::atomic_thread_fence(detail::memory_order_seq_cst);
+
+        std::vector<T*> & hazards = owner.protected_;
+        hazards.clear();
+        for (record * r = records_.first(); r; r = r->next_) {
+            for (std::size_t i = 0; i != Slots; ++i) {
+                T * p = r->hazards_[i].load(memory_order_relaxed);
+                if (p)
+                    hazards.push_back(p);
+            }
+        }
+        std::sort(hazards.begin(), hazards.end());
+
+        std::vector<T*> & retired = owner.retired_;
+        typename std::vector<T*>::iterator kept = retired.begin();
+        for (typename std::vector<T*>::iterator it = retired.begin(); it != retired.end(); ++it) {
+            if (std::binary_search(hazards.begin(), hazards.end(), *it))
+                *kept++ = *it;
+            else
+                deleter_(*it);
+        }
+        retired.erase(kept, retired.end());
+    }
+
+    void free_all(std::vector<T*> & objects)
+    {
+        for (typename std::vector<T*>::iterator it = objects.begin(); it != objects.end(); ++it)
+            deleter_(*it);
+        objects.clear();
+    }
+
+    detail::record_list<record> records_;
+    Deleter deleter_;
+    const std::size_t scan_threshold_;
+#endif
+};
+
+} /* namespace lockfree */
+} /* namespace boost */
+
+#endif /* BOOST_LOCKFREE_HAZARD_POINTERS_HPP_INCLUDED */
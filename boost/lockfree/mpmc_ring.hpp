@@ -0,0 +1,673 @@
+//  lock-free bounded multi-producer/multi-consumer ringbuffer
+//  based on the array-based queue by Dmitry Vyukov
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_LOCKFREE_MPMC_RING_HPP_INCLUDED
+#define BOOST_LOCKFREE_MPMC_RING_HPP_INCLUDED
+
+#include <cstddef>
+#include <new>
+
+#include <boost/assert.hpp>
+#ifdef BOOST_NO_CXX11_DELETED_FUNCTIONS
+#include <boost/noncopyable.hpp>
+#endif
+#include <boost/mpl/if.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/aligned_storage.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+
+#include <boost/lockfree/detail/atomic.hpp>
+#include <boost/lockfree/detail/branch_hints.hpp>
+#include <boost/lockfree/detail/copy_payload.hpp>
+#include <boost/lockfree/detail/parameter.hpp>
+#include <boost/lockfree/detail/prefix.hpp>
+
+namespace boost    {
+namespace lockfree {
+namespace detail   {
+
+typedef parameter::parameters<boost::parameter::optional<tag::capacity>,
+                              boost::parameter::optional<tag::allocator>
+                             > mpmc_ring_signature;
+
+/* smallest power of two, which is not smaller than N and at least 2 */
+template <std::size_t N, std::size_t P = 2, bool Done = (P >= N)>
+struct ring_size
+{
+    static const std::size_t value = ring_size<N, P * 2>::value;
+};
+
+template <std::size_t N, std::size_t P>
+struct ring_size<N, P, true>
+{
+    static const std::size_t value = P;
+};
+
+inline std::size_t runtime_ring_size(std::size_t n)
+{
+    std::size_t size = 2;
+    while (size < n)
+        size *= 2;
+    return size;
+}
+
+/* every slot carries a sequence number, which tells producers and consumers
+ * whether the slot is ready for the position they have claimed:
+ *  - sequence == position: the slot is free for the producer of this position
+ *  - sequence == position + 1: the slot holds the element of this position
+ * after consuming, the sequence is advanced by the size of the ring, so that
+ * the slot becomes free for the producer of the next lap.
+ * if the copy constructor of T throws, the producer still publishes the slot, but marks it as holding no element, so
+ * that the consumer of this position skips it instead of waiting forever.
+ * */
+template <typename T>
+struct mpmc_ring_slot
+{
+    atomic<std::size_t> sequence;
+    bool constructed;
+    typename boost::aligned_storage<sizeof(T), boost::alignment_of<T>::value>::type storage;
+
+    T * data(void)
+    {
+        return static_cast<T*>(static_cast<void*>(&storage));
+    }
+};
+
+template <typename T>
+class mpmc_ring_base
+#ifdef BOOST_NO_CXX11_DELETED_FUNCTIONS
+        : boost::noncopyable
+#endif
+{
+#ifndef BOOST_DOXYGEN_INVOKED
+    typedef std::size_t size_t;
+    static const int padding_size = BOOST_LOCKFREE_CACHELINE_BYTES - sizeof(size_t);
+    char padding0[BOOST_LOCKFREE_CACHELINE_BYTES]; /* keep the positions away from the previous members */
+    atomic<size_t> enqueue_pos_;
+    char padding1[padding_size]; /* force enqueue_pos_ and dequeue_pos_ to different cache lines */
+    atomic<size_t> dequeue_pos_;
+    char padding2[padding_size];
+
+#ifndef BOOST_NO_CXX11_DELETED_FUNCTIONS
+    mpmc_ring_base(mpmc_ring_base const &) = delete;
+    mpmc_ring_base(mpmc_ring_base &&)      = delete;
+    const mpmc_ring_base& operator=( const mpmc_ring_base& ) = delete;
+#endif
+
+protected:
+    typedef mpmc_ring_slot<T> slot;
+
+    mpmc_ring_base(void):
+        enqueue_pos_(0), dequeue_pos_(0)
+    {}
+
+    static void initialize(slot * slots, size_t size)
+    {
+        for (size_t i = 0; i != size; ++i)
+            slots[i].sequence.store(i, memory_order_relaxed);
+    }
+
+    void destroy_elements(slot * slots, size_t size)
+    {
+        size_t const mask = size - 1;
+        size_t const end = enqueue_pos_.load(memory_order_relaxed);
+        for (size_t pos = dequeue_pos_.load(memory_order_relaxed); pos != end; ++pos) {
+            slot & s = slots[pos & mask];
+            if (s.sequence.load(memory_order_relaxed) == pos + 1 && s.constructed)
+                s.data()->~T();
+        }
+    }
+
+    /* publish a claimed slot, which is skipped by the consumer unless it holds an element */
+    static void publish(slot & s, size_t seq, bool constructed, memory_order order)
+    {
+        s.constructed = constructed;
+        s.sequence.store(seq, order);
+    }
+
+    static void construct(slot & s, size_t pos, T const & t, memory_order order)
+    {
+        try {
+            new (s.data()) T(t);
+        } catch(...) {
+            publish(s, pos + 1, false, order);
+            throw;
+        }
+        publish(s, pos + 1, true, order);
+    }
+
+    /* move the element of a claimed slot to ret and release the slot for the next lap. the element is destroyed and the
+     * slot is released even if the assignment throws. */
+    template <typename U>
+    static void consume(slot & s, size_t pos, size_t size, U & ret, memory_order order)
+    {
+        T * element = s.data();
+        try {
+            detail::copy_payload(*element, ret);
+        } catch(...) {
+            element->~T();
+            s.sequence.store(pos + size, order);
+            throw;
+        }
+        element->~T();
+        s.sequence.store(pos + size, order);
+    }
+
+    bool push(T const & t, slot * slots, size_t size)
+    {
+        using detail::likely;
+
+        size_t const mask = size - 1;
+        size_t pos = enqueue_pos_.load(memory_order_relaxed);
+
+        for (;;) {
+            slot & s = slots[pos & mask];
+            size_t seq = s.sequence.load(memory_order_acquire);
+            std::ptrdiff_t dif = static_cast<std::ptrdiff_t>(seq - pos);
+
+            if (likely(dif == 0)) {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, memory_order_relaxed)) {
+                    construct(s, pos, t, memory_order_release);
+                    return true;
+                }
+            } else if (dif < 0)
+                return false; /* ring is full */
+            else
+                pos = enqueue_pos_.load(memory_order_relaxed);
+        }
+    }
+
+    template <typename U>
+    bool pop(U & ret, slot * slots, size_t size)
+    {
+        using detail::likely;
+
+        size_t const mask = size - 1;
+        size_t pos = dequeue_pos_.load(memory_order_relaxed);
+
+        for (;;) {
+            slot & s = slots[pos & mask];
+            size_t seq = s.sequence.load(memory_order_acquire);
+            std::ptrdiff_t dif = static_cast<std::ptrdiff_t>(seq - (pos + 1));
+
+            if (likely(dif == 0)) {
+                if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, memory_order_relaxed)) {
+                    if (likely(s.constructed)) {
+                        consume(s, pos, size, ret, memory_order_release);
+                        return true;
+                    }
+
+                    /* skip the slot of a push that failed */
+                    s.sequence.store(pos + size, memory_order_release);
+                    pos = dequeue_pos_.load(memory_order_relaxed);
+                }
+            } else if (dif < 0)
+                return false; /* ring is empty */
+            else
+                pos = dequeue_pos_.load(memory_order_relaxed);
+        }
+    }
+
+    bool unsynchronized_push(T const & t, slot * slots, size_t size)
+    {
+        size_t const pos = enqueue_pos_.load(memory_order_relaxed);
+        slot & s = slots[pos & (size - 1)];
+        if (s.sequence.load(memory_order_relaxed) != pos)
+            return false;
+
+        new (s.data()) T(t);
+        publish(s, pos + 1, true, memory_order_relaxed);
+        enqueue_pos_.store(pos + 1, memory_order_relaxed);
+        return true;
+    }
+
+    template <typename U>
+    bool unsynchronized_pop(U & ret, slot * slots, size_t size)
+    {
+        for (;;) {
+            size_t const pos = dequeue_pos_.load(memory_order_relaxed);
+            slot & s = slots[pos & (size - 1)];
+            if (s.sequence.load(memory_order_relaxed) != pos + 1)
+                return false;
+
+            dequeue_pos_.store(pos + 1, memory_order_relaxed);
+            if (s.constructed) {
+                consume(s, pos, size, ret, memory_order_relaxed);
+                return true;
+            }
+
+            /* skip the slot of a push that failed */
+            s.sequence.store(pos + size, memory_order_relaxed);
+        }
+    }
+
+    bool empty(slot * slots, size_t size) const
+    {
+        size_t const pos = dequeue_pos_.load(memory_order_relaxed);
+        return slots[pos & (size - 1)].sequence.load(memory_order_acquire) != pos + 1;
+    }
+
+public:
+    bool is_lock_free(void) const
+    {
+        return enqueue_pos_.is_lock_free() && dequeue_pos_.is_lock_free();
+    }
+#endif
+};
+
+template <typename T, std::size_t MaxSize>
+class compile_time_sized_mpmc_ring:
+    public mpmc_ring_base<T>
+{
+    typedef std::size_t size_t;
+    typedef typename mpmc_ring_base<T>::slot slot;
+    static const size_t ring_size = detail::ring_size<MaxSize>::value;
+    slot slots_[ring_size];
+
+public:
+    compile_time_sized_mpmc_ring(void)
+    {
+        mpmc_ring_base<T>::initialize(slots_, ring_size);
+    }
+
+    ~compile_time_sized_mpmc_ring(void)
+    {
+        mpmc_ring_base<T>::destroy_elements(slots_, ring_size);
+    }
+
+    size_t capacity(void) const
+    {
+        return ring_size;
+    }
+
+protected:
+    slot * slots(void)
+    {
+        return slots_;
+    }
+
+    size_t size(void) const
+    {
+        return ring_size;
+    }
+};
+
+template <typename T, typename Alloc>
+class runtime_sized_mpmc_ring:
+    public mpmc_ring_base<T>,
+    private Alloc::template rebind<mpmc_ring_slot<T> >::other
+{
+    typedef std::size_t size_t;
+    typedef typename mpmc_ring_base<T>::slot slot;
+    typedef typename Alloc::template rebind<slot>::other slot_allocator;
+
+    size_t ring_size_;
+    slot * slots_;
+
+    void allocate(void)
+    {
+        slots_ = &*slot_allocator::allocate(ring_size_);
+        for (size_t i = 0; i != ring_size_; ++i)
+            new (slots_ + i) slot();
+        mpmc_ring_base<T>::initialize(slots_, ring_size_);
+    }
+
+public:
+    explicit runtime_sized_mpmc_ring(size_t max_elements):
+        ring_size_(runtime_ring_size(max_elements))
+    {
+        allocate();
+    }
+
+    template <typename U>
+    runtime_sized_mpmc_ring(typename Alloc::template rebind<U>::other const & alloc, size_t max_elements):
+        slot_allocator(alloc), ring_size_(runtime_ring_size(max_elements))
+    {
+        allocate();
+    }
+
+    runtime_sized_mpmc_ring(Alloc const & alloc, size_t max_elements):
+        slot_allocator(alloc), ring_size_(runtime_ring_size(max_elements))
+    {
+        allocate();
+    }
+
+    ~runtime_sized_mpmc_ring(void)
+    {
+        mpmc_ring_base<T>::destroy_elements(slots_, ring_size_);
+        for (size_t i = 0; i != ring_size_; ++i)
+            slots_[i].~slot();
+        slot_allocator::deallocate(slots_, ring_size_);
+    }
+
+    size_t capacity(void) const
+    {
+        return ring_size_;
+    }
+
+protected:
+    slot * slots(void)
+    {
+        return slots_;
+    }
+
+    size_t size(void) const
+    {
+        return ring_size_;
+    }
+};
+
+template <typename T, typename A0, typename A1>
+struct make_mpmc_ring
+{
+    typedef typename mpmc_ring_signature::bind<A0, A1>::type bound_args;
+
+    typedef extract_capacity<bound_args> extract_capacity_t;
+
+    static const bool runtime_sized = !extract_capacity_t::has_capacity;
+    static const size_t capacity    =  extract_capacity_t::capacity;
+
+    typedef extract_allocator<bound_args, T> extract_allocator_t;
+    typedef typename extract_allocator_t::type allocator;
+
+    // allocator argument is only sane, for run-time sized ringbuffers
+    BOOST_STATIC_ASSERT((mpl::if_<mpl::bool_<!runtime_sized>,
+                                  mpl::bool_<!extract_allocator_t::has_allocator>,
+                                  mpl::true_
+                                 >::type::value));
+
+    typedef typename mpl::if_c<runtime_sized,
+                               runtime_sized_mpmc_ring<T, allocator>,
+                               compile_time_sized_mpmc_ring<T, capacity>
+                              >::type ring_type;
+};
+
+} /* namespace detail */
+
+
+/** The mpmc_ring class provides a bounded multi-writer/multi-reader fifo queue, pushing and popping is lock-free.
+ *
+ *  Elements are stored in a contiguous array of slots, each of which carries a sequence number. Producers and consumers
+ *  claim a position with a single compare-and-exchange and then use the sequence number of the slot to tell whether it
+ *  is ready, so no nodes are allocated and no tagged pointers are required. In contrast to \ref boost::lockfree::queue,
+ *  the capacity is always fixed.
+ *
+ *  The number of slots is the requested capacity rounded up to a power of two (and at least 2). The ring can hold as many
+ *  elements as it has slots.
+ *
+ *  \b Policies:
+ *  - \c boost::lockfree::capacity<>, optional <br>
+ *    If this template argument is passed to the options, the size of the ringbuffer is set at compile-time.
+ *
+ *  - \c boost::lockfree::allocator<>, defaults to \c boost::lockfree::allocator<std::allocator<T>> <br>
+ *    Specifies the allocator that is used to allocate the ringbuffer. This option is only valid, if the ringbuffer is configured
+ *    to be sized at run-time
+ *
+ *  \b Requirements:
+ *  - T must have a copy constructor
+ *  - T must be assignable to the type that it is popped to
+ *
+ *  If the copy constructor of T throws during a push, the exception is propagated and the ring remains usable, but the
+ *  position claimed by the push stays empty until it is skipped by a consumer, so empty() may report false for it. If
+ *  the assignment throws during a pop, the exception is propagated and the popped element is lost.
+ * */
+#ifndef BOOST_DOXYGEN_INVOKED
+template <typename T,
+          class A0 = boost::parameter::void_,
+          class A1 = boost::parameter::void_>
+#else
+template <typename T, ...Options>
+#endif
+class mpmc_ring:
+    public detail::make_mpmc_ring<T, A0, A1>::ring_type
+{
+private:
+
+#ifndef BOOST_DOXYGEN_INVOKED
+    typedef typename detail::make_mpmc_ring<T, A0, A1>::ring_type base_type;
+    static const bool runtime_sized = detail::make_mpmc_ring<T, A0, A1>::runtime_sized;
+    typedef typename detail::make_mpmc_ring<T, A0, A1>::allocator allocator_arg;
+
+    struct implementation_defined
+    {
+        typedef allocator_arg allocator;
+        typedef std::size_t size_type;
+    };
+#endif
+
+public:
+    typedef T value_type;
+    typedef typename implementation_defined::allocator allocator;
+    typedef typename implementation_defined::size_type size_type;
+
+    /** Constructs a mpmc_ring
+     *
+     *  \pre mpmc_ring must be configured to be sized at compile-time
+     */
+    // @{
+    mpmc_ring(void)
+    {
+        BOOST_ASSERT(!runtime_sized);
+    }
+
+    template <typename U>
+    explicit mpmc_ring(typename allocator::template rebind<U>::other const & alloc)
+    {
+        // just for API compatibility: we don't actually need an allocator
+        BOOST_STATIC_ASSERT(!runtime_sized);
+    }
+
+    explicit mpmc_ring(allocator const & alloc)
+    {
+        // just for API compatibility: we don't actually need an allocator
+        BOOST_ASSERT(!runtime_sized);
+    }
+    // @}
+
+
+    /** Constructs a mpmc_ring for at least element_count elements
+     *
+     *  \pre mpmc_ring must be configured to be sized at run-time
+     */
+    // @{
+    explicit mpmc_ring(size_type element_count):
+        base_type(element_count)
+    {
+        BOOST_ASSERT(runtime_sized);
+    }
+
+    template <typename U>
+    mpmc_ring(size_type element_count, typename allocator::template rebind<U>::other const & alloc):
+        base_type(alloc, element_count)
+    {
+        BOOST_STATIC_ASSERT(runtime_sized);
+    }
+
+    mpmc_ring(size_type element_count, allocator_arg const & alloc):
+        base_type(alloc, element_count)
+    {
+        BOOST_ASSERT(runtime_sized);
+    }
+    // @}
+
+#ifdef BOOST_DOXYGEN_INVOKED
+    /**
+     * \return true, if implementation is lock-free.
+     * */
+    bool is_lock_free (void) const;
+
+    /**
+     * \return the number of elements, that the ring is able to hold.
+     * */
+    size_type capacity (void) const;
+#endif
+
+    /** Check if the ring is empty
+     *
+     * \return true, if the ring is empty, false otherwise
+     * \note The result is only accurate, if no other thread modifies the ring. Therefore it is rarely practical to use this
+     *       value in program logic.
+     * */
+    bool empty(void)
+    {
+        return base_type::empty(base_type::slots(), base_type::size());
+    }
+
+    /** Pushes object t to the ring.
+     *
+     * \post object will be pushed to the ring, unless it is full.
+     * \returns true, if the push operation is successful.
+     *
+     * \note Thread-safe and non-blocking
+     * */
+    bool push(T const & t)
+    {
+        return base_type::push(t, base_type::slots(), base_type::size());
+    }
+
+    /** Pushes object t to the ring.
+     *
+     * \post object will be pushed to the ring, unless it is full.
+     * \returns true, if the push operation is successful.
+     *
+     * \note Thread-safe and non-blocking. Equivalent to push(), since the ring never allocates memory.
+     * */
+    bool bounded_push(T const & t)
+    {
+        return push(t);
+    }
+
+    /** Pushes object t to the ring.
+     *
+     * \post object will be pushed to the ring, unless it is full.
+     * \returns true, if the push operation is successful.
+     *
+     * \note Not Thread-safe
+     * */
+    bool unsynchronized_push(T const & t)
+    {
+        return base_type::unsynchronized_push(t, base_type::slots(), base_type::size());
+    }
+
+    /** Pops object from ring.
+     *
+     * \post if pop operation is successful, object will be copied to ret.
+     * \returns true, if the pop operation is successful, false if ring was empty.
+     *
+     * \note Thread-safe and non-blocking
+     * */
+    bool pop (T & ret)
+    {
+        return pop<T>(ret);
+    }
+
+    /** Pops object from ring.
+     *
+     * \pre type U must be constructible by T and copyable, or T must be convertible to U
+     * \post if pop operation is successful, object will be copied to ret.
+     * \returns true, if the pop operation is successful, false if ring was empty.
+     *
+     * \note Thread-safe and non-blocking
+     * */
+    template <typename U>
+    bool pop (U & ret)
+    {
+        return base_type::pop(ret, base_type::slots(), base_type::size());
+    }
+
+    /** Pops object from ring.
+     *
+     * \post if pop operation is successful, object will be copied to ret.
+     * \returns true, if the pop operation is successful, false if ring was empty.
+     *
+     * \note Not thread-safe, but non-blocking
+     * */
+    bool unsynchronized_pop (T & ret)
+    {
+        return unsynchronized_pop<T>(ret);
+    }
+
+    /** Pops object from ring.
+     *
+     * \pre type U must be constructible by T and copyable, or T must be convertible to U
+     * \post if pop operation is successful, object will be copied to ret.
+     * \returns true, if the pop operation is successful, false if ring was empty.
+     *
+     * \note Not thread-safe, but non-blocking
+     * */
+    template <typename U>
+    bool unsynchronized_pop (U & ret)
+    {
+        return base_type::unsynchronized_pop(ret, base_type::slots(), base_type::size());
+    }
+
+    /** consumes one element via a functor
+     *
+     *  pops one element from the ring and applies the functor on this object
+     *
+     * \returns true, if one element was consumed
+     *
+     * \note Thread-safe and non-blocking, if functor is thread-safe and non-blocking
+     * */
+    template <typename Functor>
+    bool consume_one(Functor & f)
+    {
+        T element;
+        bool success = pop(element);
+        if (success)
+            f(element);
+
+        return success;
+    }
+
+    /// \copydoc boost::lockfree::mpmc_ring::consume_one(Functor & rhs)
+    template <typename Functor>
+    bool consume_one(Functor const & f)
+    {
+        T element;
+        bool success = pop(element);
+        if (success)
+            f(element);
+
+        return success;
+    }
+
+    /** consumes all elements via a functor
+     *
+     * sequentially pops all elements from the ring and applies the functor on each object
+     *
+     * \returns number of elements that are consumed
+     *
+     * \note Thread-safe and non-blocking, if functor is thread-safe and non-blocking
+     * */
+    template <typename Functor>
+    size_type consume_all(Functor & f)
+    {
+        size_type element_count = 0;
+        while (consume_one(f))
+            element_count += 1;
+
+        return element_count;
+    }
+
+    /// \copydoc boost::lockfree::mpmc_ring::consume_all(Functor & rhs)
+    template <typename Functor>
+    size_type consume_all(Functor const & f)
+    {
+        size_type element_count = 0;
+        while (consume_one(f))
+            element_count += 1;
+
+        return element_count;
+    }
+};
+
+} /* namespace lockfree */
+} /* namespace boost */
+
+
+#endif /* BOOST_LOCKFREE_MPMC_RING_HPP_INCLUDED */
@@ -0,0 +1,501 @@
+//  lock-free multi-producer/single-consumer queue
+//  based on the intrusive node-based queue by Dmitry Vyukov
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_LOCKFREE_MPSC_QUEUE_HPP_INCLUDED
+#define BOOST_LOCKFREE_MPSC_QUEUE_HPP_INCLUDED
+
+#include <cstddef>
+#include <memory>
+#include <new>
+
+#include <boost/config.hpp>
+#ifdef BOOST_NO_CXX11_DELETED_FUNCTIONS
+#include <boost/noncopyable.hpp>
+#endif
+
+#include <boost/lockfree/detail/atomic.hpp>
+#include <boost/lockfree/detail/branch_hints.hpp>
+#include <boost/lockfree/detail/copy_payload.hpp>
+#include <boost/lockfree/detail/parameter.hpp>
+#include <boost/lockfree/detail/prefix.hpp>
+
+namespace boost    {
+namespace lockfree {
+namespace detail   {
+
+typedef parameter::parameters<boost::parameter::optional<tag::allocator>
+                             > mpsc_queue_signature;
+
+} /* namespace detail */
+
+/** Base class for the elements of an \ref boost::lockfree::intrusive_mpsc_queue.
+ *
+ *  An element may be in at most one queue at a time, but may be pushed again once it has been popped.
+ * */
+class mpsc_queue_hook
+{
+#ifndef BOOST_DOXYGEN_INVOKED
+    template <typename T> friend class intrusive_mpsc_queue;
+
+    atomic<mpsc_queue_hook*> next_;
+#endif
+
+public:
+    mpsc_queue_hook(void):
+        next_(0)
+    {}
+
+    mpsc_queue_hook(mpsc_queue_hook const &):
+        next_(0)
+    {}
+
+    mpsc_queue_hook & operator=(mpsc_queue_hook const &)
+    {
+        return *this;
+    }
+};
+
+/** The intrusive_mpsc_queue class provides a multi-writer/single-reader fifo queue of caller-owned elements.
+ *
+ *  Pushing is wait-free and consists of a single atomic exchange. Popping is performed by a single thread and never
+ *  needs a compare-and-exchange. The queue does not allocate memory: elements derive from \ref boost::lockfree::mpsc_queue_hook
+ *  and are linked directly.
+ *
+ *  \note While a producer is between its exchange and linking its element, the consumer cannot see that element or any
+ *        element pushed after it, so pop may fail although the queue is not empty. The consumer is therefore not
+ *        lock-free in the strict sense.
+ *
+ *  \b Requirements:
+ *  - T must be derived from \ref boost::lockfree::mpsc_queue_hook
+ * */
+template <typename T>
+class intrusive_mpsc_queue
+#ifdef BOOST_NO_CXX11_DELETED_FUNCTIONS
+    : boost::noncopyable
+#endif
+{
+private:
+#ifndef BOOST_DOXYGEN_INVOKED
+    typedef mpsc_queue_hook hook;
+
+#ifndef BOOST_NO_CXX11_DELETED_FUNCTIONS
+    intrusive_mpsc_queue(intrusive_mpsc_queue const &) = delete;
+    intrusive_mpsc_queue(intrusive_mpsc_queue &&)      = delete;
+    const intrusive_mpsc_queue& operator=( const intrusive_mpsc_queue& ) = delete;
+#endif
+
+    void link(hook * n)
+    {
+        n->next_.store(0, memory_order_relaxed);
+        hook * prev = head_.exchange(n, memory_order_acq_rel);
+        prev->next_.store(n, memory_order_release);
+    }
+#endif
+
+public:
+    typedef T * value_type;
+    typedef std::size_t size_type;
+
+    //! Construct an empty queue
+    intrusive_mpsc_queue(void):
+        head_(&stub_), tail_(&stub_)
+    {}
+
+    /**
+     * \return true, if implementation is lock-free.
+     * */
+    bool is_lock_free (void) const
+    {
+        return head_.is_lock_free();
+    }
+
+    /** Check if the queue is empty
+     *
+     * \return true, if the queue is empty, false otherwise
+     * \note The result is only accurate, if no other thread modifies the queue. Therefore it is rarely practical to use this
+     *       value in program logic.
+     * */
+    bool empty(void) const
+    {
+        return head_.load(memory_order_acquire) == &stub_;
+    }
+
+    /** Pushes element t to the queue.
+     *
+     * \pre t is not in any queue
+     * \returns true
+     *
+     * \note Thread-safe and wait-free
+     * */
+    bool push(T * t)
+    {
+        link(t);
+        return true;
+    }
+
+    /** Pops element from queue.
+     *
+     * \pre only one thread is allowed to pop data from the queue
+     * \post if pop operation is successful, the element is stored to ret and is no longer referenced by the queue.
+     * \returns true, if the pop operation is successful, false if queue was empty.
+     *
+     * \note Thread-safe against concurrent push
+     * */
+    bool pop(T * & ret)
+    {
+        using detail::likely;
+
+        hook * tail = tail_;
+        hook * next = tail->next_.load(memory_order_acquire);
+
+        /* skip the stub node */
+        if (tail == &stub_) {
+            if (next == 0)
+                return false;
+            tail_ = next;
+            tail = next;
+            next = next->next_.load(memory_order_acquire);
+        }
+
+        if (likely(next != 0)) {
+            tail_ = next;
+            ret = static_cast<T*>(tail);
+            return true;
+        }
+
+        /* a producer has exchanged the head but not yet linked its element */
+        if (tail != head_.load(memory_order_acquire))
+            return false;
+
+        /* tail is the last element: put the stub behind it, so that tail can be unlinked */
+        link(&stub_);
+
+        next = tail->next_.load(memory_order_acquire);
+        if (next != 0) {
+            tail_ = next;
+            ret = static_cast<T*>(tail);
+            return true;
+        }
+        return false;
+    }
+
+    /** consumes one element via a functor
+     *
+     *  pops one element from the queue and applies the functor on it
+     *
+     * \pre only one thread is allowed to pop data from the queue
+     * \returns true, if one element was consumed
+     * */
+    template <typename Functor>
+    bool consume_one(Functor & f)
+    {
+        T * element;
+        bool success = pop(element);
+        if (success)
+            f(element);
+
+        return success;
+    }
+
+    /// \copydoc boost::lockfree::intrusive_mpsc_queue::consume_one(Functor & rhs)
+    template <typename Functor>
+    bool consume_one(Functor const & f)
+    {
+        T * element;
+        bool success = pop(element);
+        if (success)
+            f(element);
+
+        return success;
+    }
+
+    /** consumes all elements via a functor
+     *
+     * sequentially pops all elements from the queue and applies the functor on each of them
+     *
+     * \pre only one thread is allowed to pop data from the queue
+     * \returns number of elements that are consumed
+     * */
+    template <typename Functor>
+    size_type consume_all(Functor & f)
+    {
+        size_type element_count = 0;
+        while (consume_one(f))
+            element_count += 1;
+
+        return element_count;
+    }
+
+    /// \copydoc boost::lockfree::intrusive_mpsc_queue::consume_all(Functor & rhs)
+    template <typename Functor>
+    size_type consume_all(Functor const & f)
+    {
+        size_type element_count = 0;
+        while (consume_one(f))
+            element_count += 1;
+
+        return element_count;
+    }
+
+private:
+#ifndef BOOST_DOXYGEN_INVOKED
+    atomic<hook*> head_;
+    static const int padding_size = BOOST_LOCKFREE_CACHELINE_BYTES - sizeof(hook*);
+    char padding1[padding_size]; /* producers and the consumer work on different cache lines */
+    hook * tail_;
+    hook stub_;
+#endif
+};
+
+
+/** The mpsc_queue class provides a multi-writer/single-reader fifo queue, pushing is wait-free apart from allocating a node.
+ *
+ *  Each element is copied into a node allocated with the configured allocator and linked with a single atomic exchange. The
+ *  consumer side uses no compare-and-exchange, which makes it cheaper than \ref boost::lockfree::queue when only one thread
+ *  pops. See \ref boost::lockfree::intrusive_mpsc_queue for the progress guarantees of pop.
+ *
+ *  \b Policies:
+ *  - \c boost::lockfree::allocator<>, defaults to \c boost::lockfree::allocator<std::allocator<void>> <br>
+ *    Specifies the allocator that is used for the nodes
+ *
+ *  \b Requirements:
+ *  - T must have a copy constructor
+ * */
+#ifndef BOOST_DOXYGEN_INVOKED
+template <typename T,
+          class A0 = boost::parameter::void_>
+#else
+template <typename T, ...Options>
+#endif
+class mpsc_queue
+#ifdef BOOST_NO_CXX11_DELETED_FUNCTIONS
+    : boost::noncopyable
+#endif
+{
+private:
+#ifndef BOOST_DOXYGEN_INVOKED
+    typedef typename detail::mpsc_queue_signature::bind<A0>::type bound_args;
+
+    struct node:
+        mpsc_queue_hook
+    {
+        explicit node(T const & t):
+            data(t)
+        {}
+
+        T data;
+    };
+
+    typedef typename detail::extract_allocator<bound_args, node>::type node_allocator;
+
+    struct implementation_defined
+    {
+        typedef node_allocator allocator;
+        typedef std::size_t size_type;
+    };
+
+#ifndef BOOST_NO_CXX11_DELETED_FUNCTIONS
+    mpsc_queue(mpsc_queue const &) = delete;
+    mpsc_queue(mpsc_queue &&)      = delete;
+    const mpsc_queue& operator=( const mpsc_queue& ) = delete;
+#endif
+
+    struct destroyer:
+        node_allocator
+    {
+        explicit destroyer(node_allocator const & alloc):
+            node_allocator(alloc)
+        {}
+
+        void destroy(node * n)
+        {
+            n->~node();
+            node_allocator::deallocate(n, 1);
+        }
+    };
+#endif
+
+public:
+    typedef T value_type;
+    typedef typename implementation_defined::allocator allocator;
+    typedef typename implementation_defined::size_type size_type;
+
+    //! Construct queue
+    // @{
+    mpsc_queue(void):
+        alloc_(node_allocator())
+    {}
+
+    template <typename U>
+    explicit mpsc_queue(typename node_allocator::template rebind<U>::other const & alloc):
+        alloc_(alloc)
+    {}
+
+    explicit mpsc_queue(allocator const & alloc):
+        alloc_(alloc)
+    {}
+    // @}
+
+    /** Destroys queue, frees all remaining nodes.
+     * */
+    ~mpsc_queue(void)
+    {
+        node * n;
+        while (queue_.pop(n))
+            alloc_.destroy(n);
+    }
+
+    /** \copydoc boost::lockfree::intrusive_mpsc_queue::is_lock_free
+     * */
+    bool is_lock_free (void) const
+    {
+        return queue_.is_lock_free();
+    }
+
+    /** \copydoc boost::lockfree::intrusive_mpsc_queue::empty
+     * */
+    bool empty(void) const
+    {
+        return queue_.empty();
+    }
+
+    /** Pushes object t to the queue.
+     *
+     * \post object will be pushed to the queue
+     * \returns true
+     *
+     * \note Thread-safe. A node is allocated from the allocator, which may not be lock-free.
+     * \throws if memory allocator or the copy constructor of T throws
+     * */
+    bool push(T const & t)
+    {
+        node * n = &*alloc_.allocate(1);
+        try {
+            new (n) node(t);
+        } catch (...) {
+            alloc_.deallocate(n, 1);
+            throw;
+        }
+        return queue_.push(n);
+    }
+
+    /** Pops object from queue.
+     *
+     * \pre only one thread is allowed to pop data from the queue
+     * \post if pop operation is successful, object will be copied to ret.
+     * \returns true, if the pop operation is successful, false if queue was empty.
+     *
+     * \note Thread-safe against concurrent push
+     * */
+    bool pop (T & ret)
+    {
+        return pop<T>(ret);
+    }
+
+    /** Pops object from queue.
+     *
+     * \pre only one thread is allowed to pop data from the queue
+     * \pre type U must be constructible by T and copyable, or T must be convertible to U
+     * \post if pop operation is successful, object will be copied to ret.
+     * \returns true, if the pop operation is successful, false if queue was empty.
+     *
+     * \note Thread-safe against concurrent push
+     * */
+    template <typename U>
+    bool pop (U & ret)
+    {
+        node * n;
+        if (!queue_.pop(n))
+            return false;
+
+        detail::copy_payload(n->data, ret);
+        alloc_.destroy(n);
+        return true;
+    }
+
+    /** consumes one element via a functor
+     *
+     *  pops one element from the queue and applies the functor on this object
+     *
+     * \pre only one thread is allowed to pop data from the queue
+     * \returns true, if one element was consumed
+     * */
+    template <typename Functor>
+    bool consume_one(Functor & f)
+    {
+        node * n;
+        if (!queue_.pop(n))
+            return false;
+
+        try {
+            f(n->data);
+        } catch (...) {
+            alloc_.destroy(n);
+            throw;
+        }
+        alloc_.destroy(n);
+        return true;
+    }
+
+    /// \copydoc boost::lockfree::mpsc_queue::consume_one(Functor & rhs)
+    template <typename Functor>
+    bool consume_one(Functor const & f)
+    {
+        node * n;
+        if (!queue_.pop(n))
+            return false;
+
+        try {
+            f(n->data);
+        } catch (...) {
+            alloc_.destroy(n);
+            throw;
+        }
+        alloc_.destroy(n);
+        return true;
+    }
+
+    /** consumes all elements via a functor
+     *
+     * sequentially pops all elements from the queue and applies the functor on each object
+     *
+     * \pre only one thread is allowed to pop data from the queue
+     * \returns number of elements that are consumed
+     * */
+    template <typename Functor>
+    size_type consume_all(Functor & f)
+    {
+        size_type element_count = 0;
+        while (consume_one(f))
+            element_count += 1;
+
+        return element_count;
+    }
+
+    /// \copydoc boost::lockfree::mpsc_queue::consume_all(Functor & rhs)
+    template <typename Functor>
+    size_type consume_all(Functor const & f)
+    {
+        size_type element_count = 0;
+        while (consume_one(f))
+            element_count += 1;
+
+        return element_count;
+    }
+
+private:
+#ifndef BOOST_DOXYGEN_INVOKED
+    intrusive_mpsc_queue<node> queue_;
+    destroyer alloc_;
+#endif
+};
+
+} /* namespace lockfree */
+} /* namespace boost */
+
+
+#endif /* BOOST_LOCKFREE_MPSC_QUEUE_HPP_INCLUDED */
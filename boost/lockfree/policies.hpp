@@ -21,6 +21,7 @@ namespace lockfree {
 namespace tag { struct allocator ; }
 namespace tag { struct fixed_sized; }
 namespace tag { struct capacity; }
+namespace tag { struct reclamation; }
 
 #endif
 
@@ -52,6 +53,29 @@ struct allocator:
     boost::parameter::template_keyword<tag::allocator, Alloc>
 {};
 
+/** Selects the \b memory \b reclamation scheme of a node-based data structure.
+ *
+ *  By default, nodes that have been removed from a data structure are kept in a freelist until the data structure is
+ *  destroyed. With \ref boost::lockfree::hazard_pointers or \ref boost::lockfree::epoch_based, they are returned to the
+ *  allocator as soon as no thread can access them any more.
+ *  This option cannot be combined with \c fixed_sized<true> or \c capacity<>.
+ * */
+template <class Scheme>
+struct reclamation:
+    boost::parameter::template_keyword<tag::reclamation, Scheme>
+{};
+
+/** Memory reclamation scheme: threads publish the nodes they access in hazard pointers, a removed node is freed once no
+ *  hazard pointer refers to it. The number of unreclaimed nodes is bounded, even if a thread stalls.
+ * */
+struct hazard_pointers {};
+
+/** Memory reclamation scheme: threads announce the global epoch during each operation, a removed node is freed once the
+ *  epoch has advanced twice. This is cheaper than \ref boost::lockfree::hazard_pointers, but a stalled thread prevents
+ *  all reclamation.
+ * */
+struct epoch_based {};
+
 }
 }
 
@@ -23,6 +23,7 @@
 #include <boost/lockfree/detail/copy_payload.hpp>
 #include <boost/lockfree/detail/freelist.hpp>
 #include <boost/lockfree/detail/parameter.hpp>
+#include <boost/lockfree/detail/reclamation.hpp>
 #include <boost/lockfree/detail/tagged_ptr.hpp>
 
 namespace boost    {
@@ -30,7 +31,8 @@ namespace lockfree {
 namespace detail   {
 
 typedef parameter::parameters<boost::parameter::optional<tag::allocator>,
-                              boost::parameter::optional<tag::capacity>
+                              boost::parameter::optional<tag::capacity>,
+                              boost::parameter::optional<tag::reclamation>
                              > queue_signature;
 
 } /* namespace detail */
@@ -55,6 +57,11 @@ typedef parameter::parameters<boost::parameter::optional<tag::allocator>,
  *  - \ref boost::lockfree::allocator, defaults to \c boost::lockfree::allocator<std::allocator<void>> \n
  *    Specifies the allocator that is used for the internal freelist
  *
+ *  - \ref boost::lockfree::reclamation, optional \n
+ *    If \c reclamation<hazard_pointers> or \c reclamation<epoch_based> is passed to the options, popped nodes are
+ *    returned to the allocator instead of the freelist, once no other thread can access them. Only valid, if the queue
+ *    is not fixed-sized.
+ *
  *  \b Requirements:
  *   - T must have a copy constructor
  *   - T must have a trivial assignment operator
@@ -123,6 +130,13 @@ private:
     typedef typename pool_t::tagged_node_handle tagged_node_handle;
     typedef typename detail::select_tagged_handle<node, node_based>::handle_type handle_type;
 
+    // memory reclamation is only sane for node-based queues
+    BOOST_STATIC_ASSERT((node_based || !detail::extract_reclamation<bound_args>::has_reclamation));
+
+    typedef typename detail::select_reclaimer<typename detail::extract_reclamation<bound_args>::type,
+                                              node, pool_t>::type reclaimer_t;
+    typedef typename reclaimer_t::guard guard;
+
     void initialize(void)
     {
         node * n = pool.template construct<true, false>(pool.null_handle());
@@ -168,7 +182,8 @@ public:
     queue(void):
         head_(tagged_node_handle(0, 0)),
         tail_(tagged_node_handle(0, 0)),
-        pool(node_allocator(), capacity)
+        pool(node_allocator(), capacity),
+        reclaimer(pool)
     {
         BOOST_ASSERT(has_capacity);
         initialize();
@@ -178,7 +193,8 @@ public:
     explicit queue(typename node_allocator::template rebind<U>::other const & alloc):
         head_(tagged_node_handle(0, 0)),
         tail_(tagged_node_handle(0, 0)),
-        pool(alloc, capacity)
+        pool(alloc, capacity),
+        reclaimer(pool)
     {
         BOOST_STATIC_ASSERT(has_capacity);
         initialize();
@@ -187,7 +203,8 @@ public:
     explicit queue(allocator const & alloc):
         head_(tagged_node_handle(0, 0)),
         tail_(tagged_node_handle(0, 0)),
-        pool(alloc, capacity)
+        pool(alloc, capacity),
+        reclaimer(pool)
     {
         BOOST_ASSERT(has_capacity);
         initialize();
@@ -199,7 +216,8 @@ public:
     explicit queue(size_type n):
         head_(tagged_node_handle(0, 0)),
         tail_(tagged_node_handle(0, 0)),
-        pool(node_allocator(), n + 1)
+        pool(node_allocator(), n + 1),
+        reclaimer(pool)
     {
         BOOST_ASSERT(!has_capacity);
         initialize();
@@ -209,7 +227,8 @@ public:
     queue(size_type n, typename node_allocator::template rebind<U>::other const & alloc):
         head_(tagged_node_handle(0, 0)),
         tail_(tagged_node_handle(0, 0)),
-        pool(alloc, n + 1)
+        pool(alloc, n + 1),
+        reclaimer(pool)
     {
         BOOST_STATIC_ASSERT(!has_capacity);
         initialize();
@@ -292,8 +311,9 @@ private:
         if (n == NULL)
             return false;
 
+        guard g(reclaimer);
         for (;;) {
-            tagged_node_handle tail = tail_.load(memory_order_acquire);
+            tagged_node_handle tail = g.protect(0, tail_);
             node * tail_node = pool.get_pointer(tail);
             tagged_node_handle next = tail_node->next.load(memory_order_acquire);
             node * next_ptr = pool.get_pointer(next);
@@ -374,13 +394,15 @@ public:
     bool pop (U & ret)
     {
         using detail::likely;
+        guard g(reclaimer);
         for (;;) {
-            tagged_node_handle head = head_.load(memory_order_acquire);
+            tagged_node_handle head = g.protect(0, head_);
             node * head_ptr = pool.get_pointer(head);
 
             tagged_node_handle tail = tail_.load(memory_order_acquire);
             tagged_node_handle next = head_ptr->next.load(memory_order_acquire);
             node * next_ptr = pool.get_pointer(next);
+            g.protect_pointer(1, next_ptr); /* validated by reloading head */
 
             tagged_node_handle head2 = head_.load(memory_order_acquire);
             if (likely(head == head2)) {
@@ -403,7 +425,7 @@ public:
 
                     tagged_node_handle new_head(pool.get_handle(next), head.get_next_tag());
                     if (head_.compare_exchange_weak(head, new_head)) {
-                        pool.template destruct<true>(head);
+                        g.retire(head_ptr);
                         return true;
                     }
                 }
@@ -535,6 +557,7 @@ private:
     char padding2[padding_size];
 
     pool_t pool;
+    reclaimer_t reclaimer;
 #endif
 };
 
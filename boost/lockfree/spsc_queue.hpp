@@ -11,6 +11,7 @@
 #define BOOST_LOCKFREE_SPSC_QUEUE_HPP_INCLUDED
 
 #include <algorithm>
+#include <limits>
 
 #include <boost/array.hpp>
 #include <boost/assert.hpp>
@@ -27,6 +28,27 @@
 
 namespace boost    {
 namespace lockfree {
+
+/** Describes elements of a \ref boost::lockfree::spsc_queue that can be accessed in place.
+ *
+ *  Since the elements may wrap around the end of the ringbuffer, they are stored in up to two contiguous arrays:
+ *  [first, first + first_size) followed by [second, second + second_size).
+ * */
+template <typename T>
+struct spsc_range
+{
+    T * first;
+    std::size_t first_size;
+    T * second;
+    std::size_t second_size;
+
+    //! \return the total number of elements
+    std::size_t size(void) const
+    {
+        return first_size + second_size;
+    }
+};
+
 namespace detail   {
 
 typedef parameter::parameters<boost::parameter::optional<tag::capacity>,
@@ -41,10 +63,12 @@ class ringbuffer_base
 {
 #ifndef BOOST_DOXYGEN_INVOKED
     typedef std::size_t size_t;
-    static const int padding_size = BOOST_LOCKFREE_CACHELINE_BYTES - sizeof(size_t);
+    static const int padding_size = BOOST_LOCKFREE_CACHELINE_BYTES - 2 * sizeof(size_t);
     atomic<size_t> write_index_;
+    size_t cached_read_index_;  /* last value of read_index_ seen by the push thread */
     char padding1[padding_size]; /* force read_index and write_index to different cache lines */
     atomic<size_t> read_index_;
+    size_t cached_write_index_; /* last value of write_index_ seen by the pop thread */
 
 #ifndef BOOST_NO_CXX11_DELETED_FUNCTIONS
     ringbuffer_base(ringbuffer_base const &) = delete;
@@ -54,7 +78,7 @@ class ringbuffer_base
 
 protected:
     ringbuffer_base(void):
-        write_index_(0), read_index_(0)
+        write_index_(0), cached_read_index_(0), read_index_(0), cached_write_index_(0)
     {}
 
     static size_t next_index(size_t arg, size_t max_size)
@@ -82,12 +106,34 @@ protected:
         return ret;
     }
 
+    /* the indices of the other thread are only loaded, if the cached copies do not show enough elements or space. this
+     * avoids pulling the cache line of the other thread on every operation */
+    size_t write_available_cached(size_t write_index, size_t required, size_t max_size)
+    {
+        size_t avail = write_available(write_index, cached_read_index_, max_size);
+        if (avail < required) {
+            cached_read_index_ = read_index_.load(memory_order_acquire);
+            avail = write_available(write_index, cached_read_index_, max_size);
+        }
+        return avail;
+    }
+
+    size_t read_available_cached(size_t read_index, size_t required, size_t max_size)
+    {
+        size_t avail = read_available(cached_write_index_, read_index, max_size);
+        if (avail < required) {
+            cached_write_index_ = write_index_.load(memory_order_acquire);
+            avail = read_available(cached_write_index_, read_index, max_size);
+        }
+        return avail;
+    }
+
     bool push(T const & t, T * buffer, size_t max_size)
     {
         size_t write_index = write_index_.load(memory_order_relaxed);  // only written from push thread
         size_t next = next_index(write_index, max_size);
 
-        if (next == read_index_.load(memory_order_acquire))
+        if (write_available_cached(write_index, 1, max_size) == 0)
             return false; /* ringbuffer is full */
 
         buffer[write_index] = t;
@@ -100,8 +146,7 @@ protected:
     size_t push(const T * input_buffer, size_t input_count, T * internal_buffer, size_t max_size)
     {
         size_t write_index = write_index_.load(memory_order_relaxed);  // only written from push thread
-        const size_t read_index  = read_index_.load(memory_order_acquire);
-        const size_t avail = write_available(write_index, read_index, max_size);
+        const size_t avail = write_available_cached(write_index, input_count, max_size);
 
         if (avail == 0)
             return 0;
@@ -134,13 +179,12 @@ protected:
         // FIXME: avoid std::distance and std::advance
 
         size_t write_index = write_index_.load(memory_order_relaxed);  // only written from push thread
-        const size_t read_index  = read_index_.load(memory_order_acquire);
-        const size_t avail = write_available(write_index, read_index, max_size);
+        size_t input_count = std::distance(begin, end);
+        const size_t avail = write_available_cached(write_index, input_count, max_size);
 
         if (avail == 0)
             return begin;
 
-        size_t input_count = std::distance(begin, end);
         input_count = (std::min)(input_count, avail);
 
         size_t new_write_index = write_index + input_count;
@@ -170,9 +214,8 @@ protected:
 
     bool pop (T & ret, T * buffer, size_t max_size)
     {
-        size_t write_index = write_index_.load(memory_order_acquire);
         size_t read_index  = read_index_.load(memory_order_relaxed); // only written from pop thread
-        if (empty(write_index, read_index))
+        if (read_available_cached(read_index, 1, max_size) == 0)
             return false;
 
         ret = buffer[read_index];
@@ -183,10 +226,9 @@ protected:
 
     size_t pop (T * output_buffer, size_t output_count, const T * internal_buffer, size_t max_size)
     {
-        const size_t write_index = write_index_.load(memory_order_acquire);
         size_t read_index = read_index_.load(memory_order_relaxed); // only written from pop thread
 
-        const size_t avail = read_available(write_index, read_index, max_size);
+        const size_t avail = read_available_cached(read_index, output_count, max_size);
 
         if (avail == 0)
             return 0;
@@ -217,10 +259,11 @@ protected:
     template <typename OutputIterator>
     size_t pop (OutputIterator it, const T * internal_buffer, size_t max_size)
     {
-        const size_t write_index = write_index_.load(memory_order_acquire);
         size_t read_index = read_index_.load(memory_order_relaxed); // only written from pop thread
 
-        const size_t avail = read_available(write_index, read_index, max_size);
+        /* the iterator can take all elements, so always load the current write index */
+        cached_write_index_ = write_index_.load(memory_order_acquire);
+        const size_t avail = read_available(cached_write_index_, read_index, max_size);
         if (avail == 0)
             return 0;
 
@@ -244,6 +287,56 @@ protected:
         read_index_.store(new_read_index, memory_order_release);
         return avail;
     }
+
+    static spsc_range<T> make_range(T * buffer, size_t index, size_t count, size_t max_size)
+    {
+        spsc_range<T> ret;
+        ret.first = buffer + index;
+        ret.first_size = (std::min)(count, max_size - index);
+        ret.second = buffer;
+        ret.second_size = count - ret.first_size;
+        return ret;
+    }
+
+    spsc_range<T> write_reserve(size_t count, T * buffer, size_t max_size)
+    {
+        size_t write_index = write_index_.load(memory_order_relaxed);  // only written from push thread
+        const size_t avail = write_available_cached(write_index, count, max_size);
+
+        return make_range(buffer, write_index, (std::min)(count, avail), max_size);
+    }
+
+    void write_commit(size_t count, size_t max_size)
+    {
+        size_t write_index = write_index_.load(memory_order_relaxed);  // only written from push thread
+        BOOST_ASSERT(count <= write_available(write_index, cached_read_index_, max_size));
+
+        size_t new_write_index = write_index + count;
+        if (new_write_index >= max_size)
+            new_write_index -= max_size;
+
+        write_index_.store(new_write_index, memory_order_release);
+    }
+
+    spsc_range<T> read_peek(size_t count, T * buffer, size_t max_size)
+    {
+        size_t read_index = read_index_.load(memory_order_relaxed); // only written from pop thread
+        const size_t avail = read_available_cached(read_index, count, max_size);
+
+        return make_range(buffer, read_index, (std::min)(count, avail), max_size);
+    }
+
+    void read_release(size_t count, size_t max_size)
+    {
+        size_t read_index = read_index_.load(memory_order_relaxed); // only written from pop thread
+        BOOST_ASSERT(count <= read_available(cached_write_index_, read_index, max_size));
+
+        size_t new_read_index = read_index + count;
+        if (new_read_index >= max_size)
+            new_read_index -= max_size;
+
+        read_index_.store(new_read_index, memory_order_release);
+    }
 #endif
 
 
@@ -255,6 +348,8 @@ public:
     void reset(void)
     {
         write_index_.store(0, memory_order_relaxed);
+        cached_read_index_ = 0;
+        cached_write_index_ = 0;
         read_index_.store(0, memory_order_release);
     }
 
@@ -336,6 +431,26 @@ public:
     {
         return ringbuffer_base<T>::pop(it, array_.c_array(), max_size);
     }
+
+    spsc_range<T> write_reserve(size_t count)
+    {
+        return ringbuffer_base<T>::write_reserve(count, array_.c_array(), max_size);
+    }
+
+    void write_commit(size_t count)
+    {
+        ringbuffer_base<T>::write_commit(count, max_size);
+    }
+
+    spsc_range<T> read_peek(size_t count)
+    {
+        return ringbuffer_base<T>::read_peek(count, array_.c_array(), max_size);
+    }
+
+    void read_release(size_t count)
+    {
+        ringbuffer_base<T>::read_release(count, max_size);
+    }
 };
 
 template <typename T, typename Alloc>
@@ -427,6 +542,26 @@ public:
     {
         return ringbuffer_base<T>::pop(it, array_, max_elements_);
     }
+
+    spsc_range<T> write_reserve(size_t count)
+    {
+        return ringbuffer_base<T>::write_reserve(count, &*array_, max_elements_);
+    }
+
+    void write_commit(size_t count)
+    {
+        ringbuffer_base<T>::write_commit(count, max_elements_);
+    }
+
+    spsc_range<T> read_peek(size_t count)
+    {
+        return ringbuffer_base<T>::read_peek(count, &*array_, max_elements_);
+    }
+
+    void read_release(size_t count)
+    {
+        ringbuffer_base<T>::read_release(count, max_elements_);
+    }
 };
 
 template <typename T, typename A0, typename A1>
@@ -500,6 +635,7 @@ public:
     typedef T value_type;
     typedef typename implementation_defined::allocator allocator;
     typedef typename implementation_defined::size_type size_type;
+    typedef spsc_range<T> range;
 
     /** Constructs a spsc_queue
      *
@@ -653,6 +789,66 @@ public:
         return base_type::pop(it);
     }
 
+    /** Reserves up to count elements at the end of the ringbuffer, so that they can be written in place.
+     *
+     * \pre only one thread is allowed to push data to the spsc_queue
+     * \return the reserved elements, fewer than count if there is not enough space
+     *
+     * \note Thread-safe and wait-free. The elements are not visible to the consumer before write_commit is called.
+     * */
+    range write_reserve(size_type count)
+    {
+        return base_type::write_reserve(count);
+    }
+
+    /** Publishes the first count elements of the last write_reserve to the consumer.
+     *
+     * \pre only one thread is allowed to push data to the spsc_queue
+     * \pre count must not exceed the size of the range returned by the last call to write_reserve
+     *
+     * \note Thread-safe and wait-free
+     * */
+    void write_commit(size_type count)
+    {
+        base_type::write_commit(count);
+    }
+
+    /** Gives in-place access to up to count elements at the front of the ringbuffer.
+     *
+     * \pre only one thread is allowed to pop data to the spsc_queue
+     * \return the available elements, fewer than count if the ringbuffer does not hold enough
+     *
+     * \note Thread-safe and wait-free. The elements remain in the spsc_queue until read_release is called.
+     * */
+    range read_peek(size_type count)
+    {
+        return base_type::read_peek(count);
+    }
+
+    /** Gives in-place access to all elements at the front of the ringbuffer.
+     *
+     * \pre only one thread is allowed to pop data to the spsc_queue
+     * \return the available elements
+     *
+     * \note Thread-safe and wait-free. The elements remain in the spsc_queue until read_release is called.
+     * */
+    range read_peek(void)
+    {
+        return base_type::read_peek((std::numeric_limits<size_type>::max)());
+    }
+
+    /** Removes the first count elements from the ringbuffer, after they have been processed in place.
+     *
+     * \pre only one thread is allowed to pop data to the spsc_queue
+     * \pre count must not exceed the size of the range returned by the last call to read_peek
+     *
+     * \note Thread-safe and wait-free
+     * */
+    void read_release(size_type count)
+    {
+        base_type::read_release(count);
+    }
+
     /** consumes one element via a functor
      *
      *  pops one element from the queue and applies the functor on this object
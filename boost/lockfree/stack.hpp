@@ -22,6 +22,7 @@
 #include <boost/lockfree/detail/copy_payload.hpp>
 #include <boost/lockfree/detail/freelist.hpp>
 #include <boost/lockfree/detail/parameter.hpp>
+#include <boost/lockfree/detail/reclamation.hpp>
 #include <boost/lockfree/detail/tagged_ptr.hpp>
 
 namespace boost    {
@@ -29,7 +30,8 @@ namespace lockfree {
 namespace detail   {
 
 typedef parameter::parameters<boost::parameter::optional<tag::allocator>,
-                              boost::parameter::optional<tag::capacity>
+                              boost::parameter::optional<tag::capacity>,
+                              boost::parameter::optional<tag::reclamation>
                              > stack_signature;
 
 }
@@ -54,6 +56,11 @@ typedef parameter::parameters<boost::parameter::optional<tag::allocator>,
  *  - \c boost::lockfree::allocator<>, defaults to \c boost::lockfree::allocator<std::allocator<void>> <br>
  *    Specifies the allocator that is used for the internal freelist
  *
+ *  - \c boost::lockfree::reclamation<>, optional <br>
+ *    If \c reclamation<hazard_pointers> or \c reclamation<epoch_based> is passed to the options, popped nodes are
+ *    returned to the allocator instead of the freelist, once no other thread can access them. Only valid, if the stack
+ *    is not fixed-sized.
+ *
  *  \b Requirements:
  *  - T must have a copy constructor
  * */
@@ -98,6 +105,13 @@ private:
     typedef typename detail::select_freelist<node, node_allocator, compile_time_sized, fixed_sized, capacity>::type pool_t;
     typedef typename pool_t::tagged_node_handle tagged_node_handle;
 
+    // memory reclamation is only sane for node-based stacks
+    BOOST_STATIC_ASSERT((node_based || !detail::extract_reclamation<bound_args>::has_reclamation));
+
+    typedef typename detail::select_reclaimer<typename detail::extract_reclamation<bound_args>::type,
+                                              node, pool_t>::type reclaimer_t;
+    typedef typename reclaimer_t::guard guard;
+
     // check compile-time capacity
     BOOST_STATIC_ASSERT((mpl::if_c<has_capacity,
                                    mpl::bool_<capacity - 1 < boost::integer_traits<boost::uint16_t>::const_max>,
@@ -140,7 +154,8 @@ public:
     //! Construct stack
     // @{
     stack(void):
-        pool(node_allocator(), capacity)
+        pool(node_allocator(), capacity),
+        reclaimer(pool)
     {
         BOOST_ASSERT(has_capacity);
         initialize();
@@ -148,14 +163,16 @@ public:
 
     template <typename U>
     explicit stack(typename node_allocator::template rebind<U>::other const & alloc):
-        pool(alloc, capacity)
+        pool(alloc, capacity),
+        reclaimer(pool)
     {
         BOOST_STATIC_ASSERT(has_capacity);
         initialize();
     }
 
     explicit stack(allocator const & alloc):
-        pool(alloc, capacity)
+        pool(alloc, capacity),
+        reclaimer(pool)
     {
         BOOST_ASSERT(has_capacity);
         initialize();
@@ -165,7 +182,8 @@ public:
     //! Construct stack, allocate n nodes for the freelist.
     // @{
     explicit stack(size_type n):
-        pool(node_allocator(), n)
+        pool(node_allocator(), n),
+        reclaimer(pool)
     {
         BOOST_ASSERT(!has_capacity);
         initialize();
@@ -173,7 +191,8 @@ public:
 
     template <typename U>
     stack(size_type n, typename node_allocator::template rebind<U>::other const & alloc):
-        pool(alloc, n)
+        pool(alloc, n),
+        reclaimer(pool)
     {
         BOOST_STATIC_ASSERT(!has_capacity);
         initialize();
@@ -435,7 +454,8 @@ public:
     bool pop(U & ret)
     {
         BOOST_STATIC_ASSERT((boost::is_convertible<T, U>::value));
-        tagged_node_handle old_tos = tos.load(detail::memory_order_consume);
+        guard g(reclaimer);
+        tagged_node_handle old_tos = g.protect(0, tos);
 
         for (;;) {
             node * old_tos_pointer = pool.get_pointer(old_tos);
@@ -446,9 +466,10 @@ public:
 
             if (tos.compare_exchange_weak(old_tos, new_tos)) {
                 detail::copy_payload(old_tos_pointer->v, ret);
-                pool.template destruct<true>(old_tos);
+                g.retire(old_tos_pointer);
                 return true;
             }
+            old_tos = g.protect(0, tos, old_tos);
         }
     }
 
@@ -573,6 +594,7 @@ private:
     char padding[padding_size];
 
     pool_t pool;
+    reclaimer_t reclaimer;
 #endif
 };
 
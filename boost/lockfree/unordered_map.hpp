@@ -0,0 +1,576 @@
+//  lock-free hash map, based on split-ordered lists from
+//  Shalev, O. and Shavit, N.,
+//  "Split-ordered lists: lock-free extensible hash tables"
+//  and the list-based set from
+//  Michael, M. M.,
+//  "High performance dynamic lock-free hash tables and list-based sets"
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_LOCKFREE_UNORDERED_MAP_HPP_INCLUDED
+#define BOOST_LOCKFREE_UNORDERED_MAP_HPP_INCLUDED
+
+#include <climits>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+
+#include <boost/assert.hpp>
+#include <boost/config.hpp>
+#include <boost/functional/hash.hpp>
+#ifdef BOOST_NO_CXX11_DELETED_FUNCTIONS
+#include <boost/noncopyable.hpp>
+#endif
+
+#include <boost/lockfree/detail/atomic.hpp>
+#include <boost/lockfree/detail/freelist.hpp>
+#include <boost/lockfree/detail/parameter.hpp>
+#include <boost/lockfree/detail/prefix.hpp>
+#include <boost/lockfree/detail/reclamation.hpp>
+#include <boost/lockfree/detail/tagged_ptr.hpp>
+#include <boost/lockfree/epoch_reclamation.hpp>
+
+namespace boost    {
+namespace lockfree {
+namespace detail   {
+
+typedef parameter::parameters<boost::parameter::optional<tag::allocator>
+                             > unordered_map_signature;
+
+} /* namespace detail */
+
+/** The unordered_map class provides a hash map with lock-free find, insert and erase, construction/destruction has to
+ *  be synchronized.
+ *
+ *  All elements are stored in a single linked list, which is sorted by the bit-reversed hash values of their keys. The
+ *  buckets are pointers to dummy nodes within this list, so the number of buckets can be doubled without moving any
+ *  element: new buckets are initialized lazily by inserting their dummy node after the dummy node of their parent bucket.
+ *  The bucket table is stored in segments of growing size, which are never reallocated.
+ *
+ *  Erased elements are pushed to a freelist, once no other thread can access them. Every operation creates a guard of a
+ *  \ref boost::lockfree::epoch_domain for this. Nodes are not returned to the OS before the map is destroyed.
+ *
+ *  \b Policies:
+ *  - \ref boost::lockfree::allocator, defaults to \c boost::lockfree::allocator<std::allocator<void>> \n
+ *    Specifies the allocator that is used for the internal freelist, the dummy nodes and the bucket table
+ *
+ *  \b Requirements:
+ *   - Key and T must have a copy constructor
+ *   - T must have an assignment operator
+ *   - Hash and Pred must be copyable and thread-safe
+ *
+ * */
+#ifndef BOOST_DOXYGEN_INVOKED
+template <typename Key,
+          typename T,
+          typename Hash = boost::hash<Key>,
+          typename Pred = std::equal_to<Key>,
+          class A0 = boost::parameter::void_>
+#else
+template <typename Key, typename T, typename Hash = boost::hash<Key>, typename Pred = std::equal_to<Key>, ...Options>
+#endif
+class unordered_map
+#ifdef BOOST_NO_CXX11_DELETED_FUNCTIONS
+    : boost::noncopyable
+#endif
+{
+private:
+#ifndef BOOST_DOXYGEN_INVOKED
+    typedef typename detail::unordered_map_signature::bind<A0>::type bound_args;
+
+    struct list_node;
+    typedef detail::tagged_ptr<list_node> tagged_list_ptr;
+
+    /* the tag of the next pointer marks its node as erased, nodes are never reused while they can be accessed, so
+     * the tag is not needed to prevent the ABA problem */
+    static const typename tagged_list_ptr::tag_t erased_tag = 1;
+
+    /* dummy nodes have even split-order keys, elements odd ones */
+    struct list_node
+    {
+        explicit list_node(std::size_t so_key):
+            next(tagged_list_ptr(0, 0)), so_key(so_key)
+        {}
+
+        atomic<tagged_list_ptr> next;
+        std::size_t so_key;
+    };
+
+    struct node:
+        list_node
+    {
+        node(Key const & key, T const & value):
+            list_node(1), key(key), value(value)
+        {}
+
+        const Key key;
+        T value;
+    };
+
+    typedef typename detail::extract_allocator<bound_args, node>::type node_allocator;
+    typedef typename node_allocator::template rebind<list_node>::other dummy_allocator;
+    typedef atomic<list_node*> bucket;
+    typedef typename node_allocator::template rebind<bucket>::other bucket_allocator;
+
+    typedef detail::freelist_stack<node, node_allocator> pool_t;
+    typedef epoch_domain<node, detail::pool_recycle<pool_t> > reclaimer_t;
+    typedef typename reclaimer_t::guard guard;
+
+    static const std::size_t size_t_bits = sizeof(std::size_t) * CHAR_BIT;
+    static const std::size_t max_load_factor = 2;
+    static const std::size_t max_bucket_count = std::size_t(1) << (size_t_bits - 1);
+
+    /* segment 0 holds buckets 0 and 1, segment s > 0 the buckets [2**s, 2**(s+1)) */
+    static const std::size_t segment_count = size_t_bits;
+
+    struct position
+    {
+        atomic<tagged_list_ptr> * prev;
+        list_node * curr;
+        list_node * next;
+    };
+
+    struct implementation_defined
+    {
+        typedef node_allocator allocator;
+        typedef std::size_t size_type;
+    };
+
+#endif
+
+#ifndef BOOST_NO_CXX11_DELETED_FUNCTIONS
+    unordered_map(unordered_map const &) = delete;
+    unordered_map(unordered_map &&)      = delete;
+    const unordered_map& operator=( const unordered_map& ) = delete;
+#endif
+
+public:
+    typedef Key key_type;
+    typedef T mapped_type;
+    typedef Hash hasher;
+    typedef Pred key_equal;
+    typedef typename implementation_defined::allocator allocator;
+    typedef typename implementation_defined::size_type size_type;
+
+    /**
+     * \return true, if implementation is lock-free.
+     *
+     * \warning It only checks, if the list nodes and the freelist can be modified in a lock-free manner. Initializing a
+     *          bucket or a segment of the bucket table and inserting an element, while the freelist is empty, allocates
+     *          memory, which may not be lock-free.
+     * */
+    bool is_lock_free (void) const
+    {
+        return head_->next.is_lock_free() && bucket_count_.is_lock_free() && pool_.is_lock_free();
+    }
+
+    //! Construct unordered_map
+    unordered_map(void):
+        pool_(node_allocator(), 0),
+        reclaimer_(pool_),
+        dummy_allocator_(node_allocator()),
+        bucket_allocator_(node_allocator())
+    {
+        initialize(0);
+    }
+
+    //! Construct unordered_map for n elements, allocate n nodes for the freelist.
+    // @{
+    explicit unordered_map(size_type n):
+        pool_(node_allocator(), n),
+        reclaimer_(pool_),
+        dummy_allocator_(node_allocator()),
+        bucket_allocator_(node_allocator())
+    {
+        initialize(n);
+    }
+
+    unordered_map(size_type n, hasher const & hf, key_equal const & eql = key_equal(),
+                  allocator const & alloc = allocator()):
+        hash_(hf),
+        equal_(eql),
+        pool_(alloc, n),
+        reclaimer_(pool_),
+        dummy_allocator_(alloc),
+        bucket_allocator_(alloc)
+    {
+        initialize(n);
+    }
+    // @}
+
+    /** Allocate n nodes for the freelist
+     *
+     *  \note thread-safe, may block if memory allocator blocks
+     *
+     * */
+    void reserve(size_type n)
+    {
+        pool_.template reserve<true>(n);
+    }
+
+    /** Destroys unordered_map, free all nodes and buckets.
+     * */
+    ~unordered_map(void)
+    {
+        list_node * n = head_;
+        while (n) {
+            list_node * next = n->next.load(memory_order_relaxed).get_ptr();
+            if (is_dummy(n))
+                destroy_dummy(n);
+            else
+                pool_.template destruct<false>(static_cast<node*>(n));
+            n = next;
+        }
+
+        for (std::size_t s = 0; s != segment_count; ++s) {
+            bucket * segment = segments_[s].load(memory_order_relaxed);
+            if (segment)
+                destroy_segment(segment, s);
+        }
+    }
+
+    /** Inserts a copy of value with the given key, unless the map already contains an element with an equal key.
+     *
+     * \returns true, if the element has been inserted.
+     *
+     * \note Thread-safe. If the internal memory pool is exhausted, a new node will be allocated from the OS. This may not
+     *       be lock-free.
+     * */
+    bool insert(Key const & key, T const & value)
+    {
+        const std::size_t hash = hash_(key);
+        const std::size_t so_key = regular_key(hash);
+
+        guard g(reclaimer_);
+        list_node * head = bucket_head(g, hash & (bucket_count_.load(memory_order_acquire) - 1));
+
+        node * n = NULL;
+        position pos;
+        for (;;) {
+            if (find_position(g, head, so_key, &key, pos)) {
+                if (n)
+                    pool_.template destruct<true>(n);
+                return false;
+            }
+
+            if (!n) {
+                n = pool_.template construct<true, false>(key, value);
+                n->so_key = so_key;
+            }
+
+            n->next.store(tagged_list_ptr(pos.curr, 0), memory_order_relaxed);
+            tagged_list_ptr expected(pos.curr, 0);
+            if (pos.prev->compare_exchange_strong(expected, tagged_list_ptr(n, 0)))
+                break;
+        }
+
+        const std::size_t count = bucket_count_.load(memory_order_relaxed);
+        if (size_.fetch_add(1, memory_order_relaxed) + 1 > count * max_load_factor && count < max_bucket_count) {
+            std::size_t expected = count;
+            bucket_count_.compare_exchange_strong(expected, count * 2, memory_order_release, memory_order_relaxed);
+        }
+        return true;
+    }
+
+    /** Erases the element with the given key.
+     *
+     * \returns true, if the map contained an element with an equal key.
+     *
+     * \note Thread-safe and non-blocking
+     * */
+    bool erase(Key const & key)
+    {
+        const std::size_t hash = hash_(key);
+        const std::size_t so_key = regular_key(hash);
+
+        guard g(reclaimer_);
+        list_node * head = bucket_head(g, hash & (bucket_count_.load(memory_order_acquire) - 1));
+
+        position pos;
+        for (;;) {
+            if (!find_position(g, head, so_key, &key, pos))
+                return false;
+
+            /* logical deletion, the node is erased by the thread that marks it */
+            tagged_list_ptr next(pos.next, 0);
+            if (!pos.curr->next.compare_exchange_strong(next, tagged_list_ptr(pos.next, erased_tag)))
+                continue;
+
+            tagged_list_ptr expected(pos.curr, 0);
+            if (pos.prev->compare_exchange_strong(expected, tagged_list_ptr(pos.next, 0)))
+                g.retire(static_cast<node*>(pos.curr));
+            else
+                find_position(g, head, so_key, &key, pos); /* unlinks the marked node */
+
+            size_.fetch_sub(1, memory_order_relaxed);
+            return true;
+        }
+    }
+
+    /** Looks up the element with the given key and copies its value to ret.
+     *
+     * \returns true, if the map contains an element with an equal key.
+     *
+     * \note Thread-safe and non-blocking. The value must not be modified concurrently.
+     * */
+    bool find(Key const & key, T & ret)
+    {
+        const std::size_t hash = hash_(key);
+
+        guard g(reclaimer_);
+        list_node * head = bucket_head(g, hash & (bucket_count_.load(memory_order_acquire) - 1));
+
+        position pos;
+        if (!find_position(g, head, regular_key(hash), &key, pos))
+            return false;
+
+        ret = static_cast<node*>(pos.curr)->value;
+        return true;
+    }
+
+    /** \returns true, if the map contains an element with the given key.
+     *
+     * \note Thread-safe and non-blocking
+     * */
+    bool contains(Key const & key)
+    {
+        const std::size_t hash = hash_(key);
+
+        guard g(reclaimer_);
+        list_node * head = bucket_head(g, hash & (bucket_count_.load(memory_order_acquire) - 1));
+
+        position pos;
+        return find_position(g, head, regular_key(hash), &key, pos);
+    }
+
+    /** \returns the number of elements
+     *
+     * \note The result is only accurate, if no other thread modifies the map.
+     * */
+    size_type size(void) const
+    {
+        return size_.load(memory_order_relaxed);
+    }
+
+    /** Check if the map is empty
+     *
+     * \note The result is only accurate, if no other thread modifies the map.
+     * */
+    bool empty(void) const
+    {
+        return size() == 0;
+    }
+
+    /** \returns the current number of buckets
+     *
+     * \note The number of buckets is doubled, when the map contains more than twice as many elements as buckets.
+     * */
+    size_type bucket_count(void) const
+    {
+        return bucket_count_.load(memory_order_relaxed);
+    }
+
+private:
+#ifndef BOOST_DOXYGEN_INVOKED
+    void initialize(size_type n)
+    {
+        for (std::size_t s = 0; s != segment_count; ++s)
+            segments_[s].store(NULL, memory_order_relaxed);
+
+        std::size_t count = 2;
+        while (count * max_load_factor < n && count < max_bucket_count)
+            count *= 2;
+        bucket_count_.store(count, memory_order_relaxed);
+        size_.store(0, memory_order_relaxed);
+
+        head_ = create_dummy(0);
+        bucket_slot(0).store(head_, memory_order_release);
+    }
+
+    static std::size_t reverse_bits(std::size_t x)
+    {
+        std::size_t shift = size_t_bits;
+        std::size_t mask = ~std::size_t(0);
+        while ((shift >>= 1) > 0) {
+            mask ^= mask << shift;
+            x = ((x >> shift) & mask) | ((x << shift) & ~mask);
+        }
+        return x;
+    }
+
+    static std::size_t regular_key(std::size_t hash)
+    {
+        return reverse_bits(hash | max_bucket_count);
+    }
+
+    static std::size_t dummy_key(std::size_t bucket_index)
+    {
+        return reverse_bits(bucket_index);
+    }
+
+    static bool is_dummy(list_node const * n)
+    {
+        return (n->so_key & 1) == 0;
+    }
+
+    static std::size_t segment_index(std::size_t bucket_index)
+    {
+        std::size_t s = 0;
+        while (bucket_index >>= 1)
+            ++s;
+        return s;
+    }
+
+    static std::size_t segment_size(std::size_t s)
+    {
+        return s == 0 ? 2 : std::size_t(1) << s;
+    }
+
+    static std::size_t segment_begin(std::size_t s)
+    {
+        return s == 0 ? 0 : std::size_t(1) << s;
+    }
+
+    bucket & bucket_slot(std::size_t bucket_index)
+    {
+        const std::size_t s = segment_index(bucket_index);
+        bucket * segment = segments_[s].load(memory_order_acquire);
+        if (!segment) {
+            bucket * new_segment = create_segment(s);
+            if (segments_[s].compare_exchange_strong(segment, new_segment, memory_order_acq_rel, memory_order_acquire))
+                segment = new_segment;
+            else
+                destroy_segment(new_segment, s);
+        }
+        return segment[bucket_index - segment_begin(s)];
+    }
+
+    list_node * bucket_head(guard & g, std::size_t bucket_index)
+    {
+        list_node * head = bucket_slot(bucket_index).load(memory_order_acquire);
+        if (head)
+            return head;
+        return initialize_bucket(g, bucket_index);
+    }
+
+    /* the parent of a bucket is the bucket without the most significant bit of its index, its dummy node precedes the
+     * dummy node of the new bucket in split order */
+    list_node * initialize_bucket(guard & g, std::size_t bucket_index)
+    {
+        const std::size_t parent = bucket_index & ~(std::size_t(1) << segment_index(bucket_index));
+
+        list_node * parent_head = bucket_head(g, parent);
+        list_node * dummy = create_dummy(dummy_key(bucket_index));
+
+        position pos;
+        for (;;) {
+            if (find_position(g, parent_head, dummy->so_key, NULL, pos)) {
+                /* another thread has inserted the dummy node */
+                destroy_dummy(dummy);
+                dummy = pos.curr;
+                break;
+            }
+
+            dummy->next.store(tagged_list_ptr(pos.curr, 0), memory_order_relaxed);
+            tagged_list_ptr expected(pos.curr, 0);
+            if (pos.prev->compare_exchange_strong(expected, tagged_list_ptr(dummy, 0)))
+                break;
+        }
+
+        bucket_slot(bucket_index).store(dummy, memory_order_release);
+        return dummy;
+    }
+
+    /* searches the list, starting at head, for the node with the given split-order key and an equal key (or the
+     * dummy node with this split-order key, if key is NULL). on return, pos.curr is the found node or its successor
+     * and pos.prev the next pointer, that refers to pos.curr. marked nodes are unlinked on the way. */
+    bool find_position(guard & g, list_node * head, std::size_t so_key, Key const * key, position & pos)
+    {
+        for (;;) {
+            pos.prev = &head->next;
+            pos.curr = pos.prev->load(memory_order_acquire).get_ptr();
+
+            for (;;) {
+                if (!pos.curr)
+                    return false;
+
+                tagged_list_ptr next = pos.curr->next.load(memory_order_acquire);
+                pos.next = next.get_ptr();
+
+                if (pos.prev->load(memory_order_acquire) != tagged_list_ptr(pos.curr, 0))
+                    break; /* prev has been changed or marked, restart */
+
+                if (next.get_tag() == erased_tag) {
+                    tagged_list_ptr expected(pos.curr, 0);
+                    if (!pos.prev->compare_exchange_strong(expected, tagged_list_ptr(pos.next, 0)))
+                        break;
+
+                    g.retire(static_cast<node*>(pos.curr));
+                    pos.curr = pos.next;
+                    continue;
+                }
+
+                const std::size_t curr_key = pos.curr->so_key;
+                if (curr_key > so_key)
+                    return false;
+
+                if (curr_key == so_key && (!key || equal_(static_cast<node*>(pos.curr)->key, *key)))
+                    return true;
+
+                pos.prev = &pos.curr->next;
+                pos.curr = pos.next;
+            }
+        }
+    }
+
+    list_node * create_dummy(std::size_t so_key)
+    {
+        list_node * n = dummy_allocator_.allocate(1);
+        new (n) list_node(so_key);
+        return n;
+    }
+
+    void destroy_dummy(list_node * n)
+    {
+        n->~list_node();
+        dummy_allocator_.deallocate(n, 1);
+    }
+
+    bucket * create_segment(std::size_t s)
+    {
+        const std::size_t size = segment_size(s);
+        bucket * segment = bucket_allocator_.allocate(size);
+        for (std::size_t i = 0; i != size; ++i)
+            new (segment + i) bucket(NULL);
+        return segment;
+    }
+
+    void destroy_segment(bucket * segment, std::size_t s)
+    {
+        const std::size_t size = segment_size(s);
+        for (std::size_t i = 0; i != size; ++i)
+            segment[i].~bucket();
+        bucket_allocator_.deallocate(segment, size);
+    }
+
+    Hash hash_;
+    Pred equal_;
+    pool_t pool_;
+    reclaimer_t reclaimer_;
+    dummy_allocator dummy_allocator_;
+    bucket_allocator bucket_allocator_;
+    list_node * head_;
+    atomic<bucket*> segments_[segment_count];
+    atomic<std::size_t> bucket_count_;
+    char padding[BOOST_LOCKFREE_CACHELINE_BYTES];
+    atomic<std::size_t> size_;
+#endif
+};
+
+} /* namespace lockfree */
+} /* namespace boost */
+
+#endif /* BOOST_LOCKFREE_UNORDERED_MAP_HPP_INCLUDED */
@@ -26,6 +26,8 @@
 #include <boost/log/attributes/attribute.hpp>
 #include <boost/log/attributes/attribute_value_set.hpp>
 #include <boost/log/expressions/filter.hpp>
+#include <boost/log/detail/severity_threshold.hpp>
+#include <boost/log/utility/type_info_wrapper.hpp>
 #include <boost/log/detail/header.hpp>
 
 #ifdef BOOST_LOG_HAS_PRAGMA_ONCE
@@ -141,6 +143,24 @@ public:
      */
     BOOST_LOG_API void remove_all_sinks();
 
+    /*!
+     * The method returns the cached lowest severity level of log records that may pass the global filter and
+     * at least one of the sink filters. The threshold is only known for filters constructed from expressions
+     * like <tt>severity >= level</tt> or their conjunctions. Loggers use the threshold to discard log records
+     * before composing attribute values. The cache is updated whenever the global filter or the set of sinks change.
+     *
+     * \param name The severity attribute name.
+     * \param value_type The severity level type.
+     * \return The cached threshold. The reference remains valid as long as the logging core exists.
+     */
+    BOOST_LOG_API boost::log::aux::severity_threshold_cache const&
+    get_severity_threshold(attribute_name const& name, type_info_wrapper const& value_type);
+    /*!
+     * The method updates the cached severity thresholds. Sink frontends call this method when their filter is changed
+     * while they are registered in the core, sinks that implement filtering differently should call it as well.
+     */
+    BOOST_LOG_API void update_severity_thresholds();
+
     /*!
      * The method performs flush on all registered sinks.
      *
@@ -0,0 +1,264 @@
+/*
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   severity_threshold.hpp
+ *
+ * \brief  This header is the Boost.Log library implementation, see the library documentation
+ *         at http://www.boost.org/libs/log/doc/log.html.
+ */
+
+#ifndef BOOST_LOG_DETAIL_SEVERITY_THRESHOLD_HPP_INCLUDED_
+#define BOOST_LOG_DETAIL_SEVERITY_THRESHOLD_HPP_INCLUDED_
+
+#include <boost/cstdint.hpp>
+#include <boost/integer_traits.hpp>
+#include <boost/mpl/or.hpp>
+#include <boost/mpl/and.hpp>
+#include <boost/mpl/bool.hpp>
+#include <boost/utility/enable_if.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/type_traits/is_signed.hpp>
+#include <boost/type_traits/is_integral.hpp>
+#include <boost/proto/tags.hpp>
+#include <boost/proto/traits.hpp>
+#include <boost/log/detail/config.hpp>
+#include <boost/log/attributes/attribute_name.hpp>
+#include <boost/log/attributes/fallback_policy_fwd.hpp>
+#include <boost/log/expressions/attr_fwd.hpp>
+#include <boost/log/utility/type_info_wrapper.hpp>
+#if !defined(BOOST_LOG_NO_THREADS)
+#include <boost/atomic/atomic.hpp>
+#endif
+#include <boost/log/detail/header.hpp>
+
+#ifdef BOOST_LOG_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+namespace boost {
+
+BOOST_LOG_OPEN_NAMESPACE
+
+namespace aux {
+
+/*!
+ * The lower bound of severity levels of the log records that may pass a filter. The threshold is only
+ * known for filters of the form <tt>attr< T >(name) >= level</tt> and their conjunctions and disjunctions.
+ */
+struct severity_threshold
+{
+    //! Severity attribute name, empty if the threshold is not known
+    attribute_name name;
+    //! Severity attribute value type
+    type_info_wrapper value_type;
+    //! The lowest severity level that may pass the filter
+    intmax_t level;
+
+    severity_threshold() : level(0)
+    {
+    }
+    severity_threshold(attribute_name const& n, type_info_wrapper const& t, intmax_t lvl) :
+        name(n), value_type(t), level(lvl)
+    {
+    }
+
+    //! Returns \c true if the threshold is known
+    bool is_known() const BOOST_NOEXCEPT { return !!name; }
+    //! Returns \c true if the threshold applies to the severity level of the specified attribute and type
+    bool applies_to(attribute_name const& n, type_info_wrapper const& t) const { return name == n && value_type == t; }
+};
+
+/*!
+ * The trait selects severity level types that can be reduced to an integer threshold. These are the integral types
+ * that convert to \c intmax_t without changing the value. Enumerations may define their own comparison operators,
+ * so only the enumerations the trait is specialized for, such as <tt>trivial::severity_level</tt>, are selected.
+ */
+template< typename T >
+struct is_severity_level_type :
+    public mpl::and_<
+        is_integral< T >,
+        mpl::bool_< is_signed< T >::value || (sizeof(T) < sizeof(intmax_t)) >
+    >
+{
+};
+
+//! The trait selects threshold values that compare with the severity levels the same way as integers do
+template< typename T, typename ValueT >
+struct is_severity_threshold_value :
+    public mpl::or_<
+        is_same< T, ValueT >,
+        mpl::and_<
+            is_integral< T >,
+            is_severity_level_type< ValueT >,
+            mpl::bool_< is_signed< T >::value == is_signed< ValueT >::value >
+        >
+    >
+{
+};
+
+//! The function creates a threshold from the attribute value and the level it is compared with
+template< typename T, typename TagT, typename ValueT >
+inline typename enable_if<
+    mpl::and_< is_severity_level_type< T >, is_severity_threshold_value< T, ValueT > >,
+    severity_threshold
+>::type make_severity_threshold(expressions::attribute_terminal< T, fallback_to_none, TagT > const& attr, ValueT const& level, intmax_t offset)
+{
+    const intmax_t lvl = static_cast< intmax_t >(level);
+    // No record passes <tt>attr > level</tt> with the greatest level, which the threshold cannot express
+    if (lvl > integer_traits< intmax_t >::const_max - offset)
+        return severity_threshold();
+    return severity_threshold(attr.get_name(), typeid(T), lvl + offset);
+}
+
+//! The overload is used when the comparison operands are not an attribute and a constant level
+template< typename LeftT, typename RightT >
+inline severity_threshold make_severity_threshold(LeftT const&, RightT const&, intmax_t)
+{
+    return severity_threshold();
+}
+
+template< typename T >
+typename enable_if< proto::is_expr< T >, severity_threshold >::type extract_severity_threshold(T const& expr);
+template< typename T >
+typename disable_if< proto::is_expr< T >, severity_threshold >::type extract_severity_threshold(T const&);
+
+//! The overload is used for expressions that cannot be reduced to a threshold
+template< typename ExprT, typename TagT >
+inline severity_threshold extract_severity_threshold(ExprT const&, TagT)
+{
+    return severity_threshold();
+}
+
+//! The overload extracts the threshold from expressions <tt>attr >= level</tt>
+template< typename ExprT >
+inline severity_threshold extract_severity_threshold(ExprT const& expr, proto::tag::greater_equal)
+{
+    return make_severity_threshold(proto::value(proto::child_c< 0 >(expr)), proto::value(proto::child_c< 1 >(expr)), 0);
+}
+
+//! The overload extracts the threshold from expressions <tt>attr > level</tt>
+template< typename ExprT >
+inline severity_threshold extract_severity_threshold(ExprT const& expr, proto::tag::greater)
+{
+    return make_severity_threshold(proto::value(proto::child_c< 0 >(expr)), proto::value(proto::child_c< 1 >(expr)), 1);
+}
+
+//! The overload extracts the threshold from expressions <tt>level <= attr</tt>
+template< typename ExprT >
+inline severity_threshold extract_severity_threshold(ExprT const& expr, proto::tag::less_equal)
+{
+    return make_severity_threshold(proto::value(proto::child_c< 1 >(expr)), proto::value(proto::child_c< 0 >(expr)), 0);
+}
+
+//! The overload extracts the threshold from expressions <tt>level < attr</tt>
+template< typename ExprT >
+inline severity_threshold extract_severity_threshold(ExprT const& expr, proto::tag::less)
+{
+    return make_severity_threshold(proto::value(proto::child_c< 1 >(expr)), proto::value(proto::child_c< 0 >(expr)), 1);
+}
+
+//! The overload extracts the threshold from expressions <tt>a && b</tt>, a record has to pass both thresholds
+template< typename ExprT >
+inline severity_threshold extract_severity_threshold(ExprT const& expr, proto::tag::logical_and)
+{
+    severity_threshold left = aux::extract_severity_threshold(proto::child_c< 0 >(expr));
+    severity_threshold right = aux::extract_severity_threshold(proto::child_c< 1 >(expr));
+    if (!left.is_known())
+        return right;
+    if (right.applies_to(left.name, left.value_type) && right.level > left.level)
+        left.level = right.level;
+    return left;
+}
+
+//! The overload extracts the threshold from expressions <tt>a || b</tt>, a record has to pass any of the thresholds
+template< typename ExprT >
+inline severity_threshold extract_severity_threshold(ExprT const& expr, proto::tag::logical_or)
+{
+    severity_threshold left = aux::extract_severity_threshold(proto::child_c< 0 >(expr));
+    severity_threshold right = aux::extract_severity_threshold(proto::child_c< 1 >(expr));
+    if (!left.is_known() || !right.applies_to(left.name, left.value_type))
+        return severity_threshold();
+    if (right.level < left.level)
+        left.level = right.level;
+    return left;
+}
+
+/*!
+ * The function attempts to reduce a filter expression to a severity threshold. For function objects
+ * that are not filter expressions the threshold is not known.
+ */
+template< typename T >
+inline typename enable_if< proto::is_expr< T >, severity_threshold >::type extract_severity_threshold(T const& expr)
+{
+    return aux::extract_severity_threshold(expr, typename proto::tag_of< T >::type());
+}
+
+template< typename T >
+inline typename disable_if< proto::is_expr< T >, severity_threshold >::type extract_severity_threshold(T const&)
+{
+    return severity_threshold();
+}
+
+/*!
+ * The cached lower bound of severity levels of the log records that may pass the filters in the logging core.
+ * Loggers use the cache to discard records without composing the attribute values.
+ */
+class severity_threshold_cache
+{
+private:
+    //! The lowest severity level that may pass the filters
+#if !defined(BOOST_LOG_NO_THREADS)
+    boost::atomic< intmax_t > m_Level;
+#else
+    intmax_t m_Level;
+#endif
+
+public:
+    severity_threshold_cache() : m_Level(integer_traits< intmax_t >::const_min)
+    {
+    }
+
+    //! Sets the new threshold
+    void set_level(intmax_t level) BOOST_NOEXCEPT
+    {
+#if !defined(BOOST_LOG_NO_THREADS)
+        m_Level.store(level, boost::memory_order_relaxed);
+#else
+        m_Level = level;
+#endif
+    }
+
+    //! Returns \c true if the records with the specified level will not pass the filters
+    template< typename T >
+    typename enable_if< is_severity_level_type< T >, bool >::type is_filtered_out(T level) const BOOST_NOEXCEPT
+    {
+#if !defined(BOOST_LOG_NO_THREADS)
+        return static_cast< intmax_t >(level) < m_Level.load(boost::memory_order_relaxed);
+#else
+        return static_cast< intmax_t >(level) < m_Level;
+#endif
+    }
+
+    //! The overload is used for severity levels that are not integers, such records are never discarded
+    template< typename T >
+    typename disable_if< is_severity_level_type< T >, bool >::type is_filtered_out(T const&) const BOOST_NOEXCEPT
+    {
+        return false;
+    }
+
+    BOOST_LOG_DELETED_FUNCTION(severity_threshold_cache(severity_threshold_cache const&))
+    BOOST_LOG_DELETED_FUNCTION(severity_threshold_cache& operator= (severity_threshold_cache const&))
+};
+
+} // namespace aux
+
+BOOST_LOG_CLOSE_NAMESPACE // namespace log
+
+} // namespace boost
+
+#include <boost/log/detail/footer.hpp>
+
+#endif // BOOST_LOG_DETAIL_SEVERITY_THRESHOLD_HPP_INCLUDED_
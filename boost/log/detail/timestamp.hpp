@@ -61,6 +61,11 @@ public:
     {
         return duration(m_ticks - that.m_ticks);
     }
+
+    bool operator< (timestamp that) const
+    {
+        return m_ticks < that.m_ticks;
+    }
 };
 
 /*!
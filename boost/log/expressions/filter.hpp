@@ -15,12 +15,14 @@
 #ifndef BOOST_LOG_EXPRESSIONS_FILTER_HPP_INCLUDED_
 #define BOOST_LOG_EXPRESSIONS_FILTER_HPP_INCLUDED_
 
+#include <algorithm>
 #include <boost/move/core.hpp>
 #include <boost/move/utility.hpp>
 #include <boost/utility/enable_if.hpp>
 #include <boost/log/detail/config.hpp>
 #include <boost/log/attributes/attribute_value_set.hpp>
 #include <boost/log/detail/light_function.hpp>
+#include <boost/log/detail/severity_threshold.hpp>
 #include <boost/log/detail/header.hpp>
 
 #ifdef BOOST_LOG_HAS_PRAGMA_ONCE
@@ -56,6 +58,8 @@ private:
 private:
     //! Filter function
     filter_type m_Filter;
+    //! Severity threshold, if the filter can be reduced to it
+    boost::log::aux::severity_threshold m_SeverityThreshold;
 
 public:
     /*!
@@ -67,13 +71,15 @@ public:
     /*!
      * Copy constructor
      */
-    filter(filter const& that) : m_Filter(that.m_Filter)
+    filter(filter const& that) : m_Filter(that.m_Filter), m_SeverityThreshold(that.m_SeverityThreshold)
     {
     }
     /*!
      * Move constructor
      */
-    filter(BOOST_RV_REF(filter) that) BOOST_NOEXCEPT : m_Filter(boost::move(that.m_Filter))
+    filter(BOOST_RV_REF(filter) that) BOOST_NOEXCEPT :
+        m_Filter(boost::move(that.m_Filter)),
+        m_SeverityThreshold(that.m_SeverityThreshold)
     {
     }
 
@@ -87,7 +93,7 @@ public:
     template< typename FunT >
     filter(FunT const& fun, typename disable_if< move_detail::is_rv< FunT >, int >::type = 0)
 #endif
-        : m_Filter(fun)
+        : m_Filter(fun), m_SeverityThreshold(boost::log::aux::extract_severity_threshold(fun))
     {
     }
 
@@ -97,6 +103,7 @@ public:
     filter& operator= (BOOST_RV_REF(filter) that) BOOST_NOEXCEPT
     {
         m_Filter.swap(that.m_Filter);
+        std::swap(m_SeverityThreshold, that.m_SeverityThreshold);
         return *this;
     }
     /*!
@@ -105,6 +112,7 @@ public:
     filter& operator= (BOOST_COPY_ASSIGN_REF(filter) that)
     {
         m_Filter = that.m_Filter;
+        m_SeverityThreshold = that.m_SeverityThreshold;
         return *this;
     }
     /*!
@@ -140,14 +148,27 @@ public:
     void reset()
     {
         m_Filter = default_filter();
+        m_SeverityThreshold = boost::log::aux::severity_threshold();
     }
 
+#ifndef BOOST_LOG_DOXYGEN_PASS
+    /*!
+     * \internal The method returns the lowest severity level the filter may pass. The threshold is only known
+     *           if the filter was constructed from an expression like <tt>severity >= level</tt>.
+     */
+    boost::log::aux::severity_threshold const& get_severity_threshold() const BOOST_NOEXCEPT
+    {
+        return m_SeverityThreshold;
+    }
+#endif // BOOST_LOG_DOXYGEN_PASS
+
     /*!
      * Swaps two filters
      */
     void swap(filter& that) BOOST_NOEXCEPT
     {
         m_Filter.swap(that.m_Filter);
+        std::swap(m_SeverityThreshold, that.m_SeverityThreshold);
     }
 };
 
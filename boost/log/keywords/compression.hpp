@@ -0,0 +1,37 @@
+/*
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   keywords/compression.hpp
+ *
+ * The header contains the \c compression keyword declaration.
+ */
+
+#ifndef BOOST_LOG_KEYWORDS_COMPRESSION_HPP_INCLUDED_
+#define BOOST_LOG_KEYWORDS_COMPRESSION_HPP_INCLUDED_
+
+#include <boost/parameter/keyword.hpp>
+#include <boost/log/detail/config.hpp>
+
+#ifdef BOOST_LOG_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+namespace boost {
+
+BOOST_LOG_OPEN_NAMESPACE
+
+namespace keywords {
+
+//! The keyword for passing the compression method of the stored files to a file collector initialization
+BOOST_PARAMETER_KEYWORD(tag, compression)
+
+} // namespace keywords
+
+BOOST_LOG_CLOSE_NAMESPACE // namespace log
+
+} // namespace boost
+
+#endif // BOOST_LOG_KEYWORDS_COMPRESSION_HPP_INCLUDED_
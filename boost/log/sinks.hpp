@@ -27,10 +27,12 @@
 #include <boost/log/sinks/unbounded_ordering_queue.hpp>
 #include <boost/log/sinks/bounded_fifo_queue.hpp>
 #include <boost/log/sinks/bounded_ordering_queue.hpp>
+#include <boost/log/sinks/per_thread_fifo_queue.hpp>
 #include <boost/log/sinks/drop_on_overflow.hpp>
 #include <boost/log/sinks/block_on_overflow.hpp>
 #endif // !defined(BOOST_LOG_NO_THREADS)
 
+#include <boost/log/sinks/binary_file_backend.hpp>
 #include <boost/log/sinks/syslog_backend.hpp>
 #include <boost/log/sinks/text_file_backend.hpp>
 #include <boost/log/sinks/text_multifile_backend.hpp>
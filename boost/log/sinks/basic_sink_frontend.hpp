@@ -21,6 +21,7 @@
 #include <boost/log/detail/code_conversion.hpp>
 #include <boost/log/detail/attachable_sstream_buf.hpp>
 #include <boost/log/detail/fake_mutex.hpp>
+#include <boost/log/core/core.hpp>
 #include <boost/log/core/record_view.hpp>
 #include <boost/log/sinks/sink.hpp>
 #include <boost/log/sinks/frontend_requirements.hpp>
@@ -89,16 +90,24 @@ public:
     template< typename FunT >
     void set_filter(FunT const& filter)
     {
-        BOOST_LOG_EXPR_IF_MT(boost::log::aux::exclusive_lock_guard< mutex_type > lock(m_Mutex);)
-        m_Filter = filter;
+        {
+            BOOST_LOG_EXPR_IF_MT(boost::log::aux::exclusive_lock_guard< mutex_type > lock(m_Mutex);)
+            m_Filter = filter;
+        }
+        if (this->is_registered())
+            core::get()->update_severity_thresholds();
     }
     /*!
      * The method resets the filter
      */
     void reset_filter()
     {
-        BOOST_LOG_EXPR_IF_MT(boost::log::aux::exclusive_lock_guard< mutex_type > lock(m_Mutex);)
-        m_Filter.reset();
+        {
+            BOOST_LOG_EXPR_IF_MT(boost::log::aux::exclusive_lock_guard< mutex_type > lock(m_Mutex);)
+            m_Filter.reset();
+        }
+        if (this->is_registered())
+            core::get()->update_severity_thresholds();
     }
 
     /*!
@@ -120,6 +129,17 @@ public:
         m_ExceptionHandler.clear();
     }
 
+#ifndef BOOST_LOG_DOXYGEN_PASS
+    /*!
+     * \internal The method returns the lowest severity level the filter may pass
+     */
+    boost::log::aux::severity_threshold get_severity_threshold() const
+    {
+        BOOST_LOG_EXPR_IF_MT(boost::log::aux::shared_lock_guard< mutex_type > lock(m_Mutex);)
+        return m_Filter.get_severity_threshold();
+    }
+#endif // BOOST_LOG_DOXYGEN_PASS
+
     /*!
      * The method returns \c true if no filter is set or the attribute values pass the filter
      *
@@ -0,0 +1,154 @@
+/*
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   binary_file_backend.hpp
+ *
+ * The header contains implementation of a binary file sink backend.
+ */
+
+#ifndef BOOST_LOG_SINKS_BINARY_FILE_BACKEND_HPP_INCLUDED_
+#define BOOST_LOG_SINKS_BINARY_FILE_BACKEND_HPP_INCLUDED_
+
+#include <ios>
+#include <string>
+#include <boost/filesystem/path.hpp>
+#include <boost/log/keywords/file_name.hpp>
+#include <boost/log/keywords/open_mode.hpp>
+#include <boost/log/keywords/auto_flush.hpp>
+#include <boost/log/keywords/format.hpp>
+#include <boost/log/detail/config.hpp>
+#include <boost/log/detail/parameter_tools.hpp>
+#include <boost/log/sinks/basic_sink_backend.hpp>
+#include <boost/log/sinks/frontend_requirements.hpp>
+#include <boost/log/detail/header.hpp>
+
+#ifdef BOOST_LOG_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+namespace boost {
+
+BOOST_LOG_OPEN_NAMESPACE
+
+namespace sinks {
+
+/*!
+ * \brief An implementation of a binary file logging sink backend
+ *
+ * The sink backend does not format log records. Instead, it writes the attribute values of every record
+ * to a file in a compact binary format, along with the identifier of a format string. Attribute names and
+ * format strings are written to the file once, when they are first used, so that the file is self-describing.
+ * The file can later be rendered to text with \c binary_log_reader, which reconstructs the attribute values,
+ * and a formatter that is parsed from the format string with \c parse_formatter.
+ *
+ * The backend supports attribute values of the following types: \c bool, \c char, all integral types,
+ * \c float, \c double, <tt>long double</tt> (stored as \c double), \c std::string,
+ * <tt>boost::posix_time::ptime</tt>, <tt>trivial::severity_level</tt>, thread and process identifiers.
+ * Attribute values of other types are not written.
+ */
+class binary_file_backend :
+    public basic_sink_backend<
+        combine_requirements< synchronized_feeding, flushing >::type
+    >
+{
+    //! Base type
+    typedef basic_sink_backend<
+        combine_requirements< synchronized_feeding, flushing >::type
+    > base_type;
+
+private:
+    //! \cond
+
+    struct implementation;
+    implementation* m_pImpl;
+
+    //! \endcond
+
+public:
+    /*!
+     * Default constructor. The constructed sink backend uses default values of all the parameters.
+     */
+    BOOST_LOG_API binary_file_backend();
+
+    /*!
+     * Constructor. Creates a sink backend with the specified named parameters.
+     * The following named parameters are supported:
+     *
+     * \li \c file_name - Specifies the name of the file to write. If not specified, "log.blog" will be used.
+     * \li \c open_mode - File open mode. The mode should be presented in form of mask compatible to
+     *                    <tt>std::ios_base::openmode</tt>. If not specified, <tt>trunc | out</tt> will be used.
+     *                    The file is always opened in binary mode. When appending to a file, a new file
+     *                    header is written, which the reader accepts in the middle of the file.
+     * \li \c format - The format string that is written along with the records, in the syntax accepted by
+     *                 \c parse_formatter. If not specified, "%Message%" will be used.
+     * \li \c auto_flush - Specifies a flag, whether or not to automatically flush the file after each
+     *                     written log record. By default, is \c false.
+     */
+#ifndef BOOST_LOG_DOXYGEN_PASS
+    BOOST_LOG_PARAMETRIZED_CONSTRUCTORS_CALL(binary_file_backend, construct)
+#else
+    template< typename... ArgsT >
+    explicit binary_file_backend(ArgsT... const& args);
+#endif
+
+    /*!
+     * Destructor
+     */
+    BOOST_LOG_API ~binary_file_backend();
+
+    /*!
+     * The method sets the format string for the records written after the call. The format string is written
+     * to the file before the first such record.
+     *
+     * \param format The format string, in the syntax accepted by \c parse_formatter.
+     */
+    BOOST_LOG_API void set_format(std::string const& format);
+
+    /*!
+     * Sets the flag to automatically flush the file after each log record
+     */
+    BOOST_LOG_API void auto_flush(bool f = true);
+
+    /*!
+     * The method writes the record to the file
+     */
+    BOOST_LOG_API void consume(record_view const& rec);
+
+    /*!
+     * The method flushes the file
+     */
+    BOOST_LOG_API void flush();
+
+private:
+#ifndef BOOST_LOG_DOXYGEN_PASS
+    //! Constructor implementation
+    template< typename ArgsT >
+    void construct(ArgsT const& args)
+    {
+        construct(
+            filesystem::path(args[keywords::file_name | filesystem::path("log.blog")]),
+            args[keywords::open_mode | (std::ios_base::trunc | std::ios_base::out)],
+            std::string(args[keywords::format | "%Message%"]),
+            args[keywords::auto_flush | false]);
+    }
+    //! Constructor implementation
+    BOOST_LOG_API void construct(
+        filesystem::path const& file_name,
+        std::ios_base::openmode mode,
+        std::string const& format,
+        bool auto_flush);
+#endif // BOOST_LOG_DOXYGEN_PASS
+};
+
+} // namespace sinks
+
+BOOST_LOG_CLOSE_NAMESPACE // namespace log
+
+} // namespace boost
+
+#include <boost/log/detail/footer.hpp>
+
+#endif // BOOST_LOG_SINKS_BINARY_FILE_BACKEND_HPP_INCLUDED_
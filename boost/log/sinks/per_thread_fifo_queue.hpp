@@ -0,0 +1,516 @@
+/*
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   per_thread_fifo_queue.hpp
+ *
+ * The header contains implementation of per-thread FIFO queueing strategy for
+ * the asynchronous sink frontend.
+ */
+
+#ifndef BOOST_LOG_SINKS_PER_THREAD_FIFO_QUEUE_HPP_INCLUDED_
+#define BOOST_LOG_SINKS_PER_THREAD_FIFO_QUEUE_HPP_INCLUDED_
+
+#include <boost/log/detail/config.hpp>
+
+#ifdef BOOST_LOG_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+#if defined(BOOST_LOG_NO_THREADS)
+#error Boost.Log: This header content is only supported in multithreaded environment
+#endif
+
+#include <new>
+#include <cstddef>
+#include <vector>
+#include <boost/cstdint.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/move/utility.hpp>
+#include <boost/atomic/atomic.hpp>
+#include <boost/type_traits/aligned_storage.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+#include <boost/thread/tss.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/log/detail/event.hpp>
+#include <boost/log/detail/timestamp.hpp>
+#include <boost/log/core/record_view.hpp>
+#include <boost/log/detail/header.hpp>
+
+namespace boost {
+
+BOOST_LOG_OPEN_NAMESPACE
+
+namespace aux {
+
+/*!
+ * The base class of the thread-specific references to the per-thread queues. Thread-specific
+ * storage is looked up by the address of the \c thread_specific_ptr, so a queue created at the address
+ * of a destroyed one would see the references left by the old queue in other threads. The references
+ * carry the unique identifier of their queue, so that stale ones can be detected.
+ */
+struct per_thread_queue_ref_base
+{
+    const uintmax_t m_queue_id;
+
+    explicit per_thread_queue_ref_base(uintmax_t id) : m_queue_id(id)
+    {
+    }
+    virtual ~per_thread_queue_ref_base()
+    {
+    }
+};
+
+//! The generator of per-thread queue identifiers
+template< typename >
+struct per_thread_queue_ids
+{
+    static boost::atomic< uintmax_t > counter;
+};
+
+template< typename T >
+boost::atomic< uintmax_t > per_thread_queue_ids< T >::counter(0u);
+
+} // namespace aux
+
+namespace sinks {
+
+/*!
+ * \brief Per-thread FIFO log record queueing strategy
+ *
+ * The \c per_thread_fifo_queue class is intended to be used with
+ * the \c asynchronous_sink frontend as a log record queueing strategy.
+ *
+ * Every thread that enqueues log records gets a separate queue of limited capacity,
+ * specified by the \c MaxQueueSizeV template parameter. The enqueueing threads do not
+ * contend with each other and with the dequeueing thread, unless a queue overflows.
+ * Upon reaching the size limit, the queue invokes the overflow handling strategy
+ * specified in the \c OverflowStrategyT template parameter to handle the situation.
+ * The library provides overflow handling strategies for most common cases:
+ * \c drop_on_overflow will silently discard the log record, and \c block_on_overflow
+ * will put the enqueueing thread to wait until there is space in its queue.
+ *
+ * The dequeueing thread merges the per-thread queues in the order of the time points
+ * when the records were enqueued. Records that are being enqueued concurrently with
+ * dequeueing may be dequeued after the records enqueued slightly later by other threads.
+ * The cost of dequeueing is linear to the number of threads that enqueue records.
+ * The queue of a thread is released when the thread terminates and all its records
+ * have been dequeued.
+ */
+template< std::size_t MaxQueueSizeV, typename OverflowStrategyT >
+class per_thread_fifo_queue :
+    private OverflowStrategyT
+{
+    BOOST_STATIC_ASSERT_MSG(MaxQueueSizeV > 0, "Boost.Log: The per-thread queue capacity must not be zero");
+
+private:
+    typedef OverflowStrategyT overflow_strategy;
+    typedef boost::mutex mutex_type;
+
+    //! Log record with enqueueing timestamp
+    struct enqueued_record
+    {
+        boost::log::aux::timestamp m_timestamp;
+        record_view m_record;
+
+        explicit enqueued_record(record_view const& rec) :
+            m_timestamp(boost::log::aux::get_timestamp()),
+            m_record(rec)
+        {
+        }
+    };
+
+    //! Single producer single consumer ring buffer of the records enqueued by one thread
+    class ring
+    {
+    private:
+        typedef typename aligned_storage<
+            sizeof(enqueued_record),
+            alignment_of< enqueued_record >::value
+        >::type storage_type;
+
+        enum { padding_size = 64 };
+
+    private:
+        //! The position of the next record to dequeue, only modified by the dequeueing thread
+        boost::atomic< std::size_t > m_head;
+        //! The last observed value of \c m_tail, only used by the dequeueing thread
+        std::size_t m_cached_tail;
+        char m_padding1[padding_size];
+        //! The position of the next record to enqueue, only modified by the enqueueing thread
+        boost::atomic< std::size_t > m_tail;
+        //! The last observed value of \c m_head, only used by the enqueueing thread
+        std::size_t m_cached_head;
+        char m_padding2[padding_size];
+        //! The flag is set when the enqueueing thread terminates
+        boost::atomic< bool > m_abandoned;
+        //! Records
+        storage_type m_storage[MaxQueueSizeV];
+
+    public:
+        ring() : m_head(0), m_cached_tail(0), m_tail(0), m_cached_head(0), m_abandoned(false)
+        {
+        }
+
+        ~ring()
+        {
+            const std::size_t tail = m_tail.load(boost::memory_order_acquire);
+            for (std::size_t head = m_head.load(boost::memory_order_relaxed); head != tail; ++head)
+                slot(head)->~enqueued_record();
+        }
+
+        //! Checks if the ring is full, only called by the enqueueing thread
+        bool full()
+        {
+            const std::size_t tail = m_tail.load(boost::memory_order_relaxed);
+            if (tail - m_cached_head < MaxQueueSizeV)
+                return false;
+            m_cached_head = m_head.load(boost::memory_order_acquire);
+            return tail - m_cached_head >= MaxQueueSizeV;
+        }
+
+        //! Checks if the ring is full, in a way that synchronizes with \c pop
+        bool full_synchronized()
+        {
+            boost::atomic_thread_fence(boost::memory_order_seq_cst);
+            m_cached_head = m_head.load(boost::memory_order_acquire);
+            return m_tail.load(boost::memory_order_relaxed) - m_cached_head >= MaxQueueSizeV;
+        }
+
+        //! Enqueues a record, only called by the enqueueing thread if the ring is not full
+        void push(record_view const& rec)
+        {
+            const std::size_t tail = m_tail.load(boost::memory_order_relaxed);
+            new (slot(tail)) enqueued_record(rec);
+            m_tail.store(tail + 1u, boost::memory_order_release);
+        }
+
+        //! Returns the oldest record or \c NULL if the ring is empty, only called by the dequeueing thread
+        enqueued_record* front()
+        {
+            const std::size_t head = m_head.load(boost::memory_order_relaxed);
+            if (head == m_cached_tail)
+            {
+                m_cached_tail = m_tail.load(boost::memory_order_acquire);
+                if (head == m_cached_tail)
+                    return NULL;
+            }
+            return slot(head);
+        }
+
+        /*!
+         * Dequeues the oldest record, only called by the dequeueing thread if the ring is not empty.
+         * Returns \c true if the ring was full before the call.
+         */
+        bool pop(record_view& rec)
+        {
+            const std::size_t head = m_head.load(boost::memory_order_relaxed);
+            enqueued_record* p = slot(head);
+            rec = boost::move(p->m_record);
+            p->~enqueued_record();
+            m_head.store(head + 1u, boost::memory_order_release);
+
+            // Pairs with the fence in full_synchronized: either the enqueueing thread sees the free slot,
+            // or this thread sees the ring was full
+            boost::atomic_thread_fence(boost::memory_order_seq_cst);
+            return m_tail.load(boost::memory_order_relaxed) - head >= MaxQueueSizeV;
+        }
+
+        //! Marks the ring as abandoned by the enqueueing thread
+        void abandon()
+        {
+            m_abandoned.store(true, boost::memory_order_release);
+        }
+
+        //! Checks if the ring can be released, only called by the dequeueing thread
+        bool expired()
+        {
+            return m_abandoned.load(boost::memory_order_acquire) && front() == NULL;
+        }
+
+    private:
+        enqueued_record* slot(std::size_t pos)
+        {
+            return static_cast< enqueued_record* >(static_cast< void* >(m_storage + pos % MaxQueueSizeV));
+        }
+
+        //  Copying prohibited
+        ring(ring const&);
+        ring& operator= (ring const&);
+    };
+
+    //! Thread-specific reference to the ring of the thread
+    struct ring_ref :
+        public boost::log::aux::per_thread_queue_ref_base
+    {
+        shared_ptr< ring > m_ring;
+
+        ring_ref(uintmax_t queue_id, shared_ptr< ring > const& r) :
+            boost::log::aux::per_thread_queue_ref_base(queue_id),
+            m_ring(r)
+        {
+        }
+        ~ring_ref()
+        {
+            m_ring->abandon();
+        }
+    };
+
+    typedef std::vector< shared_ptr< ring > > ring_list;
+    typedef std::vector< ring* > ring_snapshot;
+
+private:
+    //! Synchronization primitive, protects the list of rings and the overflow strategy
+    mutex_type m_mutex;
+    //! Rings of all threads
+    ring_list m_rings;
+    //! The counter is incremented every time the list of rings changes
+    boost::atomic< unsigned int > m_rings_version;
+    //! The number of threads blocked in the overflow strategy
+    std::size_t m_blocked_count;
+    //! The unique identifier of the queue
+    const uintmax_t m_id;
+    //! The ring of the current thread
+    thread_specific_ptr< boost::log::aux::per_thread_queue_ref_base > m_ring_ref;
+
+    //! The copy of the list of rings, only used by the dequeueing thread
+    ring_snapshot m_snapshot;
+    //! The version of the list of rings the snapshot was taken from
+    unsigned int m_snapshot_version;
+
+    //! Event object to block on
+    boost::log::aux::event m_event;
+    //! The flag is set when the dequeueing thread is about to block
+    boost::atomic< bool > m_dequeue_waiting;
+    //! Interruption flag
+    boost::atomic< bool > m_interruption_requested;
+
+protected:
+    //! Default constructor
+    per_thread_fifo_queue() :
+        m_rings_version(0),
+        m_blocked_count(0),
+        m_id(boost::log::aux::per_thread_queue_ids< void >::counter.fetch_add(1u, boost::memory_order_relaxed)),
+        m_snapshot_version(0),
+        m_dequeue_waiting(false),
+        m_interruption_requested(false)
+    {
+    }
+    //! Initializing constructor
+    template< typename ArgsT >
+    explicit per_thread_fifo_queue(ArgsT const&) :
+        m_rings_version(0),
+        m_blocked_count(0),
+        m_id(boost::log::aux::per_thread_queue_ids< void >::counter.fetch_add(1u, boost::memory_order_relaxed)),
+        m_snapshot_version(0),
+        m_dequeue_waiting(false),
+        m_interruption_requested(false)
+    {
+    }
+
+    //! Enqueues log record to the queue
+    void enqueue(record_view const& rec)
+    {
+        ring* const r = get_ring();
+        if (r->full())
+        {
+            unique_lock< mutex_type > lock(m_mutex);
+            while (r->full_synchronized())
+            {
+                ++m_blocked_count;
+                const bool retry = overflow_strategy::on_overflow(rec, lock);
+                --m_blocked_count;
+                if (!retry)
+                    return;
+            }
+        }
+
+        r->push(rec);
+        notify_dequeue();
+    }
+
+    //! Attempts to enqueue log record to the queue
+    bool try_enqueue(record_view const& rec)
+    {
+        ring* const r = get_ring();
+
+        // Do not invoke the bounding strategy in case of overflow as it may block
+        if (r->full())
+            return false;
+
+        r->push(rec);
+        notify_dequeue();
+        return true;
+    }
+
+    //! Attempts to dequeue a log record ready for processing from the queue, does not block if the queue is empty
+    bool try_dequeue_ready(record_view& rec)
+    {
+        return try_dequeue(rec);
+    }
+
+    //! Attempts to dequeue log record from the queue, does not block if the queue is empty
+    bool try_dequeue(record_view& rec)
+    {
+        update_snapshot();
+
+        ring* oldest = NULL;
+        enqueued_record* oldest_record = NULL;
+        bool expired_rings = false;
+        for (typename ring_snapshot::const_iterator it = m_snapshot.begin(), end = m_snapshot.end(); it != end; ++it)
+        {
+            ring* const r = *it;
+            enqueued_record* const p = r->front();
+            if (p)
+            {
+                if (!oldest_record || p->m_timestamp < oldest_record->m_timestamp)
+                {
+                    oldest = r;
+                    oldest_record = p;
+                }
+            }
+            else
+                expired_rings |= r->expired();
+        }
+
+        if (expired_rings)
+            release_expired_rings();
+
+        if (oldest)
+        {
+            if (oldest->pop(rec))
+                on_ring_space_available();
+            return true;
+        }
+
+        return false;
+    }
+
+    //! Dequeues log record from the queue, blocks if the queue is empty
+    bool dequeue_ready(record_view& rec)
+    {
+        while (!m_interruption_requested.load(boost::memory_order_relaxed))
+        {
+            if (try_dequeue(rec))
+                return true;
+
+            // Pairs with the fence in notify_dequeue: either the enqueueing thread sees the flag,
+            // or this thread sees the enqueued record
+            m_dequeue_waiting.store(true, boost::memory_order_relaxed);
+            boost::atomic_thread_fence(boost::memory_order_seq_cst);
+            if (!m_interruption_requested.load(boost::memory_order_relaxed) && !has_records())
+                m_event.wait();
+            m_dequeue_waiting.store(false, boost::memory_order_relaxed);
+        }
+        m_interruption_requested.store(false, boost::memory_order_relaxed);
+
+        return false;
+    }
+
+    //! Wakes a thread possibly blocked in the \c dequeue method
+    void interrupt_dequeue()
+    {
+        lock_guard< mutex_type > lock(m_mutex);
+        m_interruption_requested.store(true, boost::memory_order_relaxed);
+        overflow_strategy::interrupt();
+        m_event.set_signalled();
+    }
+
+private:
+    //! Returns the ring of the current thread, creates one if needed
+    ring* get_ring()
+    {
+        boost::log::aux::per_thread_queue_ref_base* base = m_ring_ref.get();
+        if (base && base->m_queue_id == m_id)
+            return static_cast< ring_ref* >(base)->m_ring.get();
+
+        // Either the thread has not enqueued records yet, or the reference was left by a destroyed queue
+        // at the same address. In the latter case resetting the pointer releases the ring of the old queue.
+        shared_ptr< ring > r = boost::make_shared< ring >();
+        {
+            lock_guard< mutex_type > lock(m_mutex);
+            m_rings.push_back(r);
+            m_rings_version.fetch_add(1u, boost::memory_order_release);
+        }
+        m_ring_ref.reset(new ring_ref(m_id, r));
+        return r.get();
+    }
+
+    //! Wakes the dequeueing thread if it is blocked
+    void notify_dequeue()
+    {
+        boost::atomic_thread_fence(boost::memory_order_seq_cst);
+        if (m_dequeue_waiting.load(boost::memory_order_relaxed))
+            m_event.set_signalled();
+    }
+
+    //! Wakes the threads blocked on overflow, so that the thread whose ring has space can proceed
+    void on_ring_space_available()
+    {
+        lock_guard< mutex_type > lock(m_mutex);
+        for (std::size_t n = m_blocked_count; n > 0; --n)
+            overflow_strategy::on_queue_space_available();
+    }
+
+    //! Checks if any of the rings contains records
+    bool has_records()
+    {
+        update_snapshot();
+        for (typename ring_snapshot::const_iterator it = m_snapshot.begin(), end = m_snapshot.end(); it != end; ++it)
+        {
+            if ((*it)->front())
+                return true;
+        }
+        return false;
+    }
+
+    //! Updates the snapshot of the list of rings, if it has changed
+    void update_snapshot()
+    {
+        if (m_rings_version.load(boost::memory_order_acquire) != m_snapshot_version)
+        {
+            lock_guard< mutex_type > lock(m_mutex);
+            take_snapshot();
+        }
+    }
+
+    //! Releases the rings of the terminated threads
+    void release_expired_rings()
+    {
+        lock_guard< mutex_type > lock(m_mutex);
+        typename ring_list::iterator it = m_rings.begin();
+        while (it != m_rings.end())
+        {
+            if ((*it)->expired())
+                it = m_rings.erase(it);
+            else
+                ++it;
+        }
+        m_rings_version.fetch_add(1u, boost::memory_order_release);
+        take_snapshot();
+    }
+
+    //! Copies the list of rings, the mutex must be locked
+    void take_snapshot()
+    {
+        m_snapshot_version = m_rings_version.load(boost::memory_order_relaxed);
+        m_snapshot.clear();
+        for (typename ring_list::const_iterator it = m_rings.begin(), end = m_rings.end(); it != end; ++it)
+            m_snapshot.push_back(it->get());
+    }
+};
+
+} // namespace sinks
+
+BOOST_LOG_CLOSE_NAMESPACE // namespace log
+
+} // namespace boost
+
+#include <boost/log/detail/footer.hpp>
+
+#endif // BOOST_LOG_SINKS_PER_THREAD_FIFO_QUEUE_HPP_INCLUDED_
@@ -19,6 +19,10 @@
 #include <string>
 #include <boost/log/detail/config.hpp>
 #include <boost/log/detail/light_function.hpp>
+#include <boost/log/detail/severity_threshold.hpp>
+#if !defined(BOOST_LOG_NO_THREADS)
+#include <boost/atomic/atomic.hpp>
+#endif
 #include <boost/log/core/record_view.hpp>
 #include <boost/log/attributes/attribute_value_set.hpp>
 #include <boost/log/detail/header.hpp>
@@ -43,12 +47,18 @@ public:
 private:
     //! The flag indicates that the sink passes log records across thread boundaries
     const bool m_cross_thread;
+    //! The flag indicates that the sink is registered in the logging core
+#if !defined(BOOST_LOG_NO_THREADS)
+    boost::atomic< bool > m_registered;
+#else
+    bool m_registered;
+#endif
 
 public:
     /*!
      * Default constructor
      */
-    explicit sink(bool cross_thread) : m_cross_thread(cross_thread)
+    explicit sink(bool cross_thread) : m_cross_thread(cross_thread), m_registered(false)
     {
     }
 
@@ -93,6 +103,34 @@ public:
      */
     virtual void flush() = 0;
 
+#ifndef BOOST_LOG_DOXYGEN_PASS
+    /*!
+     * \internal The method returns the lowest severity level the sink filter may pass. The logging core uses
+     *           the threshold to discard records early. By default the threshold is not known.
+     */
+    virtual boost::log::aux::severity_threshold get_severity_threshold() const
+    {
+        return boost::log::aux::severity_threshold();
+    }
+
+    /*!
+     * \internal The method returns \c true if the sink is registered in the logging core. Sinks only need to
+     *           update the cached severity thresholds of the core when they are registered.
+     */
+    bool is_registered() const BOOST_NOEXCEPT
+    {
+        return m_registered;
+    }
+
+    /*!
+     * \internal The method is called by the logging core when the sink is added or removed
+     */
+    void set_registered(bool registered) BOOST_NOEXCEPT
+    {
+        m_registered = registered;
+    }
+#endif // BOOST_LOG_DOXYGEN_PASS
+
     /*!
      * The method indicates that the sink passes log records between different threads. This information is
      * needed by the logging core to detach log records from all thread-specific resources before passing it
@@ -18,6 +18,7 @@
 #include <ios>
 #include <string>
 #include <ostream>
+#include <cstddef>
 #include <boost/limits.hpp>
 #include <boost/cstdint.hpp>
 #include <boost/shared_ptr.hpp>
@@ -29,9 +30,12 @@
 #include <boost/log/keywords/max_size.hpp>
 #include <boost/log/keywords/min_free_space.hpp>
 #include <boost/log/keywords/target.hpp>
+#include <boost/log/keywords/compression.hpp>
 #include <boost/log/keywords/file_name.hpp>
 #include <boost/log/keywords/open_mode.hpp>
 #include <boost/log/keywords/auto_flush.hpp>
+#include <boost/log/keywords/buffer_size.hpp>
+#include <boost/log/keywords/flush_interval.hpp>
 #include <boost/log/keywords/rotation_size.hpp>
 #include <boost/log/keywords/time_based_rotation.hpp>
 #include <boost/log/detail/config.hpp>
@@ -61,6 +65,14 @@ enum scan_method
     scan_all        //!< Scan for all files in the directory
 };
 
+//! The enumeration of the stored files compression methods
+enum compression_method
+{
+    no_compression,     //!< Store files as is
+    gzip_compression,   //!< Compress stored files with gzip, the ".gz" extension is appended to the file names
+    bzip2_compression   //!< Compress stored files with bzip2, the ".bz2" extension is appended to the file names
+};
+
 /*!
  * \brief Base class for file collectors
  *
@@ -129,7 +141,8 @@ namespace aux {
     BOOST_LOG_API shared_ptr< collector > make_collector(
         filesystem::path const& target_dir,
         uintmax_t max_size,
-        uintmax_t min_free_space
+        uintmax_t min_free_space,
+        compression_method compression
     );
     template< typename ArgsT >
     inline shared_ptr< collector > make_collector(ArgsT const& args)
@@ -137,7 +150,8 @@ namespace aux {
         return aux::make_collector(
             filesystem::path(args[keywords::target]),
             args[keywords::max_size | (std::numeric_limits< uintmax_t >::max)()],
-            args[keywords::min_free_space | static_cast< uintmax_t >(0)]);
+            args[keywords::min_free_space | static_cast< uintmax_t >(0)],
+            args[keywords::compression | no_compression]);
     }
 
 } // namespace aux
@@ -159,6 +173,11 @@ inline shared_ptr< collector > make_collector(T1 const& a1, T2 const& a2, T3 con
 {
     return aux::make_collector((a1, a2, a3));
 }
+template< typename T1, typename T2, typename T3, typename T4 >
+inline shared_ptr< collector > make_collector(T1 const& a1, T2 const& a2, T3 const& a3, T4 const& a4)
+{
+    return aux::make_collector((a1, a2, a3, a4));
+}
 
 #else
 
@@ -190,6 +209,14 @@ inline shared_ptr< collector > make_collector(T1 const& a1, T2 const& a2, T3 con
  *                         the collector tries to maintain. If the threshold is exceeded, the oldest
  *                         file(s) is deleted to free space. The threshold is not maintained, if not
  *                         specified.
+ * \li \c compression - Specifies the compression method of the stored files, see \c compression_method.
+ *                      The files are compressed by a background thread after they are moved to the target
+ *                      directory. The compressed file sizes are used to maintain the \c max_size threshold.
+ *                      The files are not compressed, if not specified. If the same collector is requested
+ *                      more than once, the last specified method other than \c no_compression is used, so
+ *                      a request without compression does not disable compression requested earlier.
+ *                      The library must be built with the \c BOOST_LOG_WITH_COMPRESSION macro defined
+ *                      for compression to be supported, otherwise an exception is thrown.
  *
  * \return The file collector.
  */
@@ -377,7 +404,15 @@ public:
      * \li \c time_based_rotation - Specifies the predicate for time-based file rotation.
      *                              No time-based file rotations will be performed, if not specified.
      * \li \c auto_flush - Specifies a flag, whether or not to automatically flush the file after each
-     *                     written log record. By default, is \c false.
+     *                     written log record. If the output is buffered, the record is passed to the background
+     *                     thread without waiting for it to be written. By default, is \c false.
+     * \li \c buffer_size - Specifies the size of the output buffer, in bytes. If not zero, the formatted records
+     *                      are accumulated in buffers of this size, which are written to the file by a background
+     *                      thread. The background thread also closes the rotated files and passes them to the
+     *                      file collector. By default, is 0, which means the records are written to a file stream.
+     * \li \c flush_interval - Specifies the time interval of writing the accumulated records to the file and
+     *                         synchronizing the file with the storage device. Only used if \c buffer_size is not zero.
+     *                         By default, the buffers are only written when they are full or the backend is flushed.
      *
      * \note Read the caution note regarding file name pattern in the <tt>sinks::file::collector::scan_for_files</tt>
      *       documentation.
@@ -462,9 +497,34 @@ public:
 
     /*!
      * Sets the flag to automatically flush buffers of all attached streams after each log record
+     *
+     * \note When the output is buffered, the record is passed to the background thread without waiting for it
+     *       to be written, and the file is not synchronized with the storage device. Call \c flush to wait
+     *       for the records to reach the storage device.
      */
     BOOST_LOG_API void auto_flush(bool f = true);
 
+    /*!
+     * The method sets the size of the output buffer. If the size is not zero, the formatted records are accumulated
+     * in buffers of this size, which are written to the file by a background thread. The new size takes effect
+     * when the next file is opened.
+     *
+     * \note When the output is buffered, flushing the backend also synchronizes the file with the storage device.
+     *
+     * \param size The output buffer size, in bytes, or 0 to write records directly to the file stream.
+     */
+    BOOST_LOG_API void set_buffer_size(std::size_t size);
+
+    /*!
+     * The method sets the time interval of writing the buffered records to the file and synchronizing the file
+     * with the storage device. The interval is only used if the output is buffered. The new interval takes effect
+     * when the next file is opened.
+     *
+     * \param interval The flush interval. If \c posix_time::not_a_date_time, the buffers are only written
+     *                 when they are full or the backend is flushed.
+     */
+    BOOST_LOG_API void set_flush_interval(posix_time::time_duration const& interval);
+
     /*!
      * Performs scanning of the target directory for log files that may have been left from
      * previous runs of the application. The found files are considered by the file collector
@@ -513,7 +573,9 @@ private:
             args[keywords::open_mode | (std::ios_base::trunc | std::ios_base::out)],
             args[keywords::rotation_size | (std::numeric_limits< uintmax_t >::max)()],
             args[keywords::time_based_rotation | time_based_rotation_predicate()],
-            args[keywords::auto_flush | false]);
+            args[keywords::auto_flush | false],
+            args[keywords::buffer_size | static_cast< std::size_t >(0u)],
+            args[keywords::flush_interval | posix_time::time_duration(posix_time::not_a_date_time)]);
     }
     //! Constructor implementation
     BOOST_LOG_API void construct(
@@ -521,7 +583,9 @@ private:
         std::ios_base::openmode mode,
         uintmax_t rotation_size,
         time_based_rotation_predicate const& time_based_rotation,
-        bool auto_flush);
+        bool auto_flush,
+        std::size_t buffer_size,
+        posix_time::time_duration const& flush_interval);
 
     //! The method sets file name mask
     BOOST_LOG_API void set_file_name_pattern_internal(filesystem::path const& pattern);
@@ -23,6 +23,7 @@
 #include <boost/log/detail/config.hpp>
 #include <boost/log/detail/locks.hpp>
 #include <boost/log/detail/default_attribute_names.hpp>
+#include <boost/log/detail/severity_threshold.hpp>
 #include <boost/log/attributes/attribute.hpp>
 #include <boost/log/attributes/attribute_cast.hpp>
 #include <boost/log/attributes/attribute_value_impl.hpp>
@@ -186,6 +187,8 @@ private:
     severity_level m_DefaultSeverity;
     //! Severity attribute
     severity_attribute m_SeverityAttr;
+    //! Cached lowest severity level that may pass the filters
+    boost::log::aux::severity_threshold_cache const* m_pSeverityThreshold;
 
 public:
     /*!
@@ -194,7 +197,8 @@ public:
      */
     basic_severity_logger() :
         base_type(),
-        m_DefaultSeverity(static_cast< severity_level >(0))
+        m_DefaultSeverity(static_cast< severity_level >(0)),
+        m_pSeverityThreshold(get_severity_threshold_cache())
     {
         base_type::add_attribute_unlocked(boost::log::aux::default_attribute_names::severity(), m_SeverityAttr);
     }
@@ -204,7 +208,8 @@ public:
     basic_severity_logger(basic_severity_logger const& that) :
         base_type(static_cast< base_type const& >(that)),
         m_DefaultSeverity(that.m_DefaultSeverity),
-        m_SeverityAttr(that.m_SeverityAttr)
+        m_SeverityAttr(that.m_SeverityAttr),
+        m_pSeverityThreshold(that.m_pSeverityThreshold)
     {
         base_type::attributes()[boost::log::aux::default_attribute_names::severity()] = m_SeverityAttr;
     }
@@ -214,7 +219,8 @@ public:
     basic_severity_logger(BOOST_RV_REF(basic_severity_logger) that) :
         base_type(boost::move(static_cast< base_type& >(that))),
         m_DefaultSeverity(boost::move(that.m_DefaultSeverity)),
-        m_SeverityAttr(boost::move(that.m_SeverityAttr))
+        m_SeverityAttr(boost::move(that.m_SeverityAttr)),
+        m_pSeverityThreshold(that.m_pSeverityThreshold)
     {
         base_type::attributes()[boost::log::aux::default_attribute_names::severity()] = m_SeverityAttr;
     }
@@ -227,7 +233,8 @@ public:
     template< typename ArgsT >
     explicit basic_severity_logger(ArgsT const& args) :
         base_type(args),
-        m_DefaultSeverity(args[keywords::severity | severity_level()])
+        m_DefaultSeverity(args[keywords::severity | severity_level()]),
+        m_pSeverityThreshold(get_severity_threshold_cache())
     {
         base_type::add_attribute_unlocked(boost::log::aux::default_attribute_names::severity(), m_SeverityAttr);
     }
@@ -249,7 +256,11 @@ protected:
     template< typename ArgsT >
     record open_record_unlocked(ArgsT const& args)
     {
-        m_SeverityAttr.set_value(args[keywords::severity | m_DefaultSeverity]);
+        const severity_level level = args[keywords::severity | m_DefaultSeverity];
+        // Discard the record early if it would not pass the filters anyway
+        if (m_pSeverityThreshold->is_filtered_out(level))
+            return record();
+        m_SeverityAttr.set_value(level);
         return base_type::open_record_unlocked(args);
     }
 
@@ -261,6 +272,16 @@ protected:
         m_DefaultSeverity = that.m_DefaultSeverity;
         that.m_DefaultSeverity = t;
         m_SeverityAttr.swap(that.m_SeverityAttr);
+        boost::log::aux::severity_threshold_cache const* p = m_pSeverityThreshold;
+        m_pSeverityThreshold = that.m_pSeverityThreshold;
+        that.m_pSeverityThreshold = p;
+    }
+
+private:
+    //! Returns the severity threshold cached in the logging core for this logger
+    boost::log::aux::severity_threshold_cache const* get_severity_threshold_cache() const
+    {
+        return &base_type::core()->get_severity_threshold(boost::log::aux::default_attribute_names::severity(), typeid(severity_level));
     }
 };
 
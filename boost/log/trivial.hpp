@@ -19,6 +19,7 @@
 #include <ostream>
 #include <boost/log/detail/config.hpp>
 #include <boost/log/keywords/severity.hpp>
+#include <boost/log/detail/severity_threshold.hpp>
 #include <boost/log/sources/severity_logger.hpp>
 #include <boost/log/sources/record_ostream.hpp>
 #include <boost/log/detail/header.hpp>
@@ -48,6 +49,25 @@ enum severity_level
     fatal
 };
 
+} // namespace trivial
+
+#ifndef BOOST_LOG_DOXYGEN_PASS
+
+namespace aux {
+
+//! The trivial severity levels are ordered as integers, so filters on them can be reduced to a threshold
+template< >
+struct is_severity_level_type< trivial::severity_level > :
+    public mpl::true_
+{
+};
+
+} // namespace aux
+
+#endif // BOOST_LOG_DOXYGEN_PASS
+
+namespace trivial {
+
 //! Returns stringized enumeration value or \c NULL, if the value is not valid
 BOOST_LOG_API const char* to_string(severity_level lvl);
 
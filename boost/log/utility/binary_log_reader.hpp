@@ -0,0 +1,111 @@
+/*
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   binary_log_reader.hpp
+ *
+ * This header contains a reader of the files written by the binary file sink backend.
+ */
+
+#ifndef BOOST_LOG_UTILITY_BINARY_LOG_READER_HPP_INCLUDED_
+#define BOOST_LOG_UTILITY_BINARY_LOG_READER_HPP_INCLUDED_
+
+#include <istream>
+#include <string>
+#include <boost/cstdint.hpp>
+#include <boost/log/detail/config.hpp>
+#include <boost/log/attributes/attribute_value_set.hpp>
+#include <boost/log/detail/header.hpp>
+
+#ifdef BOOST_LOG_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+namespace boost {
+
+BOOST_LOG_OPEN_NAMESPACE
+
+/*!
+ * \brief A reader of the files written by \c binary_file_backend
+ *
+ * The reader decodes the log records from a stream, one at a time, and reconstructs the attribute values
+ * of every record along with the format string the record was written with. The attribute values can be
+ * passed to the logging core to be formatted and output by regular sinks:
+ *
+ * \code
+ * attribute_value_set values;
+ * while (reader.read_record(values))
+ * {
+ *     record rec = core::get()->open_record(values);
+ *     if (rec)
+ *         core::get()->push_record(boost::move(rec));
+ * }
+ * \endcode
+ *
+ * When the end of the stream is reached in the middle of a record, the stream is positioned at the beginning of
+ * the record, so that reading can be resumed after more data is written to the file.
+ *
+ * \note The reader is not thread-safe.
+ */
+class binary_log_reader
+{
+private:
+    //! \cond
+
+    struct implementation;
+    implementation* m_pImpl;
+
+    //! \endcond
+
+public:
+    /*!
+     * Constructor. Reads the file header from the stream.
+     *
+     * \param strm The stream to read the records from. The stream should be opened in binary mode
+     *             and should outlive the reader.
+     *
+     * \b Throws: An exception of type \c parse_error if the stream does not begin with a binary log file header.
+     */
+    BOOST_LOG_API explicit binary_log_reader(std::istream& strm);
+
+    /*!
+     * Destructor
+     */
+    BOOST_LOG_API ~binary_log_reader();
+
+    /*!
+     * The method reads the next record from the stream.
+     *
+     * \param values Receives the attribute values of the record. The previous contents of the set are discarded.
+     * \return \c true if a record has been read, \c false if the end of the stream has been reached.
+     *
+     * \b Throws: An exception of type \c parse_error if the stream contents are malformed.
+     */
+    BOOST_LOG_API bool read_record(attribute_value_set& values);
+
+    /*!
+     * \return The identifier of the format string of the last read record. The identifier changes whenever
+     *         a record is written with a different format string, so it can be used to cache formatters.
+     *         Format strings with different identifiers may be equal. The identifier of the first format
+     *         string is 1.
+     */
+    BOOST_LOG_API uintmax_t format_id() const;
+
+    /*!
+     * \return The format string of the last read record.
+     */
+    BOOST_LOG_API std::string const& format() const;
+
+    BOOST_LOG_DELETED_FUNCTION(binary_log_reader(binary_log_reader const&))
+    BOOST_LOG_DELETED_FUNCTION(binary_log_reader& operator= (binary_log_reader const&))
+};
+
+BOOST_LOG_CLOSE_NAMESPACE // namespace log
+
+} // namespace boost
+
+#include <boost/log/detail/footer.hpp>
+
+#endif // BOOST_LOG_UTILITY_BINARY_LOG_READER_HPP_INCLUDED_
@@ -295,6 +295,13 @@
 #define BOOST_THREAD_PROVIDES_INTERRUPTIONS
 #endif
 
+// FUTEX
+// futex_mutex and futex_condition_variable change the layout of the thread data, so they are provided only on
+// request, and the library has to be built with the same setting.
+#if defined BOOST_THREAD_PROVIDES_FUTEX && defined __linux__
+#define BOOST_THREAD_HAS_FUTEX
+#endif
+
 // CORRELATIONS
 
 // EXPLICIT_LOCK_CONVERSION.
@@ -0,0 +1,100 @@
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_THREAD_DETAIL_NULLARY_FUNCTION_HPP
+#define BOOST_THREAD_DETAIL_NULLARY_FUNCTION_HPP
+
+#include <boost/thread/detail/config.hpp>
+#include <boost/thread/detail/move.hpp>
+#include <boost/smart_ptr/shared_ptr.hpp>
+#include <boost/type_traits/decay.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/utility/enable_if.hpp>
+
+#include <boost/config/abi_prefix.hpp>
+
+namespace boost
+{
+  namespace detail
+  {
+    template <typename F>
+    class nullary_function;
+
+    /**
+     * Type erased void() function object, used to store the closures of an executor.
+     *
+     * Other than boost::function, it accepts move-only function objects when rvalue references are supported. Copies
+     * share the stored function object.
+     */
+    template <>
+    class nullary_function<void()>
+    {
+      struct impl_base
+      {
+        virtual void call()=0;
+        virtual ~impl_base()
+        {
+        }
+      };
+
+      template <typename F>
+      struct impl_type: impl_base
+      {
+        F f;
+#if ! defined BOOST_NO_CXX11_RVALUE_REFERENCES
+        template <typename G>
+        explicit impl_type(G&& g) :
+          f(boost::forward<G>(g))
+        {
+        }
+#else
+        explicit impl_type(F const& g) :
+          f(g)
+        {
+        }
+#endif
+        void call()
+        {
+          f();
+        }
+      };
+
+      shared_ptr<impl_base> impl;
+
+    public:
+      nullary_function()
+      {
+      }
+
+#if ! defined BOOST_NO_CXX11_RVALUE_REFERENCES
+      template <typename F>
+      nullary_function(F&& f,
+          typename disable_if<is_same<typename decay<F>::type, nullary_function>, int>::type = 0) :
+        impl(new impl_type<typename decay<F>::type>(boost::forward<F>(f)))
+      {
+      }
+#else
+      template <typename F>
+      nullary_function(F const& f) :
+        impl(new impl_type<typename decay<F>::type>(f))
+      {
+      }
+#endif
+
+      void operator()() const
+      {
+        impl->call();
+      }
+
+      bool empty() const BOOST_NOEXCEPT
+      {
+        return !impl;
+      }
+    };
+  }
+}
+
+#include <boost/config/abi_suffix.hpp>
+
+#endif
@@ -0,0 +1,302 @@
+#ifndef BOOST_THREAD_DISTRIBUTED_SHARED_MUTEX_HPP
+#define BOOST_THREAD_DISTRIBUTED_SHARED_MUTEX_HPP
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/thread/detail/config.hpp>
+#include <boost/thread/detail/delete.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/lock_guard.hpp>
+#include <boost/thread/lock_types.hpp>
+#include <boost/thread/thread_only.hpp>
+#if defined(BOOST_THREAD_PLATFORM_WIN32)
+#include <boost/thread/win32/thread_primitives.hpp>
+#else
+#include <pthread.h>
+#endif
+#ifdef BOOST_THREAD_USES_CHRONO
+#include <boost/chrono/system_clocks.hpp>
+#endif
+#include <boost/atomic.hpp>
+#include <boost/functional/hash.hpp>
+#include <boost/scoped_array.hpp>
+#include <cstddef>
+#include <new>
+
+#include <boost/config/abi_prefix.hpp>
+
+namespace boost
+{
+  /**
+   * A SharedLockable mutex for read-mostly workloads.
+   *
+   * Every thread is mapped to one of several reader counters, that are placed on separate cache lines. lock_shared()
+   * and unlock_shared() only modify the counter of the calling thread and read a writer flag, that only changes when a
+   * writer comes, so that readers on different cores don't contend on a shared cache line. A writer sets the flag,
+   * which turns new readers away, and waits until all the counters have dropped to zero, so that the writers pay for
+   * the aggregation. Writers take precedence over new readers.
+   *
+   * Precondition: unlock_shared() is called by the thread, that called lock_shared().
+   */
+  class distributed_shared_mutex
+  {
+  private:
+    enum { cache_line_size = 64 };
+
+    struct slot
+    {
+      atomic<long> readers;
+      // a slot fills a cache line and the slots start on a line boundary, so that the counters of two slots never
+      // share a line
+      char padding[cache_line_size - sizeof(atomic<long>)];
+
+      slot() :
+        readers(0)
+      {
+      }
+    };
+
+    // over-allocated by up to a cache line, so that slots_ can be aligned; the slots are trivially destructible
+    scoped_array<char> storage_;
+    slot* slots_;
+    std::size_t mask_;
+
+    // writers are serialized by mtx_ and the writer_ flag, that is only modified while mtx_ is locked
+    mutex mtx_;
+    // notified when writer_ is reset
+    condition_variable gate_;
+    // notified when a reader leaves while a writer is waiting
+    condition_variable drained_;
+    atomic<bool> writer_;
+
+    static std::size_t default_slot_count()
+    {
+      std::size_t const concurrency = thread::hardware_concurrency();
+      return concurrency ? 2 * concurrency : 8;
+    }
+
+    slot& current_slot()
+    {
+#if defined(BOOST_THREAD_PLATFORM_WIN32)
+      std::size_t h = boost::hash_value(detail::win32::GetCurrentThreadId());
+#else
+      std::size_t h = boost::hash<pthread_t>()(pthread_self());
+#endif
+      // the thread ids are usually aligned addresses
+      h ^= h >> 16;
+      h *= 0x45d9f3bu;
+      h ^= h >> 16;
+      return slots_[h & mask_];
+    }
+
+    bool readers_drained() const
+    {
+      for (std::size_t i = 0; i <= mask_; ++i)
+      {
+        if (slots_[i].readers.load() != 0)
+        {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    void leave(slot& s)
+    {
+      // pairs with the store of writer_ in lock(): either the writer sees the decrement, or this thread sees the
+      // writer and notifies it after the writer has started to wait
+      s.readers.fetch_sub(1);
+      if (writer_.load())
+      {
+        lock_guard<mutex> lk(mtx_);
+        drained_.notify_all();
+      }
+    }
+
+  public:
+    BOOST_THREAD_NO_COPYABLE(distributed_shared_mutex)
+
+    /**
+     * Effects: creates a mutex with at least slot_count reader counters, twice the number of hardware threads by
+     * default.
+     */
+    explicit distributed_shared_mutex(std::size_t slot_count = default_slot_count()) :
+      slots_(0), mask_(0), writer_(false)
+    {
+      std::size_t n = 1;
+      while (n < slot_count)
+        n *= 2;
+      storage_.reset(new char[n * sizeof(slot) + cache_line_size - 1]);
+      std::size_t const misalignment = reinterpret_cast<std::size_t>(storage_.get()) % cache_line_size;
+      char* const first = storage_.get() + (misalignment ? cache_line_size - misalignment : 0);
+      for (std::size_t i = 0; i < n; ++i)
+        new (first + i * sizeof(slot)) slot();
+      slots_ = reinterpret_cast<slot*>(first);
+      mask_ = n - 1;
+    }
+
+    // Shared ownership
+
+    void lock_shared()
+    {
+      slot& s = current_slot();
+      for (;;)
+      {
+        s.readers.fetch_add(1);
+        if (!writer_.load())
+        {
+          return;
+        }
+        leave(s);
+
+        unique_lock<mutex> lk(mtx_);
+        while (writer_.load(memory_order_relaxed))
+          gate_.wait(lk);
+      }
+    }
+
+    bool try_lock_shared()
+    {
+      slot& s = current_slot();
+      s.readers.fetch_add(1);
+      if (!writer_.load())
+      {
+        return true;
+      }
+      leave(s);
+      return false;
+    }
+
+#ifdef BOOST_THREAD_USES_CHRONO
+    template <class Rep, class Period>
+    bool try_lock_shared_for(const chrono::duration<Rep, Period>& rel_time)
+    {
+      return try_lock_shared_until(chrono::steady_clock::now() + rel_time);
+    }
+
+    template <class Clock, class Duration>
+    bool try_lock_shared_until(const chrono::time_point<Clock, Duration>& abs_time)
+    {
+      slot& s = current_slot();
+      for (;;)
+      {
+        s.readers.fetch_add(1);
+        if (!writer_.load())
+        {
+          return true;
+        }
+        leave(s);
+
+        unique_lock<mutex> lk(mtx_);
+        while (writer_.load(memory_order_relaxed))
+        {
+          if (gate_.wait_until(lk, abs_time) == cv_status::timeout && writer_.load(memory_order_relaxed))
+          {
+            return false;
+          }
+        }
+      }
+    }
+#endif
+
+    void unlock_shared()
+    {
+      leave(current_slot());
+    }
+
+    // Exclusive ownership
+
+    void lock()
+    {
+      unique_lock<mutex> lk(mtx_);
+      while (writer_.load(memory_order_relaxed))
+        gate_.wait(lk);
+      writer_.store(true);
+      try
+      {
+        while (!readers_drained())
+          drained_.wait(lk);
+      }
+      catch (...)
+      {
+        // interrupted while the readers drain
+        writer_.store(false);
+        gate_.notify_all();
+        throw;
+      }
+    }
+
+    bool try_lock()
+    {
+      unique_lock<mutex> lk(mtx_, try_to_lock);
+      if (!lk.owns_lock() || writer_.load(memory_order_relaxed))
+      {
+        return false;
+      }
+      writer_.store(true);
+      if (!readers_drained())
+      {
+        writer_.store(false);
+        gate_.notify_all();
+        return false;
+      }
+      return true;
+    }
+
+#ifdef BOOST_THREAD_USES_CHRONO
+    template <class Rep, class Period>
+    bool try_lock_for(const chrono::duration<Rep, Period>& rel_time)
+    {
+      return try_lock_until(chrono::steady_clock::now() + rel_time);
+    }
+
+    template <class Clock, class Duration>
+    bool try_lock_until(const chrono::time_point<Clock, Duration>& abs_time)
+    {
+      unique_lock<mutex> lk(mtx_);
+      while (writer_.load(memory_order_relaxed))
+      {
+        if (gate_.wait_until(lk, abs_time) == cv_status::timeout && writer_.load(memory_order_relaxed))
+        {
+          return false;
+        }
+      }
+      writer_.store(true);
+      try
+      {
+        while (!readers_drained())
+        {
+          if (drained_.wait_until(lk, abs_time) == cv_status::timeout && !readers_drained())
+          {
+            writer_.store(false);
+            gate_.notify_all();
+            return false;
+          }
+        }
+      }
+      catch (...)
+      {
+        writer_.store(false);
+        gate_.notify_all();
+        throw;
+      }
+      return true;
+    }
+#endif
+
+    void unlock()
+    {
+      {
+        lock_guard<mutex> lk(mtx_);
+        writer_.store(false);
+      }
+      gate_.notify_all();
+    }
+  };
+}
+
+#include <boost/config/abi_suffix.hpp>
+
+#endif
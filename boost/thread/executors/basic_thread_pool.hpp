@@ -0,0 +1,305 @@
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_THREAD_EXECUTORS_BASIC_THREAD_POOL_HPP
+#define BOOST_THREAD_EXECUTORS_BASIC_THREAD_POOL_HPP
+
+#include <boost/thread/detail/config.hpp>
+#include <boost/thread/detail/delete.hpp>
+#include <boost/thread/detail/move.hpp>
+#include <boost/thread/detail/nullary_function.hpp>
+#include <boost/thread/executors/is_executor.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/future.hpp>
+#include <boost/thread/lock_guard.hpp>
+#include <boost/thread/lock_types.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/sync_bounded_queue.hpp>
+#include <boost/thread/thread_only.hpp>
+#include <boost/thread/detail/thread_group.hpp>
+#include <boost/thread/tss.hpp>
+#include <boost/throw_exception.hpp>
+#include <boost/bind.hpp>
+#include <boost/container/deque.hpp>
+#include <boost/smart_ptr/shared_ptr.hpp>
+#include <boost/type_traits/decay.hpp>
+#include <boost/utility/result_of.hpp>
+#include <vector>
+
+#include <boost/config/abi_prefix.hpp>
+
+namespace boost
+{
+  namespace executors
+  {
+    /**
+     * A fixed number of worker threads, that execute the closures submitted to the pool.
+     *
+     * Every worker owns a deque: closures submitted by a worker are pushed to the back of its own deque and popped
+     * from there in LIFO order, while idle workers steal from the front of the other deques. Closures submitted by
+     * other threads go to a shared queue. Closures that fan out further closures thus only hold the pool lock to
+     * check for sleeping workers, and do not contend on a single queue.
+     */
+    class basic_thread_pool
+    {
+    public:
+      /// the type-erased closure, that is stored in the queues
+      typedef boost::detail::nullary_function<void()> work;
+
+    private:
+      struct worker_queue
+      {
+        mutex mtx;
+        container::deque<work> tasks;
+      };
+
+      mutable mutex mtx_;
+      condition_variable work_available_;
+      container::deque<work> submitted_;
+      std::vector<shared_ptr<worker_queue> > queues_;
+      thread_group threads_;
+      thread_specific_ptr<worker_queue> current_;
+      std::size_t idle_;
+      bool closed_;
+
+      static void no_cleanup(worker_queue*)
+      {
+      }
+
+    public:
+      BOOST_THREAD_NO_COPYABLE(basic_thread_pool)
+
+      /**
+       * Effects: creates a pool with thread_count worker threads, one per hardware thread by default.
+       *
+       * Throws: whatever thread creation throws, after the threads that have already been created are joined.
+       */
+      explicit basic_thread_pool(unsigned thread_count = thread::hardware_concurrency()) :
+        current_(&no_cleanup),
+        idle_(0),
+        closed_(false)
+      {
+        if (thread_count == 0)
+          thread_count = 1;
+
+        for (unsigned i = 0; i < thread_count; ++i)
+          queues_.push_back(shared_ptr<worker_queue>(new worker_queue()));
+
+        try
+        {
+          for (unsigned i = 0; i < thread_count; ++i)
+            threads_.create_thread(boost::bind(&basic_thread_pool::worker_thread, this, queues_[i].get()));
+        }
+        catch (...)
+        {
+          close();
+          threads_.join_all();
+          throw;
+        }
+      }
+
+      /**
+       * Effects: closes the pool and joins the worker threads, after they have executed all pending closures.
+       */
+      ~basic_thread_pool()
+      {
+        close();
+        join();
+      }
+
+      /**
+       * Effects: no further closures are accepted from threads outside of the pool. The workers exit, once all
+       * pending closures, including the ones they submit while draining, have been executed.
+       */
+      void close()
+      {
+        lock_guard<mutex> lk(mtx_);
+        closed_ = true;
+        work_available_.notify_all();
+      }
+
+      bool closed() const
+      {
+        lock_guard<mutex> lk(mtx_);
+        return closed_;
+      }
+
+      /**
+       * Effects: waits until the worker threads have exited.
+       *
+       * Precondition: the pool is closed and join() is not called from a worker thread.
+       */
+      void join()
+      {
+        threads_.join_all();
+      }
+
+      /// the number of worker threads
+      std::size_t size() const
+      {
+        return queues_.size();
+      }
+
+      /**
+       * Effects: schedules closure for execution by one of the worker threads.
+       *
+       * Throws: sync_queue_is_closed, if the pool is closed and the calling thread is no worker of the pool.
+       *
+       * Note: closure must not throw.
+       */
+      template <typename Closure>
+      void execute(BOOST_THREAD_FWD_REF(Closure) closure)
+      {
+        work w(boost::forward<Closure>(closure));
+
+        if (worker_queue* own = current_.get())
+        {
+          {
+            lock_guard<mutex> lk(own->mtx);
+            own->tasks.push_back(boost::move(w));
+          }
+          lock_guard<mutex> lk(mtx_);
+          if (idle_)
+            work_available_.notify_one();
+        }
+        else
+        {
+          lock_guard<mutex> lk(mtx_);
+          if (closed_)
+            BOOST_THROW_EXCEPTION( sync_queue_is_closed() );
+          submitted_.push_back(boost::move(w));
+          if (idle_)
+            work_available_.notify_one();
+        }
+      }
+
+      /**
+       * Effects: schedules f for execution by one of the worker threads.
+       *
+       * Returns: a future, that becomes ready with the result of f or with the exception it throws.
+       *
+       * Throws: sync_queue_is_closed, if the pool is closed and the calling thread is no worker of the pool.
+       */
+      template <typename F>
+      BOOST_THREAD_FUTURE<typename boost::result_of<typename decay<F>::type()>::type>
+      submit(BOOST_THREAD_FWD_REF(F) f)
+      {
+        return boost::async(*this, boost::forward<F>(f));
+      }
+
+      /**
+       * Effects: executes one pending closure on the calling thread, if there is any. Can be called by a closure,
+       * that waits for the closures it has submitted, to avoid that all workers block.
+       *
+       * Returns: whether a closure has been executed.
+       */
+      bool try_executing_one()
+      {
+        work task;
+        worker_queue* own = current_.get();
+        if ((own && try_pop_own(*own, task)) || try_pop_submitted(task) || try_steal(own, task))
+        {
+          task();
+          return true;
+        }
+        return false;
+      }
+
+    private:
+      void worker_thread(worker_queue* own)
+      {
+        current_.reset(own);
+        work task;
+        while (pop_task(own, task))
+        {
+          task();
+          task = work();
+        }
+        current_.release();
+      }
+
+      bool try_pop_own(worker_queue& q, work& task)
+      {
+        lock_guard<mutex> lk(q.mtx);
+        if (q.tasks.empty())
+          return false;
+        task = boost::move(q.tasks.back());
+        q.tasks.pop_back();
+        return true;
+      }
+
+      bool try_pop_submitted(work& task)
+      {
+        lock_guard<mutex> lk(mtx_);
+        return pop_submitted(task);
+      }
+
+      // precondition: mtx_ is locked
+      bool pop_submitted(work& task)
+      {
+        if (submitted_.empty())
+          return false;
+        task = boost::move(submitted_.front());
+        submitted_.pop_front();
+        return true;
+      }
+
+      // steals from the front of the other deques, starting after the thief, or from all deques if thief is null
+      bool try_steal(worker_queue* thief, work& task)
+      {
+        const std::size_t n = queues_.size();
+        std::size_t start = 0;
+        for (std::size_t i = 0; i < n; ++i)
+          if (queues_[i].get() == thief)
+            start = i + 1;
+
+        for (std::size_t i = 0; i < n; ++i)
+        {
+          worker_queue& victim = *queues_[(start + i) % n];
+          if (&victim == thief)
+            continue;
+          lock_guard<mutex> lk(victim.mtx);
+          if (!victim.tasks.empty())
+          {
+            task = boost::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            return true;
+          }
+        }
+        return false;
+      }
+
+      bool pop_task(worker_queue* own, work& task)
+      {
+        if (try_pop_own(*own, task) || try_pop_submitted(task) || try_steal(own, task))
+          return true;
+
+        // Submitters push before they lock mtx_ to check for idle workers, so a closure is either found by the scan
+        // below or the submitter notifies after this worker has started to wait.
+        unique_lock<mutex> lk(mtx_);
+        for (;;)
+        {
+          if (pop_submitted(task) || try_steal(0, task))
+            return true;
+          if (closed_)
+            return false;
+
+          ++idle_;
+          work_available_.wait(lk);
+          --idle_;
+        }
+      }
+    };
+
+    template <>
+    struct is_executor<basic_thread_pool>: true_type
+    {
+    };
+  }
+  using executors::basic_thread_pool;
+}
+
+#include <boost/config/abi_suffix.hpp>
+
+#endif
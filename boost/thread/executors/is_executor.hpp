@@ -0,0 +1,32 @@
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_THREAD_EXECUTORS_IS_EXECUTOR_HPP
+#define BOOST_THREAD_EXECUTORS_IS_EXECUTOR_HPP
+
+#include <boost/thread/detail/config.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+
+namespace boost
+{
+  namespace executors
+  {
+    /**
+     * Enables the executor overloads of boost::async and of the future and shared_future then() functions for Ex.
+     *
+     * An executor provides
+     * - void execute(Closure&& closure): schedules closure for execution, closure must not throw;
+     * - void close() and bool closed() const;
+     * - bool try_executing_one(): executes one pending closure on the calling thread, if there is any.
+     *
+     * User defined executors have to specialize this trait.
+     */
+    template <class Ex>
+    struct is_executor: false_type
+    {
+    };
+  }
+}
+
+#endif
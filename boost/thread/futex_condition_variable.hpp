@@ -0,0 +1,219 @@
+#ifndef BOOST_THREAD_FUTEX_CONDITION_VARIABLE_HPP
+#define BOOST_THREAD_FUTEX_CONDITION_VARIABLE_HPP
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/thread/detail/config.hpp>
+#include <boost/thread/pthread/futex.hpp>
+
+#if defined BOOST_THREAD_HAS_FUTEX
+
+#include <boost/thread/detail/delete.hpp>
+#include <boost/thread/detail/move.hpp>
+#include <boost/thread/cv_status.hpp>
+#include <boost/thread/futex_mutex.hpp>
+#include <boost/thread/lock_guard.hpp>
+#include <boost/thread/mutex.hpp>
+#if defined BOOST_THREAD_PROVIDES_INTERRUPTIONS
+#include <boost/thread/pthread/thread_data.hpp>
+#endif
+#ifdef BOOST_THREAD_USES_CHRONO
+#include <boost/thread/pthread/timespec.hpp>
+#include <boost/chrono/system_clocks.hpp>
+#include <boost/chrono/ceil.hpp>
+#endif
+#include <boost/atomic.hpp>
+#include <climits>
+
+#include <boost/config/abi_prefix.hpp>
+
+namespace boost
+{
+#if defined BOOST_THREAD_PROVIDES_INTERRUPTIONS
+  namespace this_thread
+  {
+    void BOOST_THREAD_DECL interruption_point();
+  }
+
+  namespace detail
+  {
+    /**
+     * Publishes the futex word a thread is about to wait on, so that thread::interrupt() can wake it up.
+     *
+     * Other than interruption_checker, it doesn't lock data_mutex on the fast path: the waiter stores the word before
+     * it reads interrupt_requested, and interrupt() sets interrupt_requested before it takes the word, so at least one
+     * of them sees the other. Only when interrupt() has taken the word, the waiter locks data_mutex to wait until
+     * interrupt() no longer accesses the word.
+     */
+    class futex_interruption_checker
+    {
+      thread_data_base* const thread_info;
+      bool registered;
+
+      void operator=(futex_interruption_checker&);
+    public:
+      explicit futex_interruption_checker(futex_word& word) :
+        thread_info(detail::get_current_thread_data()),
+        registered(thread_info && thread_info->interrupt_enabled)
+      {
+        if (registered)
+        {
+          thread_info->current_futex.store(&word);
+          if (thread_info->interrupt_requested.load())
+          {
+            unregister();
+            this_thread::interruption_point();
+          }
+        }
+      }
+      ~futex_interruption_checker()
+      {
+        unregister();
+      }
+
+      void unregister()
+      {
+        if (registered)
+        {
+          registered = false;
+          if (!thread_info->current_futex.exchange(0))
+          {
+            lock_guard<mutex> guard(thread_info->data_mutex);
+          }
+        }
+      }
+
+      void interruption_point()
+      {
+        if (thread_info && thread_info->interrupt_enabled && thread_info->interrupt_requested.load())
+        {
+          this_thread::interruption_point();
+        }
+      }
+    };
+  }
+#endif
+
+  /**
+   * A condition variable, that is implemented directly on a Linux futex and can be used with any lock, e.g.
+   * unique_lock<futex_mutex>.
+   *
+   * The futex word is a sequence number, that notify_one() and notify_all() increment. They only enter the kernel,
+   * if a thread is waiting, and never lock a mutex. The waits are interruption points, which don't lock a mutex
+   * either, unless the thread is actually interrupted.
+   */
+  class futex_condition_variable
+  {
+  private:
+    detail::futex_word seq_;
+    atomic<int> waiters_;
+
+  public:
+    BOOST_THREAD_NO_COPYABLE(futex_condition_variable)
+
+    futex_condition_variable() :
+      seq_(0), waiters_(0)
+    {
+    }
+
+    template <typename Lock>
+    void wait(Lock& lk)
+    {
+      do_wait(lk, 0);
+    }
+
+    template <typename Lock, typename Predicate>
+    void wait(Lock& lk, Predicate pred)
+    {
+      while (!pred())
+        wait(lk);
+    }
+
+#ifdef BOOST_THREAD_USES_CHRONO
+    template <typename Lock, class Clock, class Duration>
+    cv_status wait_until(Lock& lk, const chrono::time_point<Clock, Duration>& t)
+    {
+      using namespace chrono;
+      nanoseconds const d = ceil<nanoseconds>(t - Clock::now());
+      if (d > nanoseconds::zero())
+      {
+        struct timespec const ts = boost::detail::to_timespec(d);
+        do_wait(lk, &ts);
+      }
+      return Clock::now() < t ? cv_status::no_timeout : cv_status::timeout;
+    }
+
+    template <typename Lock, class Clock, class Duration, class Predicate>
+    bool wait_until(Lock& lk, const chrono::time_point<Clock, Duration>& t, Predicate pred)
+    {
+      while (!pred())
+      {
+        if (wait_until(lk, t) == cv_status::timeout)
+          return pred();
+      }
+      return true;
+    }
+
+    template <typename Lock, class Rep, class Period>
+    cv_status wait_for(Lock& lk, const chrono::duration<Rep, Period>& d)
+    {
+      return wait_until(lk, chrono::steady_clock::now() + chrono::ceil<chrono::nanoseconds>(d));
+    }
+
+    template <typename Lock, class Rep, class Period, class Predicate>
+    bool wait_for(Lock& lk, const chrono::duration<Rep, Period>& d, Predicate pred)
+    {
+      return wait_until(lk, chrono::steady_clock::now() + chrono::ceil<chrono::nanoseconds>(d), boost::move(pred));
+    }
+#endif
+
+    void notify_one() BOOST_NOEXCEPT
+    {
+      ++seq_;
+      if (waiters_.load() > 0)
+      {
+        detail::futex_wake(seq_, 1);
+      }
+    }
+
+    void notify_all() BOOST_NOEXCEPT
+    {
+      ++seq_;
+      if (waiters_.load() > 0)
+      {
+        detail::futex_wake(seq_, INT_MAX);
+      }
+    }
+
+  private:
+    // timeout is relative, the lock is locked again when it returns or throws
+    template <typename Lock>
+    void do_wait(Lock& lk, struct timespec const* timeout)
+    {
+      // read while the lock is held: a notification, that follows the unlock, changes the word and
+      // futex_wait returns immediately
+      int const seq = seq_.load();
+#if defined BOOST_THREAD_PROVIDES_INTERRUPTIONS
+      detail::futex_interruption_checker check_for_interruption(seq_);
+#endif
+      // pairs with the load in notify_one and notify_all, that follows the increment of the word
+      ++waiters_;
+      lk.unlock();
+      detail::futex_wait(seq_, seq, timeout);
+      --waiters_;
+#if defined BOOST_THREAD_PROVIDES_INTERRUPTIONS
+      check_for_interruption.unregister();
+#endif
+      lk.lock();
+#if defined BOOST_THREAD_PROVIDES_INTERRUPTIONS
+      check_for_interruption.interruption_point();
+#endif
+    }
+  };
+}
+
+#include <boost/config/abi_suffix.hpp>
+
+#endif
+#endif
@@ -0,0 +1,111 @@
+#ifndef BOOST_THREAD_FUTEX_MUTEX_HPP
+#define BOOST_THREAD_FUTEX_MUTEX_HPP
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/thread/detail/config.hpp>
+#include <boost/thread/pthread/futex.hpp>
+
+#if defined BOOST_THREAD_HAS_FUTEX
+
+#include <boost/thread/detail/delete.hpp>
+#include <boost/thread/lock_types.hpp>
+#include <boost/atomic.hpp>
+
+#ifndef BOOST_THREAD_FUTEX_MUTEX_MAX_SPIN
+#define BOOST_THREAD_FUTEX_MUTEX_MAX_SPIN 100
+#endif
+
+#include <boost/config/abi_prefix.hpp>
+
+namespace boost
+{
+  /**
+   * A Lockable mutex, that is implemented directly on a Linux futex.
+   *
+   * The futex word is 0 when unlocked, 1 when locked and 2 when locked and there may be waiters, so that neither lock
+   * nor unlock enter the kernel when there is no contention. A contended lock spins for a bounded number of
+   * iterations before it blocks. The bound adapts to the number of iterations, that the recent acquisitions needed,
+   * and never exceeds BOOST_THREAD_FUTEX_MUTEX_MAX_SPIN.
+   */
+  class futex_mutex
+  {
+  private:
+    detail::futex_word state_;
+    atomic<int> spin_;
+
+  public:
+    BOOST_THREAD_NO_COPYABLE(futex_mutex)
+
+    futex_mutex() :
+      state_(0), spin_(0)
+    {
+    }
+
+    void lock()
+    {
+      if (try_lock())
+      {
+        return;
+      }
+
+      int const spin = spin_.load(memory_order_relaxed);
+      int const max_spin = (2 * spin + 10 < BOOST_THREAD_FUTEX_MUTEX_MAX_SPIN) ? 2 * spin + 10
+          : BOOST_THREAD_FUTEX_MUTEX_MAX_SPIN;
+      int count = 0;
+      bool acquired = false;
+      while (count < max_spin)
+      {
+        ++count;
+        detail::cpu_relax();
+        if (state_.load(memory_order_relaxed) == 0 && try_lock())
+        {
+          acquired = true;
+          break;
+        }
+      }
+      spin_.store(spin + (count - spin) / 8, memory_order_relaxed);
+
+      if (!acquired)
+      {
+        lock_contended();
+      }
+    }
+
+    bool try_lock()
+    {
+      int expected = 0;
+      return state_.compare_exchange_strong(expected, 1, memory_order_acquire, memory_order_relaxed);
+    }
+
+    void unlock()
+    {
+      if (state_.fetch_sub(1, memory_order_release) != 1)
+      {
+        state_.store(0, memory_order_release);
+        detail::futex_wake(state_, 1);
+      }
+    }
+
+    typedef unique_lock<futex_mutex> scoped_lock;
+    typedef detail::try_lock_wrapper<futex_mutex> scoped_try_lock;
+
+  private:
+    // marks the mutex as contended, so that the owner wakes a waiter when it unlocks
+    void lock_contended()
+    {
+      int c = state_.exchange(2, memory_order_acquire);
+      while (c != 0)
+      {
+        detail::futex_wait(state_, 2);
+        c = state_.exchange(2, memory_order_acquire);
+      }
+    }
+  };
+}
+
+#include <boost/config/abi_suffix.hpp>
+
+#endif
+#endif
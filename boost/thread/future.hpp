@@ -58,6 +58,8 @@
 
 #include <boost/utility/result_of.hpp>
 #include <boost/thread/thread_only.hpp>
+#include <boost/thread/executors/is_executor.hpp>
+#include <boost/type_traits/decay.hpp>
 
 #if defined BOOST_THREAD_PROVIDES_FUTURE
 #define BOOST_THREAD_FUTURE future
@@ -1404,6 +1406,19 @@ namespace boost
         template <class F, class Rp, class Fp>
         BOOST_THREAD_FUTURE<Rp>
         make_future_deferred_continuation_shared_state(boost::unique_lock<boost::mutex> &lock, F& f, BOOST_THREAD_FWD_REF(Fp) c);
+
+        template<typename Ex, typename F, typename Rp, typename Fp>
+        struct future_executor_continuation_shared_state;
+
+        template <class F, class Fut>
+        struct executor_continuation_result
+        {
+          typedef BOOST_THREAD_FUTURE<typename boost::result_of<F(Fut&)>::type> type;
+        };
+
+        template <class Ex, class F, class Rp, class Fp>
+        BOOST_THREAD_FUTURE<Rp>
+        make_future_executor_continuation_shared_state(boost::unique_lock<boost::mutex> &lock, Ex& ex, F& f, BOOST_THREAD_FWD_REF(Fp) c);
 #endif
 #if defined BOOST_THREAD_PROVIDES_FUTURE_UNWRAP
         template<typename F, typename Rp>
@@ -1436,6 +1451,12 @@ namespace boost
         template <class F, class Rp, class Fp>
         friend BOOST_THREAD_FUTURE<Rp>
         detail::make_future_deferred_continuation_shared_state(boost::unique_lock<boost::mutex> &lock, F& f, BOOST_THREAD_FWD_REF(Fp) c);
+        template <typename, typename, typename, typename>
+        friend struct detail::future_executor_continuation_shared_state;
+
+        template <class Ex, class F, class Rp, class Fp>
+        friend BOOST_THREAD_FUTURE<Rp>
+        detail::make_future_executor_continuation_shared_state(boost::unique_lock<boost::mutex> &lock, Ex& ex, F& f, BOOST_THREAD_FWD_REF(Fp) c);
 #endif
 #if defined BOOST_THREAD_PROVIDES_FUTURE_UNWRAP
         template<typename F, typename Rp>
@@ -1583,6 +1604,10 @@ namespace boost
         template<typename F>
         inline BOOST_THREAD_FUTURE<typename boost::result_of<F(BOOST_THREAD_FUTURE&)>::type>
         then(launch policy, BOOST_THREAD_FWD_REF(F) func);
+        template<typename Ex, typename F>
+        inline typename boost::lazy_enable_if_c<executors::is_executor<Ex>::value,
+          detail::executor_continuation_result<F, BOOST_THREAD_FUTURE> >::type
+        then(Ex& ex, BOOST_THREAD_FWD_REF(F) func);
 
         template <typename R2>
         inline typename disable_if< is_void<R2>, BOOST_THREAD_FUTURE<R> >::type
@@ -1631,6 +1656,12 @@ namespace boost
             template <class F, class Rp, class Fp>
             friend BOOST_THREAD_FUTURE<Rp>
             detail::make_future_deferred_continuation_shared_state(boost::unique_lock<boost::mutex> &lock, F& f, BOOST_THREAD_FWD_REF(Fp) c);
+            template <typename, typename, typename, typename>
+            friend struct detail::future_executor_continuation_shared_state;
+
+            template <class Ex, class F, class Rp, class Fp>
+            friend BOOST_THREAD_FUTURE<Rp>
+            detail::make_future_executor_continuation_shared_state(boost::unique_lock<boost::mutex> &lock, Ex& ex, F& f, BOOST_THREAD_FWD_REF(Fp) c);
     #endif
 #if defined BOOST_THREAD_PROVIDES_FUTURE_UNWRAP
             template<typename F, typename Rp>
@@ -1797,6 +1828,12 @@ namespace boost
         template <class F, class Rp, class Fp>
         friend BOOST_THREAD_FUTURE<Rp>
         detail::make_future_deferred_continuation_shared_state(boost::unique_lock<boost::mutex> &lock, F& f, BOOST_THREAD_FWD_REF(Fp) c);
+        template <typename, typename, typename, typename>
+        friend struct detail::future_executor_continuation_shared_state;
+
+        template <class Ex, class F, class Rp, class Fp>
+        friend BOOST_THREAD_FUTURE<Rp>
+        detail::make_future_executor_continuation_shared_state(boost::unique_lock<boost::mutex> &lock, Ex& ex, F& f, BOOST_THREAD_FWD_REF(Fp) c);
 #endif
 #if defined BOOST_THREAD_PROVIDES_SIGNATURE_PACKAGED_TASK
         template <class> friend class packaged_task;// todo check if this works in windows
@@ -1898,6 +1935,10 @@ namespace boost
         template<typename F>
         inline BOOST_THREAD_FUTURE<typename boost::result_of<F(shared_future&)>::type>
         then(launch policy, BOOST_THREAD_FWD_REF(F) func);
+        template<typename Ex, typename F>
+        inline typename boost::lazy_enable_if_c<executors::is_executor<Ex>::value,
+          detail::executor_continuation_result<F, shared_future> >::type
+        then(Ex& ex, BOOST_THREAD_FWD_REF(F) func);
 #endif
 //#if defined BOOST_THREAD_PROVIDES_FUTURE_UNWRAP
 //        inline
@@ -3569,6 +3610,98 @@ namespace boost
     }
 #endif
 
+  ////////////////////////////////
+  // template <class Ex, class F>
+  // future<typename result_of<typename decay<F>::type()>::type> async(Ex& ex, F&& f);
+  ////////////////////////////////
+  namespace detail
+  {
+    // the closure, that async(ex, f) passes to the executor
+    template <typename Rp, typename Fp>
+    struct executor_task
+    {
+      shared_ptr<promise<Rp> > p_;
+      Fp f_;
+
+#if ! defined BOOST_NO_CXX11_RVALUE_REFERENCES
+      template <typename G>
+      executor_task(shared_ptr<promise<Rp> > const& p, G&& g) :
+        p_(p), f_(boost::forward<G>(g))
+      {
+      }
+#else
+      executor_task(shared_ptr<promise<Rp> > const& p, Fp const& g) :
+        p_(p), f_(g)
+      {
+      }
+#endif
+
+      void operator()()
+      {
+        try
+        {
+          p_->set_value(f_());
+        }
+        catch(...)
+        {
+          p_->set_exception(boost::current_exception());
+        }
+      }
+    };
+
+    template <typename Fp>
+    struct executor_task<void, Fp>
+    {
+      shared_ptr<promise<void> > p_;
+      Fp f_;
+
+#if ! defined BOOST_NO_CXX11_RVALUE_REFERENCES
+      template <typename G>
+      executor_task(shared_ptr<promise<void> > const& p, G&& g) :
+        p_(p), f_(boost::forward<G>(g))
+      {
+      }
+#else
+      executor_task(shared_ptr<promise<void> > const& p, Fp const& g) :
+        p_(p), f_(g)
+      {
+      }
+#endif
+
+      void operator()()
+      {
+        try
+        {
+          f_();
+          p_->set_value();
+        }
+        catch(...)
+        {
+          p_->set_exception(boost::current_exception());
+        }
+      }
+    };
+
+    template <typename F>
+    struct executor_async_result
+    {
+      typedef BOOST_THREAD_FUTURE<typename boost::result_of<typename decay<F>::type()>::type> type;
+    };
+  }
+
+  template <class Ex, class F>
+  typename boost::lazy_enable_if_c<executors::is_executor<Ex>::value, detail::executor_async_result<F> >::type
+  async(Ex& ex, BOOST_THREAD_FWD_REF(F) f)
+  {
+    typedef typename decay<F>::type Fp;
+    typedef typename boost::result_of<Fp()>::type Rp;
+
+    shared_ptr<promise<Rp> > p(new promise<Rp>());
+    BOOST_THREAD_FUTURE<Rp> result(p->get_future());
+    ex.execute(detail::executor_task<Rp, Fp>(p, boost::forward<F>(f)));
+    return boost::move(result);
+  }
+
 
   ////////////////////////////////
   // make_future deprecated
@@ -3891,6 +4024,160 @@ namespace boost
       return BOOST_THREAD_FUTURE<Rp>(h);
     }
 
+    /////////////////////////
+    /// future_executor_continuation_shared_state
+    /////////////////////////
+
+    template<typename Ex, typename F, typename Rp, typename Fp>
+    struct future_executor_continuation_shared_state: shared_state<Rp>
+    {
+      Ex* ex;
+      F parent;
+      Fp continuation;
+
+      // keeps the shared state alive, until the executor has run the continuation
+      struct run_it
+      {
+        shared_ptr<future_executor_continuation_shared_state> that_;
+
+        explicit run_it(shared_ptr<future_executor_continuation_shared_state> const& that) :
+          that_(that)
+        {
+        }
+        void operator()()
+        {
+          that_->run();
+        }
+      };
+
+    public:
+      future_executor_continuation_shared_state(
+          Ex& e, F& f, BOOST_THREAD_FWD_REF(Fp) c
+          ) :
+      ex(&e),
+      parent(f.future_),
+      continuation(boost::move(c))
+      {
+        this->set_async();
+      }
+
+      void launch_continuation(boost::unique_lock<boost::mutex>& lock)
+      {
+        run_it fct(static_pointer_cast<future_executor_continuation_shared_state>(this->shared_from_this()));
+        lock.unlock();
+        try
+        {
+          ex->execute(boost::move(fct));
+        }
+        catch(...)
+        {
+          // the continuation will never run, e.g. because the executor is closed
+          this->mark_exceptional_finish();
+        }
+      }
+
+      void run()
+      {
+        try
+        {
+          this->mark_finished_with_result(continuation(parent));
+        }
+#if defined BOOST_THREAD_PROVIDES_INTERRUPTIONS
+        catch(thread_interrupted& )
+        {
+          this->mark_interrupted_finish();
+        }
+#endif
+        catch(...)
+        {
+          this->mark_exceptional_finish();
+        }
+      }
+    };
+
+    template<typename Ex, typename F, typename Fp>
+    struct future_executor_continuation_shared_state<Ex, F, void, Fp>: shared_state<void>
+    {
+      Ex* ex;
+      F parent;
+      Fp continuation;
+
+      struct run_it
+      {
+        shared_ptr<future_executor_continuation_shared_state> that_;
+
+        explicit run_it(shared_ptr<future_executor_continuation_shared_state> const& that) :
+          that_(that)
+        {
+        }
+        void operator()()
+        {
+          that_->run();
+        }
+      };
+
+    public:
+      future_executor_continuation_shared_state(
+          Ex& e, F& f, BOOST_THREAD_FWD_REF(Fp) c
+          ) :
+      ex(&e),
+      parent(f.future_),
+      continuation(boost::move(c))
+      {
+        this->set_async();
+      }
+
+      void launch_continuation(boost::unique_lock<boost::mutex>& lock)
+      {
+        run_it fct(static_pointer_cast<future_executor_continuation_shared_state>(this->shared_from_this()));
+        lock.unlock();
+        try
+        {
+          ex->execute(boost::move(fct));
+        }
+        catch(...)
+        {
+          // the continuation will never run, e.g. because the executor is closed
+          this->mark_exceptional_finish();
+        }
+      }
+
+      void run()
+      {
+        try
+        {
+          continuation(parent);
+          this->mark_finished_with_result();
+        }
+#if defined BOOST_THREAD_PROVIDES_INTERRUPTIONS
+        catch(thread_interrupted& )
+        {
+          this->mark_interrupted_finish();
+        }
+#endif
+        catch(...)
+        {
+          this->mark_exceptional_finish();
+        }
+      }
+    };
+
+    ////////////////////////////////
+    // make_future_executor_continuation_shared_state
+    ////////////////////////////////
+    template<typename Ex, typename F, typename Rp, typename Fp>
+    BOOST_THREAD_FUTURE<Rp>
+    make_future_executor_continuation_shared_state(
+        boost::unique_lock<boost::mutex> &lock, Ex& ex, F& f, BOOST_THREAD_FWD_REF(Fp) c
+        )
+    {
+      shared_ptr<future_executor_continuation_shared_state<Ex, F, Rp, Fp> >
+          h(new future_executor_continuation_shared_state<Ex, F, Rp, Fp>(ex, f, boost::forward<Fp>(c)));
+      f.future_->set_continuation_ptr(h, lock);
+
+      return BOOST_THREAD_FUTURE<Rp>(h);
+    }
+
   }
 
   ////////////////////////////////
@@ -4079,6 +4366,44 @@ namespace boost
       );
     }
   }
+
+  ////////////////////////////////
+  // template<typename Ex, typename F>
+  // auto future<R>::then(Ex& ex, F&& func) -> BOOST_THREAD_FUTURE<decltype(func(*this))>;
+  ////////////////////////////////
+
+  template <typename R>
+  template <typename Ex, typename F>
+  inline typename boost::lazy_enable_if_c<executors::is_executor<Ex>::value,
+    detail::executor_continuation_result<F, BOOST_THREAD_FUTURE<R> > >::type
+  BOOST_THREAD_FUTURE<R>::then(Ex& ex, BOOST_THREAD_FWD_REF(F) func)
+  {
+
+    typedef typename boost::result_of<F(BOOST_THREAD_FUTURE<R>&)>::type future_type;
+    BOOST_THREAD_ASSERT_PRECONDITION(this->future_!=0, future_uninitialized());
+
+    boost::unique_lock<boost::mutex> lock(this->future_->mutex);
+    return BOOST_THREAD_MAKE_RV_REF((boost::detail::make_future_executor_continuation_shared_state<Ex, BOOST_THREAD_FUTURE<R>, future_type, F>(
+                lock, ex, *this, boost::forward<F>(func)
+            )));
+  }
+
+  template <typename R>
+  template <typename Ex, typename F>
+  inline typename boost::lazy_enable_if_c<executors::is_executor<Ex>::value,
+    detail::executor_continuation_result<F, shared_future<R> > >::type
+  shared_future<R>::then(Ex& ex, BOOST_THREAD_FWD_REF(F) func)
+  {
+
+    typedef typename boost::result_of<F(shared_future<R>&)>::type future_type;
+    BOOST_THREAD_ASSERT_PRECONDITION(this->future_!=0, future_uninitialized());
+
+    boost::unique_lock<boost::mutex> lock(this->future_->mutex);
+    return BOOST_THREAD_MAKE_RV_REF((boost::detail::make_future_executor_continuation_shared_state<Ex, shared_future<R>, future_type, F>(
+                lock, ex, *this, boost::forward<F>(func)
+            )));
+  }
+
   namespace detail
   {
     template <typename T>
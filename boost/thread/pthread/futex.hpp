@@ -0,0 +1,65 @@
+#ifndef BOOST_THREAD_PTHREAD_FUTEX_HPP
+#define BOOST_THREAD_PTHREAD_FUTEX_HPP
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/thread/detail/config.hpp>
+
+#if defined BOOST_THREAD_HAS_FUTEX
+
+#include <boost/atomic.hpp>
+#include <boost/static_assert.hpp>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <time.h>
+#include <errno.h>
+
+#include <boost/config/abi_prefix.hpp>
+
+namespace boost
+{
+  namespace detail
+  {
+    // the kernel waits on the int, that is stored in the atomic
+    typedef boost::atomic<int> futex_word;
+    BOOST_STATIC_ASSERT(sizeof(futex_word) == sizeof(int));
+
+    /**
+     * Blocks until futex_wake is called on word, as long as word still contains expected. timeout is relative, no
+     * timeout if null.
+     *
+     * Returns: 0 when woken up, otherwise the errno: EAGAIN if word did not contain expected, ETIMEDOUT or EINTR.
+     */
+    inline int futex_wait(futex_word& word, int expected, struct timespec const* timeout = 0)
+    {
+      if (::syscall(SYS_futex, reinterpret_cast<int*>(&word), FUTEX_WAIT_PRIVATE, expected, timeout, 0, 0) == 0)
+      {
+        return 0;
+      }
+      return errno;
+    }
+
+    /// wakes up to count threads that are blocked in futex_wait on word
+    inline void futex_wake(futex_word& word, int count)
+    {
+      ::syscall(SYS_futex, reinterpret_cast<int*>(&word), FUTEX_WAKE_PRIVATE, count, 0, 0, 0);
+    }
+
+    /// hints the processor that the calling thread is spinning
+    inline void cpu_relax()
+    {
+#if defined(__i386__) || defined(__x86_64__)
+      __asm__ __volatile__("pause" ::: "memory");
+#elif defined(__aarch64__)
+      __asm__ __volatile__("yield" ::: "memory");
+#endif
+    }
+  }
+}
+
+#include <boost/config/abi_suffix.hpp>
+
+#endif
+#endif
@@ -17,6 +17,9 @@
 #include <boost/enable_shared_from_this.hpp>
 #include <boost/optional.hpp>
 #include <boost/assert.hpp>
+#if defined BOOST_THREAD_HAS_FUTEX
+#include <boost/atomic.hpp>
+#endif
 #ifdef BOOST_THREAD_USES_CHRONO
 #include <boost/chrono/system_clocks.hpp>
 #endif
@@ -129,7 +132,14 @@ namespace boost
             // when BOOST_THREAD_PROVIDES_INTERRUPTIONS is defined.
             // Another option is to have them always
             bool interrupt_enabled;
+#if defined BOOST_THREAD_HAS_FUTEX
+            // written while data_mutex is locked, read without it by futex_condition_variable
+            boost::atomic<bool> interrupt_requested;
+            // the futex word of the futex_condition_variable the thread waits on, if any
+            boost::atomic<boost::atomic<int>*> current_futex;
+#else
             bool interrupt_requested;
+#endif
 //#endif
             thread_data_base():
                 thread_handle(0),
@@ -142,6 +152,9 @@ namespace boost
 //#if defined BOOST_THREAD_PROVIDES_INTERRUPTIONS
                 , interrupt_enabled(true)
                 , interrupt_requested(false)
+#if defined BOOST_THREAD_HAS_FUTEX
+                , current_futex(0)
+#endif
 //#endif
             {}
             virtual ~thread_data_base();
@@ -0,0 +1,577 @@
+#ifndef BOOST_THREAD_SYNC_TWO_LOCK_QUEUE_HPP
+#define BOOST_THREAD_SYNC_TWO_LOCK_QUEUE_HPP
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/thread for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include <boost/thread/detail/config.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/lock_guard.hpp>
+#include <boost/thread/detail/move.hpp>
+#include <boost/thread/sync_bounded_queue.hpp>
+#include <boost/throw_exception.hpp>
+#include <boost/smart_ptr/shared_ptr.hpp>
+#include <boost/smart_ptr/make_shared.hpp>
+#include <boost/type_traits/aligned_storage.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+#include <boost/atomic.hpp>
+
+#include <boost/config/abi_prefix.hpp>
+
+namespace boost
+{
+
+  /**
+   * Unbounded queue with the interface of sync_queue, that is implemented as a linked list with a dummy node and
+   * separate locks for its head and its tail, as described by Michael and Scott.
+   *
+   * Producers only lock the tail and consumers only lock the head, so that a push and a pull never block each other.
+   * The condition variable is only notified, when a consumer is actually waiting for the queue to become non-empty.
+   */
+  template <typename ValueType>
+  class sync_two_lock_queue
+  {
+  public:
+    typedef ValueType value_type;
+    typedef std::size_t size_type;
+
+    // Constructors/Assignment/Destructors
+    BOOST_THREAD_NO_COPYABLE(sync_two_lock_queue)
+    inline sync_two_lock_queue();
+    inline ~sync_two_lock_queue();
+
+    // Observers
+    inline bool empty() const;
+    inline bool full() const;
+    inline size_type size() const;
+    inline bool closed() const;
+
+    // Modifiers
+    inline void close();
+
+    inline void push(const value_type& x);
+    inline void push(BOOST_THREAD_RV_REF(value_type) x);
+    inline bool try_push(const value_type& x);
+    inline bool try_push(BOOST_THREAD_RV_REF(value_type) x);
+    inline bool try_push(no_block_tag, const value_type& x);
+    inline bool try_push(no_block_tag, BOOST_THREAD_RV_REF(value_type) x);
+
+    // Observers/Modifiers
+    inline void pull(value_type&);
+    inline void pull(ValueType& elem, bool & closed);
+    // enable_if is_nothrow_copy_movable<value_type>
+    inline value_type pull();
+    inline shared_ptr<ValueType> ptr_pull();
+    inline bool try_pull(value_type&);
+    inline bool try_pull(no_block_tag,value_type&);
+    inline shared_ptr<ValueType> try_pull();
+
+  private:
+    struct node
+    {
+      atomic<node*> next;
+      typename aligned_storage<sizeof(ValueType), alignment_of<ValueType>::value>::type storage;
+
+      // the dummy node
+      node() :
+        next(0)
+      {
+      }
+      explicit node(const value_type& x) :
+        next(0)
+      {
+        new (&storage) value_type(x);
+      }
+      explicit node(BOOST_THREAD_RV_REF(value_type) x) :
+        next(0)
+      {
+        new (&storage) value_type(boost::move(x));
+      }
+
+      value_type& value()
+      {
+        return *static_cast<value_type*>(static_cast<void*>(&storage));
+      }
+      void destroy_value()
+      {
+        value().~value_type();
+      }
+    };
+
+    // consumer side, protected by head_mtx_
+    mutable mutex head_mtx_;
+    condition_variable not_empty_;
+    node* head_;
+    size_type pulled_;
+
+    // keeps the producer side on another cache line
+    char padding_[64];
+
+    // producer side, protected by tail_mtx_
+    mutable mutex tail_mtx_;
+    node* tail_;
+    size_type pushed_;
+
+    // consumers waiting on not_empty_, modified while head_mtx_ is held
+    atomic<size_type> waiting_empty_;
+    // written while both locks are held
+    bool closed_;
+
+    inline bool empty(unique_lock<mutex>& ) const BOOST_NOEXCEPT
+    {
+      return head_->next.load(memory_order_acquire) == 0;
+    }
+
+    inline void throw_if_closed(unique_lock<mutex>&);
+
+    inline bool try_pull(value_type& x, unique_lock<mutex>& lk);
+    inline shared_ptr<value_type> try_pull(unique_lock<mutex>& lk);
+
+    inline void wait_until_not_empty(unique_lock<mutex>& lk);
+    inline void wait_until_not_empty(unique_lock<mutex>& lk, bool&);
+
+    inline bool link(node* n, unique_lock<mutex>& lk);
+    inline void push_node(node* n);
+    inline bool try_push_node(node* n);
+
+    inline void notify_not_empty_if_needed()
+    {
+      // pairs with the increment in wait_until_not_empty: either the consumer sees the linked node or this thread
+      // sees the consumer waiting. As with sync_queue, the notifier decrements the count, so that the pushes done
+      // before the woken consumer runs don't notify again.
+      if (waiting_empty_.load() > 0)
+      {
+        lock_guard<mutex> lk(head_mtx_);
+        if (waiting_empty_.load(memory_order_relaxed) > 0)
+        {
+          --waiting_empty_;
+          not_empty_.notify_one();
+        }
+      }
+    }
+
+    inline void pull(value_type& elem, unique_lock<mutex>& )
+    {
+      node* first = head_->next.load(memory_order_acquire);
+      elem = boost::move(first->value());
+      pop_front(first);
+    }
+    inline boost::shared_ptr<value_type> ptr_pull(unique_lock<mutex>& )
+    {
+      node* first = head_->next.load(memory_order_acquire);
+      shared_ptr<value_type> res = make_shared<value_type>(boost::move(first->value()));
+      pop_front(first);
+      return res;
+    }
+
+    // first becomes the new dummy node
+    inline void pop_front(node* first)
+    {
+      first->destroy_value();
+      node* old_head = head_;
+      head_ = first;
+      ++pulled_;
+      delete old_head;
+    }
+  };
+
+  template <typename ValueType>
+  sync_two_lock_queue<ValueType>::sync_two_lock_queue() :
+    head_(new node()), pulled_(0), tail_(head_), pushed_(0), waiting_empty_(0), closed_(false)
+  {
+  }
+
+  template <typename ValueType>
+  sync_two_lock_queue<ValueType>::~sync_two_lock_queue()
+  {
+    node* n = head_->next.load(memory_order_relaxed);
+    delete head_;
+    while (n)
+    {
+      node* next = n->next.load(memory_order_relaxed);
+      n->destroy_value();
+      delete n;
+      n = next;
+    }
+  }
+
+  template <typename ValueType>
+  void sync_two_lock_queue<ValueType>::close()
+  {
+    {
+      lock_guard<mutex> hlk(head_mtx_);
+      lock_guard<mutex> tlk(tail_mtx_);
+      closed_ = true;
+      waiting_empty_ = 0;
+    }
+    not_empty_.notify_all();
+  }
+
+  template <typename ValueType>
+  bool sync_two_lock_queue<ValueType>::closed() const
+  {
+    lock_guard<mutex> lk(tail_mtx_);
+    return closed_;
+  }
+
+  template <typename ValueType>
+  bool sync_two_lock_queue<ValueType>::empty() const
+  {
+    lock_guard<mutex> lk(head_mtx_);
+    return head_->next.load(memory_order_acquire) == 0;
+  }
+  template <typename ValueType>
+  bool sync_two_lock_queue<ValueType>::full() const
+  {
+    return false;
+  }
+
+  template <typename ValueType>
+  typename sync_two_lock_queue<ValueType>::size_type sync_two_lock_queue<ValueType>::size() const
+  {
+    lock_guard<mutex> hlk(head_mtx_);
+    lock_guard<mutex> tlk(tail_mtx_);
+    return pushed_ - pulled_;
+  }
+
+
+  template <typename ValueType>
+  bool sync_two_lock_queue<ValueType>::try_pull(ValueType& elem, unique_lock<mutex>& lk)
+  {
+    if (empty(lk))
+    {
+      throw_if_closed(lk);
+      return false;
+    }
+    pull(elem, lk);
+    return true;
+  }
+  template <typename ValueType>
+  shared_ptr<ValueType> sync_two_lock_queue<ValueType>::try_pull(unique_lock<mutex>& lk)
+  {
+    if (empty(lk))
+    {
+      throw_if_closed(lk);
+      return shared_ptr<ValueType>();
+    }
+    return ptr_pull(lk);
+  }
+
+  template <typename ValueType>
+  bool sync_two_lock_queue<ValueType>::try_pull(ValueType& elem)
+  {
+    try
+    {
+      unique_lock<mutex> lk(head_mtx_);
+      return try_pull(elem, lk);
+    }
+    catch (...)
+    {
+      close();
+      throw;
+    }
+  }
+
+  template <typename ValueType>
+  bool sync_two_lock_queue<ValueType>::try_pull(no_block_tag,ValueType& elem)
+  {
+    try
+    {
+      unique_lock<mutex> lk(head_mtx_, try_to_lock);
+      if (!lk.owns_lock())
+      {
+        return false;
+      }
+      return try_pull(elem, lk);
+    }
+    catch (...)
+    {
+      close();
+      throw;
+    }
+  }
+  template <typename ValueType>
+  boost::shared_ptr<ValueType> sync_two_lock_queue<ValueType>::try_pull()
+  {
+    try
+    {
+      unique_lock<mutex> lk(head_mtx_);
+      return try_pull(lk);
+    }
+    catch (...)
+    {
+      close();
+      throw;
+    }
+  }
+
+  template <typename ValueType>
+  void sync_two_lock_queue<ValueType>::throw_if_closed(unique_lock<mutex>&)
+  {
+    if (closed_)
+    {
+      BOOST_THROW_EXCEPTION( sync_queue_is_closed() );
+    }
+  }
+
+  template <typename ValueType>
+  void sync_two_lock_queue<ValueType>::wait_until_not_empty(unique_lock<mutex>& lk)
+  {
+    for (;;)
+    {
+      if (! empty(lk)) break;
+      throw_if_closed(lk);
+      ++waiting_empty_;
+      // a producer, that linked its node before the increment, might not have seen it
+      if (head_->next.load() == 0)
+      {
+        not_empty_.wait(lk);
+      }
+      else
+      {
+        --waiting_empty_;
+      }
+    }
+  }
+  template <typename ValueType>
+  void sync_two_lock_queue<ValueType>::wait_until_not_empty(unique_lock<mutex>& lk, bool & closed)
+  {
+    for (;;)
+    {
+      if (! empty(lk)) break;
+      if (closed_) {closed=true; return;}
+      ++waiting_empty_;
+      if (head_->next.load() == 0)
+      {
+        not_empty_.wait(lk);
+      }
+      else
+      {
+        --waiting_empty_;
+      }
+    }
+    closed=false;
+  }
+
+  template <typename ValueType>
+  void sync_two_lock_queue<ValueType>::pull(ValueType& elem)
+  {
+    try
+    {
+      unique_lock<mutex> lk(head_mtx_);
+      wait_until_not_empty(lk);
+      pull(elem, lk);
+    }
+    catch (...)
+    {
+      close();
+      throw;
+    }
+  }
+  template <typename ValueType>
+  void sync_two_lock_queue<ValueType>::pull(ValueType& elem, bool & closed)
+  {
+    try
+    {
+      unique_lock<mutex> lk(head_mtx_);
+      wait_until_not_empty(lk, closed);
+      if (closed) {return;}
+      pull(elem, lk);
+    }
+    catch (...)
+    {
+      close();
+      throw;
+    }
+  }
+
+  // enable if ValueType is nothrow movable
+  template <typename ValueType>
+  ValueType sync_two_lock_queue<ValueType>::pull()
+  {
+    try
+    {
+      value_type elem;
+      pull(elem);
+      return boost::move(elem);
+    }
+    catch (...)
+    {
+      close();
+      throw;
+    }
+  }
+  template <typename ValueType>
+  boost::shared_ptr<ValueType> sync_two_lock_queue<ValueType>::ptr_pull()
+  {
+    try
+    {
+      unique_lock<mutex> lk(head_mtx_);
+      wait_until_not_empty(lk);
+      return ptr_pull(lk);
+    }
+    catch (...)
+    {
+      close();
+      throw;
+    }
+  }
+
+  // links n at the tail, returns false if the queue is closed
+  template <typename ValueType>
+  bool sync_two_lock_queue<ValueType>::link(node* n, unique_lock<mutex>&)
+  {
+    if (closed_)
+    {
+      return false;
+    }
+    tail_->next.store(n);
+    tail_ = n;
+    ++pushed_;
+    return true;
+  }
+
+  template <typename ValueType>
+  void sync_two_lock_queue<ValueType>::push_node(node* n)
+  {
+    bool linked;
+    {
+      unique_lock<mutex> lk(tail_mtx_);
+      linked = link(n, lk);
+    }
+    if (!linked)
+    {
+      n->destroy_value();
+      delete n;
+      BOOST_THROW_EXCEPTION( sync_queue_is_closed() );
+    }
+    notify_not_empty_if_needed();
+  }
+
+  template <typename ValueType>
+  bool sync_two_lock_queue<ValueType>::try_push_node(node* n)
+  {
+    bool linked;
+    {
+      unique_lock<mutex> lk(tail_mtx_, try_to_lock);
+      if (!lk.owns_lock())
+      {
+        n->destroy_value();
+        delete n;
+        return false;
+      }
+      linked = link(n, lk);
+    }
+    if (!linked)
+    {
+      n->destroy_value();
+      delete n;
+      BOOST_THROW_EXCEPTION( sync_queue_is_closed() );
+    }
+    notify_not_empty_if_needed();
+    return true;
+  }
+
+  template <typename ValueType>
+  bool sync_two_lock_queue<ValueType>::try_push(const ValueType& elem)
+  {
+    push(elem);
+    return true;
+  }
+
+  template <typename ValueType>
+  bool sync_two_lock_queue<ValueType>::try_push(no_block_tag, const ValueType& elem)
+  {
+    try
+    {
+      return try_push_node(new node(elem));
+    }
+    catch (...)
+    {
+      close();
+      throw;
+    }
+  }
+
+  template <typename ValueType>
+  void sync_two_lock_queue<ValueType>::push(const ValueType& elem)
+  {
+    try
+    {
+      push_node(new node(elem));
+    }
+    catch (...)
+    {
+      close();
+      throw;
+    }
+  }
+
+  template <typename ValueType>
+  bool sync_two_lock_queue<ValueType>::try_push(BOOST_THREAD_RV_REF(ValueType) elem)
+  {
+    push(boost::move(elem));
+    return true;
+  }
+
+  template <typename ValueType>
+  bool sync_two_lock_queue<ValueType>::try_push(no_block_tag, BOOST_THREAD_RV_REF(ValueType) elem)
+  {
+    try
+    {
+      return try_push_node(new node(boost::move(elem)));
+    }
+    catch (...)
+    {
+      close();
+      throw;
+    }
+  }
+
+  template <typename ValueType>
+  void sync_two_lock_queue<ValueType>::push(BOOST_THREAD_RV_REF(ValueType) elem)
+  {
+    try
+    {
+      push_node(new node(boost::move(elem)));
+    }
+    catch (...)
+    {
+      close();
+      throw;
+    }
+  }
+
+  template <typename ValueType>
+  sync_two_lock_queue<ValueType>& operator<<(sync_two_lock_queue<ValueType>& sbq, BOOST_THREAD_RV_REF(ValueType) elem)
+  {
+    sbq.push(boost::move(elem));
+    return sbq;
+  }
+
+  template <typename ValueType>
+  sync_two_lock_queue<ValueType>& operator<<(sync_two_lock_queue<ValueType>& sbq, ValueType const&elem)
+  {
+    sbq.push(elem);
+    return sbq;
+  }
+
+  template <typename ValueType>
+  sync_two_lock_queue<ValueType>& operator>>(sync_two_lock_queue<ValueType>& sbq, ValueType &elem)
+  {
+    sbq.pull(elem);
+    return sbq;
+  }
+
+}
+
+#include <boost/config/abi_suffix.hpp>
+
+#endif
@@ -0,0 +1,150 @@
+//
+// basic_acceptor_group.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include <boost/asio/basic_acceptor_group.hpp>
+
+#include <boost/asio/io_service_pool.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/read.hpp>
+#include <boost/asio/write.hpp>
+#include "unit_test.hpp"
+
+#if defined(BOOST_ASIO_HAS_BOOST_BIND)
+# include <boost/bind.hpp>
+#else // defined(BOOST_ASIO_HAS_BOOST_BIND)
+# include <functional>
+#endif // defined(BOOST_ASIO_HAS_BOOST_BIND)
+
+using namespace boost::asio;
+
+#if defined(BOOST_ASIO_HAS_BOOST_BIND)
+namespace bindns = boost;
+#else // defined(BOOST_ASIO_HAS_BOOST_BIND)
+namespace bindns = std;
+#endif
+
+#if defined(BOOST_ASIO_HAS_SO_REUSEPORT)
+
+struct accept_state
+{
+  ip::tcp::acceptor* acceptor;
+  ip::tcp::socket* socket;
+  int accepted;
+};
+
+void handle_accept(const boost::system::error_code& err, accept_state* state)
+{
+#if !defined(BOOST_ASIO_HAS_BOOST_BIND)
+  using std::placeholders::_1;
+#endif // !defined(BOOST_ASIO_HAS_BOOST_BIND)
+
+  if (err)
+    return;
+
+  ++state->accepted;
+
+  // Tell the client that its connection has been accepted.
+  char data = 0;
+  boost::system::error_code ec;
+  write(*state->socket, buffer(&data, 1), ec);
+  state->socket->close(ec);
+
+  state->acceptor->async_accept(*state->socket,
+      bindns::bind(&handle_accept, _1, state));
+}
+
+void basic_acceptor_group_test()
+{
+#if !defined(BOOST_ASIO_HAS_BOOST_BIND)
+  using std::placeholders::_1;
+#endif // !defined(BOOST_ASIO_HAS_BOOST_BIND)
+
+  io_service_pool pool(2, false);
+
+  boost::system::error_code ec;
+  basic_acceptor_group<ip::tcp> acceptors(pool,
+      ip::tcp::endpoint(ip::address_v4::loopback(), 0),
+      socket_base::max_connections, ec);
+
+  // Kernels without SO_REUSEPORT support reject the option.
+  if (ec == error::no_protocol_option || ec == error::invalid_argument)
+    return;
+
+  BOOST_ASIO_CHECK(!ec);
+  BOOST_ASIO_CHECK(acceptors.size() == 2);
+
+  ip::tcp::endpoint endpoint = acceptors.local_endpoint();
+  BOOST_ASIO_CHECK(endpoint.port() != 0);
+  BOOST_ASIO_CHECK(acceptors[1].local_endpoint() == endpoint);
+  BOOST_ASIO_CHECK(&acceptors[0].get_io_service() == &pool.get_io_service(0));
+  BOOST_ASIO_CHECK(&acceptors[1].get_io_service() == &pool.get_io_service(1));
+
+  socket_base::reuse_port option;
+  acceptors[1].get_option(option);
+  BOOST_ASIO_CHECK(option.value());
+
+  ip::tcp::socket server_socket0(pool.get_io_service(0));
+  accept_state state0 = { &acceptors[0], &server_socket0, 0 };
+  acceptors[0].async_accept(server_socket0,
+      bindns::bind(&handle_accept, _1, &state0));
+
+  ip::tcp::socket server_socket1(pool.get_io_service(1));
+  accept_state state1 = { &acceptors[1], &server_socket1, 0 };
+  acceptors[1].async_accept(server_socket1,
+      bindns::bind(&handle_accept, _1, &state1));
+
+  pool.start();
+
+  // Each client waits until the server has accepted its connection, so all
+  // connections have been handled once the loop is complete.
+  const int num_connections = 64;
+  io_service ios;
+  for (int i = 0; i < num_connections; ++i)
+  {
+    ip::tcp::socket client_socket(ios);
+    client_socket.connect(endpoint);
+    char data = 1;
+    read(client_socket, buffer(&data, 1));
+    BOOST_ASIO_CHECK(data == 0);
+  }
+
+  pool.stop();
+  pool.join();
+  acceptors.close();
+
+  BOOST_ASIO_CHECK(state0.accepted + state1.accepted == num_connections);
+
+#if defined(__linux__)
+  // Linux distributes connections among all sockets bound to the port, using
+  // a hash of the client's address and port.
+  BOOST_ASIO_CHECK(state0.accepted > 0);
+  BOOST_ASIO_CHECK(state1.accepted > 0);
+#endif // defined(__linux__)
+}
+
+#else // defined(BOOST_ASIO_HAS_SO_REUSEPORT)
+
+void basic_acceptor_group_test()
+{
+}
+
+#endif // defined(BOOST_ASIO_HAS_SO_REUSEPORT)
+
+BOOST_ASIO_TEST_SUITE
+(
+  "basic_acceptor_group",
+  BOOST_ASIO_TEST_CASE(basic_acceptor_group_test)
+)
@@ -0,0 +1,167 @@
+//
+// handler_alloc_hook.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include <boost/asio/handler_alloc_hook.hpp>
+
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/detail/thread.hpp>
+#include "unit_test.hpp"
+
+using namespace boost::asio;
+
+struct chain_handler
+{
+  io_service* ios;
+  int* count;
+
+  void operator()()
+  {
+    if (++(*count) < 100)
+      ios->post(*this);
+  }
+};
+
+struct large_handler
+{
+  int* count;
+  char payload[8192];
+
+  void operator()()
+  {
+    ++(*count);
+  }
+};
+
+struct post_large_handlers
+{
+  io_service* ios;
+  int* count;
+  int n;
+
+  void operator()()
+  {
+    large_handler lh;
+    lh.count = count;
+    for (int i = 0; i < n; ++i)
+      ios->post(lh);
+  }
+};
+
+void handler_alloc_hook_test()
+{
+  io_service ios;
+
+  handler_allocation_stats before = get_handler_allocation_stats();
+
+  int count = 0;
+  chain_handler h = { &ios, &count };
+  ios.post(h);
+  ios.run();
+  BOOST_ASIO_CHECK(count == 100);
+
+  handler_allocation_stats after = get_handler_allocation_stats();
+
+#if !defined(BOOST_ASIO_DISABLE_SMALL_BLOCK_RECYCLING)
+  // Each handler's memory is freed before the upcall, so every post made by a
+  // handler should reuse the memory of the handler that made it.
+  BOOST_ASIO_CHECK(after.hits - before.hits >= 99);
+  BOOST_ASIO_CHECK(after.misses - before.misses <= 1);
+#endif // !defined(BOOST_ASIO_DISABLE_SMALL_BLOCK_RECYCLING)
+
+  before = after;
+
+  // Post the large handler from within run(), so that its allocation is
+  // counted.
+  count = 0;
+  post_large_handlers ph = { &ios, &count, 1 };
+  ios.reset();
+  ios.post(ph);
+  ios.run();
+  BOOST_ASIO_CHECK(count == 1);
+
+  after = get_handler_allocation_stats();
+
+#if !defined(BOOST_ASIO_DISABLE_SMALL_BLOCK_RECYCLING)
+  // Blocks too large for any size class are never cached.
+  BOOST_ASIO_CHECK(after.hits == before.hits);
+  BOOST_ASIO_CHECK(after.misses - before.misses == 1);
+  BOOST_ASIO_CHECK(after.releases - before.releases == 1);
+#endif // !defined(BOOST_ASIO_DISABLE_SMALL_BLOCK_RECYCLING)
+}
+
+struct allocate_outside_io_service
+{
+  void operator()()
+  {
+    for (int i = 0; i < 1000; ++i)
+    {
+      void* p = asio_handler_allocate(16);
+      asio_handler_deallocate(p, 16);
+    }
+  }
+};
+
+void run_large_handlers()
+{
+  io_service ios;
+  int count = 0;
+  post_large_handlers ph = { &ios, &count, 1000 };
+  ios.post(ph);
+  ios.run();
+}
+
+void handler_alloc_hook_thread_test()
+{
+  handler_allocation_stats before = get_handler_allocation_stats();
+
+  // Allocations made outside an io_service are neither cached nor counted.
+  detail::thread t1((allocate_outside_io_service()));
+  allocate_outside_io_service()();
+  t1.join();
+
+  handler_allocation_stats after = get_handler_allocation_stats();
+
+  BOOST_ASIO_CHECK(after.hits == before.hits);
+  BOOST_ASIO_CHECK(after.misses == before.misses);
+  BOOST_ASIO_CHECK(after.releases == before.releases);
+
+  before = after;
+
+  // The counts from all threads running an io_service are included in the
+  // totals once the threads have returned from run().
+  detail::thread t2(&run_large_handlers);
+  detail::thread t3(&run_large_handlers);
+  detail::thread t4(&run_large_handlers);
+  run_large_handlers();
+  t2.join();
+  t3.join();
+  t4.join();
+
+  after = get_handler_allocation_stats();
+
+#if !defined(BOOST_ASIO_DISABLE_SMALL_BLOCK_RECYCLING)
+  BOOST_ASIO_CHECK(after.hits == before.hits);
+  BOOST_ASIO_CHECK(after.misses - before.misses == 4000);
+  BOOST_ASIO_CHECK(after.releases - before.releases == 4000);
+#endif // !defined(BOOST_ASIO_DISABLE_SMALL_BLOCK_RECYCLING)
+}
+
+BOOST_ASIO_TEST_SUITE
+(
+  "handler_alloc_hook",
+  BOOST_ASIO_TEST_CASE(handler_alloc_hook_test)
+  BOOST_ASIO_TEST_CASE(handler_alloc_hook_thread_test)
+)
@@ -26,6 +26,7 @@
 #endif // defined(BOOST_ASIO_HAS_BOOST_DATE_TIME)
 
 #if defined(BOOST_ASIO_HAS_BOOST_BIND)
+# include <boost/thread/mutex.hpp>
 # include <boost/thread/thread.hpp>
 # include <boost/bind.hpp>
 #else // defined(BOOST_ASIO_HAS_BOOST_BIND)
@@ -281,6 +282,103 @@ void io_service_test()
   BOOST_ASIO_CHECK(exception_count == 2);
 }
 
+struct shared_count
+{
+  boost::mutex mutex;
+  int value;
+};
+
+void locked_increment(shared_count* count)
+{
+  boost::mutex::scoped_lock lock(count->mutex);
+  ++count->value;
+}
+
+void ignore_error(const boost::system::error_code&)
+{
+}
+
+void post_and_wait_for_peer(io_service* ios, shared_count* count, timer* t)
+{
+  // Handlers posted from within a handler are queued for the posting thread,
+  // so while this handler blocks they can only be run if a peer steals them.
+  for (int i = 0; i < 100; ++i)
+    ios->post(bindns::bind(locked_increment, count));
+
+  bool all_run = false;
+  for (int i = 0; i < 1000 && !all_run; ++i)
+  {
+    {
+      boost::mutex::scoped_lock lock(count->mutex);
+      all_run = (count->value == 100);
+    }
+    if (!all_run)
+      timer(*ios, chronons::milliseconds(10)).wait();
+  }
+
+  BOOST_ASIO_CHECK(all_run);
+  t->cancel();
+}
+
+void io_service_work_stealing_test()
+{
+  io_service ios(2);
+  shared_count count;
+  count.value = 0;
+
+  // Start the reactor, so that the peer may be blocked in it rather than idle.
+  timer t(ios, chronons::seconds(60));
+  t.async_wait(&ignore_error);
+
+  ios.post(bindns::bind(post_and_wait_for_peer, &ios, &count, &t));
+  boost::thread thread1(bindns::bind(io_service_run, &ios));
+  ios.run();
+  thread1.join();
+
+  BOOST_ASIO_CHECK(count.value == 100);
+}
+
+struct continuation_increment
+{
+  int* count;
+
+  void operator()()
+  {
+    ++(*count);
+  }
+
+  friend bool asio_handler_is_continuation(continuation_increment*)
+  {
+    return true;
+  }
+};
+
+void post_continuation_and_poll(io_service* ios, int* count)
+{
+  continuation_increment handler = { count };
+  ios->post(handler);
+
+  // The continuation is queued privately for this thread, but must still be
+  // run by a nested call to poll().
+  ios->poll();
+  BOOST_ASIO_CHECK(*count == 1);
+}
+
+void io_service_nested_poll_test()
+{
+#if defined(BOOST_ASIO_ENABLE_WORK_STEALING)
+  io_service ios(2);
+#else // defined(BOOST_ASIO_ENABLE_WORK_STEALING)
+  io_service ios(1);
+#endif // defined(BOOST_ASIO_ENABLE_WORK_STEALING)
+  int count = 0;
+
+  ios.post(bindns::bind(post_continuation_and_poll, &ios, &count));
+  ios.run();
+
+  BOOST_ASIO_CHECK(count == 1);
+}
+
 class test_service : public boost::asio::io_service::service
 {
 public:
@@ -355,5 +453,7 @@ BOOST_ASIO_TEST_SUITE
 (
   "io_service",
   BOOST_ASIO_TEST_CASE(io_service_test)
+  BOOST_ASIO_TEST_CASE(io_service_work_stealing_test)
+  BOOST_ASIO_TEST_CASE(io_service_nested_poll_test)
   BOOST_ASIO_TEST_CASE(io_service_service_test)
 )
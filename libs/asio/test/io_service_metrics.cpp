@@ -0,0 +1,120 @@
+//
+// io_service_metrics.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include <boost/asio/io_service_metrics.hpp>
+
+#include <boost/asio/deadline_timer.hpp>
+#include "unit_test.hpp"
+
+#if defined(BOOST_ASIO_HAS_BOOST_BIND)
+# include <boost/bind.hpp>
+#else // defined(BOOST_ASIO_HAS_BOOST_BIND)
+# include <functional>
+#endif // defined(BOOST_ASIO_HAS_BOOST_BIND)
+
+using namespace boost::asio;
+
+#if defined(BOOST_ASIO_HAS_BOOST_BIND)
+namespace bindns = boost;
+#else // defined(BOOST_ASIO_HAS_BOOST_BIND)
+namespace bindns = std;
+#endif // defined(BOOST_ASIO_HAS_BOOST_BIND)
+namespace posix_time = boost::posix_time;
+
+void increment(int* count)
+{
+  ++(*count);
+}
+
+std::size_t histogram_total(const std::size_t* buckets)
+{
+  std::size_t total = 0;
+  for (std::size_t i = 0; i < io_service_metrics::histogram_buckets; ++i)
+    total += buckets[i];
+  return total;
+}
+
+void io_service_metrics_test()
+{
+  io_service ios;
+  int count = 0;
+
+  // Nothing is timed until collection is enabled.
+  ios.post(bindns::bind(increment, &count));
+  ios.run();
+  BOOST_ASIO_CHECK(count == 1);
+
+  io_service_metrics m = get_io_service_metrics(ios);
+  BOOST_ASIO_CHECK(m.queue_depth == 0);
+  BOOST_ASIO_CHECK(m.handlers_executed == 0);
+  BOOST_ASIO_CHECK(histogram_total(m.queue_latency) == 0);
+  BOOST_ASIO_CHECK(histogram_total(m.execution_time) == 0);
+
+  enable_io_service_metrics(ios);
+
+  count = 0;
+  for (int i = 0; i < 10; ++i)
+    ios.post(bindns::bind(increment, &count));
+
+#if !defined(BOOST_ASIO_HAS_IOCP)
+  m = get_io_service_metrics(ios);
+  BOOST_ASIO_CHECK(m.queue_depth == 10);
+#endif // !defined(BOOST_ASIO_HAS_IOCP)
+
+  ios.reset();
+  ios.run();
+  BOOST_ASIO_CHECK(count == 10);
+
+  m = get_io_service_metrics(ios);
+  BOOST_ASIO_CHECK(m.queue_depth == 0);
+#if !defined(BOOST_ASIO_HAS_IOCP)
+  BOOST_ASIO_CHECK(m.handlers_executed == 10);
+  BOOST_ASIO_CHECK(histogram_total(m.queue_latency) == 10);
+  BOOST_ASIO_CHECK(histogram_total(m.execution_time) == 10);
+#endif // !defined(BOOST_ASIO_HAS_IOCP)
+
+  // Waiting in the reactor for a timer is counted as idle time.
+  deadline_timer t(ios, posix_time::milliseconds(50));
+  t.async_wait(bindns::bind(increment, &count));
+  ios.reset();
+  ios.run();
+  BOOST_ASIO_CHECK(count == 11);
+
+  m = get_io_service_metrics(ios);
+#if defined(BOOST_ASIO_HAS_EPOLL)
+  BOOST_ASIO_CHECK(m.idle_time >= 40000);
+  BOOST_ASIO_CHECK(m.reactor_wakeups > 0);
+  BOOST_ASIO_CHECK(m.reactor_events > 0);
+#endif // defined(BOOST_ASIO_HAS_EPOLL)
+
+  // Handlers queued while collection is disabled are not timed.
+  enable_io_service_metrics(ios, false);
+  std::size_t executed = m.handlers_executed;
+  ios.post(bindns::bind(increment, &count));
+  ios.reset();
+  ios.run();
+  BOOST_ASIO_CHECK(count == 12);
+
+  m = get_io_service_metrics(ios);
+  BOOST_ASIO_CHECK(m.queue_depth == 0);
+  BOOST_ASIO_CHECK(m.handlers_executed == executed);
+}
+
+BOOST_ASIO_TEST_SUITE
+(
+  "io_service_metrics",
+  BOOST_ASIO_TEST_CASE(io_service_metrics_test)
+)
@@ -0,0 +1,97 @@
+//
+// io_service_pool.cpp
+// ~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include <boost/asio/io_service_pool.hpp>
+
+#include <stdexcept>
+#include <vector>
+#include "unit_test.hpp"
+
+#if defined(BOOST_ASIO_HAS_BOOST_BIND)
+# include <boost/bind.hpp>
+#else // defined(BOOST_ASIO_HAS_BOOST_BIND)
+# include <functional>
+#endif // defined(BOOST_ASIO_HAS_BOOST_BIND)
+
+using namespace boost::asio;
+
+#if defined(BOOST_ASIO_HAS_BOOST_BIND)
+namespace bindns = boost;
+#else // defined(BOOST_ASIO_HAS_BOOST_BIND)
+namespace bindns = std;
+#endif
+
+void record_io_service(io_service* ios, io_service_pool* pool,
+    std::size_t index, std::vector<int>* results)
+{
+  // A handler must only ever run on the thread that owns its io_service.
+  (*results)[index] = (&pool->get_io_service(index) == ios) ? 1 : -1;
+  pool->stop();
+}
+
+void io_service_pool_test()
+{
+  io_service_pool pool(3, false);
+  BOOST_ASIO_CHECK(pool.size() == 3);
+  BOOST_ASIO_CHECK(&pool.get_io_service(0) != &pool.get_io_service(1));
+  BOOST_ASIO_CHECK(&pool.get_io_service(1) != &pool.get_io_service(2));
+
+  // Round-robin selection visits every io_service.
+  io_service* a = &pool.get_io_service();
+  io_service* b = &pool.get_io_service();
+  io_service* c = &pool.get_io_service();
+  io_service* d = &pool.get_io_service();
+  BOOST_ASIO_CHECK(a != b && b != c && a != c);
+  BOOST_ASIO_CHECK(a == d);
+
+  try
+  {
+    pool.get_io_service(3);
+    BOOST_ASIO_ERROR("get_io_service did not throw");
+  }
+  catch (std::out_of_range&)
+  {
+  }
+
+  std::vector<int> results(3, 0);
+  pool.get_io_service(2).post(bindns::bind(&record_io_service,
+        &pool.get_io_service(2), &pool, 2, &results));
+  pool.run();
+  BOOST_ASIO_CHECK(results[2] == 1);
+
+  // The pool may be restarted after it has been stopped.
+  pool.get_io_service(1).post(bindns::bind(&record_io_service,
+        &pool.get_io_service(1), &pool, 1, &results));
+  pool.start();
+  pool.join();
+  BOOST_ASIO_CHECK(results[1] == 1);
+  BOOST_ASIO_CHECK(results[0] == 0);
+
+  try
+  {
+    io_service_pool empty_pool(0);
+    BOOST_ASIO_ERROR("io_service_pool constructor did not throw");
+  }
+  catch (std::invalid_argument&)
+  {
+  }
+}
+
+BOOST_ASIO_TEST_SUITE
+(
+  "io_service_pool",
+  BOOST_ASIO_TEST_CASE(io_service_pool_test)
+)
@@ -19,6 +19,7 @@
 // Test that header file is self-contained.
 #include <boost/asio/ip/tcp.hpp>
 
+#include <cstdio>
 #include <cstring>
 #include <boost/asio/io_service.hpp>
 #include <boost/asio/read.hpp>
@@ -366,6 +367,18 @@ void test()
     int i12 = socket1.async_send(null_buffers(), in_flags, lazy);
     (void)i12;
 
+    socket1.async_send(buffer(const_char_buffer),
+        socket_base::message_zero_copy, &send_handler);
+
+#if defined(BOOST_ASIO_HAS_SENDFILE)
+    socket1.send_file(0, 0, 1);
+    socket1.send_file(0, 0, 1, ec);
+
+    socket1.async_send_file(0, 0, 1, &send_handler);
+    int i12a = socket1.async_send_file(0, 0, 1, lazy);
+    (void)i12a;
+#endif // defined(BOOST_ASIO_HAS_SENDFILE)
+
     socket1.receive(buffer(mutable_char_buffer));
     socket1.receive(mutable_buffers);
     socket1.receive(null_buffers());
@@ -509,7 +522,7 @@ void handle_read_eof(const boost::system::error_code& err,
 
 void test()
 {
-  using namespace std; // For memcmp.
+  using namespace std; // For memcmp, memset, tmpfile, fputs, fwrite, etc.
   using namespace boost::asio;
   namespace ip = boost::asio::ip;
 
@@ -577,6 +590,67 @@ void test()
   BOOST_ASIO_CHECK(write_completed);
   BOOST_ASIO_CHECK(memcmp(read_buffer, write_data, sizeof(write_data)) == 0);
 
+  // Zero-copy write, which falls back to copying where unsupported.
+
+  memset(read_buffer, 0, sizeof(read_buffer));
+  read_completed = false;
+  boost::asio::async_read(client_side_socket,
+      boost::asio::buffer(read_buffer),
+      bindns::bind(handle_read,
+        _1, _2, &read_completed));
+
+  write_completed = false;
+  server_side_socket.async_send(boost::asio::buffer(write_data),
+      socket_base::message_zero_copy,
+      bindns::bind(handle_write,
+        _1, _2, &write_completed));
+
+  ios.reset();
+  ios.run();
+  BOOST_ASIO_CHECK(read_completed);
+  BOOST_ASIO_CHECK(write_completed);
+  BOOST_ASIO_CHECK(memcmp(read_buffer, write_data, sizeof(write_data)) == 0);
+
+#if defined(BOOST_ASIO_HAS_SENDFILE)
+  // Write from a file.
+
+  FILE* file = tmpfile();
+  BOOST_ASIO_CHECK(file != 0);
+  if (file)
+  {
+    fputs("0123456789", file);
+    fwrite(write_data, 1, sizeof(write_data), file);
+    fflush(file);
+
+    memset(read_buffer, 0, sizeof(read_buffer));
+    read_completed = false;
+    boost::asio::async_read(client_side_socket,
+        boost::asio::buffer(read_buffer),
+        bindns::bind(handle_read,
+          _1, _2, &read_completed));
+
+    write_completed = false;
+    server_side_socket.async_send_file(fileno(file), 10, sizeof(write_data),
+        bindns::bind(handle_write,
+          _1, _2, &write_completed));
+
+    ios.reset();
+    ios.run();
+    BOOST_ASIO_CHECK(read_completed);
+    BOOST_ASIO_CHECK(write_completed);
+    BOOST_ASIO_CHECK(memcmp(read_buffer, write_data, sizeof(write_data)) == 0);
+
+    size_t bytes_sent = server_side_socket.send_file(
+        fileno(file), 10, sizeof(write_data));
+    BOOST_ASIO_CHECK(bytes_sent == sizeof(write_data));
+    memset(read_buffer, 0, sizeof(read_buffer));
+    boost::asio::read(client_side_socket, boost::asio::buffer(read_buffer));
+    BOOST_ASIO_CHECK(memcmp(read_buffer, write_data, sizeof(write_data)) == 0);
+
+    fclose(file);
+  }
+#endif // defined(BOOST_ASIO_HAS_SENDFILE)
+
   // Cancelled read.
 
   bool read_cancel_completed = false;
@@ -378,6 +378,40 @@ void test()
     int i28 = socket1.async_receive_from(null_buffers(),
         endpoint, in_flags, lazy);
     (void)i28;
+
+#if defined(BOOST_ASIO_HAS_MMSG)
+    ip::udp::socket::send_slot send_slots[2] = {
+      ip::udp::socket::send_slot(buffer(const_char_buffer), endpoint),
+      ip::udp::socket::send_slot(buffer(const_char_buffer), endpoint) };
+    ip::udp::socket::receive_slot receive_slots[2] = {
+      ip::udp::socket::receive_slot(buffer(mutable_char_buffer)),
+      ip::udp::socket::receive_slot(buffer(mutable_char_buffer)) };
+
+    socket1.send_many(send_slots, 2);
+    socket1.send_many(send_slots, 2, in_flags, ec);
+
+    socket1.async_send_many(send_slots, 2, &send_handler);
+    socket1.async_send_many(send_slots, 2, in_flags, &send_handler);
+    int i29 = socket1.async_send_many(send_slots, 2, lazy);
+    (void)i29;
+    int i30 = socket1.async_send_many(send_slots, 2, in_flags, lazy);
+    (void)i30;
+
+    socket1.receive_many(receive_slots, 2);
+    socket1.receive_many(receive_slots, 2, in_flags, ec);
+
+    socket1.async_receive_many(receive_slots, 2, &receive_handler);
+    socket1.async_receive_many(receive_slots, 2, in_flags, &receive_handler);
+    int i31 = socket1.async_receive_many(receive_slots, 2, lazy);
+    (void)i31;
+    int i32 = socket1.async_receive_many(receive_slots, 2, in_flags, lazy);
+    (void)i32;
+
+    ip::udp::generic_receive_offload generic_receive_offload1(true);
+    socket1.set_option(generic_receive_offload1, ec);
+    ip::udp::generic_receive_offload generic_receive_offload2;
+    socket1.get_option(generic_receive_offload2, ec);
+#endif // defined(BOOST_ASIO_HAS_MMSG)
   }
   catch (std::exception&)
   {
@@ -453,6 +487,60 @@ void test()
   ios.run();
 
   BOOST_ASIO_CHECK(memcmp(send_msg, recv_msg, sizeof(send_msg)) == 0);
+
+#if defined(BOOST_ASIO_HAS_MMSG)
+  // Batched send and receive.
+
+  const size_t batch_size = 3;
+  char recv_msgs[batch_size][sizeof(send_msg)];
+  memset(recv_msgs, 0, sizeof(recv_msgs));
+
+  ip::udp::socket::send_slot send_slots[batch_size];
+  ip::udp::socket::receive_slot recv_slots[batch_size];
+  for (size_t i = 0; i < batch_size; ++i)
+  {
+    send_slots[i] = ip::udp::socket::send_slot(
+        buffer(send_msg, sizeof(send_msg) - i), target_endpoint);
+    recv_slots[i] = ip::udp::socket::receive_slot(
+        buffer(recv_msgs[i], sizeof(recv_msgs[i])));
+  }
+
+  size_t datagrams_sent = s1.send_many(send_slots, batch_size);
+  BOOST_ASIO_CHECK(datagrams_sent == batch_size);
+
+  size_t datagrams_recvd = 0;
+  while (datagrams_recvd < batch_size)
+  {
+    size_t n = s2.receive_many(recv_slots + datagrams_recvd,
+        batch_size - datagrams_recvd);
+    BOOST_ASIO_CHECK(n > 0);
+    datagrams_recvd += n;
+  }
+
+  for (size_t i = 0; i < batch_size; ++i)
+  {
+    BOOST_ASIO_CHECK(send_slots[i].bytes_transferred == sizeof(send_msg) - i);
+    BOOST_ASIO_CHECK(recv_slots[i].bytes_transferred == sizeof(send_msg) - i);
+    BOOST_ASIO_CHECK(recv_slots[i].endpoint.port()
+        == s1.local_endpoint().port());
+    BOOST_ASIO_CHECK(recv_slots[i].segment_size == 0);
+    BOOST_ASIO_CHECK(memcmp(send_msg, recv_msgs[i],
+          sizeof(send_msg) - i) == 0);
+  }
+
+  memset(recv_msgs, 0, sizeof(recv_msgs));
+
+  s2.async_receive_many(recv_slots, batch_size,
+      bindns::bind(handle_recv, 1, _1, _2));
+  s1.async_send_many(send_slots, 1,
+      bindns::bind(handle_send, 1, _1, _2));
+
+  ios.reset();
+  ios.run();
+
+  BOOST_ASIO_CHECK(recv_slots[0].bytes_transferred == sizeof(send_msg));
+  BOOST_ASIO_CHECK(memcmp(send_msg, recv_msgs[0], sizeof(send_msg)) == 0);
+#endif // defined(BOOST_ASIO_HAS_MMSG)
 }
 
 } // namespace ip_udp_socket_runtime
@@ -0,0 +1,126 @@
+//
+// post_throughput.cpp
+// ~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/asio/io_service.hpp>
+#include <boost/bind.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/thread.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "allocator.hpp"
+
+using boost::posix_time::ptime;
+using boost::posix_time::microsec_clock;
+
+// A chain of handlers, each of which posts the next until the chain's quota
+// of handlers has been run.
+class chain
+{
+public:
+  chain(boost::asio::io_service& io_service, std::size_t count)
+    : io_service_(io_service),
+      count_(count)
+  {
+  }
+
+  void start()
+  {
+    io_service_.post(ref(this));
+  }
+
+  void operator()()
+  {
+    if (--count_ > 0)
+      io_service_.post(ref(this));
+  }
+
+  friend void* asio_handler_allocate(std::size_t n, chain* c)
+  {
+    return c->allocator_.allocate(n);
+  }
+
+  friend void asio_handler_deallocate(void* p, std::size_t, chain* c)
+  {
+    c->allocator_.deallocate(p);
+  }
+
+  struct ref
+  {
+    explicit ref(chain* p)
+      : p_(p)
+    {
+    }
+
+    void operator()()
+    {
+      (*p_)();
+    }
+
+  private:
+    chain* p_;
+
+    friend void* asio_handler_allocate(std::size_t n, ref* r)
+    {
+      return asio_handler_allocate(n, r->p_);
+    }
+
+    friend void asio_handler_deallocate(void* p, std::size_t n, ref* r)
+    {
+      asio_handler_deallocate(p, n, r->p_);
+    }
+  };
+
+private:
+  boost::asio::io_service& io_service_;
+  std::size_t count_;
+  allocator allocator_;
+};
+
+int main(int argc, char* argv[])
+{
+  if (argc != 4)
+  {
+    std::fprintf(stderr,
+        "Usage: post_throughput <nthreads> <nchains> <nposts>\n");
+    return 1;
+  }
+
+  std::size_t num_threads = static_cast<std::size_t>(std::atoi(argv[1]));
+  std::size_t num_chains = static_cast<std::size_t>(std::atoi(argv[2]));
+  std::size_t num_posts = static_cast<std::size_t>(std::atoi(argv[3]));
+
+  boost::asio::io_service io_service(num_threads);
+  std::vector<boost::shared_ptr<chain> > chains;
+
+  for (std::size_t i = 0; i < num_chains; ++i)
+  {
+    boost::shared_ptr<chain> c(new chain(io_service, num_posts));
+    chains.push_back(c);
+    c->start();
+  }
+
+  ptime start = microsec_clock::universal_time();
+
+  boost::thread_group threads;
+  for (std::size_t i = 0; i < num_threads; ++i)
+    threads.create_thread(boost::bind(
+          static_cast<std::size_t (boost::asio::io_service::*)()>(
+            &boost::asio::io_service::run), &io_service));
+  threads.join_all();
+
+  ptime stop = microsec_clock::universal_time();
+
+  double seconds = (stop - start).total_microseconds() / 1000000.0;
+  double total = static_cast<double>(num_chains) * num_posts;
+  std::printf("%.0f handlers in %.3f s: %.0f handlers/s\n",
+      total, seconds, total / seconds);
+}
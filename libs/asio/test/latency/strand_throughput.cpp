@@ -0,0 +1,140 @@
+//
+// strand_throughput.cpp
+// ~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/strand.hpp>
+#include <boost/bind.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/thread.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "allocator.hpp"
+
+using boost::posix_time::ptime;
+using boost::posix_time::microsec_clock;
+
+// A strand together with a chain of handlers. Each handler posts the next
+// handler through the strand, along with an optional number of no-op handlers
+// that queue up behind it, until the quota of handlers has been run. All
+// handlers for a chain run on its strand, so the allocator needs no locking.
+class strand_chain
+{
+public:
+  strand_chain(boost::asio::io_service& io_service,
+      std::size_t count, std::size_t fanout)
+    : strand_(io_service),
+      count_(count),
+      fanout_(fanout)
+  {
+  }
+
+  void start()
+  {
+    strand_.post(ref(this));
+  }
+
+  void operator()()
+  {
+    for (std::size_t i = 0; i < fanout_ && count_ > 1; ++i, --count_)
+      strand_.post(ref(this, false));
+    if (--count_ > 0)
+      strand_.post(ref(this));
+  }
+
+  friend void* asio_handler_allocate(std::size_t n, strand_chain* c)
+  {
+    return c->allocator_.allocate(n);
+  }
+
+  friend void asio_handler_deallocate(void* p, std::size_t, strand_chain* c)
+  {
+    c->allocator_.deallocate(p);
+  }
+
+  struct ref
+  {
+    explicit ref(strand_chain* p, bool repost = true)
+      : p_(p),
+        repost_(repost)
+    {
+    }
+
+    void operator()()
+    {
+      if (repost_)
+        (*p_)();
+    }
+
+  private:
+    strand_chain* p_;
+    bool repost_;
+
+    friend void* asio_handler_allocate(std::size_t n, ref* r)
+    {
+      return asio_handler_allocate(n, r->p_);
+    }
+
+    friend void asio_handler_deallocate(void* p, std::size_t n, ref* r)
+    {
+      asio_handler_deallocate(p, n, r->p_);
+    }
+  };
+
+private:
+  boost::asio::io_service::strand strand_;
+  std::size_t count_;
+  std::size_t fanout_;
+  allocator allocator_;
+};
+
+int main(int argc, char* argv[])
+{
+  if (argc != 4 && argc != 5)
+  {
+    std::fprintf(stderr,
+        "Usage: strand_throughput <nthreads> <nstrands> <nposts> [<fanout>]\n");
+    return 1;
+  }
+
+  std::size_t num_threads = static_cast<std::size_t>(std::atoi(argv[1]));
+  std::size_t num_strands = static_cast<std::size_t>(std::atoi(argv[2]));
+  std::size_t num_posts = static_cast<std::size_t>(std::atoi(argv[3]));
+  std::size_t fanout = argc == 5
+    ? static_cast<std::size_t>(std::atoi(argv[4])) : 0;
+
+  boost::asio::io_service io_service(num_threads);
+  std::vector<boost::shared_ptr<strand_chain> > chains;
+
+  for (std::size_t i = 0; i < num_strands; ++i)
+  {
+    boost::shared_ptr<strand_chain> c(
+        new strand_chain(io_service, num_posts, fanout));
+    chains.push_back(c);
+    c->start();
+  }
+
+  ptime start = microsec_clock::universal_time();
+
+  boost::thread_group threads;
+  for (std::size_t i = 0; i < num_threads; ++i)
+    threads.create_thread(boost::bind(
+          static_cast<std::size_t (boost::asio::io_service::*)()>(
+            &boost::asio::io_service::run), &io_service));
+  threads.join_all();
+
+  ptime stop = microsec_clock::universal_time();
+
+  double seconds = (stop - start).total_microseconds() / 1000000.0;
+  double total = static_cast<double>(num_strands) * num_posts;
+  std::printf("%.0f handlers on %d strands in %.3f s: %.0f handlers/s\n",
+      total, static_cast<int>(num_strands), seconds, total / seconds);
+}
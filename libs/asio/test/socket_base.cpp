@@ -166,6 +166,17 @@ void test()
     (void)static_cast<bool>(!enable_connection_aborted1);
     (void)static_cast<bool>(enable_connection_aborted1.value());
 
+    // reactor_batching class.
+
+    socket_base::reactor_batching reactor_batching1(true);
+    sock.set_option(reactor_batching1);
+    socket_base::reactor_batching reactor_batching2;
+    sock.get_option(reactor_batching2);
+    reactor_batching1 = true;
+    (void)static_cast<bool>(reactor_batching1);
+    (void)static_cast<bool>(!reactor_batching1);
+    (void)static_cast<bool>(reactor_batching1.value());
+
     // non_blocking_io class.
 
     socket_base::non_blocking_io non_blocking_io(true);
@@ -625,6 +636,31 @@ void test()
   BOOST_ASIO_CHECK(!static_cast<bool>(enable_connection_aborted4));
   BOOST_ASIO_CHECK(!enable_connection_aborted4);
 
+  // reactor_batching class.
+
+  socket_base::reactor_batching reactor_batching1(true);
+  BOOST_ASIO_CHECK(reactor_batching1.value());
+  udp_sock.set_option(reactor_batching1, ec);
+  BOOST_ASIO_CHECK_MESSAGE(!ec, ec.value() << ", " << ec.message());
+
+  socket_base::reactor_batching reactor_batching2;
+  udp_sock.get_option(reactor_batching2, ec);
+  BOOST_ASIO_CHECK_MESSAGE(!ec, ec.value() << ", " << ec.message());
+#if defined(BOOST_ASIO_HAS_EPOLL)
+  BOOST_ASIO_CHECK(reactor_batching2.value());
+#else // defined(BOOST_ASIO_HAS_EPOLL)
+  BOOST_ASIO_CHECK(!reactor_batching2.value());
+#endif // defined(BOOST_ASIO_HAS_EPOLL)
+
+  socket_base::reactor_batching reactor_batching3(false);
+  udp_sock.set_option(reactor_batching3, ec);
+  BOOST_ASIO_CHECK_MESSAGE(!ec, ec.value() << ", " << ec.message());
+
+  socket_base::reactor_batching reactor_batching4;
+  udp_sock.get_option(reactor_batching4, ec);
+  BOOST_ASIO_CHECK_MESSAGE(!ec, ec.value() << ", " << ec.message());
+  BOOST_ASIO_CHECK(!reactor_batching4.value());
+
   // non_blocking_io class.
 
   socket_base::non_blocking_io non_blocking_io1(true);
@@ -210,8 +210,29 @@ void strand_test()
   BOOST_ASIO_CHECK(count == 0);
 }
 
+void strand_outlives_io_service_test()
+{
+  int count = 0;
+
+  // Check that strands may be destroyed after their io_service, both with and
+  // without handlers waiting on them.
+  io_service* ios = new io_service;
+  strand* s1 = new strand(*ios);
+  strand* s2 = new strand(*s1);
+  strand* s3 = new strand(*ios);
+  s1->post(bindns::bind(increment, &count));
+  s1->post(bindns::bind(increment, &count));
+  delete s2;
+  delete ios;
+  delete s1;
+  delete s3;
+
+  BOOST_ASIO_CHECK(count == 0);
+}
+
 BOOST_ASIO_TEST_SUITE
 (
   "strand",
   BOOST_ASIO_TEST_CASE(strand_test)
+  BOOST_ASIO_TEST_CASE(strand_outlives_io_service_test)
 )
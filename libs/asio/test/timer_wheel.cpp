@@ -0,0 +1,249 @@
+//
+// timer_wheel.cpp
+// ~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include <boost/asio/detail/timer_wheel.hpp>
+
+#include <cstddef>
+#include <vector>
+#include "unit_test.hpp"
+
+#if defined(BOOST_ASIO_HAS_BOOST_DATE_TIME)
+
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/detail/op_queue.hpp>
+#include <boost/asio/detail/wait_op.hpp>
+
+using namespace boost::asio::detail;
+namespace pt = boost::posix_time;
+
+// Time traits with a clock that only moves when told to.
+struct manual_time_traits
+{
+  typedef pt::ptime time_type;
+  typedef pt::time_duration duration_type;
+
+  static time_type current;
+
+  static time_type now()
+  {
+    return current;
+  }
+
+  static time_type add(const time_type& t, const duration_type& d)
+  {
+    return t + d;
+  }
+
+  static duration_type subtract(const time_type& t1, const time_type& t2)
+  {
+    return t1 - t2;
+  }
+
+  static bool less_than(const time_type& t1, const time_type& t2)
+  {
+    return t1 < t2;
+  }
+
+  static pt::time_duration to_posix_duration(const duration_type& d)
+  {
+    return d;
+  }
+};
+
+manual_time_traits::time_type manual_time_traits::current(
+    boost::gregorian::date(2013, 1, 1));
+
+typedef timer_wheel<manual_time_traits> wheel_type;
+
+// Get the time that is the given number of ticks of the wheel after start.
+pt::ptime at_tick(const pt::ptime& start, long long ticks)
+{
+  return start + pt::microseconds(ticks * BOOST_ASIO_TIMER_WHEEL_RESOLUTION);
+}
+
+class test_op
+  : public wait_op
+{
+public:
+  explicit test_op(int id)
+    : wait_op(&test_op::do_complete),
+      id_(id)
+  {
+  }
+
+  int id() const
+  {
+    return id_;
+  }
+
+private:
+  static void do_complete(io_service_impl*, operation*,
+      const boost::system::error_code&, std::size_t)
+  {
+  }
+
+  int id_;
+};
+
+// Move the clock to the given number of ticks after the start, and collect
+// the identifiers of the timers that expire.
+std::vector<int> advance_to(wheel_type& wheel,
+    const pt::ptime& start, long long ticks)
+{
+  manual_time_traits::current = at_tick(start, ticks);
+
+  op_queue<operation> ops;
+  wheel.get_ready_timers(ops);
+
+  std::vector<int> ids;
+  while (operation* op = ops.front())
+  {
+    ops.pop();
+    ids.push_back(static_cast<test_op*>(op)->id());
+  }
+  return ids;
+}
+
+void cascade_test()
+{
+  const pt::ptime start = manual_time_traits::now();
+  wheel_type wheel;
+
+  // Expiry times in ticks, covering each level of the wheel and the boundaries
+  // between them. Each level has 256 slots, so level 1 starts at 256 ticks,
+  // level 2 at 65536 ticks and level 3 at 16777216 ticks.
+  const long long expiry[] =
+  {
+    5, 255, 256, 257, 300, 1000, 65535, 65536, 65537,
+    70000, 200000, 16777215, 16777216, 16777300, 20000000
+  };
+  const std::size_t num_timers = sizeof(expiry) / sizeof(expiry[0]);
+
+  // Enqueue the timers in reverse order, so that the order in which they are
+  // dequeued is not simply the order in which they were added.
+  std::vector<wheel_type::per_timer_data> timers(num_timers);
+  std::vector<test_op*> ops;
+  for (std::size_t i = num_timers; i > 0; --i)
+  {
+    test_op* op = new test_op(static_cast<int>(i - 1));
+    ops.push_back(op);
+    wheel.enqueue_timer(at_tick(start, expiry[i - 1]), timers[i - 1], op);
+  }
+  BOOST_ASIO_CHECK(!wheel.empty());
+
+  for (std::size_t i = 0; i < num_timers; ++i)
+  {
+    // A timer must not fire before its expiry time, even after being moved
+    // down from a higher level.
+    std::vector<int> ids = advance_to(wheel, start, expiry[i] - 1);
+    BOOST_ASIO_CHECK(ids.empty());
+
+    ids = advance_to(wheel, start, expiry[i]);
+    BOOST_ASIO_CHECK(ids.size() == 1 && ids[0] == static_cast<int>(i));
+  }
+  BOOST_ASIO_CHECK(wheel.empty());
+
+  for (std::size_t i = 0; i < ops.size(); ++i)
+    delete ops[i];
+}
+
+void cascade_batch_test()
+{
+  const pt::ptime start = manual_time_traits::now();
+  wheel_type wheel;
+
+  const long long expiry[] = { 70000, 3, 300, 65536, 256, 20000000, 1000 };
+  const std::size_t num_timers = sizeof(expiry) / sizeof(expiry[0]);
+
+  std::vector<wheel_type::per_timer_data> timers(num_timers);
+  std::vector<test_op*> ops;
+  for (std::size_t i = 0; i < num_timers; ++i)
+  {
+    test_op* op = new test_op(static_cast<int>(expiry[i]));
+    ops.push_back(op);
+    wheel.enqueue_timer(at_tick(start, expiry[i]), timers[i], op);
+  }
+
+  // A single jump past all of the expiry times must still dequeue the timers
+  // in the order in which they expire.
+  std::vector<int> ids = advance_to(wheel, start, 30000000);
+  BOOST_ASIO_CHECK(ids.size() == num_timers);
+  for (std::size_t i = 1; i < ids.size(); ++i)
+    BOOST_ASIO_CHECK(ids[i - 1] < ids[i]);
+  BOOST_ASIO_CHECK(wheel.empty());
+
+  for (std::size_t i = 0; i < ops.size(); ++i)
+    delete ops[i];
+}
+
+void beyond_horizon_test()
+{
+  const pt::ptime start = manual_time_traits::now();
+  wheel_type wheel;
+
+  // The wheel covers 256^4 ticks. Timers further away are parked in the last
+  // slot of the highest level and reinserted when it is cascaded.
+  const long long range = 4294967296LL;
+  const long long expiry[] = { 10, range - 1, range + 1000, 2 * range + 5 };
+  const std::size_t num_timers = sizeof(expiry) / sizeof(expiry[0]);
+
+  std::vector<wheel_type::per_timer_data> timers(num_timers);
+  std::vector<test_op*> ops;
+  for (std::size_t i = 0; i < num_timers; ++i)
+  {
+    test_op* op = new test_op(static_cast<int>(i));
+    ops.push_back(op);
+    wheel.enqueue_timer(at_tick(start, expiry[i]), timers[i], op);
+  }
+
+  for (std::size_t i = 0; i < num_timers; ++i)
+  {
+    std::vector<int> ids = advance_to(wheel, start, expiry[i] - 1);
+    BOOST_ASIO_CHECK(ids.empty());
+
+    ids = advance_to(wheel, start, expiry[i]);
+    BOOST_ASIO_CHECK(ids.size() == 1 && ids[0] == static_cast<int>(i));
+  }
+  BOOST_ASIO_CHECK(wheel.empty());
+
+  for (std::size_t i = 0; i < ops.size(); ++i)
+    delete ops[i];
+}
+
+#else // defined(BOOST_ASIO_HAS_BOOST_DATE_TIME)
+
+void cascade_test()
+{
+}
+
+void cascade_batch_test()
+{
+}
+
+void beyond_horizon_test()
+{
+}
+
+#endif // defined(BOOST_ASIO_HAS_BOOST_DATE_TIME)
+
+BOOST_ASIO_TEST_SUITE
+(
+  "timer_wheel",
+  BOOST_ASIO_TEST_CASE(cascade_test)
+  BOOST_ASIO_TEST_CASE(cascade_batch_test)
+  BOOST_ASIO_TEST_CASE(beyond_horizon_test)
+)
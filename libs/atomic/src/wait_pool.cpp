@@ -0,0 +1,126 @@
+#include <boost/config.hpp>
+#include <boost/atomic.hpp>
+#include <boost/static_assert.hpp>
+
+#if defined(__linux__)
+#include <climits>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#elif defined(BOOST_WINDOWS)
+#include <windows.h>
+#else
+#include <sched.h>
+#endif
+
+//  Distributed under the Boost Software License, Version 1.0.
+//  See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+namespace boost {
+namespace atomics {
+namespace detail {
+
+namespace {
+
+#define BOOST_ATOMIC_CACHE_LINE_SIZE 64
+
+struct BOOST_ALIGNMENT(BOOST_ATOMIC_CACHE_LINE_SIZE) wait_state
+{
+    // Changed by every notification that finds a waiter; the futex word on Linux
+    atomic<unsigned int> seq;
+    // The number of threads in wait_pool::wait
+    atomic<unsigned int> waiters;
+};
+
+static wait_state wait_pool_[41];
+
+inline wait_state& get_state_for(const volatile void* addr)
+{
+    std::size_t index = reinterpret_cast<std::size_t>(addr) % (sizeof(wait_pool_) / sizeof(*wait_pool_));
+    return wait_pool_[index];
+}
+
+#if defined(__linux__)
+
+BOOST_STATIC_ASSERT(sizeof(atomic<unsigned int>) == sizeof(unsigned int));
+
+// Blocks until seq no longer contains old_seq. May return spuriously.
+inline void block(atomic<unsigned int>& seq, unsigned int old_seq)
+{
+    ::syscall(SYS_futex, reinterpret_cast<unsigned int*>(&seq), FUTEX_WAIT_PRIVATE, old_seq, NULL, NULL, 0);
+}
+
+inline void wake_all(atomic<unsigned int>& seq)
+{
+    ::syscall(SYS_futex, reinterpret_cast<unsigned int*>(&seq), FUTEX_WAKE_PRIVATE, INT_MAX, NULL, NULL, 0);
+}
+
+#else
+
+// Without a native primitive the waiters poll the sequence number, yielding after a few iterations
+inline void block(atomic<unsigned int>& seq, unsigned int old_seq)
+{
+    for (unsigned int i = 0; seq.load(memory_order_acquire) == old_seq; ++i)
+    {
+        if (i < 16)
+        {
+#if defined(BOOST_ATOMIC_X86_PAUSE)
+            BOOST_ATOMIC_X86_PAUSE();
+#endif
+        }
+        else
+        {
+#if defined(BOOST_WINDOWS)
+            ::Sleep(0);
+#else
+            ::sched_yield();
+#endif
+        }
+    }
+}
+
+inline void wake_all(atomic<unsigned int>&)
+{
+}
+
+#endif
+
+} // namespace
+
+
+BOOST_ATOMIC_DECL void wait_pool::wait(const volatile void* obj, changed_predicate changed, const void* old_value, memory_order order) BOOST_NOEXCEPT
+{
+    wait_state& state = get_state_for(obj);
+
+    // Pairs with the fence in notify: either the notifier sees this waiter, or this thread sees the new value
+    state.waiters.fetch_add(1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+
+    for (;;)
+    {
+        unsigned int const seq = state.seq.load(memory_order_acquire);
+        if (changed(obj, old_value, order))
+            break;
+        block(state.seq, seq);
+    }
+
+    state.waiters.fetch_sub(1, memory_order_relaxed);
+}
+
+BOOST_ATOMIC_DECL void wait_pool::notify(const volatile void* obj) BOOST_NOEXCEPT
+{
+    wait_state& state = get_state_for(obj);
+
+    // Without waiters a notification doesn't write to the shared state
+    atomic_thread_fence(memory_order_seq_cst);
+    if (state.waiters.load(memory_order_relaxed) != 0)
+    {
+        state.seq.fetch_add(1, memory_order_release);
+        wake_all(state.seq);
+    }
+}
+
+}
+}
+}
@@ -34,10 +34,18 @@ verify_lock_free(const char * type_name, int lock_free_macro_val, int lock_free_
         BOOST_CHECK(!value.is_lock_free());
     if (lock_free_macro_val == 2)
         BOOST_CHECK(value.is_lock_free());
+    BOOST_CHECK(boost::atomic<T>::is_always_lock_free == (lock_free_macro_val == 2));
 
     std::cout << "atomic<" << type_name << "> is " << lock_free_level[lock_free_macro_val] << " lock free\n";
 }
 
+// A pointer and a counter, as used by lock-free structures with a double-width compare-and-swap
+struct double_word
+{
+    void * ptr;
+    boost::uint64_t tag;
+};
+
 #if defined(__GNUC__) && defined(__i386__)
 
 #define EXPECT_CHAR_LOCK_FREE 2
@@ -186,6 +194,7 @@ int test_main(int, char *[])
 #ifdef BOOST_HAS_INT128
     verify_lock_free<boost::int128_type>("int128", BOOST_ATOMIC_INT128_LOCK_FREE, EXPECT_INT128_LOCK_FREE);
 #endif
+    verify_lock_free<double_word>("double_word", BOOST_ATOMIC_INT128_LOCK_FREE, EXPECT_INT128_LOCK_FREE);
     verify_lock_free<void *>("void *", BOOST_ATOMIC_POINTER_LOCK_FREE, EXPECT_SHORT_LOCK_FREE);
     verify_lock_free<bool>("bool", BOOST_ATOMIC_BOOL_LOCK_FREE, EXPECT_BOOL_LOCK_FREE);
 
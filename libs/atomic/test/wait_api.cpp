@@ -0,0 +1,148 @@
+//  Distributed under the Boost Software License, Version 1.0.
+//  See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+// Verify that wait() returns immediately when the value differs, and that
+// notify_one()/notify_all() wake up threads blocked in wait() on objects
+// of various sizes, including objects sharing a wait state.
+
+#include <boost/atomic.hpp>
+#include <boost/bind.hpp>
+#include <boost/ref.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/test/minimal.hpp>
+
+struct pair32
+{
+    boost::uint32_t a, b;
+};
+
+struct quad64
+{
+    boost::uint64_t a, b;
+};
+
+template<typename T>
+void
+wait_until_changed(boost::atomic<T> & value, T old_value, boost::atomic<int> & done)
+{
+    while (value.load(boost::memory_order_acquire) == old_value)
+        value.wait(old_value, boost::memory_order_acquire);
+    ++done;
+}
+
+template<typename T>
+void
+test_integral_wait(void)
+{
+    boost::atomic<T> value(T(0));
+
+    // returns immediately
+    value.wait(T(1));
+
+    boost::atomic<int> done(0);
+    boost::thread_group waiters;
+    for (int i = 0; i < 3; ++i)
+        waiters.create_thread(boost::bind(&wait_until_changed<T>, boost::ref(value), T(0), boost::ref(done)));
+
+    boost::this_thread::sleep_for(boost::chrono::milliseconds(50));
+    BOOST_CHECK(done.load() == 0);
+
+    value.store(T(1));
+    value.notify_all();
+    waiters.join_all();
+    BOOST_CHECK(done.load() == 3);
+}
+
+template<typename T>
+void
+wait_for_change(boost::atomic<T> & value, T old_value)
+{
+    value.wait(old_value);
+}
+
+template<typename T>
+void
+test_struct_wait(T const& initial, T const& changed)
+{
+    boost::atomic<T> value(initial);
+
+    // returns immediately
+    value.wait(changed);
+
+    boost::thread waiter(boost::bind(&wait_for_change<T>, boost::ref(value), initial));
+    boost::this_thread::sleep_for(boost::chrono::milliseconds(50));
+
+    value.store(changed);
+    value.notify_one();
+    waiter.join();
+}
+
+void
+ping_pong(boost::atomic<int> & turn, int me, int rounds)
+{
+    for (int i = 0; i < rounds; ++i)
+    {
+        int current;
+        while ((current = turn.load(boost::memory_order_acquire)) != me)
+            turn.wait(current, boost::memory_order_acquire);
+        turn.store(1 - me, boost::memory_order_release);
+        turn.notify_one();
+    }
+}
+
+void
+test_ping_pong(void)
+{
+    boost::atomic<int> turn(0);
+    boost::thread t0(boost::bind(&ping_pong, boost::ref(turn), 0, 10000));
+    boost::thread t1(boost::bind(&ping_pong, boost::ref(turn), 1, 10000));
+    t0.join();
+    t1.join();
+    BOOST_CHECK(turn.load() == 0);
+}
+
+// objects whose addresses map to the same wait state: a notification on one of them must not be lost
+// when it wakes up a waiter on the other
+void
+test_shared_wait_state(void)
+{
+    boost::atomic<int> values[42];
+    boost::atomic<int> & first = values[0];
+    boost::atomic<int> & second = values[41];
+    first.store(0);
+    second.store(0);
+
+    boost::atomic<int> done(0);
+    boost::thread t0(boost::bind(&wait_until_changed<int>, boost::ref(first), 0, boost::ref(done)));
+    boost::thread t1(boost::bind(&wait_until_changed<int>, boost::ref(second), 0, boost::ref(done)));
+    boost::this_thread::sleep_for(boost::chrono::milliseconds(50));
+
+    first.store(1);
+    first.notify_one();
+    t0.join();
+    BOOST_CHECK(done.load() == 1);
+
+    second.store(1);
+    second.notify_one();
+    t1.join();
+    BOOST_CHECK(done.load() == 2);
+}
+
+int test_main(int, char *[])
+{
+    test_integral_wait<char>();
+    test_integral_wait<short>();
+    test_integral_wait<int>();
+    test_integral_wait<boost::uint64_t>();
+
+    pair32 p0 = { 0, 0 }, p1 = { 0, 1 };
+    test_struct_wait(p0, p1);
+    quad64 q0 = { 0, 0 }, q1 = { 1, 0 };
+    test_struct_wait(q0, q1);
+
+    test_ping_pong();
+    test_shared_wait_state();
+
+    return 0;
+}
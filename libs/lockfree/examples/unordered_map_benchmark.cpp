@@ -0,0 +1,126 @@
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  compares the throughput of boost::lockfree::unordered_map with a boost::unordered_map, that is protected by a
+//  boost::shared_mutex, for a read-mostly workload.
+//
+//  usage: unordered_map_benchmark [max threads] [percentage of writes] [operations per thread]
+
+#include <boost/lockfree/unordered_map.hpp>
+#include <boost/unordered_map.hpp>
+#include <boost/atomic.hpp>
+#include <boost/bind.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/shared_mutex.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/barrier.hpp>
+#include <boost/chrono.hpp>
+#include <cstdlib>
+#include <iostream>
+
+const int key_count = 100000;
+
+boost::atomic<long> hits(0);
+
+class locked_map
+{
+public:
+    bool insert(int key, int value)
+    {
+        boost::unique_lock<boost::shared_mutex> lock(mutex_);
+        return map_.insert(std::make_pair(key, value)).second;
+    }
+
+    bool erase(int key)
+    {
+        boost::unique_lock<boost::shared_mutex> lock(mutex_);
+        return map_.erase(key) != 0;
+    }
+
+    bool find(int key, int & ret)
+    {
+        boost::shared_lock<boost::shared_mutex> lock(mutex_);
+        boost::unordered_map<int, int>::const_iterator it = map_.find(key);
+        if (it == map_.end())
+            return false;
+        ret = it->second;
+        return true;
+    }
+
+private:
+    boost::shared_mutex mutex_;
+    boost::unordered_map<int, int> map_;
+};
+
+typedef boost::lockfree::unordered_map<int, int> lockfree_map;
+
+template <typename Map>
+void worker(Map & map, boost::barrier & start, int id, int write_percentage, int operations)
+{
+    /* linear congruential generator, to avoid contention on a shared random number generator */
+    unsigned int state = 2654435761u * (id + 1);
+    int found = 0;
+
+    start.wait();
+    for (int i = 0; i != operations; ++i) {
+        state = state * 1664525u + 1013904223u;
+        const int key = (state >> 8) % key_count;
+        const int dice = (state >> 4) % 100;
+
+        if (dice < write_percentage / 2)
+            map.insert(key, i);
+        else if (dice < write_percentage)
+            map.erase(key);
+        else {
+            int value;
+            found += map.find(key, value);
+        }
+    }
+
+    hits += found;
+}
+
+template <typename Map>
+double run(int threads, int write_percentage, int operations)
+{
+    Map map;
+    for (int key = 0; key < key_count; key += 2)
+        map.insert(key, key);
+
+    boost::barrier start(threads + 1);
+    boost::thread_group workers;
+    for (int i = 0; i != threads; ++i)
+        workers.create_thread(boost::bind(&worker<Map>, boost::ref(map), boost::ref(start), i,
+                                          write_percentage, operations));
+
+    boost::chrono::steady_clock::time_point begin = boost::chrono::steady_clock::now();
+    start.wait();
+    workers.join_all();
+    boost::chrono::duration<double> elapsed = boost::chrono::steady_clock::now() - begin;
+
+    return threads * double(operations) / elapsed.count();
+}
+
+int main(int argc, char* argv[])
+{
+    using namespace std;
+
+    const int max_threads = argc > 1 ? atoi(argv[1]) : int(boost::thread::hardware_concurrency());
+    const int write_percentage = argc > 2 ? atoi(argv[2]) : 5;
+    const int operations = argc > 3 ? atoi(argv[3]) : 1000000;
+
+    cout << "boost::lockfree::unordered_map is ";
+    if (!lockfree_map().is_lock_free())
+        cout << "not ";
+    cout << "lockfree" << endl;
+
+    cout << write_percentage << "% writes, " << operations << " operations per thread" << endl;
+    cout << "threads\tshared_mutex (ops/s)\tlockfree (ops/s)" << endl;
+
+    for (int threads = 1; threads <= max_threads; threads *= 2) {
+        double locked = run<locked_map>(threads, write_percentage, operations);
+        double lockfree = run<lockfree_map>(threads, write_percentage, operations);
+        cout << threads << "\t" << locked << "\t\t" << lockfree << endl;
+    }
+}
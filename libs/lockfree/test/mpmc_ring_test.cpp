@@ -0,0 +1,316 @@
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/lockfree/mpmc_ring.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread.hpp>
+
+#define BOOST_TEST_MAIN
+#ifdef BOOST_LOCKFREE_INCLUDE_TESTS
+#include <boost/test/included/unit_test.hpp>
+#else
+#include <boost/test/unit_test.hpp>
+#endif
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "test_helpers.hpp"
+
+using namespace boost;
+using namespace boost::lockfree;
+using namespace std;
+
+BOOST_AUTO_TEST_CASE( simple_mpmc_ring_test )
+{
+    mpmc_ring<int> f(64);
+
+    BOOST_WARN(f.is_lock_free());
+    BOOST_REQUIRE_EQUAL(f.capacity(), 64u);
+
+    BOOST_REQUIRE(f.empty());
+    f.push(1);
+    f.push(2);
+
+    int i1(0), i2(0);
+
+    BOOST_REQUIRE(f.pop(i1));
+    BOOST_REQUIRE_EQUAL(i1, 1);
+
+    BOOST_REQUIRE(f.pop(i2));
+    BOOST_REQUIRE_EQUAL(i2, 2);
+    BOOST_REQUIRE(f.empty());
+}
+
+BOOST_AUTO_TEST_CASE( simple_mpmc_ring_test_capacity )
+{
+    mpmc_ring<int, capacity<64> > f;
+
+    BOOST_WARN(f.is_lock_free());
+    BOOST_REQUIRE_EQUAL(f.capacity(), 64u);
+
+    BOOST_REQUIRE(f.empty());
+    f.push(1);
+    f.push(2);
+
+    int i1(0), i2(0);
+
+    BOOST_REQUIRE(f.pop(i1));
+    BOOST_REQUIRE_EQUAL(i1, 1);
+
+    BOOST_REQUIRE(f.pop(i2));
+    BOOST_REQUIRE_EQUAL(i2, 2);
+    BOOST_REQUIRE(f.empty());
+}
+
+BOOST_AUTO_TEST_CASE( mpmc_ring_capacity_rounding_test )
+{
+    mpmc_ring<int> f(100);
+    BOOST_REQUIRE_EQUAL(f.capacity(), 128u);
+
+    mpmc_ring<int, capacity<3> > g;
+    BOOST_REQUIRE_EQUAL(g.capacity(), 4u);
+
+    mpmc_ring<int> h(1);
+    BOOST_REQUIRE_EQUAL(h.capacity(), 2u);
+}
+
+BOOST_AUTO_TEST_CASE( mpmc_ring_full_test )
+{
+    mpmc_ring<int, capacity<4> > f;
+
+    for (int i = 0; i != 4; ++i)
+        BOOST_REQUIRE(f.push(i));
+    BOOST_REQUIRE(!f.push(4));
+    BOOST_REQUIRE(!f.bounded_push(4));
+
+    /* wrap around the ring several times */
+    for (int i = 4; i != 100; ++i) {
+        int out;
+        BOOST_REQUIRE(f.pop(out));
+        BOOST_REQUIRE_EQUAL(out, i - 4);
+        BOOST_REQUIRE(f.push(i));
+        BOOST_REQUIRE(!f.push(i));
+    }
+
+    int out;
+    for (int i = 96; i != 100; ++i) {
+        BOOST_REQUIRE(f.pop(out));
+        BOOST_REQUIRE_EQUAL(out, i);
+    }
+    BOOST_REQUIRE(!f.pop(out));
+    BOOST_REQUIRE(f.empty());
+}
+
+BOOST_AUTO_TEST_CASE( unsafe_mpmc_ring_test )
+{
+    mpmc_ring<int> f(2);
+
+    BOOST_WARN(f.is_lock_free());
+    BOOST_REQUIRE(f.empty());
+
+    int i1(0), i2(0);
+
+    BOOST_REQUIRE(f.unsynchronized_push(1));
+    BOOST_REQUIRE(f.unsynchronized_push(2));
+    BOOST_REQUIRE(!f.unsynchronized_push(3));
+
+    BOOST_REQUIRE(f.unsynchronized_pop(i1));
+    BOOST_REQUIRE_EQUAL(i1, 1);
+
+    BOOST_REQUIRE(f.unsynchronized_pop(i2));
+    BOOST_REQUIRE_EQUAL(i2, 2);
+    BOOST_REQUIRE(!f.unsynchronized_pop(i2));
+    BOOST_REQUIRE(f.empty());
+}
+
+BOOST_AUTO_TEST_CASE( mpmc_ring_consume_one_test )
+{
+    mpmc_ring<int> f(64);
+
+    BOOST_WARN(f.is_lock_free());
+    BOOST_REQUIRE(f.empty());
+
+    f.push(1);
+    f.push(2);
+
+#ifdef BOOST_NO_CXX11_LAMBDAS
+    bool success1 = f.consume_one(test_equal(1));
+    bool success2 = f.consume_one(test_equal(2));
+#else
+    bool success1 = f.consume_one([] (int i) {
+        BOOST_REQUIRE_EQUAL(i, 1);
+    });
+
+    bool success2 = f.consume_one([] (int i) {
+        BOOST_REQUIRE_EQUAL(i, 2);
+    });
+#endif
+
+    BOOST_REQUIRE(success1);
+    BOOST_REQUIRE(success2);
+
+    BOOST_REQUIRE(f.empty());
+}
+
+BOOST_AUTO_TEST_CASE( mpmc_ring_consume_all_test )
+{
+    mpmc_ring<int> f(64);
+
+    BOOST_WARN(f.is_lock_free());
+    BOOST_REQUIRE(f.empty());
+
+    f.push(1);
+    f.push(2);
+
+#ifdef BOOST_NO_CXX11_LAMBDAS
+    size_t consumed = f.consume_all(dummy_functor());
+#else
+    size_t consumed = f.consume_all([] (int i) {
+    });
+#endif
+
+    BOOST_REQUIRE_EQUAL(consumed, 2u);
+
+    BOOST_REQUIRE(f.empty());
+}
+
+BOOST_AUTO_TEST_CASE( mpmc_ring_convert_pop_test )
+{
+    mpmc_ring<int*> f(128);
+    BOOST_REQUIRE(f.empty());
+    f.push(new int(1));
+    f.push(new int(2));
+
+    {
+        int * i1;
+
+        BOOST_REQUIRE(f.pop(i1));
+        BOOST_REQUIRE_EQUAL(*i1, 1);
+        delete i1;
+    }
+
+    {
+        boost::shared_ptr<int> i2;
+        BOOST_REQUIRE(f.pop(i2));
+        BOOST_REQUIRE_EQUAL(*i2, 2);
+    }
+
+    BOOST_REQUIRE(f.empty());
+}
+
+BOOST_AUTO_TEST_CASE( mpmc_ring_non_trivial_test )
+{
+    /* elements are constructed on push and destroyed on pop or destruction */
+    boost::shared_ptr<int> p(new int(1));
+    {
+        mpmc_ring<boost::shared_ptr<int> > f(8);
+        f.push(p);
+        f.push(p);
+        f.push(p);
+        BOOST_REQUIRE_EQUAL(p.use_count(), 4);
+
+        boost::shared_ptr<int> out;
+        BOOST_REQUIRE(f.pop(out));
+        out.reset();
+        BOOST_REQUIRE_EQUAL(p.use_count(), 3);
+
+        mpmc_ring<std::string> s(4);
+        s.push("a string that is too long for the small string buffer");
+    }
+    BOOST_REQUIRE_EQUAL(p.use_count(), 1);
+}
+
+namespace {
+
+struct throwing_element
+{
+    enum { no_throw, throw_on_copy, throw_on_assign };
+
+    static int instances;
+
+    int value;
+    int throws;
+
+    explicit throwing_element(int v = 0, int t = no_throw):
+        value(v), throws(t)
+    {
+        ++instances;
+    }
+
+    throwing_element(throwing_element const & rhs):
+        value(rhs.value), throws(rhs.throws)
+    {
+        if (rhs.throws == throw_on_copy)
+            throw std::runtime_error("copy");
+        ++instances;
+    }
+
+    throwing_element & operator=(throwing_element const & rhs)
+    {
+        if (rhs.throws == throw_on_assign)
+            throw std::runtime_error("assign");
+        value = rhs.value;
+        throws = rhs.throws;
+        return *this;
+    }
+
+    ~throwing_element(void)
+    {
+        --instances;
+    }
+};
+
+int throwing_element::instances = 0;
+
+}
+
+BOOST_AUTO_TEST_CASE( mpmc_ring_exception_test )
+{
+    {
+        mpmc_ring<throwing_element> f(4);
+        throwing_element out;
+
+        /* a failed push leaves the ring usable, and its position is skipped */
+        BOOST_REQUIRE(f.push(throwing_element(1)));
+        BOOST_REQUIRE_THROW(f.push(throwing_element(2, throwing_element::throw_on_copy)), std::runtime_error);
+        BOOST_REQUIRE(f.push(throwing_element(3)));
+
+        BOOST_REQUIRE(f.pop(out));
+        BOOST_REQUIRE_EQUAL(out.value, 1);
+        BOOST_REQUIRE(f.pop(out));
+        BOOST_REQUIRE_EQUAL(out.value, 3);
+        BOOST_REQUIRE(!f.pop(out));
+        BOOST_REQUIRE(f.empty());
+
+        /* a failed pop destroys the element and releases its slot */
+        BOOST_REQUIRE(f.push(throwing_element(4, throwing_element::throw_on_assign)));
+        BOOST_REQUIRE(f.push(throwing_element(5)));
+        BOOST_REQUIRE_THROW(f.pop(out), std::runtime_error);
+        BOOST_REQUIRE(f.pop(out));
+        BOOST_REQUIRE_EQUAL(out.value, 5);
+        BOOST_REQUIRE_EQUAL(throwing_element::instances, 1);
+
+        /* the same holds for the unsynchronized operations */
+        BOOST_REQUIRE_THROW(f.push(throwing_element(6, throwing_element::throw_on_copy)), std::runtime_error);
+        BOOST_REQUIRE(f.unsynchronized_push(throwing_element(7, throwing_element::throw_on_assign)));
+        BOOST_REQUIRE(f.unsynchronized_push(throwing_element(8)));
+        BOOST_REQUIRE_THROW(f.unsynchronized_pop(out), std::runtime_error);
+        BOOST_REQUIRE(f.unsynchronized_pop(out));
+        BOOST_REQUIRE_EQUAL(out.value, 8);
+
+        /* the ring keeps working over further laps */
+        for (int i = 0; i != 10; ++i) {
+            BOOST_REQUIRE(f.push(throwing_element(i)));
+            BOOST_REQUIRE(f.pop(out));
+            BOOST_REQUIRE_EQUAL(out.value, i);
+        }
+
+        /* a pending failed push is not destroyed with the ring */
+        BOOST_REQUIRE_THROW(f.push(throwing_element(9, throwing_element::throw_on_copy)), std::runtime_error);
+        BOOST_REQUIRE(f.push(throwing_element(10)));
+    }
+    BOOST_REQUIRE_EQUAL(throwing_element::instances, 0);
+}
@@ -0,0 +1,109 @@
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/lockfree/mpsc_queue.hpp>
+#include <boost/lockfree/blocking_queue.hpp>
+#include <boost/lockfree/mpmc_ring.hpp>
+#include <boost/thread.hpp>
+
+#define BOOST_TEST_MAIN
+#ifdef BOOST_LOCKFREE_INCLUDE_TESTS
+#include <boost/test/included/unit_test.hpp>
+#else
+#include <boost/test/unit_test.hpp>
+#endif
+
+#include <vector>
+
+namespace {
+
+static const int producer_count = 4;
+static const int nodes_per_thread = 100000;
+
+/* each producer pushes an increasing sequence tagged with its id, the consumer checks that every sequence arrives
+ * complete and in order */
+template <typename Queue>
+struct mpsc_tester
+{
+    Queue & q;
+
+    explicit mpsc_tester(Queue & q):
+        q(q)
+    {}
+
+    void produce(int id)
+    {
+        for (int i = 0; i != nodes_per_thread; ++i)
+            while (!q.push(id * nodes_per_thread + i))
+                ;
+    }
+
+    template <typename Pop>
+    void run(Pop pop)
+    {
+        boost::thread_group producers;
+        for (int i = 0; i != producer_count; ++i)
+            producers.create_thread(boost::bind(&mpsc_tester::produce, this, i));
+
+        std::vector<int> next(producer_count, 0);
+        for (int received = 0; received != producer_count * nodes_per_thread; ++received) {
+            int value = pop(q);
+            int id = value / nodes_per_thread;
+            BOOST_REQUIRE_EQUAL(value % nodes_per_thread, next[id]);
+            ++next[id];
+        }
+
+        producers.join_all();
+        BOOST_REQUIRE(q.empty());
+    }
+};
+
+struct spin_pop
+{
+    template <typename Queue>
+    int operator()(Queue & q) const
+    {
+        int value;
+        while (!q.pop(value))
+            ;
+        return value;
+    }
+};
+
+struct blocking_pop
+{
+    template <typename Queue>
+    int operator()(Queue & q) const
+    {
+        int value;
+        q.wait_pop(value);
+        return value;
+    }
+};
+
+}
+
+BOOST_AUTO_TEST_CASE( mpsc_queue_stress_test )
+{
+    typedef boost::lockfree::mpsc_queue<int> queue_type;
+    queue_type q;
+    mpsc_tester<queue_type> tester(q);
+    tester.run(spin_pop());
+}
+
+BOOST_AUTO_TEST_CASE( blocking_mpsc_queue_stress_test )
+{
+    typedef boost::lockfree::blocking_queue<boost::lockfree::mpsc_queue<int> > queue_type;
+    queue_type q;
+    mpsc_tester<queue_type> tester(q);
+    tester.run(blocking_pop());
+}
+
+BOOST_AUTO_TEST_CASE( blocking_mpmc_ring_stress_test )
+{
+    typedef boost::lockfree::blocking_queue<boost::lockfree::mpmc_ring<int, boost::lockfree::capacity<64> > > queue_type;
+    queue_type q;
+    mpsc_tester<queue_type> tester(q);
+    tester.run(blocking_pop());
+}
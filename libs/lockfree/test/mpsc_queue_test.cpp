@@ -0,0 +1,191 @@
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/lockfree/mpsc_queue.hpp>
+#include <boost/lockfree/blocking_queue.hpp>
+
+#define BOOST_TEST_MAIN
+#ifdef BOOST_LOCKFREE_INCLUDE_TESTS
+#include <boost/test/included/unit_test.hpp>
+#else
+#include <boost/test/unit_test.hpp>
+#endif
+
+#include <memory>
+
+#include "test_helpers.hpp"
+
+using namespace boost;
+using namespace boost::lockfree;
+using namespace std;
+
+BOOST_AUTO_TEST_CASE( simple_mpsc_queue_test )
+{
+    mpsc_queue<int> f;
+
+    BOOST_REQUIRE(f.empty());
+    f.push(1);
+    f.push(2);
+    BOOST_REQUIRE(!f.empty());
+
+    int i1(0), i2(0);
+
+    BOOST_REQUIRE(f.pop(i1));
+    BOOST_REQUIRE_EQUAL(i1, 1);
+
+    BOOST_REQUIRE(f.pop(i2));
+    BOOST_REQUIRE_EQUAL(i2, 2);
+    BOOST_REQUIRE(f.empty());
+    BOOST_REQUIRE(!f.pop(i1));
+
+    f.push(3);
+    BOOST_REQUIRE(f.pop(i1));
+    BOOST_REQUIRE_EQUAL(i1, 3);
+    BOOST_REQUIRE(f.empty());
+}
+
+BOOST_AUTO_TEST_CASE( mpsc_queue_allocator_test )
+{
+    mpsc_queue<int, boost::lockfree::allocator<std::allocator<int> > > f;
+
+    for (int i = 0; i != 100; ++i)
+        f.push(i);
+
+    /* the destructor frees the remaining nodes */
+    int out;
+    BOOST_REQUIRE(f.pop(out));
+    BOOST_REQUIRE_EQUAL(out, 0);
+}
+
+BOOST_AUTO_TEST_CASE( mpsc_queue_convert_pop_test )
+{
+    mpsc_queue<int*> f;
+    BOOST_REQUIRE(f.empty());
+    f.push(new int(1));
+    f.push(new int(2));
+    f.push(new int(3));
+    f.push(new int(4));
+
+    {
+        int * i1;
+
+        BOOST_REQUIRE(f.pop(i1));
+        BOOST_REQUIRE_EQUAL(*i1, 1);
+        delete i1;
+    }
+
+    {
+        boost::shared_ptr<int> i2;
+        BOOST_REQUIRE(f.pop(i2));
+        BOOST_REQUIRE_EQUAL(*i2, 2);
+    }
+
+    {
+        auto_ptr<int> i3;
+        BOOST_REQUIRE(f.pop(i3));
+
+        BOOST_REQUIRE_EQUAL(*i3, 3);
+    }
+
+    {
+        boost::shared_ptr<int> i4;
+        BOOST_REQUIRE(f.pop(i4));
+
+        BOOST_REQUIRE_EQUAL(*i4, 4);
+    }
+
+    BOOST_REQUIRE(f.empty());
+}
+
+BOOST_AUTO_TEST_CASE( mpsc_queue_consume_one_test )
+{
+    mpsc_queue<int> f;
+
+    f.push(1);
+    f.push(2);
+
+    bool success1 = f.consume_one(test_equal(1));
+    bool success2 = f.consume_one(test_equal(2));
+
+    BOOST_REQUIRE(success1);
+    BOOST_REQUIRE(success2);
+
+    BOOST_REQUIRE(f.empty());
+}
+
+BOOST_AUTO_TEST_CASE( mpsc_queue_consume_all_test )
+{
+    mpsc_queue<int> f;
+
+    f.push(1);
+    f.push(2);
+
+    size_t consumed = f.consume_all(dummy_functor());
+
+    BOOST_REQUIRE_EQUAL(consumed, 2u);
+
+    BOOST_REQUIRE(f.empty());
+}
+
+namespace {
+
+struct element:
+    mpsc_queue_hook
+{
+    explicit element(int v):
+        value(v)
+    {}
+
+    int value;
+};
+
+}
+
+BOOST_AUTO_TEST_CASE( intrusive_mpsc_queue_test )
+{
+    intrusive_mpsc_queue<element> f;
+    element e1(1), e2(2), e3(3);
+
+    BOOST_REQUIRE(f.empty());
+    f.push(&e1);
+    f.push(&e2);
+
+    element * out;
+    BOOST_REQUIRE(f.pop(out));
+    BOOST_REQUIRE_EQUAL(out, &e1);
+    BOOST_REQUIRE(f.pop(out));
+    BOOST_REQUIRE_EQUAL(out, &e2);
+    BOOST_REQUIRE(f.empty());
+    BOOST_REQUIRE(!f.pop(out));
+
+    /* popped elements can be pushed again */
+    f.push(&e2);
+    f.push(&e3);
+    f.push(&e1);
+
+    BOOST_REQUIRE(f.pop(out));
+    BOOST_REQUIRE_EQUAL(out->value, 2);
+    BOOST_REQUIRE(f.pop(out));
+    BOOST_REQUIRE_EQUAL(out->value, 3);
+    BOOST_REQUIRE(f.pop(out));
+    BOOST_REQUIRE_EQUAL(out->value, 1);
+    BOOST_REQUIRE(f.empty());
+}
+
+BOOST_AUTO_TEST_CASE( blocking_queue_test )
+{
+    blocking_queue<mpsc_queue<int> > f;
+
+    BOOST_REQUIRE(f.empty());
+    BOOST_REQUIRE(f.push(1));
+    BOOST_REQUIRE(f.push(2));
+
+    int i;
+    f.wait_pop(i);
+    BOOST_REQUIRE_EQUAL(i, 1);
+    BOOST_REQUIRE(f.pop(i));
+    BOOST_REQUIRE_EQUAL(i, 2);
+    BOOST_REQUIRE(!f.pop(i));
+    BOOST_REQUIRE(f.empty());
+}
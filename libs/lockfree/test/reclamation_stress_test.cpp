@@ -0,0 +1,53 @@
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/lockfree/queue.hpp>
+#include <boost/lockfree/stack.hpp>
+
+#define BOOST_TEST_MAIN
+#ifdef BOOST_LOCKFREE_INCLUDE_TESTS
+#include <boost/test/included/unit_test.hpp>
+#else
+#include <boost/test/unit_test.hpp>
+#endif
+
+#include "test_common.hpp"
+
+using namespace boost::lockfree;
+
+BOOST_AUTO_TEST_CASE( queue_hazard_pointers_stress_test )
+{
+    typedef queue_stress_tester<> tester_type;
+    boost::scoped_ptr<tester_type> tester(new tester_type(4, 4) );
+
+    queue<long, reclamation<hazard_pointers> > q(128);
+    tester->run(q);
+}
+
+BOOST_AUTO_TEST_CASE( queue_epoch_based_stress_test )
+{
+    typedef queue_stress_tester<> tester_type;
+    boost::scoped_ptr<tester_type> tester(new tester_type(4, 4) );
+
+    queue<long, reclamation<epoch_based> > q(128);
+    tester->run(q);
+}
+
+BOOST_AUTO_TEST_CASE( stack_hazard_pointers_stress_test )
+{
+    typedef queue_stress_tester<> tester_type;
+    boost::scoped_ptr<tester_type> tester(new tester_type(4, 4) );
+
+    stack<long, reclamation<hazard_pointers> > s(128);
+    tester->run(s);
+}
+
+BOOST_AUTO_TEST_CASE( stack_epoch_based_stress_test )
+{
+    typedef queue_stress_tester<> tester_type;
+    boost::scoped_ptr<tester_type> tester(new tester_type(4, 4) );
+
+    stack<long, reclamation<epoch_based> > s(128);
+    tester->run(s);
+}
@@ -0,0 +1,181 @@
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/lockfree/epoch_reclamation.hpp>
+#include <boost/lockfree/hazard_pointers.hpp>
+#include <boost/lockfree/queue.hpp>
+#include <boost/lockfree/stack.hpp>
+
+#define BOOST_TEST_MAIN
+#ifdef BOOST_LOCKFREE_INCLUDE_TESTS
+#include <boost/test/included/unit_test.hpp>
+#else
+#include <boost/test/unit_test.hpp>
+#endif
+
+#include <memory>
+
+using namespace boost;
+using namespace boost::lockfree;
+
+namespace {
+
+int live_objects = 0;
+
+struct object
+{
+    object(void)
+    {
+        ++live_objects;
+    }
+
+    ~object(void)
+    {
+        --live_objects;
+    }
+};
+
+/* std::allocator, which counts the allocated nodes */
+long live_nodes = 0;
+
+template <typename T>
+struct counting_allocator:
+    std::allocator<T>
+{
+    template <typename U>
+    struct rebind
+    {
+        typedef counting_allocator<U> other;
+    };
+
+    counting_allocator(void)
+    {}
+
+    template <typename U>
+    counting_allocator(counting_allocator<U> const &)
+    {}
+
+    T * allocate(std::size_t n)
+    {
+        live_nodes += n;
+        return std::allocator<T>::allocate(n);
+    }
+
+    void deallocate(T * p, std::size_t n)
+    {
+        live_nodes -= n;
+        std::allocator<T>::deallocate(p, n);
+    }
+};
+
+}
+
+BOOST_AUTO_TEST_CASE( hazard_pointer_domain_test )
+{
+    {
+        hazard_pointer_domain<object> domain(checked_deleter<object>(), 4);
+        boost::lockfree::detail::atomic<object*> shared(new object);
+
+        hazard_pointer_domain<object>::guard reader(domain);
+        object * protected_object = reader.protect(0, shared);
+
+        {
+            hazard_pointer_domain<object>::guard writer(domain);
+            object * old = shared.exchange(0);
+            BOOST_REQUIRE_EQUAL(old, protected_object);
+            writer.retire(old);
+
+            /* two scans */
+            for (int i = 0; i != 6; ++i)
+                writer.retire(new object);
+        }
+
+        /* only the object, which is protected by the reader, survives the scans */
+        BOOST_REQUIRE_EQUAL(live_objects, 1);
+    }
+    BOOST_REQUIRE_EQUAL(live_objects, 0);
+}
+
+BOOST_AUTO_TEST_CASE( epoch_domain_test )
+{
+    {
+        epoch_domain<object> domain(checked_deleter<object>(), 1);
+
+        {
+            epoch_domain<object>::guard reader(domain);
+            {
+                epoch_domain<object>::guard writer(domain);
+                for (int i = 0; i != 8; ++i)
+                    writer.retire(new object);
+            }
+            {
+                epoch_domain<object>::guard writer(domain);
+                writer.retire(new object);
+            }
+
+            /* the reader has seen the first epoch, so nothing can be freed */
+            BOOST_REQUIRE_EQUAL(live_objects, 9);
+        }
+
+        for (int i = 0; i != 4; ++i) {
+            epoch_domain<object>::guard writer(domain);
+            writer.retire(new object);
+        }
+
+        BOOST_REQUIRE(live_objects < 13);
+    }
+    BOOST_REQUIRE_EQUAL(live_objects, 0);
+}
+
+template <typename Container>
+void reclaim_nodes(void)
+{
+    live_nodes = 0;
+    {
+        Container c(1);
+
+        for (int i = 0; i != 1000; ++i)
+            c.push(i);
+        BOOST_REQUIRE(live_nodes >= 1000);
+
+        int out;
+        for (int i = 0; i != 1000; ++i)
+            BOOST_REQUIRE(c.pop(out));
+        BOOST_REQUIRE(c.empty());
+
+        /* all but the last few retired nodes have been returned to the allocator */
+        BOOST_REQUIRE(live_nodes < 200);
+    }
+    BOOST_REQUIRE_EQUAL(live_nodes, 0);
+}
+
+BOOST_AUTO_TEST_CASE( queue_reclamation_test )
+{
+    reclaim_nodes<queue<int, allocator<counting_allocator<void> >, reclamation<hazard_pointers> > >();
+    reclaim_nodes<queue<int, allocator<counting_allocator<void> >, reclamation<epoch_based> > >();
+}
+
+BOOST_AUTO_TEST_CASE( stack_reclamation_test )
+{
+    reclaim_nodes<stack<int, allocator<counting_allocator<void> >, reclamation<hazard_pointers> > >();
+    reclaim_nodes<stack<int, allocator<counting_allocator<void> >, reclamation<epoch_based> > >();
+}
+
+BOOST_AUTO_TEST_CASE( freelist_keeps_nodes_test )
+{
+    live_nodes = 0;
+    {
+        queue<int, allocator<counting_allocator<void> > > q(1);
+
+        for (int i = 0; i != 1000; ++i)
+            q.push(i);
+
+        int out;
+        while (q.pop(out))
+            ;
+
+        BOOST_REQUIRE(live_nodes > 1000);
+    }
+    BOOST_REQUIRE_EQUAL(live_nodes, 0);
+}
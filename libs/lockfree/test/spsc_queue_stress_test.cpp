@@ -209,3 +209,59 @@ BOOST_AUTO_TEST_CASE( spsc_queue_test_buffering )
     test1->run();
 }
 
+
+struct spsc_queue_tester_in_place
+{
+    spsc_queue<int> sf;
+
+    spsc_queue_tester_in_place(void):
+        sf(100)
+    {}
+
+    void add(void)
+    {
+        int next = 0;
+        while (next != int(nodes_per_thread)) {
+            spsc_queue<int>::range r = sf.write_reserve(7);
+
+            size_t count = (std::min)(r.size(), size_t(nodes_per_thread - next));
+            for (size_t i = 0; i != count; ++i) {
+                int & slot = (i < r.first_size) ? r.first[i] : r.second[i - r.first_size];
+                slot = next++;
+            }
+            sf.write_commit(count);
+        }
+    }
+
+    void get(void)
+    {
+        int expected = 0;
+        while (expected != int(nodes_per_thread)) {
+            spsc_queue<int>::range r = sf.read_peek();
+
+            for (size_t i = 0; i != r.first_size; ++i)
+                BOOST_REQUIRE_EQUAL(r.first[i], expected++);
+            for (size_t i = 0; i != r.second_size; ++i)
+                BOOST_REQUIRE_EQUAL(r.second[i], expected++);
+
+            sf.read_release(r.size());
+        }
+    }
+
+    void run(void)
+    {
+        boost::thread reader(boost::bind(&spsc_queue_tester_in_place::get, this));
+        boost::thread writer(boost::bind(&spsc_queue_tester_in_place::add, this));
+
+        writer.join();
+        reader.join();
+
+        BOOST_REQUIRE(sf.empty());
+    }
+};
+
+BOOST_AUTO_TEST_CASE( spsc_queue_test_in_place )
+{
+    boost::shared_ptr<spsc_queue_tester_in_place> test1(new spsc_queue_tester_in_place);
+    test1->run();
+}
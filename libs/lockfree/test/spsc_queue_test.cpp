@@ -306,3 +306,78 @@ BOOST_AUTO_TEST_CASE( spsc_queue_buffer_pop_test )
     spsc_queue_buffer_pop<reference_to_array, 7, 16, 64>();
     spsc_queue_buffer_pop<output_iterator_, 7, 16, 64>();
 }
+
+BOOST_AUTO_TEST_CASE( spsc_queue_write_reserve_test )
+{
+    spsc_queue<int, capacity<8> > f;
+
+    spsc_queue<int, capacity<8> >::range r = f.write_reserve(5);
+    BOOST_REQUIRE_EQUAL(r.size(), 5u);
+    BOOST_REQUIRE_EQUAL(r.first_size, 5u);
+    for (int i = 0; i != 5; ++i)
+        r.first[i] = i;
+
+    /* nothing is visible before the commit */
+    BOOST_REQUIRE(f.empty());
+    f.write_commit(3);
+    BOOST_REQUIRE(!f.empty());
+
+    int out[8];
+    BOOST_REQUIRE_EQUAL(f.pop(out, 8), 3u);
+    for (int i = 0; i != 3; ++i)
+        BOOST_REQUIRE_EQUAL(out[i], i);
+
+    /* the ringbuffer wraps, so the space is split */
+    r = f.write_reserve(100);
+    BOOST_REQUIRE_EQUAL(r.size(), 8u);
+    BOOST_REQUIRE_EQUAL(r.first_size, 6u);
+    BOOST_REQUIRE_EQUAL(r.second_size, 2u);
+    for (size_t i = 0; i != r.first_size; ++i)
+        r.first[i] = 10 + int(i);
+    for (size_t i = 0; i != r.second_size; ++i)
+        r.second[i] = 20 + int(i);
+    f.write_commit(8);
+
+    BOOST_REQUIRE_EQUAL(f.write_reserve(1).size(), 0u);
+
+    BOOST_REQUIRE_EQUAL(f.pop(out, 8), 8u);
+    BOOST_REQUIRE_EQUAL(out[0], 10);
+    BOOST_REQUIRE_EQUAL(out[5], 15);
+    BOOST_REQUIRE_EQUAL(out[6], 20);
+    BOOST_REQUIRE_EQUAL(out[7], 21);
+    BOOST_REQUIRE(f.empty());
+}
+
+BOOST_AUTO_TEST_CASE( spsc_queue_read_peek_test )
+{
+    spsc_queue<int> f(8);
+
+    BOOST_REQUIRE_EQUAL(f.read_peek().size(), 0u);
+
+    for (int i = 0; i != 6; ++i)
+        f.push(i);
+
+    spsc_queue<int>::range r = f.read_peek(4);
+    BOOST_REQUIRE_EQUAL(r.size(), 4u);
+    BOOST_REQUIRE_EQUAL(r.first[0], 0);
+    BOOST_REQUIRE_EQUAL(r.first[3], 3);
+    f.read_release(4);
+
+    for (int i = 6; i != 12; ++i)
+        f.push(i);
+
+    r = f.read_peek();
+    BOOST_REQUIRE_EQUAL(r.size(), 8u);
+    BOOST_REQUIRE_EQUAL(r.first_size, 5u);
+    BOOST_REQUIRE_EQUAL(r.first[0], 4);
+    BOOST_REQUIRE_EQUAL(r.second[0], 9);
+    BOOST_REQUIRE_EQUAL(r.second[2], 11);
+
+    f.read_release(1);
+    int out;
+    BOOST_REQUIRE(f.pop(out));
+    BOOST_REQUIRE_EQUAL(out, 5);
+
+    f.read_release(f.read_peek().size());
+    BOOST_REQUIRE(f.empty());
+}
@@ -0,0 +1,96 @@
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/lockfree/unordered_map.hpp>
+#include <boost/thread.hpp>
+
+#define BOOST_TEST_MAIN
+#ifdef BOOST_LOCKFREE_INCLUDE_TESTS
+#include <boost/test/included/unit_test.hpp>
+#else
+#include <boost/test/unit_test.hpp>
+#endif
+
+namespace {
+
+static const int writer_count = 4;
+static const int reader_count = 2;
+static const int keys_per_writer = 2000;
+static const int rounds = 20;
+static const int stable_keys = 1000;
+
+/* each writer inserts and erases its own range of keys, while the readers check that the stable keys, which are
+ * inserted before the threads start, are always found with their original value */
+struct unordered_map_tester
+{
+    typedef boost::lockfree::unordered_map<int, int> map_type;
+
+    map_type m;
+    boost::lockfree::detail::atomic<int> writers_done;
+    boost::lockfree::detail::atomic<int> errors;
+
+    unordered_map_tester(void):
+        writers_done(0), errors(0)
+    {
+        for (int i = 0; i != stable_keys; ++i)
+            m.insert(-1 - i, i);
+    }
+
+    void write(int id)
+    {
+        const int begin = id * keys_per_writer;
+        const int end = begin + keys_per_writer;
+
+        for (int round = 0; round != rounds; ++round) {
+            for (int i = begin; i != end; ++i)
+                if (!m.insert(i, i + round))
+                    ++errors;
+
+            for (int i = begin; i != end; ++i) {
+                int value;
+                if (!m.find(i, value) || value != i + round)
+                    ++errors;
+            }
+
+            for (int i = begin; i != end; ++i)
+                if (!m.erase(i))
+                    ++errors;
+        }
+        ++writers_done;
+    }
+
+    void read(void)
+    {
+        while (writers_done.load() != writer_count) {
+            for (int i = 0; i != stable_keys; ++i) {
+                int value;
+                if (!m.find(-1 - i, value) || value != i)
+                    ++errors;
+            }
+        }
+    }
+
+    void run(void)
+    {
+        boost::thread_group threads;
+        for (int i = 0; i != writer_count; ++i)
+            threads.create_thread(boost::bind(&unordered_map_tester::write, this, i));
+        for (int i = 0; i != reader_count; ++i)
+            threads.create_thread(boost::bind(&unordered_map_tester::read, this));
+        threads.join_all();
+
+        BOOST_REQUIRE_EQUAL(errors.load(), 0);
+        BOOST_REQUIRE_EQUAL(m.size(), std::size_t(stable_keys));
+        for (int i = 0; i != writer_count * keys_per_writer; ++i)
+            BOOST_REQUIRE(!m.contains(i));
+    }
+};
+
+}
+
+BOOST_AUTO_TEST_CASE( unordered_map_stress_test )
+{
+    unordered_map_tester tester;
+    tester.run();
+}
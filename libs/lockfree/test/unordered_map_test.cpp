@@ -0,0 +1,165 @@
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/lockfree/unordered_map.hpp>
+
+#define BOOST_TEST_MAIN
+#ifdef BOOST_LOCKFREE_INCLUDE_TESTS
+#include <boost/test/included/unit_test.hpp>
+#else
+#include <boost/test/unit_test.hpp>
+#endif
+
+#include <string>
+
+using namespace boost;
+using namespace boost::lockfree;
+using namespace std;
+
+namespace {
+
+/* maps all keys to the same bucket */
+struct constant_hash
+{
+    std::size_t operator()(int) const
+    {
+        return 42;
+    }
+};
+
+struct counted
+{
+    static int live;
+
+    explicit counted(int v = 0):
+        value(v)
+    {
+        ++live;
+    }
+
+    counted(counted const & rhs):
+        value(rhs.value)
+    {
+        ++live;
+    }
+
+    ~counted(void)
+    {
+        --live;
+    }
+
+    int value;
+};
+
+int counted::live = 0;
+
+}
+
+BOOST_AUTO_TEST_CASE( simple_unordered_map_test )
+{
+    boost::lockfree::unordered_map<int, int> m;
+    BOOST_WARN(m.is_lock_free());
+
+    BOOST_REQUIRE(m.empty());
+    BOOST_REQUIRE(m.insert(1, 10));
+    BOOST_REQUIRE(m.insert(2, 20));
+    BOOST_REQUIRE(!m.insert(1, 11));
+    BOOST_REQUIRE_EQUAL(m.size(), 2u);
+
+    int value = 0;
+    BOOST_REQUIRE(m.find(1, value));
+    BOOST_REQUIRE_EQUAL(value, 10);
+    BOOST_REQUIRE(m.find(2, value));
+    BOOST_REQUIRE_EQUAL(value, 20);
+    BOOST_REQUIRE(!m.find(3, value));
+    BOOST_REQUIRE(m.contains(2));
+    BOOST_REQUIRE(!m.contains(3));
+
+    BOOST_REQUIRE(m.erase(1));
+    BOOST_REQUIRE(!m.erase(1));
+    BOOST_REQUIRE(!m.contains(1));
+    BOOST_REQUIRE_EQUAL(m.size(), 1u);
+
+    BOOST_REQUIRE(m.insert(1, 12));
+    BOOST_REQUIRE(m.find(1, value));
+    BOOST_REQUIRE_EQUAL(value, 12);
+}
+
+BOOST_AUTO_TEST_CASE( unordered_map_string_test )
+{
+    boost::lockfree::unordered_map<string, string> m(16);
+
+    BOOST_REQUIRE(m.insert("one", "1"));
+    BOOST_REQUIRE(m.insert("two", "2"));
+
+    string value;
+    BOOST_REQUIRE(m.find("one", value));
+    BOOST_REQUIRE_EQUAL(value, "1");
+    BOOST_REQUIRE(m.erase("two"));
+    BOOST_REQUIRE(!m.find("two", value));
+}
+
+BOOST_AUTO_TEST_CASE( unordered_map_collision_test )
+{
+    boost::lockfree::unordered_map<int, int, constant_hash> m;
+
+    for (int i = 0; i != 100; ++i)
+        BOOST_REQUIRE(m.insert(i, i * 2));
+
+    for (int i = 0; i != 100; i += 2)
+        BOOST_REQUIRE(m.erase(i));
+
+    for (int i = 0; i != 100; ++i) {
+        int value = -1;
+        if (i % 2) {
+            BOOST_REQUIRE(m.find(i, value));
+            BOOST_REQUIRE_EQUAL(value, i * 2);
+        } else
+            BOOST_REQUIRE(!m.find(i, value));
+    }
+    BOOST_REQUIRE_EQUAL(m.size(), 50u);
+}
+
+BOOST_AUTO_TEST_CASE( unordered_map_growth_test )
+{
+    boost::lockfree::unordered_map<int, int> m;
+    const std::size_t initial_buckets = m.bucket_count();
+
+    const int count = 10000;
+    for (int i = 0; i != count; ++i)
+        BOOST_REQUIRE(m.insert(i, -i));
+
+    BOOST_REQUIRE_EQUAL(m.size(), std::size_t(count));
+    BOOST_REQUIRE_GT(m.bucket_count(), initial_buckets);
+    BOOST_REQUIRE_LE(m.size(), m.bucket_count() * 2);
+
+    for (int i = 0; i != count; ++i) {
+        int value = 1;
+        BOOST_REQUIRE(m.find(i, value));
+        BOOST_REQUIRE_EQUAL(value, -i);
+    }
+
+    for (int i = 0; i != count; ++i)
+        BOOST_REQUIRE(m.erase(i));
+    BOOST_REQUIRE(m.empty());
+
+    for (int i = 0; i != count; ++i)
+        BOOST_REQUIRE(!m.contains(i));
+}
+
+BOOST_AUTO_TEST_CASE( unordered_map_destructor_test )
+{
+    {
+        boost::lockfree::unordered_map<int, counted> m;
+        for (int i = 0; i != 1000; ++i)
+            m.insert(i, counted(i));
+        for (int i = 0; i < 1000; i += 3)
+            m.erase(i);
+
+        counted value;
+        BOOST_REQUIRE(m.find(1, value));
+        BOOST_REQUIRE_EQUAL(value.value, 1);
+    }
+    BOOST_REQUIRE_EQUAL(counted::live, 0);
+}
@@ -0,0 +1,84 @@
+/*
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   decode.cpp
+ *
+ * \brief  An example of rendering a binary log to text. The records are read from the file given on the
+ *         command line, or from the standard input, and formatted with the format strings stored in the file.
+ */
+
+// #define BOOST_ALL_DYN_LINK 1
+
+#include <iostream>
+#include <fstream>
+#include <boost/cstdint.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/move/utility.hpp>
+#include <boost/log/core.hpp>
+#include <boost/log/trivial.hpp>
+#include <boost/log/core/record.hpp>
+#include <boost/log/attributes/attribute_value_set.hpp>
+#include <boost/log/sinks/sync_frontend.hpp>
+#include <boost/log/sinks/text_ostream_backend.hpp>
+#include <boost/log/utility/empty_deleter.hpp>
+#include <boost/log/utility/binary_log_reader.hpp>
+#include <boost/log/utility/setup/formatter_parser.hpp>
+
+namespace logging = boost::log;
+namespace sinks = boost::log::sinks;
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        std::ifstream file;
+        if (argc > 1)
+        {
+            file.open(argv[1], std::ios_base::in | std::ios_base::binary);
+            if (!file.is_open())
+            {
+                std::cerr << "Could not open " << argv[1] << std::endl;
+                return 1;
+            }
+        }
+        std::istream& strm = argc > 1 ? static_cast< std::istream& >(file) : std::cin;
+
+        // The severity levels of the trivial logger are written to the file, make them formattable
+        logging::register_simple_formatter_factory< logging::trivial::severity_level, char >("Severity");
+
+        // The sink that prints the rendered records
+        typedef sinks::synchronous_sink< sinks::text_ostream_backend > sink_t;
+        boost::shared_ptr< sink_t > sink = boost::make_shared< sink_t >();
+        sink->locked_backend()->add_stream(boost::shared_ptr< std::ostream >(&std::cout, logging::empty_deleter()));
+        boost::shared_ptr< logging::core > core = logging::core::get();
+        core->add_sink(sink);
+
+        logging::binary_log_reader reader(strm);
+        logging::attribute_value_set values;
+        boost::uintmax_t format_id = 0;
+        while (reader.read_record(values))
+        {
+            // Parse the format string only when it changes
+            if (reader.format_id() != format_id)
+            {
+                format_id = reader.format_id();
+                sink->set_formatter(logging::parse_formatter(reader.format()));
+            }
+
+            logging::record rec = core->open_record(boost::move(values));
+            if (rec)
+                core->push_record(boost::move(rec));
+        }
+
+        return 0;
+    }
+    catch (std::exception& e)
+    {
+        std::cerr << "FAILURE: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,57 @@
+/*
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   main.cpp
+ *
+ * \brief  An example of writing a binary log. The log records are not formatted when written,
+ *         the file can be rendered to text with the binary_log_decode example.
+ */
+
+// #define BOOST_ALL_DYN_LINK 1
+
+#include <iostream>
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/log/core.hpp>
+#include <boost/log/trivial.hpp>
+#include <boost/log/sinks/sync_frontend.hpp>
+#include <boost/log/sinks/binary_file_backend.hpp>
+#include <boost/log/utility/setup/common_attributes.hpp>
+
+namespace logging = boost::log;
+namespace sinks = boost::log::sinks;
+namespace keywords = boost::log::keywords;
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        // Create a sink that writes attribute values instead of formatted text
+        typedef sinks::synchronous_sink< sinks::binary_file_backend > sink_t;
+        boost::shared_ptr< sinks::binary_file_backend > backend = boost::make_shared< sinks::binary_file_backend >(
+            keywords::file_name = "sample.blog",
+            keywords::format = "%LineID%: %TimeStamp% [%ThreadID%] <%Severity%> %Message%");
+        logging::core::get()->add_sink(boost::make_shared< sink_t >(backend));
+
+        logging::add_common_attributes();
+
+        for (unsigned int i = 0; i < 10; ++i)
+        {
+            BOOST_LOG_TRIVIAL(info) << "Some log record " << i;
+        }
+
+        // The format string may be changed at any time, the new format is written to the file along with the records
+        backend->set_format("%LineID%: <%Severity%> %Message%");
+        BOOST_LOG_TRIVIAL(warning) << "A record with a different format";
+
+        return 0;
+    }
+    catch (std::exception& e)
+    {
+        std::cout << "FAILURE: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,403 @@
+/*
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   binary_file_backend.cpp
+ *
+ * \brief  This header is the Boost.Log library implementation, see the library documentation
+ *         at http://www.boost.org/libs/log/doc/log.html.
+ */
+
+#include <string>
+#include <vector>
+#include <boost/cstdint.hpp>
+#include <boost/limits.hpp>
+#include <boost/mpl/vector.hpp>
+#include <boost/type_traits/is_signed.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/date_time/gregorian/gregorian_types.hpp>
+#include <boost/log/exceptions.hpp>
+#include <boost/log/core/record_view.hpp>
+#include <boost/log/attributes/attribute_name.hpp>
+#include <boost/log/attributes/attribute_value.hpp>
+#include <boost/log/attributes/attribute_value_set.hpp>
+#include <boost/log/attributes/value_visitation.hpp>
+#include <boost/log/trivial.hpp>
+#include <boost/log/detail/thread_id.hpp>
+#include <boost/log/detail/process_id.hpp>
+#include <boost/log/sinks/binary_file_backend.hpp>
+#include "binary_log_format.hpp"
+#include <boost/log/detail/header.hpp>
+
+namespace boost {
+
+BOOST_LOG_OPEN_NAMESPACE
+
+namespace sinks {
+
+namespace {
+
+namespace binary_log = boost::log::aux::binary_log;
+
+//! Attribute value types supported by the backend
+typedef mpl::vector<
+    bool,
+    char,
+    signed char,
+    unsigned char,
+    short,
+    unsigned short,
+    int,
+    unsigned int,
+    long,
+    unsigned long,
+#if defined(BOOST_HAS_LONG_LONG)
+    long long,
+    unsigned long long,
+#endif
+    float,
+    double,
+    long double,
+    std::string,
+    posix_time::ptime,
+    trivial::severity_level,
+#if !defined(BOOST_LOG_NO_THREADS)
+    log::aux::thread::id,
+#endif
+    log::aux::process::id
+> supported_types;
+
+//! Appends raw bytes of a value in the native byte order
+template< typename T >
+inline void put_raw(std::string& buf, T value)
+{
+    buf.append(reinterpret_cast< const char* >(&value), sizeof(value));
+}
+
+//! Selects the value type tag of an integral type
+template< typename T >
+inline binary_log::value_type integral_type_tag()
+{
+    const bool is_signed = boost::is_signed< T >::value;
+    switch (sizeof(T))
+    {
+    case 1:
+        return is_signed ? binary_log::int8_value : binary_log::uint8_value;
+    case 2:
+        return is_signed ? binary_log::int16_value : binary_log::uint16_value;
+    case 4:
+        return is_signed ? binary_log::int32_value : binary_log::uint32_value;
+    default:
+        return is_signed ? binary_log::int64_value : binary_log::uint64_value;
+    }
+}
+
+//! The visitor that encodes attribute values
+class value_encoder
+{
+public:
+    typedef void result_type;
+
+private:
+    std::string* m_pBuffer;
+
+public:
+    explicit value_encoder(std::string& buf) : m_pBuffer(&buf)
+    {
+    }
+
+    void operator() (bool value) const
+    {
+        put_tag(binary_log::bool_value);
+        m_pBuffer->push_back(static_cast< char >(value));
+    }
+    void operator() (char value) const
+    {
+        put_tag(binary_log::char_value);
+        m_pBuffer->push_back(value);
+    }
+    void operator() (signed char value) const { put_integral(value); }
+    void operator() (unsigned char value) const { put_integral(value); }
+    void operator() (short value) const { put_integral(value); }
+    void operator() (unsigned short value) const { put_integral(value); }
+    void operator() (int value) const { put_integral(value); }
+    void operator() (unsigned int value) const { put_integral(value); }
+    void operator() (long value) const { put_integral(value); }
+    void operator() (unsigned long value) const { put_integral(value); }
+#if defined(BOOST_HAS_LONG_LONG)
+    void operator() (long long value) const { put_integral(value); }
+    void operator() (unsigned long long value) const { put_integral(value); }
+#endif
+    void operator() (float value) const
+    {
+        put_tag(binary_log::float_value);
+        put_raw(*m_pBuffer, value);
+    }
+    void operator() (double value) const
+    {
+        put_tag(binary_log::double_value);
+        put_raw(*m_pBuffer, value);
+    }
+    void operator() (long double value) const
+    {
+        (*this)(static_cast< double >(value));
+    }
+    void operator() (std::string const& value) const
+    {
+        put_tag(binary_log::string_value);
+        binary_log::put_varint(*m_pBuffer, value.size());
+        m_pBuffer->append(value);
+    }
+    void operator() (posix_time::ptime const& value) const
+    {
+        if (value.is_special())
+            return;
+        const posix_time::ptime epoch(gregorian::date(1970, 1, 1));
+        put_tag(binary_log::ptime_value);
+        put_raw(*m_pBuffer, static_cast< int64_t >((value - epoch).total_microseconds()));
+    }
+    void operator() (trivial::severity_level value) const
+    {
+        put_tag(binary_log::severity_value);
+        put_raw(*m_pBuffer, static_cast< int32_t >(value));
+    }
+#if !defined(BOOST_LOG_NO_THREADS)
+    void operator() (log::aux::thread::id const& value) const
+    {
+        put_tag(binary_log::thread_id_value);
+        put_raw(*m_pBuffer, static_cast< uint64_t >(value.native_id()));
+    }
+#endif
+    void operator() (log::aux::process::id const& value) const
+    {
+        put_tag(binary_log::process_id_value);
+        put_raw(*m_pBuffer, static_cast< uint64_t >(value.native_id()));
+    }
+
+private:
+    void put_tag(binary_log::value_type type) const
+    {
+        m_pBuffer->push_back(static_cast< char >(type));
+    }
+
+    template< typename T >
+    void put_integral(T value) const
+    {
+        const binary_log::value_type type = integral_type_tag< T >();
+        put_tag(type);
+        switch (type)
+        {
+        case binary_log::int8_value:
+        case binary_log::uint8_value:
+            put_raw(*m_pBuffer, static_cast< uint8_t >(value)); break;
+        case binary_log::int16_value:
+        case binary_log::uint16_value:
+            put_raw(*m_pBuffer, static_cast< uint16_t >(value)); break;
+        case binary_log::int32_value:
+        case binary_log::uint32_value:
+            put_raw(*m_pBuffer, static_cast< uint32_t >(value)); break;
+        default:
+            put_raw(*m_pBuffer, static_cast< uint64_t >(value)); break;
+        }
+    }
+};
+
+} // namespace
+
+//! Sink implementation data
+struct binary_file_backend::implementation
+{
+    //! File name
+    filesystem::path m_FileName;
+    //! File open mode
+    std::ios_base::openmode m_OpenMode;
+    //! The file stream
+    filesystem::ofstream m_File;
+    //! Auto-flush flag
+    bool m_fAutoFlush;
+
+    //! Current format string
+    std::string m_Format;
+    //! Identifier of the current format string
+    uintmax_t m_FormatID;
+    //! Indicates that the current format string has not been written to the file yet
+    bool m_fFormatPending;
+
+    //! Attribute names that have been written to the file, indexed by the attribute name identifier
+    std::vector< bool > m_WrittenNames;
+
+    //! The buffer for the record being written
+    std::string m_Record;
+    //! The buffer for the record values
+    std::string m_Values;
+
+    implementation() :
+        m_OpenMode(std::ios_base::trunc | std::ios_base::out),
+        m_fAutoFlush(false),
+        m_FormatID(0),
+        m_fFormatPending(true)
+    {
+    }
+
+    //! Opens the file and writes the file header
+    void open_file()
+    {
+        m_File.open(m_FileName, m_OpenMode | std::ios_base::binary);
+        if (!m_File.is_open())
+        {
+            filesystem::filesystem_error err(
+                "Failed to open file for writing",
+                m_FileName,
+                system::error_code(system::errc::io_error, system::generic_category()));
+            BOOST_THROW_EXCEPTION(err);
+        }
+
+        std::string header(binary_log::signature, sizeof(binary_log::signature));
+        header.push_back(static_cast< char >(binary_log::version));
+        header.push_back(static_cast< char >(binary_log::native_byte_order));
+        m_File.write(header.data(), static_cast< std::streamsize >(header.size()));
+    }
+
+    //! Appends an entry to the record buffer
+    void put_entry(binary_log::entry_type type, std::string const& body)
+    {
+        m_Record.push_back(static_cast< char >(type));
+        binary_log::put_varint(m_Record, body.size());
+        m_Record.append(body);
+    }
+
+    //! Appends a name or a format string definition to the record buffer
+    void put_definition(binary_log::entry_type type, uintmax_t id, std::string const& str)
+    {
+        std::string body;
+        binary_log::put_varint(body, id);
+        binary_log::put_varint(body, str.size());
+        body.append(str);
+        put_entry(type, body);
+    }
+};
+
+//! Constructor
+BOOST_LOG_API binary_file_backend::binary_file_backend()
+{
+    construct(log::aux::empty_arg_list());
+}
+
+//! Constructor implementation
+BOOST_LOG_API void binary_file_backend::construct(
+    filesystem::path const& file_name,
+    std::ios_base::openmode mode,
+    std::string const& format,
+    bool auto_flush)
+{
+    mode |= std::ios_base::out;
+    if ((mode & std::ios_base::app) == 0)
+        mode |= std::ios_base::trunc;
+
+    implementation* impl = new implementation();
+    impl->m_FileName = file_name;
+    impl->m_OpenMode = mode;
+    impl->m_Format = format;
+    impl->m_fAutoFlush = auto_flush;
+    try
+    {
+        impl->open_file();
+    }
+    catch (...)
+    {
+        delete impl;
+        throw;
+    }
+    m_pImpl = impl;
+}
+
+//! Destructor
+BOOST_LOG_API binary_file_backend::~binary_file_backend()
+{
+    delete m_pImpl;
+}
+
+//! The method sets the format string
+BOOST_LOG_API void binary_file_backend::set_format(std::string const& format)
+{
+    if (format != m_pImpl->m_Format)
+    {
+        m_pImpl->m_Format = format;
+        ++m_pImpl->m_FormatID;
+        m_pImpl->m_fFormatPending = true;
+    }
+}
+
+//! Sets the flag to automatically flush the file after each log record
+BOOST_LOG_API void binary_file_backend::auto_flush(bool f)
+{
+    m_pImpl->m_fAutoFlush = f;
+}
+
+//! The method writes the record to the file
+BOOST_LOG_API void binary_file_backend::consume(record_view const& rec)
+{
+    implementation* const impl = m_pImpl;
+    if (!impl->m_File.good())
+        return;
+
+    impl->m_Record.clear();
+    if (impl->m_fFormatPending)
+    {
+        impl->put_definition(binary_log::format_entry, impl->m_FormatID, impl->m_Format);
+        impl->m_fFormatPending = false;
+    }
+
+    impl->m_Values.clear();
+    binary_log::put_varint(impl->m_Values, impl->m_FormatID);
+
+    attribute_value_set const& values = rec.attribute_values();
+    for (attribute_value_set::const_iterator it = values.begin(), end = values.end(); it != end; ++it)
+    {
+        const std::string::size_type size = impl->m_Values.size();
+        const attribute_name::id_type name_id = it->first.id();
+        binary_log::put_varint(impl->m_Values, name_id);
+        // The encoder writes nothing for values that cannot be represented, such as special time points
+        const std::string::size_type value_pos = impl->m_Values.size();
+        if (!it->second.visit< supported_types >(value_encoder(impl->m_Values)) || impl->m_Values.size() == value_pos)
+        {
+            // The value is of an unsupported type, discard the name
+            impl->m_Values.resize(size);
+            continue;
+        }
+
+        // Name definitions precede the record that uses them
+        if (name_id >= impl->m_WrittenNames.size())
+            impl->m_WrittenNames.resize(name_id + 1u, false);
+        if (!impl->m_WrittenNames[name_id])
+        {
+            impl->put_definition(binary_log::name_entry, name_id, it->first.string());
+            impl->m_WrittenNames[name_id] = true;
+        }
+    }
+
+    impl->put_entry(binary_log::record_entry, impl->m_Values);
+    impl->m_File.write(impl->m_Record.data(), static_cast< std::streamsize >(impl->m_Record.size()));
+
+    if (impl->m_fAutoFlush)
+        impl->m_File.flush();
+}
+
+//! The method flushes the file
+BOOST_LOG_API void binary_file_backend::flush()
+{
+    if (m_pImpl->m_File.is_open())
+        m_pImpl->m_File.flush();
+}
+
+} // namespace sinks
+
+BOOST_LOG_CLOSE_NAMESPACE // namespace log
+
+} // namespace boost
+
+#include <boost/log/detail/footer.hpp>
@@ -0,0 +1,139 @@
+/*
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   binary_log_format.hpp
+ *
+ * \brief  This header is the Boost.Log library implementation, see the library documentation
+ *         at http://www.boost.org/libs/log/doc/log.html.
+ *
+ * The header contains definitions of the binary log format, which is written by \c binary_file_backend
+ * and read by \c binary_log_reader:
+ *
+ * \code
+ * file    := signature version byte_order entry*
+ * entry   := entry_type(1 byte) size(varint) body(size bytes)
+ * name    := id(varint) string                       -- entry_type 1, defines an attribute name
+ * format  := id(varint) string                       -- entry_type 2, defines a format string
+ * record  := format_id(varint) value*                -- entry_type 3, a log record
+ * value   := name_id(varint) value_type(1 byte) payload
+ * string  := length(varint) chars(length bytes)
+ * \endcode
+ *
+ * Payloads of numeric values are stored in the byte order of the writer. A writer that appends to an existing file
+ * starts with a new file header, which resets all name and format definitions; entry types must therefore never
+ * be equal to the first character of the signature. Entries of unknown types are skipped by the reader, records
+ * with values of unknown types are rejected.
+ */
+
+#ifndef BOOST_LOG_BINARY_LOG_FORMAT_HPP_INCLUDED_
+#define BOOST_LOG_BINARY_LOG_FORMAT_HPP_INCLUDED_
+
+#include <string>
+#include <boost/cstdint.hpp>
+#include <boost/detail/endian.hpp>
+#include <boost/log/detail/config.hpp>
+#include <boost/log/detail/header.hpp>
+
+#ifdef BOOST_LOG_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+namespace boost {
+
+BOOST_LOG_OPEN_NAMESPACE
+
+namespace aux {
+
+namespace binary_log {
+
+//! File signature
+const char signature[4] = { 'B', 'L', 'O', 'G' };
+//! Format version
+const uint8_t version = 1;
+
+//! Byte order markers
+enum byte_order
+{
+    little_endian = 1,
+    big_endian = 2
+};
+
+#if defined(BOOST_LITTLE_ENDIAN)
+const uint8_t native_byte_order = little_endian;
+#else
+const uint8_t native_byte_order = big_endian;
+#endif
+
+//! Entry types
+enum entry_type
+{
+    name_entry = 1,
+    format_entry = 2,
+    record_entry = 3
+};
+
+//! Attribute value types
+enum value_type
+{
+    bool_value = 1,
+    char_value,
+    int8_value,
+    uint8_value,
+    int16_value,
+    uint16_value,
+    int32_value,
+    uint32_value,
+    int64_value,
+    uint64_value,
+    float_value,
+    double_value,
+    string_value,
+    //! Microseconds since 1970-01-01 00:00:00, as int64
+    ptime_value,
+    //! \c trivial::severity_level, as int32
+    severity_value,
+    //! Thread id, as uint64
+    thread_id_value,
+    //! Process id, as uint64
+    process_id_value
+};
+
+//! Appends an unsigned integer in the LEB128 encoding
+inline void put_varint(std::string& buf, uintmax_t n)
+{
+    while (n >= 0x80u)
+    {
+        buf.push_back(static_cast< char >((n & 0x7Fu) | 0x80u));
+        n >>= 7;
+    }
+    buf.push_back(static_cast< char >(n));
+}
+
+//! Decodes an unsigned integer in the LEB128 encoding, returns \c false if the input ends prematurely or the value overflows
+inline bool get_varint(const char*& p, const char* end, uintmax_t& n)
+{
+    n = 0;
+    for (unsigned int shift = 0; p != end && shift < sizeof(uintmax_t) * 8u; shift += 7)
+    {
+        const uint8_t byte = static_cast< uint8_t >(*p++);
+        n |= static_cast< uintmax_t >(byte & 0x7Fu) << shift;
+        if ((byte & 0x80u) == 0)
+            return true;
+    }
+    return false;
+}
+
+} // namespace binary_log
+
+} // namespace aux
+
+BOOST_LOG_CLOSE_NAMESPACE // namespace log
+
+} // namespace boost
+
+#include <boost/log/detail/footer.hpp>
+
+#endif // BOOST_LOG_BINARY_LOG_FORMAT_HPP_INCLUDED_
@@ -0,0 +1,377 @@
+/*
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   binary_log_reader.cpp
+ *
+ * \brief  This header is the Boost.Log library implementation, see the library documentation
+ *         at http://www.boost.org/libs/log/doc/log.html.
+ */
+
+#include <map>
+#include <string>
+#include <cstring>
+#include <algorithm>
+#include <boost/cstdint.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/date_time/gregorian/gregorian_types.hpp>
+#include <boost/log/exceptions.hpp>
+#include <boost/log/trivial.hpp>
+#include <boost/log/attributes/attribute_name.hpp>
+#include <boost/log/attributes/attribute_value_impl.hpp>
+#include <boost/log/detail/thread_id.hpp>
+#include <boost/log/detail/process_id.hpp>
+#include <boost/log/utility/binary_log_reader.hpp>
+#include "binary_log_format.hpp"
+#include <boost/log/detail/header.hpp>
+
+namespace boost {
+
+BOOST_LOG_OPEN_NAMESPACE
+
+namespace {
+
+namespace binary_log = boost::log::aux::binary_log;
+
+//! The reader of a record body
+class record_decoder
+{
+private:
+    const char* m_p;
+    const char* const m_End;
+    const bool m_fSwapBytes;
+
+public:
+    record_decoder(const char* begin, const char* end, bool swap_bytes) :
+        m_p(begin),
+        m_End(end),
+        m_fSwapBytes(swap_bytes)
+    {
+    }
+
+    bool at_end() const { return m_p == m_End; }
+
+    uintmax_t get_varint()
+    {
+        uintmax_t n = 0;
+        if (!binary_log::get_varint(m_p, m_End, n))
+            BOOST_LOG_THROW_DESCR(parse_error, "Malformed binary log record: invalid integer encoding");
+        return n;
+    }
+
+    uint8_t get_byte()
+    {
+        require(1u);
+        return static_cast< uint8_t >(*m_p++);
+    }
+
+    std::string get_string()
+    {
+        const uintmax_t size = get_varint();
+        require(size);
+        std::string str(m_p, static_cast< std::size_t >(size));
+        m_p += size;
+        return str;
+    }
+
+    //! Reads a numeric value in the byte order of the writer
+    template< typename T >
+    T get()
+    {
+        require(sizeof(T));
+        char bytes[sizeof(T)];
+        std::memcpy(bytes, m_p, sizeof(T));
+        m_p += sizeof(T);
+        if (m_fSwapBytes)
+            std::reverse(bytes, bytes + sizeof(T));
+        T value;
+        std::memcpy(&value, bytes, sizeof(T));
+        return value;
+    }
+
+private:
+    void require(uintmax_t size) const
+    {
+        if (static_cast< uintmax_t >(m_End - m_p) < size)
+            BOOST_LOG_THROW_DESCR(parse_error, "Malformed binary log record: unexpected end of record");
+    }
+};
+
+//! Decodes an attribute value of the specified type
+attribute_value decode_value(record_decoder& decoder, uint8_t type)
+{
+    switch (type)
+    {
+    case binary_log::bool_value:
+        return attributes::make_attribute_value(decoder.get_byte() != 0);
+    case binary_log::char_value:
+        return attributes::make_attribute_value(static_cast< char >(decoder.get_byte()));
+    case binary_log::int8_value:
+        return attributes::make_attribute_value(decoder.get< int8_t >());
+    case binary_log::uint8_value:
+        return attributes::make_attribute_value(decoder.get< uint8_t >());
+    case binary_log::int16_value:
+        return attributes::make_attribute_value(decoder.get< int16_t >());
+    case binary_log::uint16_value:
+        return attributes::make_attribute_value(decoder.get< uint16_t >());
+    case binary_log::int32_value:
+        return attributes::make_attribute_value(decoder.get< int32_t >());
+    case binary_log::uint32_value:
+        return attributes::make_attribute_value(decoder.get< uint32_t >());
+    case binary_log::int64_value:
+        return attributes::make_attribute_value(decoder.get< int64_t >());
+    case binary_log::uint64_value:
+        return attributes::make_attribute_value(decoder.get< uint64_t >());
+    case binary_log::float_value:
+        return attributes::make_attribute_value(decoder.get< float >());
+    case binary_log::double_value:
+        return attributes::make_attribute_value(decoder.get< double >());
+    case binary_log::string_value:
+        return attributes::make_attribute_value(decoder.get_string());
+    case binary_log::ptime_value:
+        {
+            const posix_time::ptime epoch(gregorian::date(1970, 1, 1));
+            return attributes::make_attribute_value(epoch + posix_time::microseconds(decoder.get< int64_t >()));
+        }
+    case binary_log::severity_value:
+        return attributes::make_attribute_value(static_cast< trivial::severity_level >(decoder.get< int32_t >()));
+#if !defined(BOOST_LOG_NO_THREADS)
+    case binary_log::thread_id_value:
+        return attributes::make_attribute_value(
+            log::aux::thread::id(static_cast< log::aux::thread::native_type >(decoder.get< uint64_t >())));
+#endif
+    case binary_log::process_id_value:
+        return attributes::make_attribute_value(
+            log::aux::process::id(static_cast< log::aux::process::native_type >(decoder.get< uint64_t >())));
+    default:
+        // The size of the value is not known, so the rest of the record cannot be decoded
+        BOOST_LOG_THROW_DESCR(parse_error, "Malformed binary log record: unsupported attribute value type");
+    }
+}
+
+} // namespace
+
+//! Reader implementation data
+struct binary_log_reader::implementation
+{
+    //! Attribute names, by their identifiers in the file
+    typedef std::map< uintmax_t, attribute_name > name_map;
+    //! Format strings and their identifiers in the reader, by their identifiers in the file
+    typedef std::map< uintmax_t, std::pair< uintmax_t, std::string > > format_map;
+
+    //! The stream
+    std::istream& m_Stream;
+    //! Indicates that the writer byte order differs from the native one
+    bool m_fSwapBytes;
+
+    name_map m_Names;
+    format_map m_Formats;
+    //! The number of format strings read so far
+    uintmax_t m_FormatCount;
+
+    //! Format identifier of the last read record
+    uintmax_t m_FormatID;
+    //! Format string of the last read record
+    std::string m_Format;
+
+    //! Entry body buffer
+    std::string m_Buffer;
+
+    explicit implementation(std::istream& strm) : m_Stream(strm), m_fSwapBytes(false), m_FormatCount(0), m_FormatID(0)
+    {
+    }
+
+    //! Reads the file header, returns \c false if the stream ends prematurely
+    bool read_header()
+    {
+        char header[sizeof(binary_log::signature) + 2u];
+        if (!read_bytes(header, sizeof(header)))
+            return false;
+        if (std::memcmp(header, binary_log::signature, sizeof(binary_log::signature)) != 0)
+            BOOST_LOG_THROW_DESCR(parse_error, "The stream does not contain a binary log");
+
+        const uint8_t version = static_cast< uint8_t >(header[sizeof(binary_log::signature)]);
+        if (version != binary_log::version)
+            BOOST_LOG_THROW_DESCR(parse_error, "Unsupported binary log format version");
+
+        const uint8_t byte_order = static_cast< uint8_t >(header[sizeof(binary_log::signature) + 1u]);
+        if (byte_order != binary_log::little_endian && byte_order != binary_log::big_endian)
+            BOOST_LOG_THROW_DESCR(parse_error, "Malformed binary log header: invalid byte order");
+        m_fSwapBytes = (byte_order != binary_log::native_byte_order);
+
+        // The file may have been appended by a different process, so the previous definitions are no longer valid
+        m_Names.clear();
+        m_Formats.clear();
+        return true;
+    }
+
+    //! Reads the specified number of bytes, returns \c false if the stream ends prematurely
+    bool read_bytes(char* p, std::streamsize size)
+    {
+        m_Stream.read(p, size);
+        return m_Stream.gcount() == size;
+    }
+
+    //! Reads an integer in the LEB128 encoding from the stream, returns \c false if the stream ends prematurely
+    bool read_varint(uintmax_t& n)
+    {
+        char buf[(sizeof(uintmax_t) * 8u + 6u) / 7u];
+        for (std::size_t i = 0; i < sizeof(buf); ++i)
+        {
+            if (!read_bytes(buf + i, 1))
+                return false;
+            if ((static_cast< uint8_t >(buf[i]) & 0x80u) == 0)
+            {
+                const char* p = buf;
+                binary_log::get_varint(p, buf + i + 1u, n);
+                return true;
+            }
+        }
+        BOOST_LOG_THROW_DESCR(parse_error, "Malformed binary log entry: invalid integer encoding");
+    }
+
+    //! Processes a name or a format string definition
+    void read_definition(binary_log::entry_type type)
+    {
+        record_decoder decoder(m_Buffer.data(), m_Buffer.data() + m_Buffer.size(), m_fSwapBytes);
+        const uintmax_t id = decoder.get_varint();
+        std::string str = decoder.get_string();
+        if (type == binary_log::name_entry)
+            m_Names[id] = attribute_name(str);
+        else
+        {
+            std::pair< uintmax_t, std::string >& format = m_Formats[id];
+            format.first = ++m_FormatCount;
+            format.second.swap(str);
+        }
+    }
+
+    //! Decodes a record
+    void read_record(attribute_value_set& values)
+    {
+        record_decoder decoder(m_Buffer.data(), m_Buffer.data() + m_Buffer.size(), m_fSwapBytes);
+        const uintmax_t format_id = decoder.get_varint();
+        format_map::const_iterator format = m_Formats.find(format_id);
+        if (format == m_Formats.end())
+            BOOST_LOG_THROW_DESCR(parse_error, "Malformed binary log record: undefined format string");
+
+        attribute_value_set new_values;
+        while (!decoder.at_end())
+        {
+            const uintmax_t name_id = decoder.get_varint();
+            name_map::const_iterator name = m_Names.find(name_id);
+            if (name == m_Names.end())
+                BOOST_LOG_THROW_DESCR(parse_error, "Malformed binary log record: undefined attribute name");
+            const uint8_t type = decoder.get_byte();
+            new_values.insert(name->second, decode_value(decoder, type));
+        }
+        new_values.freeze();
+
+        values.swap(new_values);
+        if (m_FormatID != format->second.first)
+        {
+            m_FormatID = format->second.first;
+            m_Format = format->second.second;
+        }
+    }
+};
+
+//! Constructor
+BOOST_LOG_API binary_log_reader::binary_log_reader(std::istream& strm) : m_pImpl(new implementation(strm))
+{
+    try
+    {
+        if (!m_pImpl->read_header())
+            BOOST_LOG_THROW_DESCR(parse_error, "The stream does not contain a binary log");
+    }
+    catch (...)
+    {
+        delete m_pImpl;
+        throw;
+    }
+}
+
+//! Destructor
+BOOST_LOG_API binary_log_reader::~binary_log_reader()
+{
+    delete m_pImpl;
+}
+
+//! The method reads the next record
+BOOST_LOG_API bool binary_log_reader::read_record(attribute_value_set& values)
+{
+    implementation* const impl = m_pImpl;
+    std::istream& strm = impl->m_Stream;
+    while (true)
+    {
+        const std::istream::pos_type pos = strm.tellg();
+
+        bool complete = false;
+        char type = 0;
+        if (impl->read_bytes(&type, 1))
+        {
+            if (type == binary_log::signature[0])
+            {
+                // A file header written by a writer that appended to the file
+                strm.seekg(pos);
+                complete = impl->read_header();
+                if (complete)
+                    continue;
+            }
+            else
+            {
+                uintmax_t size = 0;
+                if (impl->read_varint(size))
+                {
+                    impl->m_Buffer.resize(static_cast< std::size_t >(size));
+                    complete = size == 0 || impl->read_bytes(&impl->m_Buffer[0], static_cast< std::streamsize >(size));
+                }
+            }
+        }
+
+        if (!complete)
+        {
+            // Rewind to the beginning of the incomplete entry, so that the caller can retry when more data is available
+            strm.clear();
+            if (pos != std::istream::pos_type(-1))
+                strm.seekg(pos);
+            return false;
+        }
+
+        switch (static_cast< uint8_t >(type))
+        {
+        case binary_log::name_entry:
+        case binary_log::format_entry:
+            impl->read_definition(static_cast< binary_log::entry_type >(type));
+            break;
+
+        case binary_log::record_entry:
+            impl->read_record(values);
+            return true;
+
+        default:
+            // Entries of unknown types are skipped
+            break;
+        }
+    }
+}
+
+//! Returns the format identifier of the last read record
+BOOST_LOG_API uintmax_t binary_log_reader::format_id() const
+{
+    return m_pImpl->m_FormatID;
+}
+
+//! Returns the format string of the last read record
+BOOST_LOG_API std::string const& binary_log_reader::format() const
+{
+    return m_pImpl->m_Format;
+}
+
+BOOST_LOG_CLOSE_NAMESPACE // namespace log
+
+} // namespace boost
+
+#include <boost/log/detail/footer.hpp>
@@ -0,0 +1,586 @@
+/*
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   buffered_file_writer.cpp
+ *
+ * \brief  This header is the Boost.Log library implementation, see the library documentation
+ *         at http://www.boost.org/libs/log/doc/log.html.
+ */
+
+#include <cerrno>
+#include <cstdio>
+#include <utility>
+#include <algorithm>
+#include <boost/bind.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/throw_exception.hpp>
+#include <boost/system/error_code.hpp>
+#include <boost/filesystem/operations.hpp>
+#if !defined(BOOST_LOG_NO_THREADS)
+#include <boost/thread/thread_time.hpp>
+#endif
+#include "buffered_file_writer.hpp"
+
+#if defined(BOOST_WINDOWS) && !defined(__CYGWIN__)
+#include <io.h>
+#else
+#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/uio.h>
+#endif
+
+#include <boost/log/detail/header.hpp>
+
+namespace boost {
+
+BOOST_LOG_OPEN_NAMESPACE
+
+namespace sinks {
+
+namespace aux {
+
+namespace {
+
+//! The maximum number of filled buffers that are waiting to be written
+const std::size_t max_pending_buffers = 4;
+
+//! Data to be written
+typedef std::pair< const char*, std::size_t > const_buffer;
+
+} // namespace
+
+//! The file being written
+struct buffered_file_writer::file
+{
+    //! File name
+    const filesystem::path m_Name;
+    //! The flag indicates that the data was written since the last synchronization
+    bool m_Dirty;
+#if defined(BOOST_WINDOWS) && !defined(__CYGWIN__)
+    //! File handle
+    std::FILE* m_Handle;
+
+    file(filesystem::path const& name, std::ios_base::openmode mode) : m_Name(name), m_Dirty(false)
+    {
+        const wchar_t* file_mode;
+        if (mode & std::ios_base::binary)
+            file_mode = (mode & std::ios_base::app) ? L"ab" : L"wb";
+        else
+            file_mode = (mode & std::ios_base::app) ? L"a" : L"w";
+        m_Handle = _wfopen(name.c_str(), file_mode);
+        if (!m_Handle)
+            throw_error("Failed to open file for writing", errno);
+    }
+
+    //! Writes the buffers to the file
+    void write(const_buffer const* buffers, std::size_t count)
+    {
+        for (; count > 0; ++buffers, --count)
+        {
+            if (std::fwrite(buffers->first, 1, buffers->second, m_Handle) != buffers->second)
+                throw_error("Failed to write to file", errno);
+            m_Dirty = true;
+        }
+    }
+
+    //! Writes the file data to the storage device
+    void sync()
+    {
+        if (m_Dirty)
+        {
+            if (std::fflush(m_Handle) != 0 || _commit(_fileno(m_Handle)) != 0)
+                throw_error("Failed to flush file", errno);
+            m_Dirty = false;
+        }
+    }
+
+    //! Closes the file
+    void close()
+    {
+        if (m_Handle)
+        {
+            sync();
+            std::FILE* handle = m_Handle;
+            m_Handle = NULL;
+            if (std::fclose(handle) != 0)
+                throw_error("Failed to close file", errno);
+        }
+    }
+
+    ~file()
+    {
+        if (m_Handle)
+            std::fclose(m_Handle);
+    }
+#else
+    //! File descriptor
+    int m_Handle;
+
+    file(filesystem::path const& name, std::ios_base::openmode mode) : m_Name(name), m_Dirty(false)
+    {
+        int flags = O_WRONLY | O_CREAT | ((mode & std::ios_base::app) ? O_APPEND : O_TRUNC);
+#if defined(O_CLOEXEC)
+        flags |= O_CLOEXEC;
+#endif
+        m_Handle = ::open(name.c_str(), flags, 0666);
+        if (m_Handle < 0)
+            throw_error("Failed to open file for writing", errno);
+    }
+
+    //! Writes the buffers to the file, with as few system calls as possible
+    void write(const_buffer const* buffers, std::size_t count)
+    {
+#if defined(IOV_MAX) && IOV_MAX < 64
+        enum { max_iovecs = IOV_MAX };
+#else
+        enum { max_iovecs = 64 };
+#endif
+        // The number of bytes of the first buffer that have already been written
+        std::size_t offset = 0;
+        while (count > 0)
+        {
+            struct iovec iov[max_iovecs];
+            std::size_t n = 0;
+            for (; n < count && n < static_cast< std::size_t >(max_iovecs); ++n)
+            {
+                const std::size_t skip = n == 0 ? offset : 0u;
+                iov[n].iov_base = const_cast< char* >(buffers[n].first + skip);
+                iov[n].iov_len = buffers[n].second - skip;
+            }
+
+            const ssize_t res = ::writev(m_Handle, iov, static_cast< int >(n));
+            if (res < 0)
+            {
+                const int err = errno;
+                if (err == EINTR)
+                    continue;
+                throw_error("Failed to write to file", err);
+            }
+            m_Dirty = true;
+
+            // Skip the written data, the write may be partial
+            std::size_t written = static_cast< std::size_t >(res);
+            while (count > 0 && written >= buffers->second - offset)
+            {
+                written -= buffers->second - offset;
+                offset = 0;
+                ++buffers;
+                --count;
+            }
+            offset += written;
+        }
+    }
+
+    //! Writes the file data to the storage device
+    void sync()
+    {
+        if (m_Dirty)
+        {
+#if defined(_POSIX_SYNCHRONIZED_IO) && _POSIX_SYNCHRONIZED_IO > 0 && !defined(__APPLE__)
+            while (::fdatasync(m_Handle) != 0)
+#else
+            while (::fsync(m_Handle) != 0)
+#endif
+            {
+                const int err = errno;
+                if (err != EINTR)
+                    throw_error("Failed to flush file", err);
+            }
+            m_Dirty = false;
+        }
+    }
+
+    //! Closes the file
+    void close()
+    {
+        if (m_Handle >= 0)
+        {
+            sync();
+            const int handle = m_Handle;
+            m_Handle = -1;
+            if (::close(handle) != 0)
+                throw_error("Failed to close file", errno);
+        }
+    }
+
+    ~file()
+    {
+        if (m_Handle >= 0)
+            ::close(m_Handle);
+    }
+#endif
+
+    //! Throws an exception with the error code
+    void throw_error(const char* descr, int err) const
+    {
+        BOOST_THROW_EXCEPTION(filesystem::filesystem_error(descr, m_Name, system::error_code(err, system::system_category())));
+    }
+};
+
+//! A request for the background thread
+struct buffered_file_writer::request
+{
+    //! The file
+    shared_ptr< file > m_pFile;
+    //! The data to write
+    buffer_type m_Buffer;
+    //! The flag indicates that the file has to be closed
+    bool m_Close;
+    //! The handler to call after closing
+    close_handler_type m_CloseHandler;
+
+    request() : m_Close(false) {}
+};
+
+buffered_file_writer::writer_buf::int_type buffered_file_writer::writer_buf::overflow(int_type c)
+{
+    if (!traits_type::eq_int_type(c, traits_type::eof()))
+    {
+        const char_type ch = traits_type::to_char_type(c);
+        m_Writer.write(&ch, 1u);
+    }
+    return traits_type::not_eof(c);
+}
+
+std::streamsize buffered_file_writer::writer_buf::xsputn(const char_type* s, std::streamsize n)
+{
+    m_Writer.write(s, static_cast< std::size_t >(n));
+    return n;
+}
+
+//! Constructor
+buffered_file_writer::buffered_file_writer(std::size_t buffer_size, posix_time::time_duration const& flush_interval) :
+    m_BufferSize(buffer_size > 0u ? buffer_size : 1u),
+    m_FlushInterval(flush_interval),
+    m_Position(0),
+    m_StreamBuf(*this),
+    m_Stream(&m_StreamBuf),
+    m_PendingBufferCount(0),
+    m_FlushRequested(0),
+    m_FlushCompleted(0)
+#if !defined(BOOST_LOG_NO_THREADS)
+    , m_Stop(false)
+#endif
+{
+    m_Buffer.reserve(m_BufferSize);
+#if !defined(BOOST_LOG_NO_THREADS)
+    thread(boost::bind(&buffered_file_writer::thread_proc, this)).swap(m_Thread);
+#endif
+}
+
+//! Destructor
+buffered_file_writer::~buffered_file_writer()
+{
+    try
+    {
+        scoped_lock lock(m_Mutex);
+        if (!m_Buffer.empty())
+            submit_buffer(lock);
+        // The file will be closed when the submitted data is written
+        m_pFile.reset();
+#if !defined(BOOST_LOG_NO_THREADS)
+        m_Stop = true;
+        m_WriterCond.notify_one();
+#endif
+    }
+    catch (...)
+    {
+    }
+
+#if !defined(BOOST_LOG_NO_THREADS)
+    m_Thread.join();
+#endif
+}
+
+//! Opens the file
+uintmax_t buffered_file_writer::open(filesystem::path const& name, std::ios_base::openmode mode)
+{
+    shared_ptr< file > f;
+    {
+        scoped_lock lock(m_Mutex);
+#if !defined(BOOST_LOG_NO_THREADS)
+        // The file with the same name may not have been moved by the file collector yet
+        while (std::find(m_ClosingFiles.begin(), m_ClosingFiles.end(), name) != m_ClosingFiles.end())
+            m_CompletionCond.wait(lock);
+#endif
+        check_error();
+        f = boost::make_shared< file >(name, mode);
+        m_pFile = f;
+    }
+
+    system::error_code ec;
+    const uintmax_t size = filesystem::file_size(name, ec);
+    m_Position = ec ? 0u : size;
+    return m_Position;
+}
+
+//! Writes data to the open file
+void buffered_file_writer::write(const char* data, std::size_t size)
+{
+    scoped_lock lock(m_Mutex);
+    check_error();
+
+    if (!m_Buffer.empty() && m_Buffer.size() + size > m_BufferSize)
+        submit_buffer(lock);
+    m_Buffer.insert(m_Buffer.end(), data, data + size);
+    m_Position += size;
+    if (m_Buffer.size() >= m_BufferSize)
+        submit_buffer(lock);
+}
+
+//! Closes the file in the background thread
+void buffered_file_writer::close(close_handler_type const& handler)
+{
+    scoped_lock lock(m_Mutex);
+    if (!m_Buffer.empty())
+        submit_buffer(lock);
+
+    m_Requests.push_back(request());
+    request& req = m_Requests.back();
+    req.m_pFile.swap(m_pFile);
+    req.m_Close = true;
+    req.m_CloseHandler = handler;
+    m_ClosingFiles.push_back(req.m_pFile->m_Name);
+    m_Position = 0;
+
+#if !defined(BOOST_LOG_NO_THREADS)
+    m_WriterCond.notify_one();
+#else
+    request_list requests;
+    requests.swap(m_Requests);
+    m_Error = process_requests(requests, shared_ptr< file >());
+    complete_requests(requests);
+#endif
+
+    check_error();
+}
+
+//! Passes the buffered data to the background thread without waiting for it to be written
+void buffered_file_writer::submit()
+{
+    scoped_lock lock(m_Mutex);
+    check_error();
+    if (!m_Buffer.empty())
+        submit_buffer(lock);
+}
+
+//! Writes all buffered data to the file and synchronizes the file with the storage device
+void buffered_file_writer::flush()
+{
+    scoped_lock lock(m_Mutex);
+    check_error();
+    if (!m_Buffer.empty())
+        submit_buffer(lock);
+
+#if !defined(BOOST_LOG_NO_THREADS)
+    const uintmax_t flush_id = ++m_FlushRequested;
+    m_WriterCond.notify_one();
+    while (m_FlushCompleted < flush_id)
+        m_CompletionCond.wait(lock);
+#else
+    request_list requests;
+    m_Error = process_requests(requests, m_pFile);
+#endif
+
+    check_error();
+}
+
+//! Passes the filled buffer to the background thread
+void buffered_file_writer::submit_buffer(scoped_lock& lock)
+{
+#if !defined(BOOST_LOG_NO_THREADS)
+    // Limit the amount of memory occupied by the buffers being written
+    while (m_PendingBufferCount >= max_pending_buffers)
+        m_CompletionCond.wait(lock);
+#endif
+
+    m_Requests.push_back(request());
+    request& req = m_Requests.back();
+    req.m_pFile = m_pFile;
+    req.m_Buffer.swap(m_Buffer);
+    ++m_PendingBufferCount;
+
+    if (!m_FreeBuffers.empty())
+    {
+        m_Buffer.swap(m_FreeBuffers.back());
+        m_FreeBuffers.pop_back();
+    }
+    else
+    {
+        m_Buffer.reserve(m_BufferSize);
+    }
+
+#if !defined(BOOST_LOG_NO_THREADS)
+    m_WriterCond.notify_one();
+#else
+    request_list requests;
+    requests.swap(m_Requests);
+    m_Error = process_requests(requests, shared_ptr< file >());
+    complete_requests(requests);
+#endif
+}
+
+//! Rethrows the error that occurred in the background thread
+void buffered_file_writer::check_error()
+{
+    if (m_Error)
+    {
+        exception_ptr err = m_Error;
+        m_Error = exception_ptr();
+        rethrow_exception(err);
+    }
+}
+
+//! Processes the submitted requests
+exception_ptr buffered_file_writer::process_requests(request_list& requests, shared_ptr< file > const& sync_file)
+{
+    exception_ptr error;
+    std::vector< const_buffer > buffers;
+    request_list::iterator it = requests.begin(), end = requests.end();
+    while (it != end)
+    {
+        try
+        {
+            if (!it->m_Close)
+            {
+                // Write the consecutive buffers of the same file at once
+                file& f = *it->m_pFile;
+                buffers.clear();
+                for (; it != end && !it->m_Close && it->m_pFile.get() == &f; ++it)
+                    buffers.push_back(const_buffer(it->m_Buffer.empty() ? NULL : &it->m_Buffer[0], it->m_Buffer.size()));
+                f.write(&buffers[0], buffers.size());
+            }
+            else
+            {
+                request& req = *it++;
+                req.m_pFile->close();
+                if (!req.m_CloseHandler.empty())
+                    req.m_CloseHandler(req.m_pFile->m_Name);
+            }
+        }
+        catch (...)
+        {
+            if (!error)
+                error = current_exception();
+        }
+    }
+
+    if (sync_file)
+    {
+        try
+        {
+            sync_file->sync();
+        }
+        catch (...)
+        {
+            if (!error)
+                error = current_exception();
+        }
+    }
+
+    return error;
+}
+
+//! Returns the buffers of the processed requests for reuse
+void buffered_file_writer::complete_requests(request_list& requests)
+{
+    request_list::iterator it = requests.begin(), end = requests.end();
+    for (; it != end; ++it)
+    {
+        if (!it->m_Close)
+        {
+            --m_PendingBufferCount;
+            if (m_FreeBuffers.size() < max_pending_buffers)
+            {
+                it->m_Buffer.clear();
+                m_FreeBuffers.push_back(buffer_type());
+                m_FreeBuffers.back().swap(it->m_Buffer);
+            }
+        }
+        else
+        {
+            std::vector< filesystem::path >::iterator closing = std::find(m_ClosingFiles.begin(), m_ClosingFiles.end(), it->m_pFile->m_Name);
+            if (closing != m_ClosingFiles.end())
+                m_ClosingFiles.erase(closing);
+        }
+    }
+}
+
+#if !defined(BOOST_LOG_NO_THREADS)
+
+//! Background thread function
+void buffered_file_writer::thread_proc()
+{
+    const bool periodic_flush = !m_FlushInterval.is_special();
+    system_time next_flush_time = get_system_time();
+    if (periodic_flush)
+        next_flush_time += m_FlushInterval;
+
+    scoped_lock lock(m_Mutex);
+    while (true)
+    {
+        if (m_Requests.empty() && m_FlushCompleted == m_FlushRequested)
+        {
+            if (m_Stop)
+                break;
+            if (periodic_flush)
+                m_WriterCond.timed_wait(lock, next_flush_time);
+            else
+                m_WriterCond.wait(lock);
+        }
+
+        bool sync = m_FlushCompleted != m_FlushRequested;
+        if (periodic_flush && get_system_time() >= next_flush_time)
+        {
+            // Write the partially filled buffer as well
+            if (!m_Buffer.empty())
+            {
+                m_Requests.push_back(request());
+                request& req = m_Requests.back();
+                req.m_pFile = m_pFile;
+                req.m_Buffer.swap(m_Buffer);
+                ++m_PendingBufferCount;
+                m_Buffer.reserve(m_BufferSize);
+            }
+            sync = true;
+            next_flush_time = get_system_time() + m_FlushInterval;
+        }
+
+        if (m_Requests.empty() && !sync)
+            continue;
+
+        const uintmax_t flush_id = m_FlushRequested;
+        shared_ptr< file > sync_file;
+        if (sync)
+            sync_file = m_pFile;
+        request_list requests;
+        requests.swap(m_Requests);
+
+        lock.unlock();
+        exception_ptr error = process_requests(requests, sync_file);
+        sync_file.reset();
+        lock.lock();
+
+        if (error && !m_Error)
+            m_Error = error;
+        complete_requests(requests);
+        m_FlushCompleted = flush_id;
+        m_CompletionCond.notify_all();
+    }
+}
+
+#endif // !defined(BOOST_LOG_NO_THREADS)
+
+} // namespace aux
+
+} // namespace sinks
+
+BOOST_LOG_CLOSE_NAMESPACE // namespace log
+
+} // namespace boost
+
+#include <boost/log/detail/footer.hpp>
@@ -0,0 +1,223 @@
+/*
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   buffered_file_writer.hpp
+ *
+ * \brief  This header is the Boost.Log library implementation, see the library documentation
+ *         at http://www.boost.org/libs/log/doc/log.html.
+ */
+
+#ifndef BOOST_LOG_BUFFERED_FILE_WRITER_HPP_INCLUDED_
+#define BOOST_LOG_BUFFERED_FILE_WRITER_HPP_INCLUDED_
+
+#include <list>
+#include <vector>
+#include <cstddef>
+#include <ostream>
+#include <streambuf>
+#include <ios>
+#include <boost/cstdint.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/exception_ptr.hpp>
+#include <boost/filesystem/path.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/log/detail/config.hpp>
+#include <boost/log/detail/light_function.hpp>
+#if !defined(BOOST_LOG_NO_THREADS)
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/condition_variable.hpp>
+#else
+#include <boost/log/detail/fake_mutex.hpp>
+#endif
+#include <boost/log/detail/header.hpp>
+
+#ifdef BOOST_LOG_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+namespace boost {
+
+BOOST_LOG_OPEN_NAMESPACE
+
+namespace sinks {
+
+namespace aux {
+
+/*!
+ * The class accumulates the written data in large buffers and passes the full buffers to a background
+ * thread, which writes them to the file with as few system calls as possible. Closing a file is also
+ * performed by the background thread, so file rotation does not block the writing thread.
+ *
+ * The methods of the class must not be called concurrently, except that the background thread runs
+ * concurrently with the writing thread. Errors that occur in the background thread are reported by
+ * the following \c write, \c close or \c flush call.
+ */
+class buffered_file_writer
+{
+public:
+    //! Handler that is called by the background thread after a file is closed
+    typedef boost::log::aux::light_function< void (filesystem::path const&) > close_handler_type;
+
+private:
+    struct file;
+    struct request;
+    typedef std::list< request > request_list;
+    typedef std::vector< char > buffer_type;
+
+#if !defined(BOOST_LOG_NO_THREADS)
+    typedef boost::mutex mutex_type;
+    typedef unique_lock< mutex_type > scoped_lock;
+#else
+    typedef boost::log::aux::fake_mutex mutex_type;
+    struct scoped_lock
+    {
+        explicit scoped_lock(mutex_type&) {}
+    };
+#endif
+
+    //! Stream buffer that passes the written data to the writer
+    class writer_buf :
+        public std::streambuf
+    {
+    private:
+        buffered_file_writer& m_Writer;
+
+    public:
+        explicit writer_buf(buffered_file_writer& writer) : m_Writer(writer) {}
+
+    protected:
+        int_type overflow(int_type c);
+        std::streamsize xsputn(const char_type* s, std::streamsize n);
+    };
+
+private:
+    //! The buffer size
+    const std::size_t m_BufferSize;
+    //! Periodic flush interval
+    const posix_time::time_duration m_FlushInterval;
+
+    //! Currently open file
+    shared_ptr< file > m_pFile;
+    //! The size of the current file, including the buffered data
+    uintmax_t m_Position;
+    //! The stream buffer that writes to the current file
+    writer_buf m_StreamBuf;
+    //! The stream that writes to the current file
+    std::ostream m_Stream;
+
+    //! Synchronization mutex
+    mutex_type m_Mutex;
+#if !defined(BOOST_LOG_NO_THREADS)
+    //! The condition is signalled when there are requests for the background thread
+    condition_variable m_WriterCond;
+    //! The condition is signalled when the background thread completes requests
+    condition_variable m_CompletionCond;
+#endif
+
+    //! The buffer being filled
+    buffer_type m_Buffer;
+    //! The requests to be processed by the background thread
+    request_list m_Requests;
+    //! Buffers available for reuse
+    std::vector< buffer_type > m_FreeBuffers;
+    //! The number of full buffers being written
+    std::size_t m_PendingBufferCount;
+    //! Names of the files that are being closed
+    std::vector< filesystem::path > m_ClosingFiles;
+    //! The number of the last requested flush
+    uintmax_t m_FlushRequested;
+    //! The number of the last completed flush
+    uintmax_t m_FlushCompleted;
+    //! The error that occurred in the background thread
+    exception_ptr m_Error;
+
+#if !defined(BOOST_LOG_NO_THREADS)
+    //! The flag is set when the background thread has to terminate
+    bool m_Stop;
+    //! The background thread
+    thread m_Thread;
+#endif
+
+public:
+    /*!
+     * Constructor. If the flush interval is not \c posix_time::not_a_date_time, the written data is
+     * periodically written to the file and synchronized with the storage device.
+     */
+    buffered_file_writer(std::size_t buffer_size, posix_time::time_duration const& flush_interval);
+    /*!
+     * Destructor. Writes all buffered data and closes the file.
+     */
+    ~buffered_file_writer();
+
+    //! Returns the buffer size
+    std::size_t buffer_size() const { return m_BufferSize; }
+    //! Returns the periodic flush interval
+    posix_time::time_duration const& flush_interval() const { return m_FlushInterval; }
+
+    //! Returns \c true if a file is open
+    bool is_open() const { return !!m_pFile; }
+    //! Returns the stream that writes to the open file
+    std::ostream& stream() { return m_Stream; }
+    //! Returns the size of the open file, including the data that has not been written yet
+    uintmax_t position() const { return m_Position; }
+
+    /*!
+     * Opens the file. If the file with the same name is being closed, the method waits until it is closed.
+     *
+     * \return The size of the file after opening.
+     */
+    uintmax_t open(filesystem::path const& name, std::ios_base::openmode mode);
+    /*!
+     * Writes data to the open file
+     */
+    void write(const char* data, std::size_t size);
+    /*!
+     * Writes all buffered data and closes the file in the background thread. After closing the handler is called.
+     */
+    void close(close_handler_type const& handler);
+    /*!
+     * Passes the buffered data to the background thread, which writes it to the file. The method does not
+     * wait for the data to be written and does not synchronize the file with the storage device. It only
+     * blocks if too many buffers are already waiting to be written.
+     */
+    void submit();
+    /*!
+     * Writes all buffered data to the file and synchronizes the file with the storage device. The method
+     * blocks until the operation completes.
+     */
+    void flush();
+
+    BOOST_LOG_DELETED_FUNCTION(buffered_file_writer(buffered_file_writer const&))
+    BOOST_LOG_DELETED_FUNCTION(buffered_file_writer& operator= (buffered_file_writer const&))
+
+private:
+    //! Passes the filled buffer to the background thread
+    void submit_buffer(scoped_lock& lock);
+    //! Rethrows the error that occurred in the background thread
+    void check_error();
+    //! Processes the submitted requests, returns the first error that occurred
+    static exception_ptr process_requests(request_list& requests, shared_ptr< file > const& sync_file);
+    //! Returns the buffers of the processed requests for reuse
+    void complete_requests(request_list& requests);
+#if !defined(BOOST_LOG_NO_THREADS)
+    //! Background thread function
+    void thread_proc();
+#endif
+};
+
+} // namespace aux
+
+} // namespace sinks
+
+BOOST_LOG_CLOSE_NAMESPACE // namespace log
+
+} // namespace boost
+
+#include <boost/log/detail/footer.hpp>
+
+#endif // BOOST_LOG_BUFFERED_FILE_WRITER_HPP_INCLUDED_
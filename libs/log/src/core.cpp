@@ -20,6 +20,7 @@
 #include <algorithm>
 #include <boost/cstdint.hpp>
 #include <boost/assert.hpp>
+#include <boost/integer_traits.hpp>
 #include <boost/weak_ptr.hpp>
 #include <boost/shared_ptr.hpp>
 #include <boost/make_shared.hpp>
@@ -32,6 +33,8 @@
 #include <boost/log/sinks/sink.hpp>
 #include <boost/log/attributes/attribute_value_set.hpp>
 #include <boost/log/detail/singleton.hpp>
+#include <boost/log/detail/severity_threshold.hpp>
+#include <boost/log/utility/type_info_wrapper.hpp>
 #if !defined(BOOST_LOG_NO_THREADS)
 #include <boost/thread/tss.hpp>
 #include <boost/thread/exceptions.hpp>
@@ -210,6 +213,25 @@ public:
         attribute_set m_thread_attributes;
     };
 
+    //! Cached severity threshold for a severity attribute
+    struct severity_threshold_entry
+    {
+        //! Severity attribute name
+        const attribute_name m_name;
+        //! Severity level type
+        const type_info_wrapper m_value_type;
+        //! The threshold
+        log::aux::severity_threshold_cache m_cache;
+
+        severity_threshold_entry(attribute_name const& name, type_info_wrapper const& value_type) :
+            m_name(name),
+            m_value_type(value_type)
+        {
+        }
+    };
+    //! Severity thresholds container type
+    typedef std::vector< shared_ptr< severity_threshold_entry > > severity_threshold_list;
+
 public:
 #if !defined(BOOST_LOG_NO_THREADS)
     //! Synchronization mutex
@@ -245,6 +267,9 @@ public:
     //! Exception handler
     exception_handler_type m_exception_handler;
 
+    //! Cached severity thresholds
+    severity_threshold_list m_severity_thresholds;
+
 public:
     //! Constructor
     implementation() :
@@ -374,6 +399,56 @@ public:
         return p;
     }
 
+    //! Updates the cached severity threshold. Must be called with the write lock held.
+    void update_severity_threshold(severity_threshold_entry& entry) const
+    {
+        const intmax_t global_level = get_threshold_level(m_filter.get_severity_threshold(), entry);
+
+        // The record has to pass at least one of the sinks
+        intmax_t sink_level = integer_traits< intmax_t >::const_max;
+        if (!m_sinks.empty())
+        {
+            sink_list::const_iterator it = m_sinks.begin(), end = m_sinks.end();
+            for (; it != end && sink_level > integer_traits< intmax_t >::const_min; ++it)
+                sink_level = (std::min)(sink_level, get_threshold_level((*it)->get_severity_threshold(), entry));
+        }
+        else
+        {
+            sink_level = get_threshold_level(m_default_sink->get_severity_threshold(), entry);
+        }
+
+        entry.m_cache.set_level((std::max)(global_level, sink_level));
+    }
+
+    //! Returns the cached severity threshold or \c NULL if it is not cached yet. Must be called with the lock held.
+    log::aux::severity_threshold_cache const* find_severity_threshold(attribute_name const& name, type_info_wrapper const& value_type) const
+    {
+        severity_threshold_list::const_iterator it = m_severity_thresholds.begin(), end = m_severity_thresholds.end();
+        for (; it != end; ++it)
+        {
+            if ((*it)->m_name == name && (*it)->m_value_type == value_type)
+                return &(*it)->m_cache;
+        }
+        return NULL;
+    }
+
+    //! Updates all cached severity thresholds. Must be called with the write lock held.
+    void update_severity_thresholds() const
+    {
+        severity_threshold_list::const_iterator it = m_severity_thresholds.begin(), end = m_severity_thresholds.end();
+        for (; it != end; ++it)
+            update_severity_threshold(**it);
+    }
+
+    //! Returns the lowest severity level the filter with the threshold may pass
+    static intmax_t get_threshold_level(log::aux::severity_threshold const& threshold, severity_threshold_entry const& entry)
+    {
+        if (threshold.applies_to(entry.m_name, entry.m_value_type))
+            return threshold.level;
+        else
+            return integer_traits< intmax_t >::const_min;
+    }
+
     //! The function initializes the logging system
     static void init_instance()
     {
@@ -446,7 +521,11 @@ BOOST_LOG_API void core::add_sink(shared_ptr< sinks::sink > const& s)
     implementation::sink_list::iterator it =
         std::find(m_impl->m_sinks.begin(), m_impl->m_sinks.end(), s);
     if (it == m_impl->m_sinks.end())
+    {
         m_impl->m_sinks.push_back(s);
+        s->set_registered(true);
+    }
+    m_impl->update_severity_thresholds();
 }
 
 //! The method removes the sink from the output
@@ -456,14 +535,54 @@ BOOST_LOG_API void core::remove_sink(shared_ptr< sinks::sink > const& s)
     implementation::sink_list::iterator it =
         std::find(m_impl->m_sinks.begin(), m_impl->m_sinks.end(), s);
     if (it != m_impl->m_sinks.end())
+    {
         m_impl->m_sinks.erase(it);
+        s->set_registered(false);
+    }
+    m_impl->update_severity_thresholds();
 }
 
 //! The method removes all registered sinks from the output
 BOOST_LOG_API void core::remove_all_sinks()
 {
     BOOST_LOG_EXPR_IF_MT(implementation::scoped_write_lock lock(m_impl->m_mutex);)
+    implementation::sink_list::iterator it = m_impl->m_sinks.begin(), end = m_impl->m_sinks.end();
+    for (; it != end; ++it)
+        (*it)->set_registered(false);
     m_impl->m_sinks.clear();
+    m_impl->update_severity_thresholds();
+}
+
+//! The method returns the cached severity threshold
+BOOST_LOG_API log::aux::severity_threshold_cache const&
+core::get_severity_threshold(attribute_name const& name, type_info_wrapper const& value_type)
+{
+    {
+        // Loggers are often created in large numbers, so the existing entries are looked up with the shared lock
+        BOOST_LOG_EXPR_IF_MT(implementation::scoped_read_lock lock(m_impl->m_mutex);)
+        log::aux::severity_threshold_cache const* p = m_impl->find_severity_threshold(name, value_type);
+        if (p)
+            return *p;
+    }
+
+    BOOST_LOG_EXPR_IF_MT(implementation::scoped_write_lock lock(m_impl->m_mutex);)
+    // The entry may have been added while the lock was released
+    log::aux::severity_threshold_cache const* p = m_impl->find_severity_threshold(name, value_type);
+    if (p)
+        return *p;
+
+    shared_ptr< implementation::severity_threshold_entry > entry =
+        boost::make_shared< implementation::severity_threshold_entry >(name, value_type);
+    m_impl->update_severity_threshold(*entry);
+    m_impl->m_severity_thresholds.push_back(entry);
+    return entry->m_cache;
+}
+
+//! The method updates the cached severity thresholds
+BOOST_LOG_API void core::update_severity_thresholds()
+{
+    BOOST_LOG_EXPR_IF_MT(implementation::scoped_write_lock lock(m_impl->m_mutex);)
+    m_impl->update_severity_thresholds();
 }
 
 
@@ -529,6 +648,7 @@ BOOST_LOG_API void core::set_filter(filter const& filter)
 {
     BOOST_LOG_EXPR_IF_MT(implementation::scoped_write_lock lock(m_impl->m_mutex);)
     m_impl->m_filter = filter;
+    m_impl->update_severity_thresholds();
 }
 
 //! The method removes the global logging filter
@@ -536,6 +656,7 @@ BOOST_LOG_API void core::reset_filter()
 {
     BOOST_LOG_EXPR_IF_MT(implementation::scoped_write_lock lock(m_impl->m_mutex);)
     m_impl->m_filter.reset();
+    m_impl->update_severity_thresholds();
 }
 
 //! The method sets exception handler function
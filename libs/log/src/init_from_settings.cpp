@@ -383,6 +383,19 @@ public:
             backend->auto_flush(param_cast_to_bool("AutoFlush", auto_flush_param.get()));
         }
 
+        // Output buffer size
+        if (optional< string_type > buffer_size_param = params["BufferSize"])
+        {
+            backend->set_buffer_size(param_cast_to_int< std::size_t >("BufferSize", buffer_size_param.get()));
+
+            // Periodic flush interval
+            if (optional< string_type > flush_interval_param = params["FlushInterval"])
+            {
+                backend->set_flush_interval(
+                    posix_time::seconds(param_cast_to_int< unsigned int >("FlushInterval", flush_interval_param.get())));
+            }
+        }
+
         // Append
         if (optional< string_type > append_param = params["Append"])
         {
@@ -406,10 +419,27 @@ public:
             if (optional< string_type > min_space_param = params["MinFreeSpace"])
                 space = param_cast_to_int< uintmax_t >("MinFreeSpace", min_space_param.get());
 
+            // Compression method
+            sinks::file::compression_method compression = sinks::file::no_compression;
+            if (optional< string_type > compression_param = params["Compression"])
+            {
+                string_type const& value = compression_param.get();
+                if (value == constants::compression_gzip())
+                    compression = sinks::file::gzip_compression;
+                else if (value == constants::compression_bzip2())
+                    compression = sinks::file::bzip2_compression;
+                else if (value != constants::compression_none())
+                {
+                    BOOST_LOG_THROW_DESCR(invalid_value,
+                        "File compression method \"" + boost::log::aux::to_narrow(value) + "\" is not supported");
+                }
+            }
+
             backend->set_file_collector(sinks::file::make_collector(
                 keywords::target = target_dir,
                 keywords::max_size = max_size,
-                keywords::min_free_space = space));
+                keywords::min_free_space = space,
+                keywords::compression = compression));
 
             // Scan for log files
             if (optional< string_type > scan_param = params["ScanForFiles"])
@@ -107,6 +107,10 @@ struct char_constants< char >
     static const char_type* scan_method_all() { return "All"; }
     static const char_type* scan_method_matching() { return "Matching"; }
 
+    static const char_type* compression_none() { return "None"; }
+    static const char_type* compression_gzip() { return "Gzip"; }
+    static const char_type* compression_bzip2() { return "Bzip2"; }
+
     static const char_type* registration_never() { return "Never"; }
     static const char_type* registration_on_demand() { return "OnDemand"; }
     static const char_type* registration_forced() { return "Forced"; }
@@ -223,6 +227,10 @@ struct char_constants< wchar_t >
     static const char_type* scan_method_all() { return L"All"; }
     static const char_type* scan_method_matching() { return L"Matching"; }
 
+    static const char_type* compression_none() { return L"None"; }
+    static const char_type* compression_gzip() { return L"Gzip"; }
+    static const char_type* compression_bzip2() { return L"Bzip2"; }
+
     static const char_type* registration_never() { return L"Never"; }
     static const char_type* registration_on_demand() { return L"OnDemand"; }
     static const char_type* registration_forced() { return L"Forced"; }
@@ -31,6 +31,7 @@
 #include <stdexcept>
 #include <boost/ref.hpp>
 #include <boost/bind.hpp>
+#include <boost/scoped_ptr.hpp>
 #include <boost/make_shared.hpp>
 #include <boost/enable_shared_from_this.hpp>
 #include <boost/throw_exception.hpp>
@@ -58,10 +59,20 @@
 #include <boost/log/attributes/time_traits.hpp>
 #include <boost/log/sinks/text_file_backend.hpp>
 #include <boost/log/sinks/text_multifile_backend.hpp>
+#include "buffered_file_writer.hpp"
+
+#if defined(BOOST_LOG_WITH_COMPRESSION)
+#include <boost/iostreams/copy.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+#include <boost/iostreams/filter/gzip.hpp>
+#include <boost/iostreams/filter/bzip2.hpp>
+#endif // defined(BOOST_LOG_WITH_COMPRESSION)
 
 #if !defined(BOOST_LOG_NO_THREADS)
 #include <boost/thread/locks.hpp>
 #include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/condition_variable.hpp>
 #endif // !defined(BOOST_LOG_NO_THREADS)
 
 #include <boost/log/detail/header.hpp>
@@ -109,6 +120,73 @@ BOOST_LOG_ANONYMOUS_NAMESPACE {
 
     typedef filesystem::filesystem_error filesystem_error;
 
+    //! Returns the extension that is appended to the names of the compressed files
+    inline const char* compressed_file_extension(file::compression_method method)
+    {
+        switch (method)
+        {
+        case file::gzip_compression:
+            return ".gz";
+        case file::bzip2_compression:
+            return ".bz2";
+        default:
+            return "";
+        }
+    }
+
+    //! Writes the compressed contents of the file to another file
+    void compress_file(
+        filesystem::path const& from,
+        filesystem::path const& to,
+        file::compression_method method)
+    {
+#if defined(BOOST_LOG_WITH_COMPRESSION)
+        filesystem::ifstream src(from, std::ios_base::in | std::ios_base::binary);
+        if (!src.is_open())
+        {
+            filesystem_error err(
+                "Failed to open file for compression",
+                from,
+                system::error_code(system::errc::io_error, system::generic_category()));
+            BOOST_THROW_EXCEPTION(err);
+        }
+
+        filesystem::ofstream dst(to, std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
+        if (!dst.is_open())
+        {
+            filesystem_error err(
+                "Failed to open file for writing",
+                to,
+                system::error_code(system::errc::io_error, system::generic_category()));
+            BOOST_THROW_EXCEPTION(err);
+        }
+
+        {
+            iostreams::filtering_ostream strm;
+            if (method == file::gzip_compression)
+                strm.push(iostreams::gzip_compressor());
+            else
+                strm.push(iostreams::bzip2_compressor());
+            strm.push(dst);
+            // The filter chain is flushed and closed when the copying completes
+            iostreams::copy(src, strm);
+        }
+
+        dst.close();
+        if (src.bad() || dst.fail())
+        {
+            filesystem_error err(
+                "Failed to compress file",
+                from,
+                to,
+                system::error_code(system::errc::io_error, system::generic_category()));
+            BOOST_THROW_EXCEPTION(err);
+        }
+#else
+        BOOST_LOG_THROW_DESCR(setup_error, "Boost.Log was built without compression support");
+#endif // defined(BOOST_LOG_WITH_COMPRESSION)
+    }
+
     //! An auxiliary traits that contain various constants and functions regarding string and character operations
     template< typename CharT >
     struct file_char_traits;
@@ -489,9 +567,19 @@ BOOST_LOG_ANONYMOUS_NAMESPACE {
             uintmax_t m_Size;
             std::time_t m_TimeStamp;
             filesystem::path m_Path;
+            //! The file is to be compressed into this file, empty if the file is not being compressed
+            filesystem::path m_CompressedPath;
         };
         //! A list of the stored files
         typedef std::list< file_info > file_list;
+        //! Information about a file to be compressed
+        struct compression_task
+        {
+            file_info m_File;
+            file::compression_method m_Method;
+        };
+        //! A list of the files to be compressed
+        typedef std::list< compression_task > compression_queue;
         //! The string type compatible with the universal path type
         typedef filesystem::path::string_type path_string_type;
 
@@ -508,6 +596,8 @@ BOOST_LOG_ANONYMOUS_NAMESPACE {
         uintmax_t m_MaxSize;
         //! Free space lower limit
         uintmax_t m_MinFreeSpace;
+        //! Compression method of the stored files
+        file::compression_method m_Compression;
         //! The current path at the point when the collector is created
         /*
          * The special member is required to calculate absolute paths with no
@@ -522,13 +612,25 @@ BOOST_LOG_ANONYMOUS_NAMESPACE {
         //! Total size of the stored files
         uintmax_t m_TotalSize;
 
+        //! The files waiting to be compressed
+        compression_queue m_CompressionQueue;
+#if !defined(BOOST_LOG_NO_THREADS)
+        //! The condition is signalled when files are added to the compression queue
+        condition_variable m_CompressionCond;
+        //! The flag is set when the compression thread has to terminate
+        bool m_StopCompression;
+        //! The thread that compresses the stored files
+        thread m_CompressionThread;
+#endif // !defined(BOOST_LOG_NO_THREADS)
+
     public:
         //! Constructor
         file_collector(
             shared_ptr< file_collector_repository > const& repo,
             filesystem::path const& target_dir,
             uintmax_t max_size,
-            uintmax_t min_free_space);
+            uintmax_t min_free_space,
+            file::compression_method compression);
 
         //! Destructor
         ~file_collector();
@@ -541,7 +643,7 @@ BOOST_LOG_ANONYMOUS_NAMESPACE {
             file::scan_method method, filesystem::path const& pattern, unsigned int* counter);
 
         //! The function updates storage restrictions
-        void update(uintmax_t max_size, uintmax_t min_free_space);
+        void update(uintmax_t max_size, uintmax_t min_free_space, file::compression_method compression);
 
         //! The function checks if the directory is governed by this collector
         bool is_governed(filesystem::path const& dir) const
@@ -560,6 +662,12 @@ BOOST_LOG_ANONYMOUS_NAMESPACE {
         {
             return p.filename().string< path_string_type >();
         }
+        //! Compresses the stored file and updates the file information
+        void compress_stored_file(compression_task const& task);
+#if !defined(BOOST_LOG_NO_THREADS)
+        //! Compression thread function
+        void compression_thread_proc();
+#endif // !defined(BOOST_LOG_NO_THREADS)
     };
 
 
@@ -594,7 +702,10 @@ BOOST_LOG_ANONYMOUS_NAMESPACE {
     public:
         //! Finds or creates a file collector
         shared_ptr< file::collector > get_collector(
-            filesystem::path const& target_dir, uintmax_t max_size, uintmax_t min_free_space);
+            filesystem::path const& target_dir,
+            uintmax_t max_size,
+            uintmax_t min_free_space,
+            file::compression_method compression);
 
         //! Removes the file collector from the list
         void remove_collector(file_collector* p);
@@ -612,13 +723,18 @@ BOOST_LOG_ANONYMOUS_NAMESPACE {
         shared_ptr< file_collector_repository > const& repo,
         filesystem::path const& target_dir,
         uintmax_t max_size,
-        uintmax_t min_free_space
+        uintmax_t min_free_space,
+        file::compression_method compression
     ) :
         m_pRepository(repo),
         m_MaxSize(max_size),
         m_MinFreeSpace(min_free_space),
+        m_Compression(compression),
         m_BasePath(filesystem::current_path()),
         m_TotalSize(0)
+#if !defined(BOOST_LOG_NO_THREADS)
+        , m_StopCompression(false)
+#endif // !defined(BOOST_LOG_NO_THREADS)
     {
         m_StorageDir = make_absolute(target_dir);
         filesystem::create_directories(m_StorageDir);
@@ -627,6 +743,17 @@ BOOST_LOG_ANONYMOUS_NAMESPACE {
     //! Destructor
     file_collector::~file_collector()
     {
+#if !defined(BOOST_LOG_NO_THREADS)
+        // Let the compression thread process the remaining files
+        {
+            lock_guard< mutex > lock(m_Mutex);
+            m_StopCompression = true;
+            m_CompressionCond.notify_one();
+        }
+        if (m_CompressionThread.joinable())
+            m_CompressionThread.join();
+#endif // !defined(BOOST_LOG_NO_THREADS)
+
         m_pRepository->remove_collector(this);
     }
 
@@ -641,6 +768,13 @@ BOOST_LOG_ANONYMOUS_NAMESPACE {
         path_string_type file_name = filename_string(src_path);
         info.m_Path = m_StorageDir / file_name;
 
+        file::compression_method compression;
+        {
+            BOOST_LOG_EXPR_IF_MT(lock_guard< mutex > lock(m_Mutex);)
+            compression = m_Compression;
+        }
+        const char* extension = compressed_file_extension(compression);
+
         // Check if the file is already in the target directory
         filesystem::path src_dir = src_path.has_parent_path() ?
                             filesystem::system_complete(src_path.parent_path()) :
@@ -648,7 +782,7 @@ BOOST_LOG_ANONYMOUS_NAMESPACE {
         const bool is_in_target_dir = filesystem::equivalent(src_dir, m_StorageDir);
         if (!is_in_target_dir)
         {
-            if (filesystem::exists(info.m_Path))
+            if (filesystem::exists(info.m_Path) || (*extension && filesystem::exists(info.m_Path.string() + extension)))
             {
                 // If the file already exists, try to mangle the file name
                 // to ensure there's no conflict. I'll need to make this customizable some day.
@@ -659,13 +793,17 @@ BOOST_LOG_ANONYMOUS_NAMESPACE {
                     path_string_type alt_file_name = formatter(file_name, n++);
                     info.m_Path = m_StorageDir / alt_file_name;
                 }
-                while (filesystem::exists(info.m_Path) && n < (std::numeric_limits< unsigned int >::max)());
+                while ((filesystem::exists(info.m_Path) || (*extension && filesystem::exists(info.m_Path.string() + extension))) &&
+                    n < (std::numeric_limits< unsigned int >::max)());
             }
 
             // The directory should have been created in constructor, but just in case it got deleted since then...
             filesystem::create_directories(m_StorageDir);
         }
 
+        if (*extension)
+            info.m_CompressedPath = info.m_Path.string() + extension;
+
         BOOST_LOG_EXPR_IF_MT(lock_guard< mutex > lock(m_Mutex);)
 
         // Check if an old file should be erased
@@ -709,8 +847,112 @@ BOOST_LOG_ANONYMOUS_NAMESPACE {
 
         m_Files.push_back(info);
         m_TotalSize += info.m_Size;
+
+        if (!info.m_CompressedPath.empty())
+        {
+            // The file size is updated when the file is compressed
+            compression_task task;
+            task.m_File = info;
+            task.m_Method = compression;
+#if !defined(BOOST_LOG_NO_THREADS)
+            m_CompressionQueue.push_back(task);
+            if (!m_CompressionThread.joinable())
+                thread(boost::bind(&file_collector::compression_thread_proc, this)).swap(m_CompressionThread);
+            else
+                m_CompressionCond.notify_one();
+#else
+            compress_stored_file(task);
+#endif // !defined(BOOST_LOG_NO_THREADS)
+        }
     }
 
+    //! Compresses the stored file and updates the file information
+    void file_collector::compress_stored_file(compression_task const& task)
+    {
+        file_info const& info = task.m_File;
+        bool compressed = false;
+        try
+        {
+            compress_file(info.m_Path, info.m_CompressedPath, task.m_Method);
+            // Preserve the chronological order of the stored files for scanning
+            filesystem::last_write_time(info.m_CompressedPath, info.m_TimeStamp);
+            compressed = true;
+        }
+        catch (std::exception&)
+        {
+            // Leave the file uncompressed
+            system::error_code ec;
+            filesystem::remove(info.m_CompressedPath, ec);
+        }
+
+        BOOST_LOG_EXPR_IF_MT(lock_guard< mutex > lock(m_Mutex);)
+
+        file_list::iterator it = m_Files.begin(), end = m_Files.end();
+        for (; it != end; ++it)
+        {
+            if (it->m_Path == info.m_Path && it->m_CompressedPath == info.m_CompressedPath)
+                break;
+        }
+
+        system::error_code ec;
+        if (it == end)
+        {
+            // The file has been erased while it was being compressed
+            if (compressed)
+                filesystem::remove(info.m_CompressedPath, ec);
+            return;
+        }
+
+        it->m_CompressedPath.clear();
+        if (compressed)
+        {
+            const uintmax_t size = filesystem::file_size(info.m_CompressedPath, ec);
+            if (!ec)
+                filesystem::remove(info.m_Path, ec);
+            if (!ec)
+            {
+                m_TotalSize -= it->m_Size;
+                m_TotalSize += size;
+                it->m_Size = size;
+                it->m_Path = info.m_CompressedPath;
+            }
+            else
+            {
+                filesystem::remove(info.m_CompressedPath, ec);
+            }
+        }
+    }
+
+#if !defined(BOOST_LOG_NO_THREADS)
+
+    //! Compression thread function
+    void file_collector::compression_thread_proc()
+    {
+        unique_lock< mutex > lock(m_Mutex);
+        while (true)
+        {
+            if (!m_CompressionQueue.empty())
+            {
+                compression_queue files;
+                files.splice(files.end(), m_CompressionQueue, m_CompressionQueue.begin());
+
+                lock.unlock();
+                compress_stored_file(files.front());
+                lock.lock();
+            }
+            else if (m_StopCompression)
+            {
+                break;
+            }
+            else
+            {
+                m_CompressionCond.wait(lock);
+            }
+        }
+    }
+
+#endif // !defined(BOOST_LOG_NO_THREADS)
+
     //! Scans the target directory for the files that have already been stored
     uintmax_t file_collector::scan_for_files(
         file::scan_method method, filesystem::path const& pattern, unsigned int* counter)
@@ -738,6 +980,9 @@ BOOST_LOG_ANONYMOUS_NAMESPACE {
                 if (counter)
                     *counter = 0;
 
+                // Compressed files are matched against the pattern without the compression extension
+                const path_string_type extension = filesystem::path(compressed_file_extension(m_Compression)).native();
+
                 file_list files;
                 filesystem::directory_iterator it(dir), end;
                 uintmax_t total_size = 0;
@@ -752,7 +997,8 @@ BOOST_LOG_ANONYMOUS_NAMESPACE {
                         {
                             static bool equivalent(filesystem::path const& left, file_info const& right)
                             {
-                                return filesystem::equivalent(left, right.m_Path);
+                                return filesystem::equivalent(left, right.m_Path) ||
+                                    (!right.m_CompressedPath.empty() && filesystem::equivalent(left, right.m_CompressedPath));
                             }
                         };
                         if (std::find_if(m_Files.begin(), m_Files.end(),
@@ -760,8 +1006,14 @@ BOOST_LOG_ANONYMOUS_NAMESPACE {
                         {
                             // Check that the file name matches the pattern
                             unsigned int file_number = 0;
+                            path_string_type file_name = filename_string(info.m_Path);
+                            if (!extension.empty() && file_name.size() > extension.size() &&
+                                file_name.compare(file_name.size() - extension.size(), extension.size(), extension) == 0)
+                            {
+                                file_name.erase(file_name.size() - extension.size());
+                            }
                             if (method != file::scan_matching ||
-                                match_pattern(filename_string(info.m_Path), mask, file_number))
+                                match_pattern(file_name, mask, file_number))
                             {
                                 info.m_Size = filesystem::file_size(info.m_Path);
                                 total_size += info.m_Size;
@@ -787,18 +1039,23 @@ BOOST_LOG_ANONYMOUS_NAMESPACE {
     }
 
     //! The function updates storage restrictions
-    void file_collector::update(uintmax_t max_size, uintmax_t min_free_space)
+    void file_collector::update(uintmax_t max_size, uintmax_t min_free_space, file::compression_method compression)
     {
         BOOST_LOG_EXPR_IF_MT(lock_guard< mutex > lock(m_Mutex);)
 
         m_MaxSize = (std::min)(m_MaxSize, max_size);
         m_MinFreeSpace = (std::max)(m_MinFreeSpace, min_free_space);
+        if (compression != file::no_compression)
+            m_Compression = compression;
     }
 
 
     //! Finds or creates a file collector
     shared_ptr< file::collector > file_collector_repository::get_collector(
-        filesystem::path const& target_dir, uintmax_t max_size, uintmax_t min_free_space)
+        filesystem::path const& target_dir,
+        uintmax_t max_size,
+        uintmax_t min_free_space,
+        file::compression_method compression)
     {
         BOOST_LOG_EXPR_IF_MT(lock_guard< mutex > lock(m_Mutex);)
 
@@ -809,7 +1066,7 @@ BOOST_LOG_ANONYMOUS_NAMESPACE {
         {
             // This may throw if the collector is being currently destroyed
             p = it->shared_from_this();
-            p->update(max_size, min_free_space);
+            p->update(max_size, min_free_space, compression);
         }
         catch (bad_weak_ptr&)
         {
@@ -818,7 +1075,7 @@ BOOST_LOG_ANONYMOUS_NAMESPACE {
         if (!p)
         {
             p = boost::make_shared< file_collector >(
-                file_collector_repository::get(), target_dir, max_size, min_free_space);
+                file_collector_repository::get(), target_dir, max_size, min_free_space, compression);
             m_Collectors.push_back(*p);
         }
 
@@ -865,9 +1122,14 @@ namespace aux {
     BOOST_LOG_API shared_ptr< collector > make_collector(
         filesystem::path const& target_dir,
         uintmax_t max_size,
-        uintmax_t min_free_space)
+        uintmax_t min_free_space,
+        compression_method compression)
     {
-        return file_collector_repository::get()->get_collector(target_dir, max_size, min_free_space);
+#if !defined(BOOST_LOG_WITH_COMPRESSION)
+        if (compression != no_compression)
+            BOOST_LOG_THROW_DESCR(setup_error, "Boost.Log was built without compression support");
+#endif // !defined(BOOST_LOG_WITH_COMPRESSION)
+        return file_collector_repository::get()->get_collector(target_dir, max_size, min_free_space, compression);
     }
 
 } // namespace aux
@@ -1056,13 +1318,67 @@ struct text_file_backend::implementation
     //! The flag shows if every written record should be flushed
     bool m_AutoFlush;
 
-    implementation(uintmax_t rotation_size, bool auto_flush) :
+    //! Output buffer size, zero if the records are written to the file stream
+    std::size_t m_BufferSize;
+    //! Periodic flush interval of the buffered output
+    posix_time::time_duration m_FlushInterval;
+    //! Buffered file writer, used instead of the file stream if the output is buffered
+    scoped_ptr< aux::buffered_file_writer > m_pWriter;
+
+    implementation(uintmax_t rotation_size, bool auto_flush, std::size_t buffer_size, posix_time::time_duration const& flush_interval) :
         m_FileOpenMode(std::ios_base::trunc | std::ios_base::out),
         m_FileCounter(0),
         m_CharactersWritten(0),
         m_FileRotationSize(rotation_size),
-        m_AutoFlush(auto_flush)
+        m_AutoFlush(auto_flush),
+        m_BufferSize(buffer_size),
+        m_FlushInterval(flush_interval)
+    {
+    }
+
+    //! Returns \c true if a file is open
+    bool is_file_open() const
+    {
+        return m_pWriter ? m_pWriter->is_open() : m_File.is_open();
+    }
+
+    //! Opens the file through the buffered writer
+    void open_buffered_file()
     {
+        if (!m_pWriter || m_pWriter->buffer_size() != m_BufferSize || m_pWriter->flush_interval() != m_FlushInterval)
+        {
+            // Destroying the previous writer waits for the files it is closing
+            m_pWriter.reset();
+            m_pWriter.reset(new aux::buffered_file_writer(m_BufferSize, m_FlushInterval));
+        }
+
+        m_pWriter->open(m_FileName, m_FileOpenMode);
+
+        if (!m_OpenHandler.empty())
+            m_OpenHandler(m_pWriter->stream());
+
+        m_CharactersWritten = m_pWriter->position();
+    }
+
+    //! Opens the file stream
+    void open_stream_file()
+    {
+        m_pWriter.reset();
+
+        m_File.open(m_FileName, m_FileOpenMode);
+        if (!m_File.is_open())
+        {
+            filesystem_error err(
+                "Failed to open file for writing",
+                m_FileName,
+                system::error_code(system::errc::io_error, system::generic_category()));
+            BOOST_THROW_EXCEPTION(err);
+        }
+
+        if (!m_OpenHandler.empty())
+            m_OpenHandler(m_File);
+
+        m_CharactersWritten = static_cast< std::streamoff >(m_File.tellp());
     }
 };
 
@@ -1078,7 +1394,7 @@ BOOST_LOG_API text_file_backend::~text_file_backend()
     try
     {
         // Attempt to put the temporary file into storage
-        if (m_pImpl->m_File.is_open() && m_pImpl->m_CharactersWritten > 0)
+        if (m_pImpl->is_file_open() && m_pImpl->m_CharactersWritten > 0)
             rotate_file();
     }
     catch (...)
@@ -1094,9 +1410,11 @@ BOOST_LOG_API void text_file_backend::construct(
     std::ios_base::openmode mode,
     uintmax_t rotation_size,
     time_based_rotation_predicate const& time_based_rotation,
-    bool auto_flush)
+    bool auto_flush,
+    std::size_t buffer_size,
+    posix_time::time_duration const& flush_interval)
 {
-    m_pImpl = new implementation(rotation_size, auto_flush);
+    m_pImpl = new implementation(rotation_size, auto_flush, buffer_size, flush_interval);
     set_file_name_pattern_internal(pattern);
     set_time_based_rotation(time_based_rotation);
     set_open_mode(mode);
@@ -1120,60 +1438,86 @@ BOOST_LOG_API void text_file_backend::auto_flush(bool f)
     m_pImpl->m_AutoFlush = f;
 }
 
+//! The method sets the output buffer size
+BOOST_LOG_API void text_file_backend::set_buffer_size(std::size_t size)
+{
+    m_pImpl->m_BufferSize = size;
+}
+
+//! The method sets the flush interval of the buffered output
+BOOST_LOG_API void text_file_backend::set_flush_interval(posix_time::time_duration const& interval)
+{
+    m_pImpl->m_FlushInterval = interval;
+}
+
 //! The method writes the message to the sink
 BOOST_LOG_API void text_file_backend::consume(record_view const& rec, string_type const& formatted_message)
 {
     typedef file_char_traits< string_type::value_type > traits_t;
+    const bool file_open = m_pImpl->is_file_open();
     if
     (
         (
-            m_pImpl->m_File.is_open() &&
+            file_open &&
             (
                 m_pImpl->m_CharactersWritten + formatted_message.size() >= m_pImpl->m_FileRotationSize ||
                 (!m_pImpl->m_TimeBasedRotation.empty() && m_pImpl->m_TimeBasedRotation())
             )
         ) ||
-        !m_pImpl->m_File.good()
+        (!m_pImpl->m_pWriter && !m_pImpl->m_File.good())
     )
     {
         rotate_file();
     }
 
-    if (!m_pImpl->m_File.is_open())
+    if (!m_pImpl->is_file_open())
     {
         m_pImpl->m_FileName = m_pImpl->m_StorageDir / m_pImpl->m_FileNameGenerator(m_pImpl->m_FileCounter++);
 
         filesystem::create_directories(m_pImpl->m_FileName.parent_path());
-        m_pImpl->m_File.open(m_pImpl->m_FileName, m_pImpl->m_FileOpenMode);
-        if (!m_pImpl->m_File.is_open())
-        {
-            filesystem_error err(
-                "Failed to open file for writing",
-                m_pImpl->m_FileName,
-                system::error_code(system::errc::io_error, system::generic_category()));
-            BOOST_THROW_EXCEPTION(err);
-        }
-
-        if (!m_pImpl->m_OpenHandler.empty())
-            m_pImpl->m_OpenHandler(m_pImpl->m_File);
-
-        m_pImpl->m_CharactersWritten = static_cast< std::streamoff >(m_pImpl->m_File.tellp());
+        if (m_pImpl->m_BufferSize > 0)
+            m_pImpl->open_buffered_file();
+        else
+            m_pImpl->open_stream_file();
     }
 
-    m_pImpl->m_File.write(formatted_message.data(), static_cast< std::streamsize >(formatted_message.size()));
-    m_pImpl->m_File.put(traits_t::newline);
+    if (m_pImpl->m_pWriter)
+    {
+        const char newline = traits_t::newline;
+        m_pImpl->m_pWriter->write(formatted_message.data(), formatted_message.size());
+        m_pImpl->m_pWriter->write(&newline, 1u);
+    }
+    else
+    {
+        m_pImpl->m_File.write(formatted_message.data(), static_cast< std::streamsize >(formatted_message.size()));
+        m_pImpl->m_File.put(traits_t::newline);
+    }
 
     m_pImpl->m_CharactersWritten += formatted_message.size() + 1;
 
     if (m_pImpl->m_AutoFlush)
-        m_pImpl->m_File.flush();
+    {
+        // With buffered output, waiting for the data to be synchronized with the storage device after every
+        // record would defeat the purpose of the background thread. The record is only handed over to it.
+        if (m_pImpl->m_pWriter)
+            m_pImpl->m_pWriter->submit();
+        else
+            m_pImpl->m_File.flush();
+    }
 }
 
 //! The method flushes the currently open log file
 BOOST_LOG_API void text_file_backend::flush()
 {
-    if (m_pImpl->m_File.is_open())
+    if (m_pImpl->m_pWriter)
+    {
+        if (m_pImpl->m_pWriter->is_open())
+            m_pImpl->m_pWriter->flush();
+    }
+    else if (m_pImpl->m_File.is_open())
+    {
         m_pImpl->m_File.flush();
+    }
 }
 
 //! The method sets file name mask
@@ -1252,6 +1596,20 @@ BOOST_LOG_API void text_file_backend::set_file_name_pattern_internal(filesystem:
 //! The method rotates the file
 BOOST_LOG_API void text_file_backend::rotate_file()
 {
+    if (m_pImpl->m_pWriter && m_pImpl->m_pWriter->is_open())
+    {
+        if (!m_pImpl->m_CloseHandler.empty())
+            m_pImpl->m_CloseHandler(m_pImpl->m_pWriter->stream());
+        m_pImpl->m_CharactersWritten = 0;
+
+        // The file is closed and passed to the collector by the background thread
+        aux::buffered_file_writer::close_handler_type on_closed;
+        if (!!m_pImpl->m_pFileCollector)
+            on_closed = boost::bind(&file::collector::store_file, m_pImpl->m_pFileCollector, _1);
+        m_pImpl->m_pWriter->close(on_closed);
+        return;
+    }
+
     if (!m_pImpl->m_CloseHandler.empty())
         m_pImpl->m_CloseHandler(m_pImpl->m_File);
     m_pImpl->m_File.close();
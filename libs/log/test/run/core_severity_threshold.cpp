@@ -0,0 +1,295 @@
+/*
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   core_severity_threshold.cpp
+ *
+ * \brief  This header contains tests for the severity thresholds cached by the logging core.
+ */
+
+#define BOOST_TEST_MODULE core_severity_threshold
+
+#include <cstddef>
+#include <limits>
+#include <boost/move/utility.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/test/unit_test.hpp>
+#include <boost/log/core/core.hpp>
+#include <boost/log/core/record.hpp>
+#include <boost/log/trivial.hpp>
+#include <boost/log/expressions.hpp>
+#include <boost/log/sources/severity_logger.hpp>
+#include <boost/log/sources/record_ostream.hpp>
+#include <boost/log/sinks/sync_frontend.hpp>
+#include <boost/log/sinks/basic_sink_backend.hpp>
+#include <boost/log/utility/type_info_wrapper.hpp>
+#include "test_sink.hpp"
+
+namespace logging = boost::log;
+namespace sinks = logging::sinks;
+namespace src = logging::sources;
+namespace expr = logging::expressions;
+
+namespace {
+
+    //! The backend counts the consumed records
+    class counting_backend :
+        public sinks::basic_sink_backend< sinks::synchronized_feeding >
+    {
+    public:
+        std::size_t m_RecordCounter;
+
+        counting_backend() : m_RecordCounter(0) {}
+
+        void consume(logging::record_view const&)
+        {
+            ++m_RecordCounter;
+        }
+    };
+
+    typedef sinks::synchronous_sink< counting_backend > counting_sink;
+
+    //! Syslog-like severity levels, where the more severe levels have lower values
+    enum syslog_level
+    {
+        emergency,
+        alert,
+        critical,
+        failure,
+        warning,
+        notice,
+        informational,
+        debug
+    };
+
+    //! The level is at least as severe as another one
+    inline bool operator>= (syslog_level left, syslog_level right)
+    {
+        return static_cast< int >(left) <= static_cast< int >(right);
+    }
+
+    //! Returns \c true if the records with the specified level are discarded by the cached threshold
+    bool is_filtered_out(int level)
+    {
+        return logging::core::get()->get_severity_threshold("Severity", typeid(int)).is_filtered_out(level);
+    }
+
+    //! Restores the default configuration of the core on destruction
+    struct core_cleanup
+    {
+        ~core_cleanup()
+        {
+            boost::shared_ptr< logging::core > core = logging::core::get();
+            core->remove_all_sinks();
+            core->reset_filter();
+        }
+    };
+
+} // namespace
+
+// The test checks that filter expressions are reduced to the severity threshold
+BOOST_AUTO_TEST_CASE(filter_reduction)
+{
+    core_cleanup cleanup;
+    boost::shared_ptr< logging::core > core = logging::core::get();
+
+    BOOST_CHECK(!is_filtered_out(-100));
+
+    core->set_filter(expr::attr< int >("Severity") >= 3);
+    BOOST_CHECK(is_filtered_out(2));
+    BOOST_CHECK(!is_filtered_out(3));
+
+    core->set_filter(expr::attr< int >("Severity") > 3);
+    BOOST_CHECK(is_filtered_out(3));
+    BOOST_CHECK(!is_filtered_out(4));
+
+    core->set_filter(5 <= expr::attr< int >("Severity"));
+    BOOST_CHECK(is_filtered_out(4));
+    BOOST_CHECK(!is_filtered_out(5));
+
+    core->set_filter(expr::has_attr< int >("Tag") && expr::attr< int >("Severity") >= 2);
+    BOOST_CHECK(is_filtered_out(1));
+    BOOST_CHECK(!is_filtered_out(2));
+
+    core->set_filter(expr::attr< int >("Severity") >= 7 || expr::attr< int >("Severity") >= 4);
+    BOOST_CHECK(is_filtered_out(3));
+    BOOST_CHECK(!is_filtered_out(4));
+
+    // Filters that cannot be reduced to a threshold never discard records early
+    core->set_filter(expr::attr< int >("Severity") >= 7 || expr::has_attr< int >("Tag"));
+    BOOST_CHECK(!is_filtered_out(-100));
+    core->set_filter(expr::attr< int >("Severity") <= 3);
+    BOOST_CHECK(!is_filtered_out(-100));
+    core->set_filter(expr::attr< int >("Severity").or_default(10) >= 3);
+    BOOST_CHECK(!is_filtered_out(-100));
+    core->set_filter(expr::attr< int >("Level") >= 3);
+    BOOST_CHECK(!is_filtered_out(-100));
+
+    // Thresholds of a different type are not applied
+    core->set_filter(expr::attr< short >("Severity") >= 3);
+    BOOST_CHECK(!is_filtered_out(-100));
+
+    core->reset_filter();
+    BOOST_CHECK(!is_filtered_out(-100));
+}
+
+// The test checks that the threshold is updated when sinks are added or removed or their filters change
+BOOST_AUTO_TEST_CASE(sink_thresholds)
+{
+    core_cleanup cleanup;
+    boost::shared_ptr< logging::core > core = logging::core::get();
+
+    boost::shared_ptr< counting_sink > sink1 = boost::make_shared< counting_sink >();
+    sink1->set_filter(expr::attr< int >("Severity") >= 5);
+    core->add_sink(sink1);
+    BOOST_CHECK(is_filtered_out(4));
+    BOOST_CHECK(!is_filtered_out(5));
+
+    // A record has to pass the global filter and at least one of the sinks
+    core->set_filter(expr::attr< int >("Severity") >= 6);
+    BOOST_CHECK(is_filtered_out(5));
+    core->reset_filter();
+
+    boost::shared_ptr< counting_sink > sink2 = boost::make_shared< counting_sink >();
+    sink2->set_filter(expr::attr< int >("Severity") >= 2);
+    core->add_sink(sink2);
+    BOOST_CHECK(is_filtered_out(1));
+    BOOST_CHECK(!is_filtered_out(2));
+
+    sink2->set_filter(expr::attr< int >("Severity") >= 8);
+    BOOST_CHECK(is_filtered_out(4));
+    BOOST_CHECK(!is_filtered_out(5));
+
+    sink1->reset_filter();
+    BOOST_CHECK(!is_filtered_out(-100));
+    sink1->set_filter(expr::attr< int >("Severity") >= 5);
+
+    core->remove_sink(sink1);
+    BOOST_CHECK(is_filtered_out(7));
+    BOOST_CHECK(!is_filtered_out(8));
+
+    // Sinks that do not expose their filters disable the threshold
+    boost::shared_ptr< test_sink > sink3(new test_sink());
+    core->add_sink(sink3);
+    BOOST_CHECK(!is_filtered_out(-100));
+    core->remove_sink(sink3);
+    BOOST_CHECK(is_filtered_out(7));
+
+    core->remove_all_sinks();
+    BOOST_CHECK(!is_filtered_out(-100));
+}
+
+// The test checks that severity loggers discard records below the threshold and pass all other records
+BOOST_AUTO_TEST_CASE(severity_logger)
+{
+    core_cleanup cleanup;
+    boost::shared_ptr< logging::core > core = logging::core::get();
+
+    boost::shared_ptr< counting_sink > sink = boost::make_shared< counting_sink >();
+    sink->set_filter(logging::trivial::severity >= logging::trivial::warning);
+    core->add_sink(sink);
+
+    src::severity_logger< logging::trivial::severity_level > lg;
+    BOOST_CHECK(!lg.open_record(logging::keywords::severity = logging::trivial::info));
+
+    BOOST_LOG_SEV(lg, logging::trivial::debug) << "discarded";
+    BOOST_LOG_SEV(lg, logging::trivial::warning) << "passed";
+    BOOST_LOG_SEV(lg, logging::trivial::error) << "passed";
+    BOOST_CHECK_EQUAL(sink->locked_backend()->m_RecordCounter, 2u);
+
+    // The logger notices filter changes
+    sink->set_filter(logging::trivial::severity >= logging::trivial::error);
+    BOOST_LOG_SEV(lg, logging::trivial::warning) << "discarded";
+    BOOST_CHECK_EQUAL(sink->locked_backend()->m_RecordCounter, 2u);
+
+    sink->reset_filter();
+    BOOST_LOG_SEV(lg, logging::trivial::trace) << "passed";
+    BOOST_CHECK_EQUAL(sink->locked_backend()->m_RecordCounter, 3u);
+
+    // Copies of the logger share the cached threshold
+    sink->set_filter(logging::trivial::severity >= logging::trivial::fatal);
+    src::severity_logger< logging::trivial::severity_level > lg2(lg);
+    BOOST_CHECK(!lg2.open_record(logging::keywords::severity = logging::trivial::error));
+    BOOST_LOG_SEV(lg2, logging::trivial::fatal) << "passed";
+    BOOST_CHECK_EQUAL(sink->locked_backend()->m_RecordCounter, 4u);
+}
+
+// The test checks that moving filters keeps the thresholds with the filter functions they were extracted from
+BOOST_AUTO_TEST_CASE(filter_move)
+{
+    logging::filter f1 = expr::attr< int >("Severity") >= 3;
+    logging::filter f2 = expr::attr< int >("Level") >= 5;
+    f1 = boost::move(f2);
+
+    BOOST_CHECK(f1.get_severity_threshold().applies_to("Level", typeid(int)));
+    BOOST_CHECK_EQUAL(f1.get_severity_threshold().level, 5);
+    BOOST_CHECK(f2.get_severity_threshold().applies_to("Severity", typeid(int)));
+    BOOST_CHECK_EQUAL(f2.get_severity_threshold().level, 3);
+}
+
+// The test checks that filters on enumerations with user-defined ordering are not reduced to a threshold
+BOOST_AUTO_TEST_CASE(custom_enum_ordering)
+{
+    core_cleanup cleanup;
+    boost::shared_ptr< logging::core > core = logging::core::get();
+
+    boost::shared_ptr< counting_sink > sink = boost::make_shared< counting_sink >();
+    core->add_sink(sink);
+    core->set_filter(expr::attr< syslog_level >("Severity") >= warning);
+
+    src::severity_logger< syslog_level > lg;
+    BOOST_LOG_SEV(lg, emergency) << "passed";
+    BOOST_LOG_SEV(lg, warning) << "passed";
+    BOOST_LOG_SEV(lg, debug) << "discarded";
+    BOOST_CHECK_EQUAL(sink->locked_backend()->m_RecordCounter, 2u);
+}
+
+// The test checks that unsigned levels that do not fit into intmax_t are not discarded early
+BOOST_AUTO_TEST_CASE(large_unsigned_levels)
+{
+    core_cleanup cleanup;
+    boost::shared_ptr< logging::core > core = logging::core::get();
+
+    boost::shared_ptr< counting_sink > sink = boost::make_shared< counting_sink >();
+    core->add_sink(sink);
+    core->set_filter(expr::attr< boost::uintmax_t >("Severity") >= 3u);
+
+    src::severity_logger< boost::uintmax_t > lg;
+    BOOST_LOG_SEV(lg, (std::numeric_limits< boost::uintmax_t >::max)()) << "passed";
+    BOOST_LOG_SEV(lg, 2u) << "discarded";
+    BOOST_CHECK_EQUAL(sink->locked_backend()->m_RecordCounter, 1u);
+
+    // No record passes the filter with the greatest level, which cannot be expressed by the threshold
+    core->set_filter(expr::attr< boost::intmax_t >("Severity") > (std::numeric_limits< boost::intmax_t >::max)());
+    BOOST_CHECK(!core->get_severity_threshold("Severity", typeid(boost::intmax_t)).is_filtered_out((std::numeric_limits< boost::intmax_t >::min)()));
+}
+
+// The test checks that sinks know whether they are registered in the core
+BOOST_AUTO_TEST_CASE(sink_registration)
+{
+    core_cleanup cleanup;
+    boost::shared_ptr< logging::core > core = logging::core::get();
+
+    boost::shared_ptr< counting_sink > sink = boost::make_shared< counting_sink >();
+    BOOST_CHECK(!sink->is_registered());
+    core->add_sink(sink);
+    BOOST_CHECK(sink->is_registered());
+    core->remove_sink(sink);
+    BOOST_CHECK(!sink->is_registered());
+
+    // Filter changes of sinks that are not registered do not affect the threshold
+    core->set_filter(expr::attr< int >("Severity") >= 3);
+    sink->set_filter(expr::attr< int >("Severity") >= 5);
+    BOOST_CHECK(is_filtered_out(2));
+    BOOST_CHECK(!is_filtered_out(3));
+
+    core->add_sink(sink);
+    BOOST_CHECK(is_filtered_out(4));
+    core->remove_all_sinks();
+    BOOST_CHECK(!sink->is_registered());
+    BOOST_CHECK(!is_filtered_out(3));
+}
@@ -0,0 +1,227 @@
+/*
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   sink_binary_file.cpp
+ *
+ * \brief  This header contains tests for the binary file sink backend and the binary log reader.
+ */
+
+#define BOOST_TEST_MODULE sink_binary_file
+
+#include <string>
+#include <sstream>
+#include <fstream>
+#include <iterator>
+#include <cstddef>
+#include <boost/cstdint.hpp>
+#include <boost/test/unit_test.hpp>
+#include <boost/filesystem/path.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/date_time/gregorian/gregorian_types.hpp>
+#include <boost/log/exceptions.hpp>
+#include <boost/log/trivial.hpp>
+#include <boost/log/attributes/constant.hpp>
+#include <boost/log/attributes/attribute_set.hpp>
+#include <boost/log/attributes/attribute_value_set.hpp>
+#include <boost/log/attributes/value_extraction.hpp>
+#include <boost/log/sinks/binary_file_backend.hpp>
+#include <boost/log/utility/binary_log_reader.hpp>
+#include "make_record.hpp"
+
+namespace logging = boost::log;
+namespace attrs = logging::attributes;
+namespace sinks = logging::sinks;
+namespace keywords = logging::keywords;
+namespace fs = boost::filesystem;
+
+namespace {
+
+    //! Removes the file on destruction
+    struct temp_file
+    {
+        fs::path path;
+
+        temp_file() : path(fs::temp_directory_path() / fs::unique_path("boost_log_test_%%%%-%%%%-%%%%.blog"))
+        {
+        }
+        ~temp_file()
+        {
+            boost::system::error_code ec;
+            fs::remove(path, ec);
+        }
+
+        std::string contents() const
+        {
+            std::ifstream strm(path.string().c_str(), std::ios_base::in | std::ios_base::binary);
+            return std::string(std::istreambuf_iterator< char >(strm), std::istreambuf_iterator< char >());
+        }
+    };
+
+    logging::record_view make_test_record(int n, std::string const& message)
+    {
+        logging::attribute_set set;
+        set["N"] = attrs::constant< int >(n);
+        set["Message"] = attrs::constant< std::string >(message);
+        return make_record_view(set);
+    }
+
+} // namespace
+
+// The test checks that attribute values of all supported types are restored by the reader
+BOOST_AUTO_TEST_CASE(value_round_trip)
+{
+    temp_file file;
+    const boost::posix_time::ptime timestamp(boost::gregorian::date(2013, 11, 2), boost::posix_time::microseconds(123456789));
+    {
+        sinks::binary_file_backend backend(keywords::file_name = file.path, keywords::format = "[%Severity%] %Message%");
+
+        logging::attribute_set set;
+        set["Bool"] = attrs::constant< bool >(true);
+        set["Char"] = attrs::constant< char >('x');
+        set["Short"] = attrs::constant< short >(-12345);
+        set["UInt"] = attrs::constant< unsigned int >(4000000000u);
+        set["Int64"] = attrs::constant< boost::int64_t >(-1234567890123LL);
+        set["Double"] = attrs::constant< double >(2.5);
+        set["Message"] = attrs::constant< std::string >("Hello, world!");
+        set["TimeStamp"] = attrs::constant< boost::posix_time::ptime >(timestamp);
+        set["Severity"] = attrs::constant< logging::trivial::severity_level >(logging::trivial::warning);
+        backend.consume(make_record_view(set));
+    }
+
+    std::stringstream strm(file.contents());
+    logging::binary_log_reader reader(strm);
+    logging::attribute_value_set values;
+    BOOST_REQUIRE(reader.read_record(values));
+    BOOST_CHECK_EQUAL(reader.format(), "[%Severity%] %Message%");
+    BOOST_CHECK_EQUAL(std::distance(values.begin(), values.end()), 9);
+
+    BOOST_CHECK_EQUAL(logging::extract< bool >("Bool", values), true);
+    BOOST_CHECK_EQUAL(logging::extract< char >("Char", values), 'x');
+    BOOST_CHECK_EQUAL(logging::extract< boost::int16_t >("Short", values), -12345);
+    BOOST_CHECK_EQUAL(logging::extract< boost::uint32_t >("UInt", values), 4000000000u);
+    BOOST_CHECK_EQUAL(logging::extract< boost::int64_t >("Int64", values), -1234567890123LL);
+    BOOST_CHECK_EQUAL(logging::extract< double >("Double", values), 2.5);
+    BOOST_CHECK_EQUAL(logging::extract< std::string >("Message", values), "Hello, world!");
+    BOOST_CHECK(logging::extract< boost::posix_time::ptime >("TimeStamp", values) == timestamp);
+    BOOST_CHECK(logging::extract< logging::trivial::severity_level >("Severity", values) == logging::trivial::warning);
+
+    BOOST_CHECK(!reader.read_record(values));
+}
+
+// The test checks that values that cannot be encoded are skipped regardless of the size of the attribute name identifier
+BOOST_AUTO_TEST_CASE(many_attribute_names)
+{
+    temp_file file;
+    const unsigned int name_count = 200;
+    {
+        sinks::binary_file_backend backend(keywords::file_name = file.path);
+
+        // Make sure that some of the name identifiers do not fit in a single byte
+        logging::attribute_set set;
+        for (unsigned int i = 0; i < name_count; ++i)
+        {
+            std::ostringstream name;
+            name << "ManyNames" << i;
+            set[name.str()] = attrs::constant< unsigned int >(i);
+        }
+        set["ManyNamesSpecialTime"] = attrs::constant< boost::posix_time::ptime >(boost::posix_time::not_a_date_time);
+        backend.consume(make_record_view(set));
+        backend.consume(make_test_record(1, "next"));
+    }
+
+    std::stringstream strm(file.contents());
+    logging::binary_log_reader reader(strm);
+    logging::attribute_value_set values;
+
+    BOOST_REQUIRE(reader.read_record(values));
+    BOOST_CHECK_EQUAL(std::distance(values.begin(), values.end()), static_cast< std::ptrdiff_t >(name_count));
+    BOOST_CHECK(values.find("ManyNamesSpecialTime") == values.end());
+    for (unsigned int i = 0; i < name_count; ++i)
+    {
+        std::ostringstream name;
+        name << "ManyNames" << i;
+        BOOST_CHECK_EQUAL(logging::extract< unsigned int >(name.str(), values), i);
+    }
+
+    BOOST_REQUIRE(reader.read_record(values));
+    BOOST_CHECK_EQUAL(logging::extract< std::string >("Message", values), "next");
+    BOOST_CHECK(!reader.read_record(values));
+}
+
+// The test checks that format strings and their identifiers follow the records
+BOOST_AUTO_TEST_CASE(format_change)
+{
+    temp_file file;
+    {
+        sinks::binary_file_backend backend(keywords::file_name = file.path, keywords::format = "%N%");
+        backend.consume(make_test_record(1, "a"));
+        backend.consume(make_test_record(2, "b"));
+        backend.set_format("%N%: %Message%");
+        backend.consume(make_test_record(3, "c"));
+    }
+
+    std::stringstream strm(file.contents());
+    logging::binary_log_reader reader(strm);
+    logging::attribute_value_set values;
+
+    BOOST_REQUIRE(reader.read_record(values));
+    BOOST_CHECK_EQUAL(reader.format(), "%N%");
+    const boost::uintmax_t first_id = reader.format_id();
+    BOOST_REQUIRE(reader.read_record(values));
+    BOOST_CHECK_EQUAL(reader.format_id(), first_id);
+    BOOST_CHECK_EQUAL(logging::extract< int >("N", values), 2);
+    BOOST_REQUIRE(reader.read_record(values));
+    BOOST_CHECK_NE(reader.format_id(), first_id);
+    BOOST_CHECK_EQUAL(reader.format(), "%N%: %Message%");
+    BOOST_CHECK_EQUAL(logging::extract< std::string >("Message", values), "c");
+    BOOST_CHECK(!reader.read_record(values));
+}
+
+// The test checks that reading can be resumed after an incomplete record and across appended file headers
+BOOST_AUTO_TEST_CASE(incremental_reading)
+{
+    temp_file file;
+    {
+        sinks::binary_file_backend backend(keywords::file_name = file.path);
+        backend.consume(make_test_record(1, "first"));
+    }
+    {
+        sinks::binary_file_backend backend(keywords::file_name = file.path, keywords::open_mode = std::ios_base::app);
+        backend.consume(make_test_record(2, "second"));
+    }
+
+    const std::string contents = file.contents();
+    std::stringstream strm;
+    strm.write(contents.data(), 10);
+    logging::binary_log_reader reader(strm);
+    logging::attribute_value_set values;
+    BOOST_CHECK(!reader.read_record(values));
+
+    for (std::size_t i = 10; i < contents.size() - 1u; ++i)
+    {
+        strm.write(contents.data() + i, 1);
+        if (reader.read_record(values))
+        {
+            BOOST_CHECK_EQUAL(logging::extract< std::string >("Message", values), "first");
+            BOOST_CHECK_EQUAL(logging::extract< int >("N", values), 1);
+            BOOST_CHECK(!reader.read_record(values));
+        }
+    }
+
+    strm.write(contents.data() + contents.size() - 1u, 1);
+    BOOST_REQUIRE(reader.read_record(values));
+    BOOST_CHECK_EQUAL(logging::extract< std::string >("Message", values), "second");
+    BOOST_CHECK_EQUAL(logging::extract< int >("N", values), 2);
+    BOOST_CHECK(!reader.read_record(values));
+}
+
+// The test checks that streams not written by the backend are rejected
+BOOST_AUTO_TEST_CASE(invalid_stream)
+{
+    std::stringstream strm("This is a text log\n");
+    BOOST_CHECK_THROW(logging::binary_log_reader reader(strm), logging::parse_error);
+}
@@ -0,0 +1,185 @@
+/*
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   sink_file_collector_compression.cpp
+ *
+ * \brief  This header contains tests for the compression of the files stored by the file collector.
+ */
+
+#define BOOST_TEST_MODULE sink_file_collector_compression
+
+#include <string>
+#include <fstream>
+#include <iterator>
+#include <boost/shared_ptr.hpp>
+#include <boost/test/unit_test.hpp>
+#include <boost/filesystem/path.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/log/detail/config.hpp>
+#include <boost/log/exceptions.hpp>
+#include <boost/log/attributes/attribute_set.hpp>
+#include <boost/log/sinks/text_file_backend.hpp>
+#if !defined(BOOST_LOG_NO_THREADS)
+#include <boost/thread/thread.hpp>
+#endif
+#if defined(BOOST_LOG_WITH_COMPRESSION)
+#include <boost/iostreams/filtering_stream.hpp>
+#include <boost/iostreams/filter/gzip.hpp>
+#include <boost/iostreams/filter/bzip2.hpp>
+#endif
+#include "make_record.hpp"
+
+namespace logging = boost::log;
+namespace sinks = logging::sinks;
+namespace keywords = logging::keywords;
+namespace fs = boost::filesystem;
+#if defined(BOOST_LOG_WITH_COMPRESSION)
+namespace io = boost::iostreams;
+#endif
+
+namespace {
+
+    //! Creates a temporary directory and removes it on destruction
+    struct temp_dir
+    {
+        fs::path path;
+
+        temp_dir() : path(fs::temp_directory_path() / fs::unique_path("boost_log_test_%%%%-%%%%-%%%%"))
+        {
+            fs::create_directories(path);
+        }
+        ~temp_dir()
+        {
+            boost::system::error_code ec;
+            fs::remove_all(path, ec);
+        }
+    };
+
+#if defined(BOOST_LOG_WITH_COMPRESSION)
+
+    //! Reads and decompresses the file
+    template< typename DecompressorT >
+    std::string read_compressed_file(fs::path const& p)
+    {
+        std::ifstream file(p.string().c_str(), std::ios_base::in | std::ios_base::binary);
+        io::filtering_istream strm;
+        strm.push(DecompressorT());
+        strm.push(file);
+        return std::string(std::istreambuf_iterator< char >(strm), std::istreambuf_iterator< char >());
+    }
+
+    //! Waits until the collector compresses the stored file
+    void wait_for_compression(fs::path const& p)
+    {
+#if !defined(BOOST_LOG_NO_THREADS)
+        for (unsigned int i = 0; i < 1000 && fs::exists(p); ++i)
+            boost::this_thread::sleep(boost::posix_time::milliseconds(10));
+#endif
+        BOOST_REQUIRE(!fs::exists(p));
+    }
+
+    //! Writes the records into a number of rotated files
+    void write_files(fs::path const& dir, boost::shared_ptr< sinks::file::collector > const& collector, unsigned int count)
+    {
+        logging::record_view rec = make_record_view(logging::attribute_set());
+        sinks::text_file_backend backend(keywords::file_name = dir / "test_%N.log");
+        backend.set_file_collector(collector);
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            backend.consume(rec, "record " + std::string(1u, static_cast< char >('0' + i)));
+            backend.rotate_file();
+        }
+    }
+
+#endif // defined(BOOST_LOG_WITH_COMPRESSION)
+
+} // namespace
+
+#if defined(BOOST_LOG_WITH_COMPRESSION)
+
+// The test checks that the stored files are compressed with gzip
+BOOST_AUTO_TEST_CASE(gzip_compression)
+{
+    temp_dir dir;
+    const fs::path target = dir.path / "target";
+    write_files(dir.path, sinks::file::make_collector(keywords::target = target, keywords::compression = sinks::file::gzip_compression), 2);
+
+    // The collector is destroyed after all files are compressed
+    BOOST_CHECK(!fs::exists(target / "test_0.log"));
+    BOOST_CHECK(!fs::exists(target / "test_1.log"));
+    BOOST_CHECK_EQUAL(read_compressed_file< io::gzip_decompressor >(target / "test_0.log.gz"), std::string("record 0\n"));
+    BOOST_CHECK_EQUAL(read_compressed_file< io::gzip_decompressor >(target / "test_1.log.gz"), std::string("record 1\n"));
+}
+
+// The test checks that the stored files are compressed with bzip2
+BOOST_AUTO_TEST_CASE(bzip2_compression)
+{
+    temp_dir dir;
+    const fs::path target = dir.path / "target";
+    write_files(dir.path, sinks::file::make_collector(keywords::target = target, keywords::compression = sinks::file::bzip2_compression), 1);
+
+    BOOST_CHECK(!fs::exists(target / "test_0.log"));
+    BOOST_CHECK_EQUAL(read_compressed_file< io::bzip2_decompressor >(target / "test_0.log.bz2"), std::string("record 0\n"));
+}
+
+// The test checks that the compressed file sizes are used to maintain the total size limit
+BOOST_AUTO_TEST_CASE(compressed_size_limit)
+{
+    temp_dir dir;
+    const fs::path target = dir.path / "target";
+    logging::record_view rec = make_record_view(logging::attribute_set());
+
+    boost::shared_ptr< sinks::file::collector > collector = sinks::file::make_collector(
+        keywords::target = target,
+        keywords::max_size = 20000u,
+        keywords::compression = sinks::file::gzip_compression);
+    sinks::text_file_backend backend(keywords::file_name = dir.path / "test_%N.log");
+    backend.set_file_collector(collector);
+
+    // Every uncompressed file exceeds half of the limit
+    const std::string message(15000u, 'a');
+    for (unsigned int i = 0; i < 5; ++i)
+    {
+        backend.consume(rec, message);
+        backend.rotate_file();
+        wait_for_compression(target / ("test_" + std::string(1u, static_cast< char >('0' + i)) + ".log"));
+    }
+
+    for (unsigned int i = 0; i < 5; ++i)
+        BOOST_CHECK(fs::exists(target / ("test_" + std::string(1u, static_cast< char >('0' + i)) + ".log.gz")));
+}
+
+// The test checks that scanning for files takes the compressed files into account
+BOOST_AUTO_TEST_CASE(scan_compressed_files)
+{
+    temp_dir dir;
+    const fs::path target = dir.path / "target";
+    write_files(dir.path, sinks::file::make_collector(keywords::target = target, keywords::compression = sinks::file::gzip_compression), 3);
+
+    sinks::text_file_backend backend(keywords::file_name = dir.path / "test_%N.log");
+    backend.set_file_collector(sinks::file::make_collector(keywords::target = target, keywords::compression = sinks::file::gzip_compression));
+    BOOST_CHECK_EQUAL(backend.scan_for_files(sinks::file::scan_matching), 3u);
+
+    // The file counter continues after the found files
+    backend.consume(make_record_view(logging::attribute_set()), "record 3");
+    backend.rotate_file();
+    wait_for_compression(target / "test_3.log");
+    BOOST_CHECK_EQUAL(read_compressed_file< io::gzip_decompressor >(target / "test_3.log.gz"), std::string("record 3\n"));
+}
+
+#else // defined(BOOST_LOG_WITH_COMPRESSION)
+
+// The test checks that compression cannot be requested if the library is built without compression support
+BOOST_AUTO_TEST_CASE(compression_not_supported)
+{
+    temp_dir dir;
+    const fs::path target = dir.path / "target";
+    BOOST_CHECK_THROW(sinks::file::make_collector(keywords::target = target, keywords::compression = sinks::file::gzip_compression), logging::setup_error);
+    BOOST_CHECK(!!sinks::file::make_collector(keywords::target = target));
+}
+
+#endif // defined(BOOST_LOG_WITH_COMPRESSION)
@@ -0,0 +1,299 @@
+/*
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   sink_per_thread_fifo_queue.cpp
+ *
+ * \brief  This header contains tests for the per-thread FIFO queueing strategy of the asynchronous sink frontend.
+ */
+
+#define BOOST_TEST_MODULE sink_per_thread_fifo_queue
+
+#include <boost/test/unit_test.hpp>
+#include <boost/log/detail/config.hpp>
+
+#if !defined(BOOST_LOG_NO_THREADS)
+
+#include <cstddef>
+#include <vector>
+#include <utility>
+#include <new>
+#include <boost/ref.hpp>
+#include <boost/bind.hpp>
+#include <boost/function.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/type_traits/aligned_storage.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/log/attributes/constant.hpp>
+#include <boost/log/attributes/attribute_set.hpp>
+#include <boost/log/attributes/value_extraction.hpp>
+#include <boost/log/sinks/basic_sink_backend.hpp>
+#include <boost/log/sinks/async_frontend.hpp>
+#include <boost/log/sinks/per_thread_fifo_queue.hpp>
+#include <boost/log/sinks/drop_on_overflow.hpp>
+#include <boost/log/sinks/block_on_overflow.hpp>
+#include "make_record.hpp"
+
+namespace logging = boost::log;
+namespace attrs = logging::attributes;
+namespace sinks = logging::sinks;
+namespace keywords = logging::keywords;
+
+namespace {
+
+    typedef std::pair< unsigned int, unsigned int > record_id;
+
+    //! The backend collects thread and record numbers of the records
+    class collecting_backend :
+        public sinks::basic_sink_backend< sinks::synchronized_feeding >
+    {
+    private:
+        mutable boost::mutex m_mutex;
+        std::vector< record_id > m_records;
+
+    public:
+        void consume(logging::record_view const& rec)
+        {
+            boost::lock_guard< boost::mutex > lock(m_mutex);
+            m_records.push_back(record_id(
+                logging::extract_or_throw< unsigned int >("ThreadNo", rec),
+                logging::extract_or_throw< unsigned int >("RecordNo", rec)));
+        }
+
+        std::vector< record_id > records() const
+        {
+            boost::lock_guard< boost::mutex > lock(m_mutex);
+            return m_records;
+        }
+    };
+
+    logging::record_view make_test_record(unsigned int thread_no, unsigned int record_no)
+    {
+        logging::attribute_set set;
+        set["ThreadNo"] = attrs::constant< unsigned int >(thread_no);
+        set["RecordNo"] = attrs::constant< unsigned int >(record_no);
+        return make_record_view(set);
+    }
+
+    template< typename SinkT >
+    void enqueue_records(SinkT& sink, unsigned int thread_no, unsigned int count)
+    {
+        for (unsigned int i = 0; i < count; ++i)
+            sink.consume(make_test_record(thread_no, i));
+    }
+
+    //! The thread runs the tasks passed to it until it is destroyed
+    class worker_thread
+    {
+    private:
+        boost::mutex m_mutex;
+        boost::condition_variable m_cond;
+        boost::function0< void > m_task;
+        bool m_stop;
+        boost::thread m_thread;
+
+    public:
+        worker_thread() : m_stop(false), m_thread(boost::bind(&worker_thread::thread_proc, this))
+        {
+        }
+        ~worker_thread()
+        {
+            {
+                boost::lock_guard< boost::mutex > lock(m_mutex);
+                m_stop = true;
+            }
+            m_cond.notify_all();
+            m_thread.join();
+        }
+
+        //! Runs the task in the thread and waits for its completion
+        void run(boost::function0< void > const& task)
+        {
+            boost::unique_lock< boost::mutex > lock(m_mutex);
+            m_task = task;
+            m_cond.notify_all();
+            while (!m_task.empty())
+                m_cond.wait(lock);
+        }
+
+    private:
+        void thread_proc()
+        {
+            boost::unique_lock< boost::mutex > lock(m_mutex);
+            while (true)
+            {
+                if (!m_task.empty())
+                {
+                    m_task();
+                    m_task.clear();
+                    m_cond.notify_all();
+                }
+                else if (m_stop)
+                    break;
+                else
+                    m_cond.wait(lock);
+            }
+        }
+    };
+
+} // namespace
+
+// The test checks that all records are passed to the backend and the order of records of every thread is preserved
+BOOST_AUTO_TEST_CASE(multithreaded_enqueue)
+{
+    enum { thread_count = 4, record_count = 20000 };
+
+    typedef sinks::asynchronous_sink<
+        collecting_backend,
+        sinks::per_thread_fifo_queue< 64, sinks::block_on_overflow >
+    > sink_t;
+    boost::shared_ptr< collecting_backend > backend = boost::make_shared< collecting_backend >();
+    sink_t sink(backend);
+
+    boost::thread_group threads;
+    for (unsigned int i = 0; i < thread_count; ++i)
+        threads.create_thread(boost::bind(&enqueue_records< sink_t >, boost::ref(sink), i, (unsigned int)record_count));
+    threads.join_all();
+    sink.flush();
+
+    std::vector< record_id > records = backend->records();
+    BOOST_REQUIRE_EQUAL(records.size(), static_cast< std::size_t >(thread_count * record_count));
+
+    std::vector< unsigned int > next(thread_count, 0u);
+    for (std::size_t i = 0; i < records.size(); ++i)
+    {
+        BOOST_REQUIRE_LT(records[i].first, static_cast< unsigned int >(thread_count));
+        BOOST_REQUIRE_EQUAL(records[i].second, next[records[i].first]);
+        ++next[records[i].first];
+    }
+
+    sink.stop();
+}
+
+// The test checks that records enqueued by different threads are dequeued in the order of enqueueing
+BOOST_AUTO_TEST_CASE(enqueue_order)
+{
+    typedef sinks::asynchronous_sink<
+        collecting_backend,
+        sinks::per_thread_fifo_queue< 16, sinks::drop_on_overflow >
+    > sink_t;
+    boost::shared_ptr< collecting_backend > backend = boost::make_shared< collecting_backend >();
+    sink_t sink(backend, false);
+
+    for (unsigned int i = 0; i < 6; ++i)
+    {
+        const unsigned int thread_no = i % 2;
+        if (thread_no == 0)
+            sink.consume(make_test_record(thread_no, i));
+        else
+            boost::thread(boost::bind(&sink_t::consume, boost::ref(sink), make_test_record(thread_no, i))).join();
+    }
+    sink.feed_records();
+
+    std::vector< record_id > records = backend->records();
+    BOOST_REQUIRE_EQUAL(records.size(), 6u);
+    for (unsigned int i = 0; i < 6; ++i)
+    {
+        BOOST_CHECK_EQUAL(records[i].first, i % 2);
+        BOOST_CHECK_EQUAL(records[i].second, i);
+    }
+}
+
+// The test checks that excessive records are discarded with the drop_on_overflow strategy
+BOOST_AUTO_TEST_CASE(drop_on_overflow)
+{
+    typedef sinks::asynchronous_sink<
+        collecting_backend,
+        sinks::per_thread_fifo_queue< 4, sinks::drop_on_overflow >
+    > sink_t;
+    boost::shared_ptr< collecting_backend > backend = boost::make_shared< collecting_backend >();
+    sink_t sink(backend, false);
+
+    enqueue_records(sink, 0, 10);
+    BOOST_CHECK(!sink.try_consume(make_test_record(0, 10)));
+    sink.feed_records();
+
+    std::vector< record_id > records = backend->records();
+    BOOST_REQUIRE_EQUAL(records.size(), 4u);
+    for (unsigned int i = 0; i < 4; ++i)
+        BOOST_CHECK_EQUAL(records[i].second, i);
+
+    // The queue of another thread is not affected
+    boost::thread(boost::bind(&enqueue_records< sink_t >, boost::ref(sink), 1u, 3u)).join();
+    enqueue_records(sink, 0, 2);
+    sink.feed_records();
+    BOOST_CHECK_EQUAL(backend->records().size(), 9u);
+}
+
+// The test checks that enqueueing threads are blocked on overflow with the block_on_overflow strategy
+BOOST_AUTO_TEST_CASE(block_on_overflow)
+{
+    enum { thread_count = 3, record_count = 100 };
+
+    typedef sinks::asynchronous_sink<
+        collecting_backend,
+        sinks::per_thread_fifo_queue< 4, sinks::block_on_overflow >
+    > sink_t;
+    boost::shared_ptr< collecting_backend > backend = boost::make_shared< collecting_backend >();
+    sink_t sink(backend, false);
+
+    boost::thread_group threads;
+    for (unsigned int i = 0; i < thread_count; ++i)
+        threads.create_thread(boost::bind(&enqueue_records< sink_t >, boost::ref(sink), i, (unsigned int)record_count));
+
+    // The threads fill their queues and block
+    boost::this_thread::sleep(boost::posix_time::milliseconds(100));
+    BOOST_CHECK(backend->records().empty());
+
+    while (backend->records().size() < static_cast< std::size_t >(thread_count * record_count))
+    {
+        sink.feed_records();
+        boost::this_thread::yield();
+    }
+    threads.join_all();
+    sink.feed_records();
+    BOOST_CHECK_EQUAL(backend->records().size(), static_cast< std::size_t >(thread_count * record_count));
+}
+
+// The test checks that a queue created at the address of a destroyed one does not use the rings left by the old queue
+BOOST_AUTO_TEST_CASE(recreate_at_same_address)
+{
+    typedef sinks::asynchronous_sink<
+        collecting_backend,
+        sinks::per_thread_fifo_queue< 16, sinks::drop_on_overflow >
+    > sink_t;
+    boost::shared_ptr< collecting_backend > backend = boost::make_shared< collecting_backend >();
+
+    // The logging thread outlives the sinks
+    worker_thread worker;
+    boost::aligned_storage< sizeof(sink_t), boost::alignment_of< sink_t >::value >::type storage;
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+        sink_t* sink = new (&storage) sink_t(backend, false);
+        worker.run(boost::bind(&enqueue_records< sink_t >, boost::ref(*sink), i, 2u));
+        sink->feed_records();
+        sink->~sink_t();
+
+        std::vector< record_id > records = backend->records();
+        BOOST_REQUIRE_EQUAL(records.size(), static_cast< std::size_t >(2u * (i + 1u)));
+        BOOST_CHECK_EQUAL(records[2u * i].first, i);
+        BOOST_CHECK_EQUAL(records[2u * i + 1u].first, i);
+    }
+}
+
+#else // !defined(BOOST_LOG_NO_THREADS)
+
+// The queueing strategy is only supported in multithreaded builds
+BOOST_AUTO_TEST_CASE(not_supported)
+{
+}
+
+#endif // !defined(BOOST_LOG_NO_THREADS)
@@ -0,0 +1,194 @@
+/*
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   sink_text_file_buffered.cpp
+ *
+ * \brief  This header contains tests for the buffered output of the text file sink backend.
+ */
+
+#define BOOST_TEST_MODULE sink_text_file_buffered
+
+#include <string>
+#include <fstream>
+#include <iterator>
+#include <ostream>
+#include <boost/test/unit_test.hpp>
+#include <boost/filesystem/path.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/log/detail/config.hpp>
+#include <boost/log/attributes/attribute_set.hpp>
+#include <boost/log/sinks/text_file_backend.hpp>
+#if !defined(BOOST_LOG_NO_THREADS)
+#include <boost/thread/thread.hpp>
+#endif
+#include "make_record.hpp"
+
+namespace logging = boost::log;
+namespace sinks = logging::sinks;
+namespace keywords = logging::keywords;
+namespace fs = boost::filesystem;
+
+namespace {
+
+    //! Creates a temporary directory and removes it on destruction
+    struct temp_dir
+    {
+        fs::path path;
+
+        temp_dir() : path(fs::temp_directory_path() / fs::unique_path("boost_log_test_%%%%-%%%%-%%%%"))
+        {
+            fs::create_directories(path);
+        }
+        ~temp_dir()
+        {
+            boost::system::error_code ec;
+            fs::remove_all(path, ec);
+        }
+    };
+
+    std::string read_file(fs::path const& p)
+    {
+        std::ifstream strm(p.string().c_str(), std::ios_base::in | std::ios_base::binary);
+        return std::string(std::istreambuf_iterator< char >(strm), std::istreambuf_iterator< char >());
+    }
+
+    void write_header(std::ostream& strm)
+    {
+        strm << "header\n";
+    }
+
+    void write_footer(std::ostream& strm)
+    {
+        strm << "footer\n";
+    }
+
+} // namespace
+
+// The test checks that the records are accumulated in the buffer until it is full or flushed
+BOOST_AUTO_TEST_CASE(buffered_output)
+{
+    temp_dir dir;
+    const fs::path file_name = dir.path / "test.log";
+    logging::record_view rec = make_record_view(logging::attribute_set());
+
+    sinks::text_file_backend backend(keywords::file_name = file_name, keywords::buffer_size = 64u);
+    backend.consume(rec, "first");
+    backend.consume(rec, "second");
+    BOOST_CHECK_EQUAL(read_file(file_name), std::string());
+
+    backend.flush();
+    BOOST_CHECK_EQUAL(read_file(file_name), std::string("first\nsecond\n"));
+
+    // The full buffers are written without flushing
+    std::string expected = "first\nsecond\n";
+    for (unsigned int i = 0; i < 100; ++i)
+    {
+        const std::string message(i % 30 + 1, static_cast< char >('a' + i % 26));
+        backend.consume(rec, message);
+        expected += message;
+        expected += '\n';
+    }
+    backend.flush();
+    BOOST_CHECK_EQUAL(read_file(file_name), expected);
+}
+
+// The test checks that the rotated files are closed and passed to the file collector
+BOOST_AUTO_TEST_CASE(rotation)
+{
+    temp_dir dir;
+    const fs::path target = dir.path / "target";
+    logging::record_view rec = make_record_view(logging::attribute_set());
+
+    {
+        sinks::text_file_backend backend
+        (
+            keywords::file_name = dir.path / "test_%N.log",
+            keywords::rotation_size = 35u,
+            keywords::buffer_size = 16u
+        );
+        backend.set_file_collector(sinks::file::make_collector(keywords::target = target));
+        backend.set_open_handler(&write_header);
+        backend.set_close_handler(&write_footer);
+
+        for (unsigned int i = 0; i < 6; ++i)
+            backend.consume(rec, "0123456789");
+    }
+
+    // Every file contains the header, two records and the footer
+    const std::string expected = "header\n0123456789\n0123456789\nfooter\n";
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+        const fs::path p = target / ("test_" + std::string(1u, static_cast< char >('0' + i)) + ".log");
+        BOOST_CHECK_MESSAGE(fs::exists(p), p.string() + " does not exist");
+        BOOST_CHECK_EQUAL(read_file(p), expected);
+    }
+    BOOST_CHECK(!fs::exists(dir.path / "test_0.log"));
+}
+
+// The test checks that the buffer size can be changed for the next file
+BOOST_AUTO_TEST_CASE(buffer_size_change)
+{
+    temp_dir dir;
+    logging::record_view rec = make_record_view(logging::attribute_set());
+
+    sinks::text_file_backend backend(keywords::file_name = dir.path / "test_%N.log", keywords::buffer_size = 1024u);
+    backend.consume(rec, "buffered");
+    BOOST_CHECK_EQUAL(read_file(dir.path / "test_0.log"), std::string());
+
+    backend.set_buffer_size(0u);
+    backend.rotate_file();
+    backend.consume(rec, "unbuffered");
+    backend.flush();
+    BOOST_CHECK_EQUAL(read_file(dir.path / "test_0.log"), std::string("buffered\n"));
+    BOOST_CHECK_EQUAL(read_file(dir.path / "test_1.log"), std::string("unbuffered\n"));
+}
+
+#if !defined(BOOST_LOG_NO_THREADS)
+
+// The test checks that the buffered records are periodically written to the file
+BOOST_AUTO_TEST_CASE(periodic_flush)
+{
+    temp_dir dir;
+    const fs::path file_name = dir.path / "test.log";
+    logging::record_view rec = make_record_view(logging::attribute_set());
+
+    sinks::text_file_backend backend
+    (
+        keywords::file_name = file_name,
+        keywords::buffer_size = 1024u,
+        keywords::flush_interval = boost::posix_time::milliseconds(10)
+    );
+    backend.consume(rec, "message");
+
+    for (unsigned int i = 0; i < 500 && read_file(file_name).empty(); ++i)
+        boost::this_thread::sleep(boost::posix_time::milliseconds(10));
+    BOOST_CHECK_EQUAL(read_file(file_name), std::string("message\n"));
+}
+
+// The test checks that auto-flush passes every record to the background thread without waiting for it to be written
+BOOST_AUTO_TEST_CASE(buffered_auto_flush)
+{
+    temp_dir dir;
+    const fs::path file_name = dir.path / "test.log";
+    logging::record_view rec = make_record_view(logging::attribute_set());
+
+    sinks::text_file_backend backend
+    (
+        keywords::file_name = file_name,
+        keywords::buffer_size = 1024u,
+        keywords::auto_flush = true
+    );
+    backend.consume(rec, "first");
+    backend.consume(rec, "second");
+
+    // The records are written by the background thread, without an explicit flush
+    for (unsigned int i = 0; i < 500 && read_file(file_name) != "first\nsecond\n"; ++i)
+        boost::this_thread::sleep(boost::posix_time::milliseconds(10));
+    BOOST_CHECK_EQUAL(read_file(file_name), std::string("first\nsecond\n"));
+}
+
+#endif // !defined(BOOST_LOG_NO_THREADS)
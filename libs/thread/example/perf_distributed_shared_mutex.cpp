@@ -0,0 +1,83 @@
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Compares the throughput of boost::shared_mutex and distributed_shared_mutex on a read-mostly workload: several
+// threads read a shared value under a shared lock and one out of [write ratio] iterations writes it under a unique
+// lock.
+//
+// usage: perf_distributed_shared_mutex [threads] [iterations per thread] [write ratio]
+
+#define BOOST_THREAD_USES_CHRONO
+
+#include <boost/thread/distributed_shared_mutex.hpp>
+#include <boost/thread/shared_mutex.hpp>
+#include <boost/thread/lock_types.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/chrono/chrono.hpp>
+#include <boost/bind.hpp>
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+  template <class Mutex>
+  struct SharedData
+  {
+    Mutex mtx;
+    long value;
+
+    SharedData() :
+      value(0)
+    {
+    }
+  };
+
+  template <class Mutex>
+  void worker_thread(SharedData<Mutex>* shared_data, int iterations, int write_ratio)
+  {
+    long sum = 0;
+    for (int i = 1; i <= iterations; ++i)
+    {
+      if (write_ratio > 0 && i % write_ratio == 0)
+      {
+        boost::unique_lock<Mutex> lk(shared_data->mtx);
+        ++shared_data->value;
+      }
+      else
+      {
+        boost::shared_lock<Mutex> lk(shared_data->mtx);
+        sum += shared_data->value;
+      }
+    }
+    if (sum < 0)
+      std::cout << sum << std::endl;
+  }
+
+  // returns the number of lock acquisitions per second
+  template <class Mutex>
+  double benchmark(int threads, int iterations, int write_ratio)
+  {
+    SharedData<Mutex> shared_data;
+    boost::thread_group group;
+    boost::chrono::steady_clock::time_point start = boost::chrono::steady_clock::now();
+    for (int i = 0; i < threads; ++i)
+      group.create_thread(boost::bind(&worker_thread<Mutex>, &shared_data, iterations, write_ratio));
+    group.join_all();
+    boost::chrono::duration<double> elapsed = boost::chrono::steady_clock::now() - start;
+    return threads * double(iterations) / elapsed.count();
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  const int threads = argc > 1 ? std::atoi(argv[1]) : 4;
+  const int iterations = argc > 2 ? std::atoi(argv[2]) : 1000000;
+  const int write_ratio = argc > 3 ? std::atoi(argv[3]) : 1000;
+
+  std::cout << threads << " threads, 1 write every " << write_ratio << " iterations (locks/s):" << std::endl;
+  std::cout << "  shared_mutex: " << benchmark<boost::shared_mutex>(threads, iterations, write_ratio) << std::endl;
+  std::cout << "  distributed_shared_mutex: "
+      << benchmark<boost::distributed_shared_mutex>(threads, iterations, write_ratio) << std::endl;
+  return 0;
+}
@@ -0,0 +1,125 @@
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Compares boost::mutex and boost::condition_variable with futex_mutex and futex_condition_variable:
+// - handoff: two threads pass a token back and forth, the average time of a handoff is reported;
+// - contention: several threads increment a shared counter under the mutex.
+//
+// usage: perf_futex [handoffs] [threads] [increments per thread]
+
+#include <boost/thread/futex_condition_variable.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/chrono/chrono.hpp>
+#include <boost/bind.hpp>
+#include <boost/ref.hpp>
+#include <cstdlib>
+#include <iostream>
+
+#if defined BOOST_THREAD_HAS_FUTEX
+
+namespace
+{
+  struct BoostTypes
+  {
+    typedef boost::mutex mutex;
+    typedef boost::condition_variable condition_variable;
+  };
+
+  struct FutexTypes
+  {
+    typedef boost::futex_mutex mutex;
+    typedef boost::futex_condition_variable condition_variable;
+  };
+
+  template <class Types>
+  struct SharedData
+  {
+    typename Types::mutex mtx;
+    typename Types::condition_variable cnd;
+    int turn;
+    long counter;
+
+    SharedData() :
+      turn(0), counter(0)
+    {
+    }
+  };
+
+  template <class Types>
+  void handoff_thread(SharedData<Types>* shared_data, int me, int handoffs)
+  {
+    boost::unique_lock<typename Types::mutex> lk(shared_data->mtx);
+    for (int i = 0; i < handoffs; ++i)
+    {
+      while (shared_data->turn != me)
+        shared_data->cnd.wait(lk);
+      shared_data->turn = 1 - me;
+      shared_data->cnd.notify_one();
+    }
+  }
+
+  // returns the average latency of a handoff in nanoseconds
+  template <class Types>
+  double benchmark_handoff(int handoffs)
+  {
+    SharedData<Types> shared_data;
+    boost::chrono::steady_clock::time_point start = boost::chrono::steady_clock::now();
+    boost::thread t0(boost::bind(&handoff_thread<Types>, &shared_data, 0, handoffs));
+    boost::thread t1(boost::bind(&handoff_thread<Types>, &shared_data, 1, handoffs));
+    t0.join();
+    t1.join();
+    boost::chrono::nanoseconds elapsed = boost::chrono::steady_clock::now() - start;
+    return double(elapsed.count()) / (2.0 * handoffs);
+  }
+
+  template <class Types>
+  void increment_thread(SharedData<Types>* shared_data, int increments)
+  {
+    for (int i = 0; i < increments; ++i)
+    {
+      boost::lock_guard<typename Types::mutex> lk(shared_data->mtx);
+      ++shared_data->counter;
+    }
+  }
+
+  // returns the number of increments per second
+  template <class Types>
+  double benchmark_contention(int threads, int increments)
+  {
+    SharedData<Types> shared_data;
+    boost::thread_group group;
+    boost::chrono::steady_clock::time_point start = boost::chrono::steady_clock::now();
+    for (int i = 0; i < threads; ++i)
+      group.create_thread(boost::bind(&increment_thread<Types>, &shared_data, increments));
+    group.join_all();
+    boost::chrono::duration<double> elapsed = boost::chrono::steady_clock::now() - start;
+    return threads * double(increments) / elapsed.count();
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  const int handoffs = argc > 1 ? std::atoi(argv[1]) : 100000;
+  const int threads = argc > 2 ? std::atoi(argv[2]) : 4;
+  const int increments = argc > 3 ? std::atoi(argv[3]) : 1000000;
+
+  std::cout << "handoff latency (ns):" << std::endl;
+  std::cout << "  boost::mutex/condition_variable: " << benchmark_handoff<BoostTypes>(handoffs) << std::endl;
+  std::cout << "  futex_mutex/futex_condition_variable: " << benchmark_handoff<FutexTypes>(handoffs) << std::endl;
+
+  std::cout << threads << " threads contending (increments/s):" << std::endl;
+  std::cout << "  boost::mutex: " << benchmark_contention<BoostTypes>(threads, increments) << std::endl;
+  std::cout << "  futex_mutex: " << benchmark_contention<FutexTypes>(threads, increments) << std::endl;
+  return 0;
+}
+
+#else
+int main()
+{
+  std::cout << "futex_mutex is not available on this platform" << std::endl;
+  return 0;
+}
+#endif
@@ -0,0 +1,85 @@
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Compares the throughput of sync_queue, that protects a deque with a single mutex, with sync_two_lock_queue, that
+// uses separate locks for the head and the tail, when several producers and consumers contend on the queue.
+//
+// usage: perf_sync_queue [max producers and consumers] [elements per producer]
+
+#define BOOST_THREAD_VERSION 4
+
+#include <boost/thread/sync_queue.hpp>
+#include <boost/thread/sync_two_lock_queue.hpp>
+#include <boost/thread/thread_only.hpp>
+#include <boost/thread/detail/thread_group.hpp>
+#include <boost/thread/barrier.hpp>
+#include <boost/chrono/chrono.hpp>
+#include <boost/bind.hpp>
+#include <boost/ref.hpp>
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+  template <class Queue>
+  void producer(Queue& q, boost::barrier& go, int count)
+  {
+    go.count_down_and_wait();
+    for (int i = 0; i < count; ++i)
+      q.push(i);
+  }
+
+  template <class Queue>
+  void consumer(Queue& q, boost::barrier& go)
+  {
+    go.count_down_and_wait();
+    for (;;)
+    {
+      int i;
+      bool closed;
+      q.pull(i, closed);
+      if (closed) return;
+    }
+  }
+
+  // returns the number of elements per second, that are pushed and pulled by n producers and n consumers
+  template <class Queue>
+  double benchmark(unsigned n, int count)
+  {
+    Queue q;
+    boost::barrier go(2 * n + 1);
+    boost::thread_group producers;
+    boost::thread_group consumers;
+    for (unsigned i = 0; i < n; ++i)
+    {
+      producers.create_thread(boost::bind(&producer<Queue>, boost::ref(q), boost::ref(go), count));
+      consumers.create_thread(boost::bind(&consumer<Queue>, boost::ref(q), boost::ref(go)));
+    }
+
+    go.count_down_and_wait();
+    boost::chrono::steady_clock::time_point start = boost::chrono::steady_clock::now();
+    producers.join_all();
+    q.close();
+    consumers.join_all();
+    boost::chrono::duration<double> elapsed = boost::chrono::steady_clock::now() - start;
+
+    return n * double(count) / elapsed.count();
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  const unsigned max_threads = argc > 1 ? std::atoi(argv[1]) : 4;
+  const int count = argc > 2 ? std::atoi(argv[2]) : 100000;
+
+  std::cout << count << " elements per producer" << std::endl;
+  std::cout << "producers/consumers\tsync_queue (elements/s)\tsync_two_lock_queue (elements/s)" << std::endl;
+  for (unsigned n = 1; n <= max_threads; n *= 2)
+  {
+    double one_lock = benchmark<boost::sync_queue<int> >(n, count);
+    double two_locks = benchmark<boost::sync_two_lock_queue<int> >(n, count);
+    std::cout << n << "\t\t\t" << one_lock << "\t\t\t" << two_locks << std::endl;
+  }
+  return 0;
+}
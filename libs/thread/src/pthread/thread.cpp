@@ -17,6 +17,8 @@
 #include <boost/thread/once.hpp>
 #include <boost/thread/tss.hpp>
 #include <boost/thread/future.hpp>
+#include <boost/thread/pthread/futex.hpp>
+#include <climits>
 
 #ifdef __GLIBC__
 #include <sys/sysinfo.h>
@@ -544,6 +546,14 @@ namespace boost
         {
             lock_guard<mutex> lk(local_thread_info->data_mutex);
             local_thread_info->interrupt_requested=true;
+#if defined BOOST_THREAD_HAS_FUTEX
+            // the waiter blocks in its destructor until data_mutex is unlocked, once the word has been taken
+            if(detail::futex_word* const futex=local_thread_info->current_futex.exchange(0))
+            {
+                ++*futex;
+                detail::futex_wake(*futex, INT_MAX);
+            }
+#endif
             if(local_thread_info->current_cond)
             {
                 boost::pthread::pthread_mutex_scoped_lock internal_lock(local_thread_info->cond_mutex);
@@ -0,0 +1,122 @@
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// <boost/thread/executors/basic_thread_pool.hpp>
+
+// class basic_thread_pool
+
+#define BOOST_THREAD_VERSION 4
+
+#include <boost/thread/executors/basic_thread_pool.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <stdexcept>
+
+boost::mutex counter_mutex;
+int counter = 0;
+
+void increment()
+{
+  boost::lock_guard<boost::mutex> lk(counter_mutex);
+  ++counter;
+}
+
+int answer()
+{
+  return 42;
+}
+
+int fail()
+{
+  throw std::runtime_error("fail");
+}
+
+// sums [begin, end) by splitting the range and submitting the halves to the pool, waits for the halves by executing
+// other closures of the pool
+struct sum_range
+{
+  typedef int result_type;
+
+  boost::basic_thread_pool* pool;
+  int begin;
+  int end;
+
+  sum_range(boost::basic_thread_pool& p, int b, int e) :
+    pool(&p), begin(b), end(e)
+  {
+  }
+
+  int operator()() const
+  {
+    if (end - begin <= 16)
+    {
+      int sum = 0;
+      for (int i = begin; i < end; ++i)
+        sum += i;
+      return sum;
+    }
+
+    int middle = begin + (end - begin) / 2;
+    boost::future<int> left = pool->submit(sum_range(*pool, begin, middle));
+    boost::future<int> right = pool->submit(sum_range(*pool, middle, end));
+    while (!left.is_ready() || !right.is_ready())
+      if (!pool->try_executing_one())
+        boost::this_thread::yield();
+    return left.get() + right.get();
+  }
+};
+
+int main()
+{
+  {
+    counter = 0;
+    {
+      boost::basic_thread_pool pool(4);
+      BOOST_TEST_EQ(pool.size(), 4u);
+      for (int i = 0; i < 1000; ++i)
+        pool.execute(&increment);
+    }
+    BOOST_TEST_EQ(counter, 1000);
+  }
+  {
+    boost::basic_thread_pool pool(2);
+    boost::future<int> f = pool.submit(&answer);
+    BOOST_TEST_EQ(f.get(), 42);
+
+    boost::future<void> v = pool.submit(&increment);
+    v.get();
+  }
+  {
+    boost::basic_thread_pool pool(2);
+    boost::future<int> f = pool.submit(&fail);
+    try
+    {
+      f.get();
+      BOOST_TEST(false);
+    }
+    catch (std::runtime_error&)
+    {
+    }
+  }
+  {
+    boost::basic_thread_pool pool(3);
+    boost::future<int> f = pool.submit(sum_range(pool, 0, 10000));
+    BOOST_TEST_EQ(f.get(), 10000 * 9999 / 2);
+  }
+  {
+    boost::basic_thread_pool pool(1);
+    pool.close();
+    BOOST_TEST(pool.closed());
+    try
+    {
+      pool.execute(&increment);
+      BOOST_TEST(false);
+    }
+    catch (boost::sync_queue_is_closed&)
+    {
+    }
+    pool.join();
+  }
+
+  return boost::report_errors();
+}
@@ -0,0 +1,88 @@
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// <boost/thread/futex_condition_variable.hpp>
+
+// class futex_condition_variable;
+
+// wait is an interruption point
+
+#include <boost/thread/futex_condition_variable.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/detail/lightweight_test.hpp>
+
+#if defined BOOST_THREAD_HAS_FUTEX && defined BOOST_THREAD_PROVIDES_INTERRUPTIONS
+
+boost::futex_condition_variable cv;
+boost::futex_mutex mut;
+
+bool waiting = false;
+bool interrupted = false;
+bool owned_after_interruption = false;
+
+void f()
+{
+  boost::unique_lock<boost::futex_mutex> lk(mut);
+  waiting = true;
+  try
+  {
+    for (;;)
+      cv.wait(lk);
+  }
+  catch (boost::thread_interrupted&)
+  {
+    interrupted = true;
+    owned_after_interruption = lk.owns_lock();
+  }
+}
+
+void g()
+{
+  boost::unique_lock<boost::futex_mutex> lk(mut);
+  boost::this_thread::disable_interruption di;
+  // not an interruption point, returns on the notification
+  cv.wait(lk);
+}
+
+int main()
+{
+  {
+    boost::thread t(f);
+    for (;;)
+    {
+      boost::lock_guard<boost::futex_mutex> lk(mut);
+      if (waiting) break;
+    }
+    t.interrupt();
+    t.join();
+    BOOST_TEST(interrupted);
+    BOOST_TEST(owned_after_interruption);
+  }
+  {
+    // interrupted before waiting
+    interrupted = false;
+    waiting = false;
+    boost::unique_lock<boost::futex_mutex> lk(mut);
+    boost::thread t(f);
+    t.interrupt();
+    lk.unlock();
+    t.join();
+    BOOST_TEST(interrupted);
+  }
+  {
+    boost::thread t(g);
+    t.interrupt();
+    for (int i = 0; i < 100 && !t.try_join_for(boost::chrono::milliseconds(10)); ++i)
+      cv.notify_all();
+    BOOST_TEST(!t.joinable());
+  }
+
+  return boost::report_errors();
+}
+
+#else
+int main()
+{
+  return 0;
+}
+#endif
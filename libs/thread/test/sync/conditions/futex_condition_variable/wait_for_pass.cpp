@@ -0,0 +1,70 @@
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// <boost/thread/futex_condition_variable.hpp>
+
+// class futex_condition_variable;
+
+// template <class Lock, class Rep, class Period>
+//     cv_status
+//     wait_for(Lock& lock, const chrono::duration<Rep, Period>& rel_time);
+
+#include <boost/thread/futex_condition_variable.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/detail/lightweight_test.hpp>
+
+#if defined BOOST_THREAD_HAS_FUTEX && defined BOOST_THREAD_USES_CHRONO
+
+boost::futex_condition_variable cv;
+boost::mutex mut;
+
+typedef boost::chrono::steady_clock Clock;
+typedef boost::chrono::milliseconds milliseconds;
+
+bool ready = false;
+
+bool is_ready()
+{
+  return ready;
+}
+
+void f()
+{
+  boost::this_thread::sleep_for(milliseconds(50));
+  {
+    boost::lock_guard<boost::mutex> lk(mut);
+    ready = true;
+  }
+  cv.notify_one();
+}
+
+int main()
+{
+  {
+    // times out, the lock is held again
+    boost::unique_lock<boost::mutex> lk(mut);
+    Clock::time_point t0 = Clock::now();
+    BOOST_TEST(cv.wait_for(lk, milliseconds(100)) == boost::cv_status::timeout);
+    Clock::time_point t1 = Clock::now();
+    BOOST_TEST(t1 - t0 >= milliseconds(100));
+    BOOST_TEST(lk.owns_lock());
+    BOOST_TEST(!cv.wait_for(lk, milliseconds(10), &is_ready));
+  }
+  {
+    // woken up before the timeout
+    boost::unique_lock<boost::mutex> lk(mut);
+    boost::thread t(f);
+    BOOST_TEST(cv.wait_for(lk, milliseconds(5000), &is_ready));
+    lk.unlock();
+    t.join();
+  }
+
+  return boost::report_errors();
+}
+
+#else
+int main()
+{
+  return 0;
+}
+#endif
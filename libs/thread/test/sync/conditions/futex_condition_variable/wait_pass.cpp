@@ -0,0 +1,103 @@
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// <boost/thread/futex_condition_variable.hpp>
+
+// class futex_condition_variable;
+
+// template <class Lock> void wait(Lock& lock);
+
+#include <boost/thread/futex_condition_variable.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/detail/lightweight_test.hpp>
+
+#if defined BOOST_THREAD_HAS_FUTEX
+
+boost::futex_condition_variable cv;
+boost::futex_mutex mut;
+
+int test1 = 0;
+int test2 = 0;
+
+void f()
+{
+  boost::unique_lock<boost::futex_mutex> lk(mut);
+  BOOST_TEST(test2 == 0);
+  test1 = 1;
+  cv.notify_one();
+  while (test2 == 0)
+    cv.wait(lk);
+  BOOST_TEST(test2 != 0);
+}
+
+// passes the turn between two threads
+int turn = 0;
+const int rounds = 10000;
+
+void ping_pong(int me)
+{
+  boost::unique_lock<boost::futex_mutex> lk(mut);
+  for (int i = 0; i < rounds; ++i)
+  {
+    cv.wait(lk, boost::bind(std::equal_to<int>(), boost::ref(turn), me));
+    turn = 1 - me;
+    cv.notify_all();
+  }
+}
+
+int ready = 0;
+bool go = false;
+
+void wait_for_go()
+{
+  boost::unique_lock<boost::futex_mutex> lk(mut);
+  ++ready;
+  cv.notify_all();
+  while (!go)
+    cv.wait(lk);
+}
+
+int main()
+{
+  {
+    boost::unique_lock<boost::futex_mutex> lk(mut);
+    boost::thread t(f);
+    BOOST_TEST(test1 == 0);
+    while (test1 == 0)
+      cv.wait(lk);
+    BOOST_TEST(test1 != 0);
+    test2 = 1;
+    lk.unlock();
+    cv.notify_one();
+    t.join();
+  }
+  {
+    boost::thread t0(boost::bind(&ping_pong, 0));
+    boost::thread t1(boost::bind(&ping_pong, 1));
+    t0.join();
+    t1.join();
+  }
+  {
+    // notify_all wakes all waiters, with a boost::mutex as well
+    boost::thread_group threads;
+    for (int i = 0; i < 4; ++i)
+      threads.create_thread(&wait_for_go);
+    {
+      boost::unique_lock<boost::futex_mutex> lk(mut);
+      while (ready != 4)
+        cv.wait(lk);
+      go = true;
+    }
+    cv.notify_all();
+    threads.join_all();
+  }
+
+  return boost::report_errors();
+}
+
+#else
+int main()
+{
+  return 0;
+}
+#endif
@@ -0,0 +1,82 @@
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// <boost/thread/future.hpp>
+
+// template <class Ex, class F>
+//     future<typename result_of<typename decay<F>::type()>::type>
+//     async(Ex& ex, F&& f);
+
+#define BOOST_THREAD_VERSION 4
+
+#include <boost/thread/executors/basic_thread_pool.hpp>
+#include <boost/thread/future.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <stdexcept>
+
+int f0()
+{
+  return 3;
+}
+
+int i = 0;
+
+int& f1()
+{
+  return i;
+}
+
+void f2()
+{
+  i = 5;
+}
+
+void f3()
+{
+  throw std::logic_error("f3");
+}
+
+struct functor
+{
+  typedef long result_type;
+
+  long operator()() const
+  {
+    return 7;
+  }
+};
+
+int main()
+{
+  boost::basic_thread_pool pool(2);
+  {
+    boost::future<int> f = boost::async(pool, &f0);
+    BOOST_TEST_EQ(f.get(), 3);
+  }
+  {
+    boost::future<int&> f = boost::async(pool, &f1);
+    BOOST_TEST(&f.get() == &i);
+  }
+  {
+    boost::future<void> f = boost::async(pool, &f2);
+    f.get();
+    BOOST_TEST_EQ(i, 5);
+  }
+  {
+    boost::future<void> f = boost::async(pool, &f3);
+    try
+    {
+      f.get();
+      BOOST_TEST(false);
+    }
+    catch (std::logic_error&)
+    {
+    }
+  }
+  {
+    boost::future<long> f = boost::async(pool, functor());
+    BOOST_TEST_EQ(f.get(), 7);
+  }
+
+  return boost::report_errors();
+}
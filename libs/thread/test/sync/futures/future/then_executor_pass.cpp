@@ -0,0 +1,115 @@
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// <boost/thread/future.hpp>
+
+// class future<R>
+
+// template<typename Ex, typename F>
+// auto then(Ex& ex, F&& func) -> future<decltype(func(*this))>;
+
+#define BOOST_THREAD_VERSION 4
+
+#include <boost/thread/executors/basic_thread_pool.hpp>
+#include <boost/thread/future.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <stdexcept>
+
+#if defined BOOST_THREAD_PROVIDES_FUTURE_CONTINUATION
+
+int p1()
+{
+  return 1;
+}
+
+int p2(boost::future<int>& f)
+{
+  BOOST_TEST(f.valid());
+  return 2 * f.get();
+}
+
+void p3(boost::future<int>& f)
+{
+  BOOST_TEST(f.valid());
+  f.get();
+}
+
+int p4(boost::shared_future<int>& f)
+{
+  return f.get() + 1;
+}
+
+int p5(boost::future<int>& f)
+{
+  f.get();
+  throw std::runtime_error("p5");
+}
+
+int main()
+{
+  boost::basic_thread_pool pool(2);
+  {
+    boost::future<int> f1 = boost::async(pool, &p1);
+    boost::future<int> f2 = f1.then(pool, &p2);
+    BOOST_TEST_EQ(f2.get(), 2);
+  }
+  {
+    boost::future<int> f1 = boost::async(pool, &p1);
+    boost::future<void> f2 = f1.then(pool, &p3);
+    f2.get();
+  }
+  {
+    boost::promise<int> p;
+    boost::future<int> f1 = p.get_future();
+    boost::future<int> f2 = f1.then(pool, &p2).then(pool, &p2);
+    BOOST_TEST(!f2.is_ready());
+    p.set_value(3);
+    BOOST_TEST_EQ(f2.get(), 12);
+  }
+  {
+    boost::shared_future<int> f1 = boost::async(pool, &p1).share();
+    boost::future<int> f2 = f1.then(pool, &p4);
+    BOOST_TEST_EQ(f2.get(), 2);
+  }
+  {
+    boost::future<int> f2 = boost::make_ready_future(1).then(pool, &p5);
+    try
+    {
+      f2.get();
+      BOOST_TEST(false);
+    }
+    catch (std::runtime_error&)
+    {
+    }
+  }
+  {
+    // a launch policy held in a variable still selects the policy overload
+    boost::launch policy = boost::launch::async;
+    boost::future<int> f2 = boost::make_ready_future(1).then(policy, &p2);
+    BOOST_TEST_EQ(f2.get(), 2);
+  }
+  {
+    // the continuation fails if the executor does not accept it
+    boost::basic_thread_pool closed_pool(1);
+    closed_pool.close();
+    boost::future<int> f2 = boost::make_ready_future(1).then(closed_pool, &p2);
+    try
+    {
+      f2.get();
+      BOOST_TEST(false);
+    }
+    catch (boost::sync_queue_is_closed&)
+    {
+    }
+  }
+
+  return boost::report_errors();
+}
+
+#else
+
+int main()
+{
+  return 0;
+}
+#endif
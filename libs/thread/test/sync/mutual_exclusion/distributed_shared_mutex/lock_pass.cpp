@@ -0,0 +1,125 @@
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// <boost/thread/distributed_shared_mutex.hpp>
+
+// class distributed_shared_mutex;
+
+// void lock();
+// void lock_shared();
+
+#include <boost/thread/distributed_shared_mutex.hpp>
+#include <boost/thread/shared_lock_guard.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/detail/lightweight_test.hpp>
+
+boost::distributed_shared_mutex m;
+
+typedef boost::chrono::steady_clock Clock;
+typedef Clock::time_point time_point;
+typedef boost::chrono::milliseconds ms;
+typedef boost::chrono::nanoseconds ns;
+
+void f()
+{
+  time_point t0 = Clock::now();
+  m.lock();
+  time_point t1 = Clock::now();
+  m.unlock();
+  ns d = t1 - t0 - ms(250);
+  // This test is spurious as it depends on the time the thread system switches the threads
+  BOOST_TEST(d < ns(2500000)+ms(1000)); // within 2.5ms
+}
+
+void g()
+{
+  time_point t0 = Clock::now();
+  m.lock_shared();
+  time_point t1 = Clock::now();
+  m.unlock_shared();
+  ns d = t1 - t0 - ms(250);
+  // This test is spurious as it depends on the time the thread system switches the threads
+  BOOST_TEST(d < ns(2500000)+ms(1000)); // within 2.5ms
+}
+
+// readers and writers check, that a writer never runs concurrently with another thread
+int readers = 0;
+int writers = 0;
+boost::mutex counters_mutex;
+bool failed = false;
+
+void reader(int n)
+{
+  for (int i = 0; i < n; ++i)
+  {
+    boost::shared_lock_guard<boost::distributed_shared_mutex> lk(m);
+    boost::lock_guard<boost::mutex> clk(counters_mutex);
+    ++readers;
+    failed = failed || writers != 0;
+    --readers;
+  }
+}
+
+void writer(int n)
+{
+  for (int i = 0; i < n; ++i)
+  {
+    boost::lock_guard<boost::distributed_shared_mutex> lk(m);
+    {
+      boost::lock_guard<boost::mutex> clk(counters_mutex);
+      failed = failed || writers != 0 || readers != 0;
+      ++writers;
+    }
+    boost::this_thread::yield();
+    {
+      boost::lock_guard<boost::mutex> clk(counters_mutex);
+      --writers;
+    }
+  }
+}
+
+int main()
+{
+  {
+    // a writer excludes writers
+    m.lock();
+    boost::thread t(f);
+    boost::this_thread::sleep_for(ms(250));
+    m.unlock();
+    t.join();
+  }
+  {
+    // a writer excludes readers
+    m.lock();
+    boost::thread t(g);
+    boost::this_thread::sleep_for(ms(250));
+    m.unlock();
+    t.join();
+  }
+  {
+    // a reader excludes writers
+    m.lock_shared();
+    boost::thread t(f);
+    boost::this_thread::sleep_for(ms(250));
+    m.unlock_shared();
+    t.join();
+  }
+  {
+    // readers share the mutex
+    m.lock_shared();
+    BOOST_TEST(m.try_lock_shared());
+    m.unlock_shared();
+    m.unlock_shared();
+  }
+  {
+    boost::thread_group threads;
+    for (int i = 0; i < 4; ++i)
+      threads.create_thread(boost::bind(&reader, 10000));
+    for (int i = 0; i < 2; ++i)
+      threads.create_thread(boost::bind(&writer, 1000));
+    threads.join_all();
+    BOOST_TEST(!failed);
+  }
+
+  return boost::report_errors();
+}
@@ -0,0 +1,89 @@
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// <boost/thread/distributed_shared_mutex.hpp>
+
+// class distributed_shared_mutex;
+
+// bool try_lock();
+// bool try_lock_shared();
+// template <class Rep, class Period>
+//     bool try_lock_for(const chrono::duration<Rep, Period>& rel_time);
+// template <class Rep, class Period>
+//     bool try_lock_shared_for(const chrono::duration<Rep, Period>& rel_time);
+
+#include <boost/thread/distributed_shared_mutex.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/detail/lightweight_test.hpp>
+
+boost::distributed_shared_mutex m(1);
+
+typedef boost::chrono::steady_clock Clock;
+typedef Clock::time_point time_point;
+typedef boost::chrono::milliseconds ms;
+typedef boost::chrono::nanoseconds ns;
+
+void try_lock_fails()
+{
+  BOOST_TEST(!m.try_lock());
+}
+
+void try_lock_shared_fails()
+{
+  BOOST_TEST(!m.try_lock_shared());
+}
+
+void try_lock_for_times_out()
+{
+  time_point t0 = Clock::now();
+  BOOST_TEST(!m.try_lock_for(ms(250)));
+  time_point t1 = Clock::now();
+  ns d = t1 - t0 - ms(250);
+  // This test is spurious as it depends on the time the thread system switches the threads
+  BOOST_TEST(d < ns(5000000)+ms(1000)); // within 5ms
+}
+
+void try_lock_shared_for_succeeds()
+{
+  BOOST_TEST(m.try_lock_shared_for(ms(300)+ms(1000)));
+  m.unlock_shared();
+}
+
+int main()
+{
+  {
+    BOOST_TEST(m.try_lock());
+    BOOST_TEST(!m.try_lock());
+    boost::thread t(try_lock_shared_fails);
+    t.join();
+    m.unlock();
+  }
+  {
+    BOOST_TEST(m.try_lock_shared());
+    boost::thread t(try_lock_fails);
+    t.join();
+    m.unlock_shared();
+    BOOST_TEST(m.try_lock());
+    m.unlock();
+  }
+  {
+    m.lock_shared();
+    boost::thread t(try_lock_for_times_out);
+    // This test is spurious as it depends on the time the thread system switches the threads
+    boost::this_thread::sleep_for(ms(300)+ms(1000));
+    m.unlock_shared();
+    t.join();
+    // the writer, that timed out, no longer turns readers away
+    BOOST_TEST(m.try_lock_shared());
+    m.unlock_shared();
+  }
+  {
+    m.lock();
+    boost::thread t(try_lock_shared_for_succeeds);
+    boost::this_thread::sleep_for(ms(250));
+    m.unlock();
+    t.join();
+  }
+
+  return boost::report_errors();
+}
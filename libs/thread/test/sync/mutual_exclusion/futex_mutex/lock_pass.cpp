@@ -0,0 +1,80 @@
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// <boost/thread/futex_mutex.hpp>
+
+// class futex_mutex;
+
+// void lock();
+
+#include <boost/thread/futex_mutex.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/detail/lightweight_test.hpp>
+
+#if defined BOOST_THREAD_HAS_FUTEX
+
+boost::futex_mutex m;
+
+#if defined BOOST_THREAD_USES_CHRONO
+typedef boost::chrono::steady_clock Clock;
+typedef Clock::time_point time_point;
+typedef boost::chrono::milliseconds ms;
+typedef boost::chrono::nanoseconds ns;
+#endif
+
+void f()
+{
+#if defined BOOST_THREAD_USES_CHRONO
+  time_point t0 = Clock::now();
+  m.lock();
+  time_point t1 = Clock::now();
+  m.unlock();
+  ns d = t1 - t0 - ms(250);
+  // This test is spurious as it depends on the time the thread system switches the threads
+  BOOST_TEST(d < ns(2500000)+ms(1000)); // within 2.5ms
+#else
+  m.lock();
+  m.unlock();
+#endif
+}
+
+long counter = 0;
+
+void increment(int n)
+{
+  for (int i = 0; i < n; ++i)
+  {
+    boost::unique_lock<boost::futex_mutex> lk(m);
+    ++counter;
+  }
+}
+
+int main()
+{
+  {
+    m.lock();
+    boost::thread t(f);
+#if defined BOOST_THREAD_USES_CHRONO
+    boost::this_thread::sleep_for(ms(250));
+#endif
+    m.unlock();
+    t.join();
+  }
+  {
+    const int n = 100000;
+    boost::thread_group threads;
+    for (int i = 0; i < 4; ++i)
+      threads.create_thread(boost::bind(&increment, n));
+    threads.join_all();
+    BOOST_TEST_EQ(counter, 4 * n);
+  }
+
+  return boost::report_errors();
+}
+
+#else
+int main()
+{
+  return 0;
+}
+#endif
@@ -0,0 +1,42 @@
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// <boost/thread/futex_mutex.hpp>
+
+// class futex_mutex;
+
+// bool try_lock();
+
+#include <boost/thread/futex_mutex.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/detail/lightweight_test.hpp>
+
+#if defined BOOST_THREAD_HAS_FUTEX
+
+boost::futex_mutex m;
+
+void f()
+{
+  BOOST_TEST(!m.try_lock());
+}
+
+int main()
+{
+  BOOST_TEST(m.try_lock());
+  boost::thread t(f);
+  t.join();
+  m.unlock();
+
+  BOOST_TEST(m.try_lock());
+  BOOST_TEST(!m.try_lock());
+  m.unlock();
+
+  return boost::report_errors();
+}
+
+#else
+int main()
+{
+  return 0;
+}
+#endif
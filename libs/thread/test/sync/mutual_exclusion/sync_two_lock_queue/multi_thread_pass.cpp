@@ -0,0 +1,248 @@
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// <boost/thread/sync_two_lock_queue.hpp>
+
+// class sync_two_lock_queue<T>
+
+//    push || pull;
+
+#include <boost/config.hpp>
+#if ! defined  BOOST_NO_CXX11_DECLTYPE
+#define BOOST_RESULT_OF_USE_DECLTYPE
+#endif
+
+#define BOOST_THREAD_VERSION 4
+
+#include <boost/thread/sync_two_lock_queue.hpp>
+#include <boost/thread/future.hpp>
+#include <boost/thread/barrier.hpp>
+
+#include <boost/thread/detail/thread_group.hpp>
+#include <boost/bind.hpp>
+#include <boost/ref.hpp>
+
+#include <boost/detail/lightweight_test.hpp>
+
+void push_range(boost::sync_two_lock_queue<int>& q, int count)
+{
+  for (int i = 0; i < count; ++i)
+    q.push(i);
+}
+
+struct call_push
+{
+  boost::sync_two_lock_queue<int> &q_;
+  boost::barrier& go_;
+
+  call_push(boost::sync_two_lock_queue<int> &q, boost::barrier &go) :
+    q_(q), go_(go)
+  {
+  }
+  typedef void result_type;
+  void operator()()
+  {
+    go_.count_down_and_wait();
+    q_.push(42);
+
+  }
+};
+
+struct call_pull
+{
+  boost::sync_two_lock_queue<int> &q_;
+  boost::barrier& go_;
+
+  call_pull(boost::sync_two_lock_queue<int> &q, boost::barrier &go) :
+    q_(q), go_(go)
+  {
+  }
+  typedef int result_type;
+  int operator()()
+  {
+    go_.count_down_and_wait();
+    return q_.pull();
+  }
+};
+
+void test_concurrent_push_and_pull_on_empty_queue()
+{
+  boost::sync_two_lock_queue<int> q;
+
+  boost::barrier go(2);
+
+  boost::future<void> push_done;
+  boost::future<int> pull_done;
+
+  try
+  {
+    push_done=boost::async(boost::launch::async,
+#if ! defined BOOST_NO_CXX11_LAMBDAS
+        [&q,&go]()
+        {
+          go.wait();
+          q.push(42);
+        }
+#else
+        call_push(q,go)
+#endif
+    );
+    pull_done=boost::async(boost::launch::async,
+#if ! defined BOOST_NO_CXX11_LAMBDAS
+        [&q,&go]() -> int
+        {
+          go.wait();
+          return q.pull();
+        }
+#else
+        call_pull(q,go)
+#endif
+    );
+
+    push_done.get();
+    BOOST_TEST_EQ(pull_done.get(), 42);
+    BOOST_TEST(q.empty());
+  }
+  catch (...)
+  {
+    BOOST_TEST(false);
+  }
+}
+
+void test_concurrent_push_on_empty_queue()
+{
+  boost::sync_two_lock_queue<int> q;
+  const unsigned int n = 3;
+  boost::barrier go(n);
+  boost::future<void> push_done[n];
+
+  try
+  {
+    for (unsigned int i =0; i< n; ++i)
+      push_done[i]=boost::async(boost::launch::async,
+#if ! defined BOOST_NO_CXX11_LAMBDAS
+        [&q,&go]()
+        {
+          go.wait();
+          q.push(42);
+        }
+#else
+        call_push(q,go)
+#endif
+    );
+
+    for (unsigned int i = 0; i < n; ++i)
+      push_done[i].get();
+
+    BOOST_TEST(!q.empty());
+    for (unsigned int i =0; i< n; ++i)
+      BOOST_TEST_EQ(q.pull(), 42);
+    BOOST_TEST(q.empty());
+
+  }
+  catch (...)
+  {
+    BOOST_TEST(false);
+  }
+}
+
+void test_concurrent_pull_on_queue()
+{
+  boost::sync_two_lock_queue<int> q;
+  const unsigned int n = 3;
+  boost::barrier go(n);
+
+  boost::future<int> pull_done[n];
+
+  try
+  {
+    for (unsigned int i =0; i< n; ++i)
+      q.push(42);
+
+    for (unsigned int i =0; i< n; ++i)
+      pull_done[i]=boost::async(boost::launch::async,
+#if ! defined BOOST_NO_CXX11_LAMBDAS
+        [&q,&go]() -> int
+        {
+          go.wait();
+          return q.pull();
+        }
+#else
+        call_pull(q,go)
+#endif
+    );
+
+    for (unsigned int i = 0; i < n; ++i)
+      BOOST_TEST_EQ(pull_done[i].get(), 42);
+    BOOST_TEST(q.empty());
+  }
+  catch (...)
+  {
+    BOOST_TEST(false);
+  }
+}
+
+struct call_drain
+{
+  boost::sync_two_lock_queue<int> &q_;
+
+  call_drain(boost::sync_two_lock_queue<int> &q) :
+    q_(q)
+  {
+  }
+  typedef long result_type;
+  long operator()()
+  {
+    long sum = 0;
+    for (;;)
+    {
+      int i;
+      bool closed;
+      q_.pull(i, closed);
+      if (closed) return sum;
+      sum += i;
+    }
+  }
+};
+
+void test_concurrent_producers_and_consumers_until_closed()
+{
+  boost::sync_two_lock_queue<int> q;
+  const unsigned int n = 3;
+  const int count = 10000;
+
+  boost::future<long> pull_done[n];
+
+  try
+  {
+    for (unsigned int i =0; i< n; ++i)
+      pull_done[i]=boost::async(boost::launch::async, call_drain(q));
+
+    boost::thread_group producers;
+    for (unsigned int i =0; i< n; ++i)
+      producers.create_thread(boost::bind(&push_range, boost::ref(q), count));
+    producers.join_all();
+    q.close();
+
+    long sum = 0;
+    for (unsigned int i = 0; i < n; ++i)
+      sum += pull_done[i].get();
+    BOOST_TEST_EQ(sum, long(n) * count * (count - 1) / 2);
+    BOOST_TEST(q.empty());
+  }
+  catch (...)
+  {
+    BOOST_TEST(false);
+  }
+}
+
+int main()
+{
+  test_concurrent_push_and_pull_on_empty_queue();
+  test_concurrent_push_on_empty_queue();
+  test_concurrent_pull_on_queue();
+  test_concurrent_producers_and_consumers_until_closed();
+
+  return boost::report_errors();
+}
+